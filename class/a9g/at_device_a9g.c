@@ -27,6 +27,8 @@
 #include <ctype.h>
 
 #include <at_device_a9g.h>
+#include <at_device_urc.h>
+#include <at_device_apn.h>
 
 #define LOG_TAG                    "at.dev.a9g"
 #include <at_log.h>
@@ -37,11 +39,6 @@
 #define A9G_THREAD_STACK_SIZE      2048
 #define A9G_THREAD_PRIORITY        (RT_THREAD_PRIORITY_MAX/2)
 
-/* AT+CSTT command default*/
-static char *CSTT_CHINA_MOBILE  = "AT+CSTT=\"CMNET\"";
-static char *CSTT_CHINA_UNICOM  = "AT+CSTT=\"UNINET\"";
-static char *CSTT_CHINA_TELECOM = "AT+CSTT=\"CTNET\"";
-
 static void a9g_power_on(struct at_device *device)
 {
     struct at_device_a9g *a9g = RT_NULL;
@@ -550,6 +547,7 @@ static void a9g_init_thread_entry(void *parameter)
     char parsed_data[10] = {0};
     rt_err_t result = RT_EOK;
     at_response_t resp = RT_NULL;
+    const struct at_device_apn *apn = RT_NULL;
     struct at_device *device = (struct at_device *)parameter;
     struct at_client *client = device->client;
 
@@ -634,6 +632,9 @@ static void a9g_init_thread_entry(void *parameter)
             goto __exit;
         }
 
+        /* the APN is found by the PLMN of the SIM card, the unknown one uses "CMNET" as before */
+        apn = at_device_apn_query(device, client);
+
         /* the device default response timeout is 40 seconds, but it set to 15 seconds is convenient to use. */
         for (uint8_t ii = 0; ii < INIT_RETRY; ii++)
         {
@@ -659,7 +660,12 @@ static void a9g_init_thread_entry(void *parameter)
                 rt_thread_mdelay(1000);
             }
 
-            AT_SEND_CMD(client, resp, 0, 1000, "AT+CGDCONT=1,\"IP\",\"CMNET\"");
+            resp = at_resp_set_info(resp, 128, 0, rt_tick_from_millisecond(1000));
+            if (at_obj_exec_cmd(client, resp, "AT+CGDCONT=1,\"IP\",\"%s\"", apn ? apn->apn : "CMNET") < 0)
+            {
+                result = -RT_ERROR;
+                goto __exit;
+            }
             rt_thread_mdelay(10);
             AT_SEND_CMD(client, resp, 0, 5 * 1000, "AT+CGACT=1,1");
             rt_thread_mdelay(10);
@@ -708,25 +714,15 @@ static void a9g_init_thread_entry(void *parameter)
             AT_SEND_CMD(client, resp, 0, 1 * 1000, "AT+CIPMUX=1");
         }
 
-        AT_SEND_CMD(client, resp, 0, 300, "AT+COPS?");
-        at_resp_parse_line_args_by_kw(resp, "+COPS:", "+COPS: %*[^\"]\"%[^\"]", &parsed_data);
-        if (rt_strcmp(parsed_data, "CHINA MOBILE") == 0)
-        {
-            /* "CMCC" */
-            LOG_I("a9g device(%s) network operator: %s", device->name, parsed_data);
-            AT_SEND_CMD(client, resp, 0, 300, CSTT_CHINA_MOBILE);
-        }
-        else if (rt_strcmp(parsed_data, "CHN-UNICOM") == 0)
-        {
-            /* "UNICOM" */
-            LOG_I("a9g device(%s) network operator: %s", device->name, parsed_data);
-            AT_SEND_CMD(client, resp, 0, 300, CSTT_CHINA_UNICOM);
-        }
-        else if (rt_strcmp(parsed_data, "CHN-CT") == 0)
+        if (apn)
         {
-            AT_SEND_CMD(client, resp, 0, 300, CSTT_CHINA_TELECOM);
-            /* "CT" */
-            LOG_I("a9g device(%s) network operator: %s", device->name, parsed_data);
+            resp = at_resp_set_info(resp, 128, 0, rt_tick_from_millisecond(300));
+            if (at_obj_exec_cmd(client, resp, "AT+CSTT=\"%s\",\"%s\",\"%s\"", apn->apn,
+                                apn->username ? apn->username : "", apn->password ? apn->password : "") < 0)
+            {
+                result = -RT_ERROR;
+                goto __exit;
+            }
         }
 
         AT_SEND_CMD(client, resp, 2, 300, "AT+CIFSR");
@@ -838,7 +834,7 @@ static int a9g_init(struct at_device *device)
     }
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
 #ifdef AT_USING_SOCKET
     a9g_socket_init(device);
@@ -26,6 +26,8 @@
 #include <string.h>
 
 #include <at_device_a9g.h>
+#include <at_device_urc.h>
+#include <at_device_parser.h>
 
 #define LOG_TAG                        "at.skt.a9g"
 #include <at_log.h>
@@ -421,6 +423,7 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
     int device_socket = 0;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -432,7 +435,11 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
     }
 
     /* get the current socket by receive data */
-    sscanf(data, "%d,%*s", &device_socket);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_int(&parser, &device_socket) < 0)
+    {
+        return;
+    }
 
     if (strstr(data, "CONNECT OK"))
     {
@@ -449,6 +456,7 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
     int device_socket = 0;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -460,7 +468,11 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
     }
 
     /* get the current socket by receive data */
-    sscanf(data, "%d,%*s", &device_socket);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_int(&parser, &device_socket) < 0)
+    {
+        return;
+    }
 
     if (rt_strstr(data, "SEND OK"))
     {
@@ -477,6 +489,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
     int device_socket = 0;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -488,7 +501,11 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
     }
 
     /* get the current socket by receive data */
-    sscanf(data, "%d,%*s", &device_socket);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_int(&parser, &device_socket) < 0)
+    {
+        return;
+    }
 
     if (rt_strstr(data, "CLOSE OK"))
     {
@@ -520,11 +537,18 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     struct at_socket *socket = RT_NULL;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
     /* get the current socket and receive buffer size by receive data */
-    sscanf(data, "+CIPRCV,%d,%d:", &device_socket, (int *) &bfsz);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+CIPRCV,") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_size(&parser, &bfsz) < 0)
+    {
+        return;
+    }
     /* get receive timeout by receive buffer length */
     timeout = bfsz;
 
@@ -608,7 +632,7 @@ int a9g_socket_init(struct at_device *device)
     RT_ASSERT(device);
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
     return RT_EOK;
 }
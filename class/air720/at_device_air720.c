@@ -26,6 +26,9 @@
 #include <string.h>
 #include <ctype.h>
 #include <at_device_air720.h>
+#include <at_device_urc.h>
+#include <at_device_cmux.h>
+#include <at_device_ppp.h>
 
 #if !defined(AT_SW_VERSION_NUM) || AT_SW_VERSION_NUM < 0x10300
 #error "This AT Client version is older, please check and update latest AT Client!"
@@ -64,6 +67,11 @@ static void air720_power_off(struct at_device *device)
 
     air720 = (struct at_device_air720 *)device->user_data;
 
+#ifdef AT_DEVICE_AIR720_USING_CMUX
+    /* the module boots in AT command mode, leave CMUX mode before it is powered off */
+    at_device_cmux_stop(device);
+#endif
+
     /* not nead to set pin configuration for m26 device power on */
     if (air720->power_pin == -1 || air720->power_status_pin == -1)
     {
@@ -124,7 +132,7 @@ static int air720_netdev_set_info(struct netdev *netdev)
         int i = 0, j = 0;
 
         /* send "AT+CGSN" commond to get device IMEI */
-        if (at_obj_exec_cmd(device->client, resp, "AT+CGSN") < 0)
+        if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+CGSN") < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -160,7 +168,7 @@ static int air720_netdev_set_info(struct netdev *netdev)
         at_resp_set_info(resp, air720_IPADDR_RESP_SIZE, 2, air720_INFO_RESP_TIMO);
 
         /* send "AT+CIFSR" commond to get IP address */
-        if (at_obj_exec_cmd(device->client, resp, "AT+CIFSR") < 0)
+        if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+CIFSR") < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -188,7 +196,7 @@ static int air720_netdev_set_info(struct netdev *netdev)
         at_resp_set_info(resp, air720_DNS_RESP_SIZE, 0, air720_INFO_RESP_TIMO);
 
         /* send "AT+CDNSCFG?" commond to get DNS servers address */
-        if (at_obj_exec_cmd(device->client, resp, "AT+CDNSCFG?") < 0)
+        if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+CDNSCFG?") < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -257,7 +265,7 @@ static void check_link_status_entry(void *parameter)
     while (1)
     {
         /* send "AT+CGREG?" commond  to check netweork interface device link status */
-        if (at_obj_exec_cmd(device->client, resp, "AT+CGREG?") < 0)
+        if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+CGREG?") < 0)
         {
             rt_thread_mdelay(air720_LINK_DELAY_TIME);
             LOG_E("air720 device(%s) send cgreg failed", device->name);
@@ -275,7 +283,7 @@ static void check_link_status_entry(void *parameter)
 
         if (rt_pin_read(air720->power_status_pin) == PIN_HIGH) //check the module_status , if moduble_status is Low, user can do your logic here
         {
-            if (at_obj_exec_cmd(device->client, resp, "AT+CSQ") == 0)
+            if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+CSQ") == 0)
             {
                 at_resp_parse_line_args_by_kw(resp, "+CSQ:", "+CSQ: %s", &parsed_data);
                 if (strncmp(parsed_data, "99,99", sizeof(parsed_data)))
@@ -399,7 +407,7 @@ static int air720_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num,
     }
 
     /* send "AT+CDNSCFG=<pri_dns>[,<sec_dns>]" commond to set dns servers */
-    if (at_obj_exec_cmd(device->client, resp, "AT+CDNSCFG=\"%s\"", inet_ntoa(*dns_server)) < 0)
+    if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+CDNSCFG=\"%s\"", inet_ntoa(*dns_server)) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -430,7 +438,7 @@ static int air720_ping_domain_resolve(struct at_device *device, const char *name
         return -RT_ENOMEM;
     }
 
-    if (at_obj_exec_cmd(device->client, resp, "AT+CDNSGIP=\"%s\"", name) < 0)
+    if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+CDNSGIP=\"%s\"", name) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -524,7 +532,7 @@ static int air720_netdev_ping(struct netdev *netdev, const char *host,
     }
 
     /* send "AT+CIPPING=<IP addr>[,<retryNum>[,<dataLen>[,<timeout>[,<ttl>]]]]" commond to send ping request */
-    if (at_obj_exec_cmd(device->client, resp, "AT+CIPPING=%s,1,%d,%d,64",
+    if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+CIPPING=%s,1,%d,%d,64",
                         host, data_len, air720_PING_TIMEO / (RT_TICK_PER_SECOND / 10)) < 0)
     {
         result = -RT_ERROR;
@@ -632,6 +640,29 @@ static struct netdev *air720_netdev_add(const char *netdev_name)
         }                                                                                       \
     } while (0)
 
+#ifdef AT_DEVICE_AIR720_USING_CMUX
+/* the socket data and URC use the first channel, the control commands use the second one */
+static const struct at_device_cmux_cfg air720_cmux_cfg =
+{
+    "AT+CMUX=0,0,5,127",
+    "ATE0;+CMEE=2",
+    127,
+    1024,
+};
+#endif /* AT_DEVICE_AIR720_USING_CMUX */
+
+#ifdef AT_DEVICE_AIR720_USING_PPP
+#ifndef AT_DEVICE_AIR720_USING_CMUX
+#error "AIR720 PPP data call needs the CMUX control channel, please define AT_DEVICE_AIR720_USING_CMUX."
+#endif
+/* the data call uses the default PDP context, release it from the module TCP/IP stack first */
+static const struct at_device_ppp_cfg air720_ppp_cfg =
+{
+    "AT+CIPSHUT",
+    "ATD*99#",
+};
+#endif /* AT_DEVICE_AIR720_USING_PPP */
+
 /* init for air720 */
 static void air720_init_thread_entry(void *parameter)
 {
@@ -659,6 +690,8 @@ static void air720_init_thread_entry(void *parameter)
 
     while (retry_num--)
     {
+        /* the physical AT client is put back after CMUX stopped by power off */
+        client = device->client;
         rt_memset(parsed_data, 0, sizeof(parsed_data));
         rt_thread_mdelay(1000);
         air720_power_on(device);
@@ -803,6 +836,29 @@ static void air720_init_thread_entry(void *parameter)
             result = -RT_ERROR;
             goto __exit;
         }
+
+#ifdef AT_DEVICE_AIR720_USING_CMUX
+        /* enter CMUX mode, the background commands do not queue behind the socket data */
+        if (at_device_cmux_start(device, &air720_cmux_cfg) < 0)
+        {
+            result = -RT_ERROR;
+            goto __exit;
+        }
+#ifdef AT_USING_SOCKET
+        /* register URC to the data channel AT client */
+        air720_socket_init(device);
+#endif
+#endif /* AT_DEVICE_AIR720_USING_CMUX */
+
+#ifdef AT_DEVICE_AIR720_USING_PPP
+        /* the sockets use lwIP over the data call instead of the module TCP/IP stack */
+        if (at_device_ppp_start(device, &air720_ppp_cfg) < 0)
+        {
+            result = -RT_ERROR;
+            goto __exit;
+        }
+#endif /* AT_DEVICE_AIR720_USING_PPP */
+
         result = RT_EOK;
 
     __exit:
@@ -896,7 +952,7 @@ static int air720_init(struct at_device *device)
     }
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
 #ifdef AT_USING_SOCKET
     air720_socket_init(device);
@@ -940,7 +996,13 @@ static int air720_reboot(struct at_device *device)
 static int air720_reset(struct at_device *device)
 {
     int result = RT_EOK;
-    struct at_client *client = device->client;
+    struct at_client *client = RT_NULL;
+
+#ifdef AT_DEVICE_AIR720_USING_CMUX
+    /* the module boots in AT command mode, leave CMUX mode before it is reset */
+    at_device_cmux_stop(device);
+#endif
+    client = device->client;
 
     /* send "AT+RST" commonds to mw31 device */
     result = at_obj_exec_cmd(client, RT_NULL, "AT+RESET");
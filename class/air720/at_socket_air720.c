@@ -26,6 +26,8 @@
 #include <stdio.h>
 #include <string.h>
 #include <at_device_air720.h>
+#include <at_device_urc.h>
+#include <at_device_parser.h>
 
 #if !defined(AT_SW_VERSION_NUM) || AT_SW_VERSION_NUM < 0x10300
 #error "This AT Client version is older, please check and update latest AT Client!"
@@ -447,6 +449,7 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
     int device_socket = 0;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -458,7 +461,11 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
     }
 
     /* get the current socket by receive data */
-    sscanf(data, "%d,%*s", &device_socket);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_int(&parser, &device_socket) < 0)
+    {
+        return;
+    }
 
     if (strstr(data, "CONNECT OK"))
     {
@@ -475,6 +482,7 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
     int device_socket = 0;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -486,7 +494,11 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
     }
 
     /* get the current socket by receive data */
-    sscanf(data, "%d,%*s", &device_socket);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_int(&parser, &device_socket) < 0)
+    {
+        return;
+    }
 
     if (rt_strstr(data, "SEND OK"))
     {
@@ -503,6 +515,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
     int device_socket = 0;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -514,7 +527,11 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
     }
 
     /* get the current socket by receive data */
-    sscanf(data, "%d,%*s", &device_socket);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_int(&parser, &device_socket) < 0)
+    {
+        return;
+    }
 
     if (rt_strstr(data, "CLOSE OK"))
     {
@@ -544,13 +561,19 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     struct at_socket *socket = RT_NULL;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
     //LOG_I("get +receive data %s", data);
     /* get the current socket and receive buffer size by receive data */
-    sscanf(data, "%*[^,],%d,%d:", &device_socket, (int *)&bfsz);
-    // sscanf(data, "+RECEIVE,%d,%d:", &device_socket, (int *)&bfsz);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_skip_to(&parser, ',') < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_size(&parser, &bfsz) < 0)
+    {
+        return;
+    }
     /* get receive timeout by receive buffer length */
     timeout = bfsz;
 
@@ -606,6 +629,7 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
 
 static void urc_dataaccept_func(struct at_client *client, const char *data, rt_size_t size)
 {
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -624,7 +648,13 @@ static void urc_dataaccept_func(struct at_client *client, const char *data, rt_s
     }
 
     /* get the current socket by receive data */
-    sscanf(data, "DATA ACCEPT:%d,%d", &device_socket, (int *)&bfsz);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "DATA ACCEPT:") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_size(&parser, &bfsz) < 0)
+    {
+        return;
+    }
 
     air720_socket_event_send(device, SET_EVENT(device_socket, AIR720_EVENT_SEND_OK));
 }
@@ -661,7 +691,7 @@ int air720_socket_init(struct at_device *device)
     RT_ASSERT(device);
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
     return RT_EOK;
 }
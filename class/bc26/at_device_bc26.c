@@ -26,6 +26,7 @@
 #include <string.h>
 
 #include <at_device_bc26.h>
+#include <at_device_baud.h>
 
 #define LOG_TAG "at.dev.bc26"
 #include <at_log.h>
@@ -660,6 +661,18 @@ static struct netdev *bc26_netdev_add(const char *netdev_name)
 
 /* =============================  bc26 device operations ============================= */
 
+#ifdef AT_DEVICE_BC26_BAUD_RATE_MAX
+/* the baud rate is saved by the module, it starts at the negotiated baud rate on the next boot */
+static const struct at_device_baud_cfg bc26_baud_cfg =
+{
+    "AT+IPR=%d;&W",
+    RT_NULL,
+    AT_DEVICE_BC26_BAUD_RATE_MAX,
+    RT_FALSE,
+    100,
+};
+#endif /* AT_DEVICE_BC26_BAUD_RATE_MAX */
+
 /* initialize for bc26 */
 static void bc26_init_thread_entry(void *parameter)
 {
@@ -692,7 +705,12 @@ static void bc26_init_thread_entry(void *parameter)
         rt_thread_mdelay(1000);
 
         /* wait bc26 startup finish, send AT every 500ms, if receive OK, SYNC success*/
+#ifdef AT_DEVICE_BC26_BAUD_RATE_MAX
+        if (at_device_baud_sync(device, &bc26_baud_cfg, BC26_WAIT_CONNECT_TIME) != RT_EOK &&
+                at_client_obj_wait_connect(client, BC26_WAIT_CONNECT_TIME))
+#else
         if (at_client_obj_wait_connect(client, BC26_WAIT_CONNECT_TIME))
+#endif
         {
             result = -RT_ETIMEOUT;
             goto __exit;
@@ -735,6 +753,15 @@ static void bc26_init_thread_entry(void *parameter)
         at_resp_parse_line_args_by_kw(resp, "+IPR:", "+IPR: %d", &i);
         LOG_D("%s device baudrate %d", device->name, i);
 
+#ifdef AT_DEVICE_BC26_BAUD_RATE_MAX
+        /* raise the baud rate to the configured maximum */
+        if (at_device_baud_negotiate(device, &bc26_baud_cfg) < 0)
+        {
+            result = -RT_ERROR;
+            goto __exit;
+        }
+#endif
+
         /* get module version */
         if (at_obj_exec_cmd(device->client, resp, "ATI") != RT_EOK)
         {
@@ -925,6 +952,10 @@ static int bc26_init(struct at_device *device)
     bc26_socket_init(device);
 #endif
 
+#ifdef AT_DEVICE_USING_COAP
+    bc26_coap_init(device);
+#endif
+
     /* add bc26 device to the netdev list */
     device->netdev = bc26_netdev_add(bc26->device_name);
     if (device->netdev == RT_NULL)
@@ -63,6 +63,11 @@ int bc26_socket_class_register(struct at_device_class *class);
 
 #endif /* AT_USING_SOCKET */
 
+#ifdef AT_DEVICE_USING_COAP
+/* bc26 device LwM2M CoAP session initialize */
+int bc26_coap_init(struct at_device *device);
+#endif /* AT_DEVICE_USING_COAP */
+
 #ifdef __cplusplus
 }
 #endif
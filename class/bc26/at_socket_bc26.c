@@ -26,6 +26,8 @@
 #include <string.h>
 
 #include <at_device_bc26.h>
+#include <at_device_urc.h>
+#include <at_device_parser.h>
 
 #define LOG_TAG                        "at.skt.bc26"
 #include <at_log.h>
@@ -533,6 +535,7 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
     int device_socket = 0, result = 0;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -543,7 +546,13 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
         return;
     }
 
-    sscanf(data, "+QIOPEN: %d,%d", &device_socket , &result);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+QIOPEN:") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_int(&parser, &result) < 0)
+    {
+        return;
+    }
 
     if (result == 0)
     {
@@ -591,6 +600,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
     struct at_socket *socket = RT_NULL;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -601,7 +611,12 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    sscanf(data, "+QIURC: \"closed\",%d", &device_socket);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+QIURC: \"closed\",") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0)
+    {
+        return;
+    }
     /* get at socket object by device socket descriptor */
     socket = &(device->sockets[device_socket]);
 
@@ -621,6 +636,7 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     struct at_socket *socket = RT_NULL;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -632,7 +648,13 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     }
 
     /* get the current socket and receive buffer size by receive data */
-    sscanf(data, "+QIURC: \"recv\",%d,%d", &device_socket, (int *) &bfsz);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+QIURC: \"recv\",") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_size(&parser, &bfsz) < 0)
+    {
+        return;
+    }
     /* set receive timeout by receive buffer length, not less than 10 ms */
     timeout = bfsz > 10 ? bfsz : 10;
 
@@ -681,11 +703,11 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
 
 static void urc_dnsqip_func(struct at_client *client, const char *data, rt_size_t size)
 {
-    int i = 0, j = 0;
     char recv_ip[16] = {0};
-    int result, ip_count, dns_ttl;
+    int result = 0;
     struct at_device *device = RT_NULL;
     struct at_device_bc26 *bc26 = RT_NULL;
+    struct at_device_parser parser;
     char *client_name = client->device->parent.name;
 
     RT_ASSERT(data && size);
@@ -704,28 +726,23 @@ static void urc_dnsqip_func(struct at_client *client, const char *data, rt_size_
         return;
     }
 
-    for (i = 0; i < size; i++)
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+QIURC: \"dnsgip\",") < 0)
     {
-        if (*(data + i) == '.')
-            j++;
+        return;
     }
+
     /* There would be several dns result, we just pickup one */
-    if (j == 3)
+    if (at_device_parser_ipv4(&parser, recv_ip) == 0)
     {
-        sscanf(data, "+QIURC: \"dnsgip\",\"%[^\"]", recv_ip);
-        recv_ip[15] = '\0';
-
         rt_memcpy(bc26->socket_data, recv_ip, sizeof(recv_ip));
 
         bc26_socket_event_send(device, BC26_EVENT_DOMAIN_OK);
     }
-    else
+    else if (at_device_parser_int(&parser, &result) == 0 && result)
     {
-        sscanf(data, "+QIURC: \"dnsgip\",%d,%d,%d", &result, &ip_count, &dns_ttl);
-        if (result)
-        {
-            at_tcp_ip_errcode_parse(result);
-        }
+        /* +QIURC: "dnsgip",<err>,<IP_count>,<DNS_ttl> */
+        at_tcp_ip_errcode_parse(result);
     }
 }
 
@@ -774,7 +791,7 @@ int bc26_socket_init(struct at_device *device)
     RT_ASSERT(device);
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
     return RT_EOK;
 }
@@ -0,0 +1,211 @@
+/*
+ * File      : at_coap_bc28.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#include <at_device_bc28.h>
+#include <at_device_coap.h>
+#include <at_device_parser.h>
+
+#define LOG_TAG                        "at.coap.bc28"
+#include <at_log.h>
+
+#if defined(AT_DEVICE_USING_BC28) && defined(AT_DEVICE_USING_COAP)
+
+/* the Quectel LwM2M commands to the CDP platform */
+
+/* +QLWEVTIND: <type>, the 3 is the 19/0/0 observed and the data can be sent */
+static void urc_event_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    int type = 0;
+    struct at_device_parser parser;
+    struct at_device *device = RT_NULL;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_coap_get_device(client);
+    if (device == RT_NULL)
+    {
+        return;
+    }
+
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+QLWEVTIND:") < 0 || at_device_parser_int(&parser, &type) < 0)
+    {
+        return;
+    }
+
+    switch (type)
+    {
+    case 1:
+        at_device_coap_notify(device, AT_DEVICE_COAP_EVENT_CLOSE, 0);
+        break;
+    case 3:
+        at_device_coap_notify(device, AT_DEVICE_COAP_EVENT_OPEN, 0);
+        break;
+    default:
+        LOG_D("%s device LwM2M event(%d).", device->name, type);
+        break;
+    }
+}
+
+/* +QLWULDATASTATUS: <status>, the 4 is the CON message acknowledged */
+static void urc_send_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    int status = 0;
+    struct at_device_parser parser;
+    struct at_device *device = RT_NULL;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_coap_get_device(client);
+    if (device == RT_NULL)
+    {
+        return;
+    }
+
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+QLWULDATASTATUS:") < 0 || at_device_parser_int(&parser, &status) < 0)
+    {
+        return;
+    }
+
+    at_device_coap_notify(device, AT_DEVICE_COAP_EVENT_SEND, (status == 4) ? 0 : status);
+}
+
+/* +NNMI: <length>,<data> */
+static void urc_recv_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    rt_size_t len = 0, hex_len = 0;
+    const char *hex = RT_NULL;
+    struct at_device_parser parser;
+    struct at_device *device = RT_NULL;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_coap_get_device(client);
+    if (device == RT_NULL)
+    {
+        return;
+    }
+
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+NNMI:") < 0 || at_device_parser_size(&parser, &len) < 0)
+    {
+        return;
+    }
+
+    hex = at_device_parser_rest(&parser, &hex_len);
+    at_device_coap_recv_hex(device, hex, hex_len, len);
+}
+
+static const struct at_urc urc_table[] =
+{
+    {"+QLWEVTIND:",         "\r\n",         urc_event_func},
+    {"+QLWULDATASTATUS:",   "\r\n",         urc_send_func},
+    {"+NNMI:",              "\r\n",         urc_recv_func},
+};
+
+/* the endpoint is the IMEI and the lifetime is set by the platform profile */
+static int bc28_coap_open(struct at_device *device, const struct at_device_coap_cfg *cfg)
+{
+    int result = RT_EOK;
+    struct at_client *client = AT_DEVICE_CTRL_CLIENT(device);
+    at_response_t resp = RT_NULL;
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(5000));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    /* the downlink is reported with the data, then start the registration */
+    if (at_obj_exec_cmd(client, resp, "AT+NCDP=%s,%d", cfg->host, cfg->port > 0 ? cfg->port : 5683) < 0 ||
+            at_obj_exec_cmd(client, resp, "AT+NNMI=1") < 0 ||
+            at_obj_exec_cmd(client, resp, "AT+QLWSREGIND=0") < 0)
+    {
+        result = -RT_ERROR;
+    }
+
+    at_delete_resp(resp);
+
+    return result;
+}
+
+static int bc28_coap_close(struct at_device *device)
+{
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(5000));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QLWSREGIND=1");
+
+    at_delete_resp(resp);
+
+    return result;
+}
+
+/* AT+QLWULDATAEX=<length>,<data>,<mode>, the mode 0x0100 is CON and 0x0000 is NON */
+static int bc28_coap_send(struct at_device *device, const char *hex, rt_size_t len, int type)
+{
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(5000));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QLWULDATAEX=%d,%s,%s", (int) len, hex,
+                             (type == AT_DEVICE_COAP_CON) ? "0x0100" : "0x0000");
+
+    at_delete_resp(resp);
+
+    return result;
+}
+
+static const struct at_device_coap_ops bc28_coap_ops =
+{
+    bc28_coap_open,
+    bc28_coap_close,
+    bc28_coap_send,
+    urc_table,
+    sizeof(urc_table) / sizeof(urc_table[0]),
+};
+
+int bc28_coap_init(struct at_device *device)
+{
+    RT_ASSERT(device);
+
+    return at_device_coap_init(device, &bc28_coap_ops);
+}
+
+#endif /* AT_DEVICE_USING_BC28 && AT_DEVICE_USING_COAP */
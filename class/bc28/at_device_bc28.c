@@ -25,6 +25,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <at_device_bc28.h>
+#include <at_device_baud.h>
 
 #if !defined(AT_SW_VERSION_NUM) || AT_SW_VERSION_NUM < 0x10301
 #error "This AT Client version is older, please check and update latest AT Client!"
@@ -544,6 +545,18 @@ static struct netdev *bc28_netdev_add(const char *netdev_name)
 
 /* =============================  bc28 device operations ============================= */
 
+#ifdef AT_DEVICE_BC28_BAUD_RATE_MAX
+/* the baud rate is saved by the module, it starts at the negotiated baud rate on the next boot */
+static const struct at_device_baud_cfg bc28_baud_cfg =
+{
+    "AT+NATSPEED=%d,3,1",
+    RT_NULL,
+    AT_DEVICE_BC28_BAUD_RATE_MAX,
+    RT_FALSE,
+    100,
+};
+#endif /* AT_DEVICE_BC28_BAUD_RATE_MAX */
+
 /* initialize for bc28 */
 static void bc28_init_thread_entry(void *parameter)
 {
@@ -577,7 +590,12 @@ static void bc28_init_thread_entry(void *parameter)
         rt_thread_mdelay(1000);
 
         /* wait bc28 startup finish, send AT every 500ms, if receive OK, SYNC success*/
+#ifdef AT_DEVICE_BC28_BAUD_RATE_MAX
+        if (at_device_baud_sync(device, &bc28_baud_cfg, BC28_WAIT_CONNECT_TIME) != RT_EOK &&
+                at_client_obj_wait_connect(client, BC28_WAIT_CONNECT_TIME))
+#else
         if (at_client_obj_wait_connect(client, BC28_WAIT_CONNECT_TIME))
+#endif
         {
             result = -RT_ETIMEOUT;
             goto __exit;
@@ -690,6 +708,15 @@ static void bc28_init_thread_entry(void *parameter)
         at_resp_parse_line_args_by_kw(resp, "+NATSPEED:", "+NATSPEED:%d", &i);
         LOG_D("%s device baudrate %d", device->name, i);
 
+#ifdef AT_DEVICE_BC28_BAUD_RATE_MAX
+        /* raise the baud rate to the configured maximum */
+        if (at_device_baud_negotiate(device, &bc28_baud_cfg) < 0)
+        {
+            result = -RT_ERROR;
+            goto __exit;
+        }
+#endif
+
         /* get module version */
         if (at_obj_exec_cmd(device->client, resp, "ATI") != RT_EOK)
         {
@@ -887,6 +914,10 @@ static int bc28_init(struct at_device *device)
     bc28_socket_init(device);
 #endif
 
+#ifdef AT_DEVICE_USING_COAP
+    bc28_coap_init(device);
+#endif
+
     /* add bc28 device to the netdev list */
     device->netdev = bc28_netdev_add(bc28->device_name);
     if (device->netdev == RT_NULL)
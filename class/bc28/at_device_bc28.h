@@ -67,6 +67,11 @@ int bc28_socket_class_register(struct at_device_class *class);
 
 #endif /* AT_USING_SOCKET */
 
+#ifdef AT_DEVICE_USING_COAP
+/* bc28 device LwM2M CoAP session initialize */
+int bc28_coap_init(struct at_device *device);
+#endif /* AT_DEVICE_USING_COAP */
+
 #ifdef __cplusplus
 }
 #endif
@@ -21,11 +21,14 @@
  * Date           Author            Notes
  * 2020-02-13     luhuadong         first version
  * 2020-07-19     luhuadong         support alloc socket
+ * 2026-10-19     agent             use the shared socket engine
  */
 
 #include <stdio.h>
 #include <string.h>
 #include <at_device_bc28.h>
+#include <at_device_socket.h>
+#include <at_device_parser.h>
 
 #if !defined(AT_SW_VERSION_NUM) || AT_SW_VERSION_NUM < 0x10301
 #error "This AT Client version is older, please check and update latest AT Client!"
@@ -39,97 +42,6 @@
 #define BC28_MODULE_SEND_MAX_SIZE       1358
 #define BC28_MODULE_RECV_MAX_SIZE       1358
 
-/* set real event by current socket and current state */
-#define SET_EVENT(socket, event)       (((socket + 1) << 16) | (event))
-
-/* AT socket event type */
-#define BC28_EVENT_CONN_OK             (1L << 0)
-#define BC28_EVENT_SEND_OK             (1L << 1)
-#define BC28_EVENT_RECV_OK             (1L << 2)
-#define BC28_EVNET_CLOSE_OK            (1L << 3)
-#define BC28_EVENT_CONN_FAIL           (1L << 4)
-#define BC28_EVENT_SEND_FAIL           (1L << 5)
-#define BC28_EVENT_DOMAIN_OK           (1L << 6)
-#define BC28_EVENT_DOMAIN_FAIL         (1L << 7)
-
-static at_evt_cb_t at_evt_cb_set[] = {
-
-        [AT_SOCKET_EVT_RECV]   = NULL,
-        [AT_SOCKET_EVT_CLOSED] = NULL,
-};
-
-static struct at_socket_ip_info
-{
-    char ip_addr[IP_ADDR_SIZE_MAX];
-    int  port;
-} bc28_sock_info[AT_DEVICE_BC28_SOCKETS_NUM];
-
-/**
- * convert data from ASCII string to Hex string.
- *
- * @param str  input ASCII string
- * @param hex  output Hex string
- * @param len  length of str, or the size you want to convert
- *
- * @return =0: convert failed, or no data need to convert
- *         >0: the size of convert success
- */
-static int string_to_hex(const char *str, char *hex, const rt_size_t len)
-{
-    RT_ASSERT(str && hex);
-
-    int str_len = rt_strlen(str);
-    int pos = 0, i;
-
-    if (len < 1 || str_len < len)
-    {
-        return 0;
-    }
-
-    for (i = 0; i < len; i++, pos += 2)
-    {
-        rt_sprintf(&hex[pos], "%02X", str[i]);
-    }
-
-    return i;
-}
-
-/**
- * convert data from Hex string to ASCII string.
- *
- * @param hex  input Hex string
- * @param str  output ASCII string
- * @param len  length of str, or the size you want to convert
- *
- * @return =0: convert failed, or no data need to convert
- *         >0: the size of convert success
- */
-static int hex_to_string(const char *hex, char *str, const rt_size_t len)
-{
-    RT_ASSERT(hex && str);
-
-    int hex_len = rt_strlen(hex);
-    int pos = 0, left, right, i;
-
-    if (len < 1 || hex_len/2 < len)
-    {
-        return 0;
-    }
-
-    for (i = 0; i < len*2; i++, pos++)
-    {
-        left = hex[i++];
-        right = hex[i];
-
-        left  = (left  < 58) ? (left  - 48) : (left  - 55);
-        right = (right < 58) ? (right - 48) : (right - 55);
-
-        str[pos] = (left << 4) | right;
-    }
-
-    return pos;
-}
-
 static void at_tcp_ip_errcode_parse(int result)//TCP/IP_QIGETERROR
 {
     switch(result)
@@ -164,65 +76,6 @@ static void at_tcp_ip_errcode_parse(int result)//TCP/IP_QIGETERROR
     default  : LOG_E("%d : Unknown err code",             result); break;
     }
 }
-
-static int bc28_socket_event_send(struct at_device *device, uint32_t event)
-{
-    return (int) rt_event_send(device->socket_event, event);
-}
-
-static int bc28_socket_event_recv(struct at_device *device, uint32_t event, uint32_t timeout, rt_uint8_t option)
-{
-    int result = RT_EOK;
-    rt_uint32_t recved;
-
-    result = rt_event_recv(device->socket_event, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
-    if (result != RT_EOK)
-    {
-        return -RT_ETIMEOUT;
-    }
-
-    return recved;
-}
-
-/**
- * close socket by AT commands.
- *
- * @param current socket
- *
- * @return  0: close socket success
- *         -1: send AT commands error
- *         -2: wait socket event timeout
- *         -5: no memory
- */
-static int bc28_socket_close(struct at_socket *socket)
-{
-    int result = RT_EOK;
-    at_response_t resp = RT_NULL;
-    int device_socket = (int) socket->user_data;
-    struct at_device *device = (struct at_device *) socket->device;
-
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(3000));
-    if (resp == RT_NULL)
-    {
-        LOG_E("no memory for resp create.");
-        return -RT_ENOMEM;
-    }
-
-    result = at_obj_exec_cmd(device->client, resp, "AT+NSOCL=%d", device_socket);
-    if (result < 0)
-    {
-        LOG_E("%s device close socket(%d) failed [%d].", device->name, device_socket, result);
-    }
-    else
-    {
-        LOG_D("%s device close socket(%d).", device->name, device_socket);
-    }
-
-    at_delete_resp(resp);
-
-    return result;
-}
-
 /**
  * create socket by AT commands.
  *
@@ -289,266 +142,42 @@ __exit:
 
     return result;
 }
-
 /**
- * create TCP/UDP client or server connect by AT commands.
+ * check the send command response, the second line is "<socket>,<length>".
  *
  * @param socket current socket
- * @param ip server or client IP address
- * @param port server or client port
- * @param type connect socket type(tcp, udp)
- * @param is_client connection is client
+ * @param resp send command response
+ * @param size the data size of send command
  *
- * @return   0: connect success
- *          -1: connect failed, send commands error or type error
- *          -2: wait socket event timeout
- *          -5: no memory
+ * @return  0: send success
+ *         -1: send failed or send data incompletely
  */
-static int bc28_socket_connect(struct at_socket *socket, char *ip, int32_t port,
-                               enum at_socket_type type, rt_bool_t is_client)
+static int bc28_socket_send_check(struct at_socket *socket, at_response_t resp, size_t size)
 {
-#define CONN_RETRY  3
-
-    int i = 0;
-    uint32_t event = 0;
-    at_response_t resp = RT_NULL;
-    int result = 0, event_result = 0;
+    int return_socket = -1, return_size = -1;
     int device_socket = (int) socket->user_data;
-    int return_socket = -1;
     struct at_device *device = (struct at_device *) socket->device;
 
-    RT_ASSERT(ip);
-    RT_ASSERT(port >= 0);
-
-    if (!is_client)
+    /* check if sent ok */
+    if (!at_resp_get_line_by_kw(resp, "OK"))
     {
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
-    if (resp == RT_NULL)
-    {
-        LOG_E("no memory for resp create.");
-        return -RT_ENOMEM;
-    }
-
-    /* if the protocol is not tcp, no need connect to server */
-    if (type != AT_SOCKET_TCP)
-    {
-        if (type == AT_SOCKET_UDP)
-        {
-            rt_strncpy(bc28_sock_info[device_socket].ip_addr, ip, IP_ADDR_SIZE_MAX);
-            bc28_sock_info[device_socket].port = port;
-        }
-        return RT_EOK;
-    }
-
-    for(i=0; i<CONN_RETRY; i++)
-    {
-        /* clear socket connect event */
-        event = SET_EVENT(device_socket, BC28_EVENT_CONN_OK | BC28_EVENT_CONN_FAIL);
-        bc28_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
-
-        if (at_obj_exec_cmd(device->client, resp, "AT+NSOCO=%d,%s,%d", device_socket, ip, port) < 0)
-        {
-            result = -RT_ERROR;
-            continue;
-        }
-        LOG_D("%s device socket(%d) try connect to %s:%d.", device->name, device_socket, ip, port);
-
-        if(!at_resp_get_line_by_kw(resp, "OK"))
-        {
-            result = -RT_ERROR;
-            continue;
-        }
-
-        /* waiting result event from AT URC, the device default connection timeout is 30 seconds*/
-        if (bc28_socket_event_recv(device, SET_EVENT(device_socket, 0),
-                                   30 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
-        {
-            LOG_D("%s device socket(%d) wait connect result timeout.", device->name, device_socket);
-            /* No news is good news */
-            result = RT_EOK;
-            break;
-        }
-
-        /* waiting OK or failed result */
-        event_result = bc28_socket_event_recv(device, BC28_EVENT_CONN_OK | BC28_EVENT_CONN_FAIL,
-                                              1 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
-        if (event_result & BC28_EVENT_CONN_FAIL)
-        {
-            LOG_E("%s device socket(%d) connect failed.", device->name, device_socket);
-            result = -RT_ERROR;
-            continue;
-        }
-        else
-        {
-            result = RT_EOK;
-            break;
-        }
-    }
-
-__exit:
-    if (resp)
+    if (at_resp_parse_line_args(resp, 2, "%d,%d", &return_socket, &return_size) <= 0)
     {
-        at_delete_resp(resp);
-    }
-
-    return result;
-}
-
-/**
- * send data to server or client by AT commands.
- *
- * @param socket current socket
- * @param buff send buffer
- * @param bfsz send buffer size
- * @param type connect socket type(tcp, udp)
- *
- * @return >=0: the size of send success
- *          -1: send AT commands error or send data error
- *          -2: waited socket event timeout
- *          -5: no memory
- */
-static int bc28_socket_send(struct at_socket *socket, const char *buff,
-                            size_t bfsz, enum at_socket_type type)
-{
-    uint32_t event = 0;
-    int result = 0, event_result = 0;
-    size_t cur_pkt_size = 0, sent_size = 0;
-    at_response_t resp = RT_NULL;
-    int device_socket = (int) socket->user_data;
-    struct at_device *device = (struct at_device *) socket->device;
-    struct at_device_bc28 *bc28 = (struct at_device_bc28 *) device->user_data;
-    rt_mutex_t lock = device->client->lock;
-
-    RT_ASSERT(buff);
-
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
-    if (resp == RT_NULL)
-    {
-        LOG_E("no memory for resp create.");
-        return -RT_ENOMEM;
+        return -RT_ERROR;
     }
 
-    rt_mutex_take(lock, RT_WAITING_FOREVER);
-
-    /* clear socket send event */
-    event = SET_EVENT(device_socket, BC28_EVENT_SEND_OK | BC28_EVENT_SEND_FAIL);
-    bc28_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
-
-    /* only use for UDP socket */
-    const char *ip = bc28_sock_info[device_socket].ip_addr;
-    const int port = bc28_sock_info[device_socket].port;
-
-    while (sent_size < bfsz)
+    if (return_socket != device_socket || return_size != (int) size)
     {
-        if (bfsz - sent_size < BC28_MODULE_SEND_MAX_SIZE)
-        {
-            cur_pkt_size = bfsz - sent_size;
-        }
-        else
-        {
-            cur_pkt_size = BC28_MODULE_SEND_MAX_SIZE;
-        }
-
-        size_t i = 0, ind = 0;
-        char hex_data[cur_pkt_size * 2 + 1];
-        rt_memset(hex_data, 0, sizeof(hex_data));
-
-        for (i=0, ind=0; i<cur_pkt_size; i++, ind+=2)
-        {
-            sprintf(&hex_data[ind], "%02X", buff[sent_size + i]);
-        }
-
-        switch (type)
-        {
-        case AT_SOCKET_TCP:
-            /* AT+NSOSD=<socket>,<length>,<data>[,<flag>[,<sequence>]] */
-            if (at_obj_exec_cmd(device->client, resp, "AT+NSOSD=%d,%d,%s,0x100,1", device_socket,
-                                (int)cur_pkt_size, hex_data) < 0)
-            {
-                result = -RT_ERROR;
-                goto __exit;
-            }
-            LOG_D("%s device tcp socket(%d) send %d bytes.\n>> %s", device->name, device_socket, (int)cur_pkt_size, hex_data);
-            break;
-
-        case AT_SOCKET_UDP:
-            /* AT+NSOST=<socket>,<remote_addr>,<remote_port>,<length>,<data>[,<sequence>] */
-            if (at_obj_exec_cmd(device->client, resp, "AT+NSOST=%d,%s,%d,%d,%s,1", device_socket,
-                                ip, port, (int)cur_pkt_size, hex_data) < 0)
-            {
-                result = -RT_ERROR;
-                goto __exit;
-            }
-            LOG_D("%s device udp socket(%d) send %d bytes to %s:%d.\n>> %s", device->name, device_socket, ip, port, (int)cur_pkt_size, hex_data);
-            break;
-
-        default:
-            LOG_E("not supported send type %d.", type);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        /* check if sent ok */
-        if (!at_resp_get_line_by_kw(resp, "OK"))
-        {
-            LOG_E("%s device socket(%d) send data failed.", device->name, device_socket);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        int return_socket = -1, return_size = -1;
-
-        if (at_resp_parse_line_args(resp, 2, "%d,%d", &return_socket, &return_size) <= 0)
-        {
-            LOG_E("%s device socket(%d) send data failed.", device->name, device_socket);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        if (return_socket != device_socket || return_size != cur_pkt_size)
-        {
-            LOG_E("%s device socket(%d) send data incompletely.", device->name, device_socket);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        /* waiting result event from AT URC, the device default timeout is 60 seconds*/
-        if (bc28_socket_event_recv(device, SET_EVENT(device_socket, 0),
-                                   60 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
-        {
-            LOG_E("%s device socket(%d) wait send result timeout.", device->name, device_socket);
-            result = -RT_ETIMEOUT;
-            goto __exit;
-        }
-        /* waiting OK or failed result */
-        event_result = bc28_socket_event_recv(device, BC28_EVENT_SEND_OK | BC28_EVENT_SEND_FAIL,
-                                              1 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
-        if (event_result & BC28_EVENT_SEND_FAIL)
-        {
-            LOG_E("%s device socket(%d) send failed.", device->name, device_socket);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-        else
-        {
-            LOG_D("%s device socket(%d) send success.", device->name, device_socket);
-            sent_size += cur_pkt_size;
-            result = sent_size;
-        }
+        LOG_E("%s device socket(%d) send data incompletely.", device->name, device_socket);
+        return -RT_ERROR;
     }
 
-__exit:
-    rt_mutex_release(lock);
-
-    if (resp)
-    {
-        at_delete_resp(resp);
-    }
+    LOG_D("%s device socket(%d) send %d bytes.", device->name, device_socket, (int) size);
 
-    return result > 0 ? sent_size : result;
+    return RT_EOK;
 }
 
 /**
@@ -589,8 +218,8 @@ int bc28_domain_resolve(const char *name, char ip[16])
         return -RT_ENOMEM;
     }
 
-    /* clear BC28_EVENT_DOMAIN_OK */
-    bc28_socket_event_recv(device, BC28_EVENT_DOMAIN_OK, 0, RT_EVENT_FLAG_OR);
+    /* clear domain resolve event */
+    at_device_socket_event_recv(device, AT_DEVICE_SOCKET_EVENT_DOMAIN_OK, 0, RT_EVENT_FLAG_OR);
 
     bc28 = (struct at_device_bc28 *) device->user_data;
     bc28->socket_data = ip;
@@ -604,14 +233,14 @@ int bc28_domain_resolve(const char *name, char ip[16])
     for(i = 0; i < RESOLVE_RETRY; i++)
     {
         /* waiting result event from AT URC, the device default connection timeout is 30 seconds.*/
-        event_result = bc28_socket_event_recv(device, BC28_EVENT_DOMAIN_OK | BC28_EVENT_DOMAIN_FAIL,
+        event_result = at_device_socket_event_recv(device, AT_DEVICE_SOCKET_EVENT_DOMAIN_OK | AT_DEVICE_SOCKET_EVENT_DOMAIN_FAIL,
                                               30 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
         if (event_result < 0)
         {
             result = -RT_ETIMEOUT;
             continue;
         }
-        else if (event_result & BC28_EVENT_DOMAIN_FAIL)
+        else if (event_result & AT_DEVICE_SOCKET_EVENT_DOMAIN_FAIL)
         {
             LOG_E("%d device resolve domain name failed.", device->name);
             result = -RT_ERROR;
@@ -634,194 +263,152 @@ int bc28_domain_resolve(const char *name, char ip[16])
     return result;
 
 }
-
-/**
- * set AT socket event notice callback
- *
- * @param event notice event
- * @param cb notice callback
- */
-static void bc28_socket_set_event_cb(at_socket_evt_t event, at_evt_cb_t cb)
-{
-    if (event < sizeof(at_evt_cb_set) / sizeof(at_evt_cb_set[1]))
-    {
-        at_evt_cb_set[event] = cb;
-    }
-}
-
 static void urc_connect_func(struct at_client *client, const char *data, rt_size_t size)
 {
     int device_socket = 0, result = 0;
     struct at_device *device = RT_NULL;
-    char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_socket_get_device(client);
     if (device == RT_NULL)
     {
-        LOG_E("get device(%s) failed.", client_name);
         return;
     }
 
     /* only for firmware version base BC28JAR02xxx */
-    sscanf(data, "+QTCPIND: %d,%d", &device_socket , &result);
-
-    if (result == 0)
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+QTCPIND:") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_int(&parser, &result) < 0)
     {
-        bc28_socket_event_send(device, SET_EVENT(device_socket, BC28_EVENT_CONN_OK));
+        return;
     }
-    else
+
+    if (result != 0)
     {
         at_tcp_ip_errcode_parse(result);
-        bc28_socket_event_send(device, SET_EVENT(device_socket, BC28_EVENT_CONN_FAIL));
     }
+    at_device_socket_connect_notice(device, device_socket, result == 0);
 }
 
 static void urc_send_func(struct at_client *client, const char *data, rt_size_t size)
 {
     int device_socket = 0, sequence = 0, status = 0;
     struct at_device *device = RT_NULL;
-    struct at_device_bc28 *bc28 = RT_NULL;
-    char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_socket_get_device(client);
     if (device == RT_NULL)
     {
-        LOG_E("get device(%s) failed.", client_name);
         return;
     }
 
-    sscanf(data, "+NSOSTR:%d,%d,%d", &device_socket, &sequence, &status);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+NSOSTR:") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_int(&parser, &sequence) < 0 ||
+            at_device_parser_int(&parser, &status) < 0)
+    {
+        return;
+    }
 
     if (1 == status)
     {
-        bc28_socket_event_send(device, SET_EVENT(device_socket, BC28_EVENT_SEND_OK));
+        at_device_socket_event_send(device, AT_DEVICE_SOCKET_EVENT(device_socket, AT_DEVICE_SOCKET_EVENT_SEND_OK));
     }
     else
     {
-        bc28_socket_event_send(device, SET_EVENT(device_socket, BC28_EVENT_SEND_FAIL));
+        at_device_socket_event_send(device, AT_DEVICE_SOCKET_EVENT(device_socket, AT_DEVICE_SOCKET_EVENT_SEND_FAIL));
     }
 }
 
 static void urc_close_func(struct at_client *client, const char *data, rt_size_t size)
 {
-    int device_socket = 0;
-    struct at_socket *socket = RT_NULL;
+    int device_socket = -1;
+    rt_bool_t is_connecting = RT_FALSE;
     struct at_device *device = RT_NULL;
-    char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_socket_get_device(client);
     if (device == RT_NULL)
     {
-        LOG_E("get device(%s) failed.", client_name);
         return;
     }
 
-    sscanf(data, "+NSOCLI: %d", &device_socket);
-
-    bc28_socket_event_send(device, SET_EVENT(device_socket, BC28_EVENT_CONN_FAIL));
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+NSOCLI:") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0)
+    {
+        return;
+    }
 
-    if (device_socket >= 0)
+    if (device_socket >= 0 && device_socket < (int) device->class->socket_num)
     {
-        /* get at socket object by device socket descriptor */
-        socket = &(device->sockets[device_socket]);
+        /* the non-blocking connect in progress is failed and closed by the connect notice */
+        is_connecting = device->socket_info[device_socket].is_connecting;
+        at_device_socket_connect_notice(device, device_socket, RT_FALSE);
 
         /* notice the socket is disconnect by remote */
-        if (at_evt_cb_set[AT_SOCKET_EVT_CLOSED])
+        if (is_connecting == RT_FALSE)
         {
-            at_evt_cb_set[AT_SOCKET_EVT_CLOSED](socket, AT_SOCKET_EVT_CLOSED, NULL, 0);
+            at_device_socket_closed_notice(device, device_socket);
         }
     }
 }
 
 static void urc_recv_func(struct at_client *client, const char *data, rt_size_t size)
 {
-    int device_socket = 0;
-    rt_int32_t timeout;
-    rt_size_t bfsz = 0, temp_size = 0;
-    char *recv_buf = RT_NULL, *hex_buf = RT_NULL, temp[8] = {0};
-    char remote_addr[IP_ADDR_SIZE_MAX] = {0};
-    int remote_port = -1, return_socket = -1, data_length = 0, remaining_length = 0;
-
-    struct at_socket *socket = RT_NULL;
+    const char *hex = RT_NULL;
+    rt_size_t hex_len = 0;
+    char remote_addr[16] = {0};
+    int device_socket = -1, remote_port = -1, bfsz = 0;
     struct at_device *device = RT_NULL;
-    char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_socket_get_device(client);
     if (device == RT_NULL)
     {
-        LOG_E("get device(%s) failed.", client_name);
         return;
     }
 
-    hex_buf = (char *) rt_calloc(1, BC28_MODULE_RECV_MAX_SIZE * 2 + 1);
-
-    /* get the current socket and receive buffer size by receive data */
-
-    /* mode 2 => +NSONMI:<socket>,<remote_addr>, <remote_port>,<length>,<data> */
-    sscanf(data, "+NSONMI:%d,%[0-9.],%d,%d,%s", &device_socket, remote_addr, &remote_port, (int *) &bfsz, hex_buf);
-    LOG_D("%s device socket(%d) recv %d bytes from %s:%d\n>> %s", device_socket, bfsz, remote_addr, remote_port, hex_buf);
-
-    /* set receive timeout by receive buffer length, not less than 10 ms */
-    timeout = bfsz > 10 ? bfsz : 10;
-
-    if (device_socket < 0 || bfsz == 0)
+    /* mode 2 => +NSONMI:<socket>,<remote_addr>,<remote_port>,<length>,<data> */
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+NSONMI:") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_ipv4(&parser, remote_addr) < 0 ||
+            at_device_parser_int(&parser, &remote_port) < 0 ||
+            at_device_parser_int(&parser, &bfsz) < 0)
     {
         return;
     }
+    hex = at_device_parser_rest(&parser, &hex_len);
 
-    recv_buf = (char *) rt_calloc(1, bfsz + 1);
-
-    if (recv_buf == RT_NULL || hex_buf == RT_NULL)
+    if (bfsz <= 0 || bfsz > BC28_MODULE_RECV_MAX_SIZE)
     {
-        LOG_E("no memory for URC receive buffer(%d).", bfsz);
-        /* read and clean the coming data */
-        while (temp_size < bfsz)
-        {
-            if (bfsz - temp_size > sizeof(temp))
-            {
-                at_client_obj_recv(client, temp, sizeof(temp), timeout);
-            }
-            else
-            {
-                at_client_obj_recv(client, temp, bfsz - temp_size, timeout);
-            }
-            temp_size += sizeof(temp);
-        }
-
-        if (recv_buf) rt_free(recv_buf);
-        if (hex_buf)  rt_free(hex_buf);
+        LOG_E("%s device socket(%d) receive invalid data length(%d).", device->name, device_socket, bfsz);
         return;
     }
+    LOG_D("%s device socket(%d) recv %d bytes from %s:%d.", device->name, device_socket, bfsz, remote_addr, remote_port);
 
-    /* convert receive data */
-    hex_to_string(hex_buf, recv_buf, bfsz);
-    rt_free(hex_buf);
-
-    /* get at socket object by device socket descriptor */
-    socket = &(device->sockets[device_socket]);
-
-    /* notice the receive buffer and buffer size */
-    if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
-    {
-        at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
-    }
+    /* convert receive data and notice it to the socket */
+    at_device_socket_set_from(device, device_socket, remote_addr, remote_port);
+    at_device_socket_recv_hex(device, device_socket, hex, hex_len, bfsz);
 }
 
 static void urc_dns_func(struct at_client *client, const char *data, rt_size_t size)
 {
-    int i = 0, j = 0;
     char recv_ip[16] = {0};
-    int result, ip_count, dns_ttl;
     struct at_device *device = RT_NULL;
     struct at_device_bc28 *bc28 = RT_NULL;
+    struct at_device_parser parser;
     char *client_name = client->device->parent.name;
 
     RT_ASSERT(data && size);
@@ -840,17 +427,17 @@ static void urc_dns_func(struct at_client *client, const char *data, rt_size_t s
         return;
     }
 
-    sscanf(data, "+QDNS:%s", recv_ip);
-    recv_ip[15] = '\0';
-
-    if (rt_strstr(recv_ip, "FAIL"))
+    /* +QDNS:<IP_address> or +QDNS:FAIL */
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+QDNS:") < 0 ||
+            at_device_parser_ipv4(&parser, recv_ip) < 0)
     {
-        bc28_socket_event_send(device, BC28_EVENT_DOMAIN_FAIL);
+        at_device_socket_event_send(device, AT_DEVICE_SOCKET_EVENT_DOMAIN_FAIL);
     }
     else
     {
         rt_memcpy(bc28->socket_data, recv_ip, sizeof(recv_ip));
-        bc28_socket_event_send(device, BC28_EVENT_DOMAIN_OK);
+        at_device_socket_event_send(device, AT_DEVICE_SOCKET_EVENT_DOMAIN_OK);
     }
 }
 
@@ -860,7 +447,6 @@ static void urc_func(struct at_client *client, const char *data, rt_size_t size)
 
     LOG_I("URC data : %.*s", size, data);
 }
-
 /* +NSOSTR:<socket>,<sequence>,<status> */
 static const struct at_urc urc_table[] =
 {
@@ -871,13 +457,39 @@ static const struct at_urc urc_table[] =
     {"+NSOCLI:",    "\r\n",       urc_close_func},
 };
 
+static const struct at_device_socket_dialect bc28_socket_dialect =
+{
+    .connect_tcp     = "AT+NSOCO=%d,%s,%d",
+    .connect_udp     = RT_NULL,
+    .close           = "AT+NSOCL=%d",
+    /* AT+NSOSD=<socket>,<length>,<data>[,<flag>[,<sequence>]] */
+    .send            = "AT+NSOSD=%d,%d,%s,0x100,1",
+    /* AT+NSOST=<socket>,<remote_addr>,<remote_port>,<length>,<data>[,<sequence>] */
+    .send_udp        = "AT+NSOST=%d,%s,%d,%d,%s,1",
+    .urc_table       = urc_table,
+    .urc_table_size  = sizeof(urc_table) / sizeof(urc_table[0]),
+    .send_max_size   = BC28_MODULE_SEND_MAX_SIZE,
+    .connect_style   = AT_DEVICE_SOCKET_CONN_URC,
+    .send_style      = AT_DEVICE_SOCKET_SEND_HEX,
+    .recv_style      = AT_DEVICE_SOCKET_RECV_HEX,
+    .connect_retry   = 2,
+    .flags           = AT_DEVICE_SOCKET_FLAG_CONN_TIMEO_OK,
+    .cmd_timeout     = 300,
+    .close_timeout   = 3000,
+    /* the device default connection timeout is 30 seconds */
+    .connect_timeout = 30000,
+    /* the device default send timeout is 60 seconds */
+    .send_timeout    = 60000,
+    .send_check      = bc28_socket_send_check,
+};
+
 static const struct at_socket_ops bc28_socket_ops =
 {
-    bc28_socket_connect,
-    bc28_socket_close,
-    bc28_socket_send,
+    at_device_socket_connect,
+    at_device_socket_close,
+    at_device_socket_send,
     bc28_domain_resolve,
-    bc28_socket_set_event_cb,
+    at_device_socket_set_event_cb,
 #if defined(AT_SW_VERSION_NUM) && AT_SW_VERSION_NUM > 0x10300
     bc28_socket_create,
 #endif
@@ -887,10 +499,7 @@ int bc28_socket_init(struct at_device *device)
 {
     RT_ASSERT(device);
 
-    /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
-
-    return RT_EOK;
+    return at_device_socket_init(device);
 }
 
 int bc28_socket_class_register(struct at_device_class *class)
@@ -899,6 +508,7 @@ int bc28_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_BC28_SOCKETS_NUM;
     class->socket_ops = &bc28_socket_ops;
+    class->socket_dialect = &bc28_socket_dialect;
 
     return RT_EOK;
 }
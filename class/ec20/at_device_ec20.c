@@ -28,6 +28,14 @@
 #include <string.h>
 
 #include <at_device_ec20.h>
+#include <at_device_sched.h>
+#include <at_device_baud.h>
+#include <at_device_cmux.h>
+#include <at_device_ppp.h>
+#include <at_device_mqtt.h>
+#include <at_device_parser.h>
+#include <at_device_boot.h>
+#include <at_device_apn.h>
 
 #define LOG_TAG                        "at.dev.ec20"
 #include <at_log.h>
@@ -38,10 +46,8 @@
 #define EC20_THREAD_STACK_SIZE          2048
 #define EC20_THREAD_PRIORITY            (RT_THREAD_PRIORITY_MAX/2)
 
-/* AT+QICSGP command default*/
-static char *QICSGP_CHINA_MOBILE = "AT+QICSGP=1,1,\"CMNET\",\"\",\"\",0";
-static char *QICSGP_CHINA_UNICOM = "AT+QICSGP=1,1,\"UNINET\",\"\",\"\",0";
-static char *QICSGP_CHINA_TELECOM = "AT+QICSGP=1,1,\"CTNET\",\"\",\"\",0";
+/* the "+CSQ:" rssi 0~31 to the signal strength in dBm */
+#define EC20_CSQ_TO_DBM(rssi)           (-113 + 2 * (rssi))
 
 #ifdef EC20_USING_CME
 static void at_cme_errcode_parse(int result)
@@ -200,6 +206,11 @@ static void ec20_power_off(struct at_device *device)
 
     ec20 = (struct at_device_ec20 *)device->user_data;
 
+#ifdef AT_DEVICE_EC20_USING_CMUX
+    /* the module boots in AT command mode, leave CMUX mode before it is powered off */
+    at_device_cmux_stop(device);
+#endif
+
     /* not nead to set pin configuration for ec20 device power on */
     if (ec20->power_pin == -1 || ec20->power_status_pin == -1)
     {
@@ -221,12 +232,129 @@ static void ec20_power_off(struct at_device *device)
 
 /* =============================  ec20 network interface operations ============================= */
 
+#define EC20_CONTEXT_RESP_SIZE   (64 * EC20_CONTEXT_ID_MAX)
+#define EC20_DNS_RESP_SIZE       96
+
+/**
+ * find the PDP context in the "AT+QIACT?" response, it lists the active contexts.
+ *
+ * @param resp the response object
+ * @param context_id the PDP context ID
+ * @param ipaddr the parsed IP address, it's length must be 16
+ *
+ * @return RT_TRUE: the context is active, RT_FALSE: not found or inactive
+ */
+static rt_bool_t ec20_context_parse(at_response_t resp, int context_id, char ipaddr[16])
+{
+    rt_size_t i;
+    int id = 0, state = 0;
+    const char *line = RT_NULL;
+    struct at_device_parser parser;
+
+    /* +QIACT: <contextID>,<context_state>,<context_type>,<IP_address> */
+    for (i = 1; i <= resp->line_counts; i++)
+    {
+        line = at_resp_get_line(resp, i);
+        at_device_parser_init(&parser, line, rt_strlen(line));
+        if (at_device_parser_expect(&parser, "+QIACT:") < 0 ||
+                at_device_parser_int(&parser, &id) < 0 || id != context_id)
+        {
+            continue;
+        }
+
+        if (at_device_parser_int(&parser, &state) < 0 ||
+                at_device_parser_skip(&parser) < 0 ||
+                at_device_parser_ipv4(&parser, ipaddr) < 0)
+        {
+            return RT_FALSE;
+        }
+
+        return state == 1 && rt_strcmp(ipaddr, "0.0.0.0") != 0;
+    }
+
+    return RT_FALSE;
+}
+
+/**
+ * This function will get the address and DNS servers of the PDP context.
+ *
+ * @param device the AT device
+ * @param context_id the PDP context ID, 1~16
+ * @param info the context information
+ *
+ * @return  0: get success, is_active is RT_FALSE if the context is not activated
+ *         -1: send AT commands error or response error
+ *         -5: no memory
+ */
+int ec20_context_get_info(struct at_device *device, int context_id, struct ec20_context_info *info)
+{
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+
+    RT_ASSERT(device && info);
+    RT_ASSERT(context_id > 0 && context_id <= EC20_CONTEXT_ID_MAX);
+
+    rt_memset(info, 0x00, sizeof(struct ec20_context_info));
+
+    resp = at_create_resp(EC20_CONTEXT_RESP_SIZE, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    /* send "AT+QIACT?" commond to get IP address */
+    at_device_sched_take(device, AT_DEVICE_CMD_BACKGROUND, RT_WAITING_FOREVER);
+    result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QIACT?");
+    at_device_sched_release(device);
+    if (result < 0)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    info->is_active = ec20_context_parse(resp, context_id, info->ipaddr);
+    if (info->is_active == RT_FALSE)
+    {
+        LOG_D("%s device context(%d) is not active.", device->name, context_id);
+        result = RT_EOK;
+        goto __exit;
+    }
+
+    resp = at_resp_set_info(resp, EC20_DNS_RESP_SIZE, 0, rt_tick_from_millisecond(300));
+
+    /* send "AT+QIDNSCFG=<contextID>" commond to get DNS servers address */
+    at_device_sched_take(device, AT_DEVICE_CMD_BACKGROUND, RT_WAITING_FOREVER);
+    result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QIDNSCFG=%d", context_id);
+    at_device_sched_release(device);
+    if (result < 0)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    /* parse response data "+QIDNSCFG: <contextID>,<pridnsaddr>,<secdnsaddr>" */
+    if (at_resp_parse_line_args_by_kw(resp, "+QIDNSCFG:", "+QIDNSCFG: %*d,\"%[^\"]\",\"%[^\"]\"",
+            info->dns_server[0], info->dns_server[1]) <= 0)
+    {
+        LOG_E("%s device prase \"AT+QIDNSCFG=%d\" cmd error.", device->name, context_id);
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+__exit:
+    if (resp)
+    {
+        at_delete_resp(resp);
+    }
+
+    return result;
+}
+
 /* set ec20 network interface device status and address information */
 static int ec20_netdev_set_info(struct netdev *netdev)
 {
 #define EC20_IMEI_RESP_SIZE      32
-#define EC20_IPADDR_RESP_SIZE    64
-#define EC20_DNS_RESP_SIZE       96
 #define EC20_INFO_RESP_TIMO      rt_tick_from_millisecond(300)
 
     int result = RT_EOK;
@@ -261,21 +389,29 @@ static int ec20_netdev_set_info(struct netdev *netdev)
         #define EC20_NETDEV_HWADDR_LEN   8
         #define EC20_IMEI_LEN            15
 
-        char imei[EC20_IMEI_LEN] = {0};
+        struct at_device_ec20 *ec20 = (struct at_device_ec20 *) device->user_data;
+        char *imei = ec20->imei;
         int i = 0, j = 0;
 
-        /* send "AT+GSN" commond to get device IMEI */
-        if (at_obj_exec_cmd(device->client, resp, "AT+GSN") < 0)
+        /* the IMEI is cached, it is not queried again when network re-initialize */
+        if (rt_strlen(imei) < EC20_IMEI_LEN)
         {
-            result = -RT_ERROR;
-            goto __exit;
-        }
+            /* send "AT+GSN" commond to get device IMEI */
+            at_device_sched_take(device, AT_DEVICE_CMD_BACKGROUND, RT_WAITING_FOREVER);
+            result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+GSN");
+            at_device_sched_release(device);
+            if (result < 0)
+            {
+                result = -RT_ERROR;
+                goto __exit;
+            }
 
-        if (at_resp_parse_line_args(resp, 2, "%s", imei) <= 0)
-        {
-            LOG_E("%s device prase \"AT+GSN\" cmd error.", device->name);
-            result = -RT_ERROR;
-            goto __exit;
+            if (at_resp_parse_line_args(resp, 2, "%15s", imei) <= 0)
+            {
+                LOG_E("%s device prase \"AT+GSN\" cmd error.", device->name);
+                result = -RT_ERROR;
+                goto __exit;
+            }
         }
 
         LOG_D("%s device IMEI number: %s", device->name, imei);
@@ -295,65 +431,30 @@ static int ec20_netdev_set_info(struct netdev *netdev)
         }
     }
 
-    /* set network interface device IP address */
+    /* set network interface device IP address and DNS servers of the default context */
     {
-        #define IP_ADDR_SIZE_MAX    16
-        char ipaddr[IP_ADDR_SIZE_MAX] = {0};
+        struct ec20_context_info info;
 
-        resp = at_resp_set_info(resp, EC20_IPADDR_RESP_SIZE, 0, EC20_INFO_RESP_TIMO);
-
-        /* send "AT+QIACT?" commond to get IP address */
-        if (at_obj_exec_cmd(device->client, resp, "AT+QIACT?") < 0)
+        result = ec20_context_get_info(device, EC20_CONTEXT_DEFAULT, &info);
+        if (result < 0 || info.is_active == RT_FALSE)
         {
+            LOG_E("%s device default context is not active.", device->name);
             result = -RT_ERROR;
             goto __exit;
         }
 
-        /* parse response data "+QIACT: 1,<context_state>,<context_type>[,<IP_address>]" */
-        if (at_resp_parse_line_args_by_kw(resp, "+QIACT:", "+QIACT: %*[^\"]\"%[^\"]", ipaddr) <= 0)
-        {
-            LOG_E("%s device \"AT+QIACT?\" cmd error.", device->name);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        LOG_D("%s device IP address: %s", device->name, ipaddr);
+        LOG_D("%s device IP address: %s", device->name, info.ipaddr);
+        LOG_D("%s device primary DNS server address: %s", device->name, info.dns_server[0]);
+        LOG_D("%s device secondary DNS server address: %s", device->name, info.dns_server[1]);
 
         /* set network interface address information */
-        inet_aton(ipaddr, &addr);
+        inet_aton(info.ipaddr, &addr);
         netdev_low_level_set_ipaddr(netdev, &addr);
-    }
-
-    /* set network interface device dns server */
-    {
-        #define DNS_ADDR_SIZE_MAX   16
-        char dns_server1[DNS_ADDR_SIZE_MAX] = {0}, dns_server2[DNS_ADDR_SIZE_MAX] = {0};
-
-        resp = at_resp_set_info(resp, EC20_DNS_RESP_SIZE, 0, EC20_INFO_RESP_TIMO);
-
-        /* send "AT+QIDNSCFG=1" commond to get DNS servers address */
-        if (at_obj_exec_cmd(device->client, resp, "AT+QIDNSCFG=1") < 0)
-        {
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        /* parse response data "+QIDNSCFG: <contextID>,<pridnsaddr>,<secdnsaddr>" */
-        if (at_resp_parse_line_args_by_kw(resp, "+QIDNSCFG:", "+QIDNSCFG: 1,\"%[^\"]\",\"%[^\"]\"",
-                dns_server1, dns_server2) <= 0)
-        {
-            LOG_E("%s device prase \"AT+QIDNSCFG=1\" cmd error.", device->name);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        LOG_D("%s device primary DNS server address: %s", device->name, dns_server1);
-        LOG_D("%s device secondary DNS server address: %s", device->name, dns_server2);
 
-        inet_aton(dns_server1, &addr);
+        inet_aton(info.dns_server[0], &addr);
         netdev_low_level_set_dns_server(netdev, 0, &addr);
 
-        inet_aton(dns_server2, &addr);
+        inet_aton(info.dns_server[1], &addr);
         netdev_low_level_set_dns_server(netdev, 1, &addr);
     }
 
@@ -372,7 +473,7 @@ static void ec20_check_link_status_entry(void *parameter)
 #define EC20_LINK_RESP_TIMO     (3 * RT_TICK_PER_SECOND)
 #define EC20_LINK_DELAY_TIME    (30 * RT_TICK_PER_SECOND)
 
-    int link_stat = 0;
+    int link_stat = 0, link_result = 0, rssi = 0, ber = 0;
     at_response_t resp = RT_NULL;
     struct at_device *device = RT_NULL;
     struct netdev *netdev = (struct netdev *) parameter;
@@ -394,7 +495,10 @@ static void ec20_check_link_status_entry(void *parameter)
     while (1)
     {
         /* send "AT+CGREG" commond  to check netweork interface device link status */
-        if (at_obj_exec_cmd(device->client, resp, "AT+CGREG?") < 0)
+        at_device_sched_take(device, AT_DEVICE_CMD_BACKGROUND, RT_WAITING_FOREVER);
+        link_result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+CGREG?");
+        at_device_sched_release(device);
+        if (link_result < 0)
         {
             if (netdev_is_link_up(netdev))
             {
@@ -415,6 +519,15 @@ static void ec20_check_link_status_entry(void *parameter)
                 {
                     netdev_low_level_set_link_status(netdev, RT_TRUE);
                 }
+
+                /* refresh the signal metrics for the connection scheduler */
+                at_device_sched_take(device, AT_DEVICE_CMD_BACKGROUND, RT_WAITING_FOREVER);
+                if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+CSQ") == RT_EOK &&
+                        at_resp_parse_line_args_by_kw(resp, "+CSQ:", "+CSQ: %d,%d", &rssi, &ber) > 0)
+                {
+                    at_device_metrics_set_signal(device, (rssi == 99) ? 0 : EC20_CSQ_TO_DBM(rssi));
+                }
+                at_device_sched_release(device);
             }
             else
             {
@@ -457,6 +570,7 @@ static int ec20_net_init(struct at_device *device);
 
 static int ec20_netdev_set_up(struct netdev *netdev)
 {
+    int result = RT_EOK;
     struct at_device *device = RT_NULL;
 
     device = at_device_get_by_name(AT_DEVICE_NAMETYPE_NETDEV, netdev->name);
@@ -468,7 +582,12 @@ static int ec20_netdev_set_up(struct netdev *netdev)
 
     if (device->is_init == RT_FALSE)
     {
-        ec20_net_init(device);
+        /* the device stays down after the initialize retries failed, the next set up tries again */
+        result = ec20_net_init(device);
+        if (result < 0)
+        {
+            return result;
+        }
         device->is_init = RT_TRUE;
 
         netdev_low_level_set_status(netdev, RT_TRUE);
@@ -529,7 +648,10 @@ static int ec20_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip
     }
 
     /* send "AT+QIDNSCFG=<pri_dns>[,<sec_dns>]" commond to set dns servers */
-    if (at_obj_exec_cmd(device->client, resp, "AT+QIDNSCFG=1,\"%s\"", inet_ntoa(*dns_server)) < 0)
+    at_device_sched_take(device, AT_DEVICE_CMD_CONTROL, RT_WAITING_FOREVER);
+    result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QIDNSCFG=1,\"%s\"", inet_ntoa(*dns_server));
+    at_device_sched_release(device);
+    if (result < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -579,7 +701,10 @@ static int ec20_netdev_ping(struct netdev *netdev, const char *host,
     }
 
     /* send "AT+QPING="<host>"[,[<timeout>][,<pingnum>]]" commond to send ping request */
-    if (at_obj_exec_cmd(device->client, resp, "AT+QPING=1,\"%s\",%d,1", host, timeout / RT_TICK_PER_SECOND) < 0)
+    at_device_sched_take(device, AT_DEVICE_CMD_BACKGROUND, RT_WAITING_FOREVER);
+    result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QPING=1,\"%s\",%d,1", host, timeout / RT_TICK_PER_SECOND);
+    at_device_sched_release(device);
+    if (result < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -678,6 +803,22 @@ static struct netdev *ec20_netdev_add(const char *netdev_name)
 
 /* =============================  ec20 device operations ============================= */
 
+#ifdef AT_DEVICE_EC20_BAUD_RATE_MAX
+/* the baud rate is saved by the module, it starts at the negotiated baud rate on the next boot */
+static const struct at_device_baud_cfg ec20_baud_cfg =
+{
+    "AT+IPR=%d;&W",
+    "AT+IFC=2,2;&W",
+    AT_DEVICE_EC20_BAUD_RATE_MAX,
+#ifdef AT_DEVICE_EC20_FLOW_CONTROL
+    RT_TRUE,
+#else
+    RT_FALSE,
+#endif
+    100,
+};
+#endif /* AT_DEVICE_EC20_BAUD_RATE_MAX */
+
 #define AT_SEND_CMD(client, resp, resp_line, timeout, cmd)                                         \
     do {                                                                                           \
         (resp) = at_resp_set_info((resp), 128, (resp_line), rt_tick_from_millisecond(timeout));    \
@@ -688,44 +829,310 @@ static struct netdev *ec20_netdev_add(const char *netdev_name)
         }                                                                                          \
     } while(0)                                                                                     \
 
+#ifdef AT_DEVICE_EC20_USING_CMUX
+/* the socket data and URC use the first channel, the control commands use the second one */
+static const struct at_device_cmux_cfg ec20_cmux_cfg =
+{
+    "AT+CMUX=0,0,5,127",
+    "ATE0;+CMEE=2",
+    127,
+    1024,
+};
+#endif /* AT_DEVICE_EC20_USING_CMUX */
+
+#ifdef AT_DEVICE_EC20_USING_PPP
+#ifndef AT_DEVICE_EC20_USING_CMUX
+#error "EC20 PPP data call needs the CMUX control channel, please define AT_DEVICE_EC20_USING_CMUX."
+#endif
+/* the data call uses the default PDP context, release it from the module TCP/IP stack first */
+static const struct at_device_ppp_cfg ec20_ppp_cfg =
+{
+    "AT+QIDEACT=1",
+    "ATD*99#",
+};
+#endif /* AT_DEVICE_EC20_USING_PPP */
+
+#ifdef AT_DEVICE_USING_MQTT
+/* the module MQTT client, the payload is written after the '>' prompt */
+static const struct at_device_mqtt_dialect ec20_mqtt_dialect =
+{
+    "AT+QMTPUB=%d,%d,%d,%d,\"%s\",%d",
+};
+#endif /* AT_DEVICE_USING_MQTT */
+
+/* read the ICCID of SIM card to the cache */
+static int ec20_iccid_query(struct at_device *device, at_response_t resp)
+{
+    const char *line = RT_NULL;
+    struct at_device_parser parser;
+    struct at_device_ec20 *ec20 = (struct at_device_ec20 *) device->user_data;
+
+    resp = at_resp_set_info(resp, 128, 0, rt_tick_from_millisecond(300));
+    if (at_obj_exec_cmd(device->client, resp, "AT+QCCID") < 0)
+    {
+        return -RT_ERROR;
+    }
+
+    line = at_resp_get_line_by_kw(resp, "+QCCID:");
+    if (line == RT_NULL)
+    {
+        return -RT_ERROR;
+    }
+
+    at_device_parser_init(&parser, line, rt_strlen(line));
+    if (at_device_parser_expect(&parser, "+QCCID:") < 0 ||
+            at_device_parser_str(&parser, ec20->iccid, sizeof(ec20->iccid)) <= 0)
+    {
+        LOG_E("%s device prase \"AT+QCCID\" cmd error.", device->name);
+        ec20->iccid[0] = '\0';
+        return -RT_ERROR;
+    }
+    LOG_D("%s device ICCID number: %s", device->name, ec20->iccid);
+
+    return RT_EOK;
+}
+
 /* initialize for ec20 */
-static void ec20_init_thread_entry(void *parameter)
+#ifdef AT_DEVICE_EC20_USING_WARM_START
+/**
+ * check the module is still attached with an active PDP context, it happens
+ * after the MCU only reset, the identification and registration are skipped.
+ *
+ * @param device the AT device
+ * @param resp the response object
+ *
+ * @return RT_TRUE: the context is active, RT_FALSE: need full initialization
+ */
+static rt_bool_t ec20_warm_start_check(struct at_device *device, at_response_t resp)
+{
+    char ipaddr[16] = {0};
+
+    resp = at_resp_set_info(resp, EC20_CONTEXT_RESP_SIZE, 0, rt_tick_from_millisecond(300));
+    if (at_obj_exec_cmd(device->client, resp, "AT+QIACT?") < 0)
+    {
+        return RT_FALSE;
+    }
+
+    if (ec20_context_parse(resp, EC20_CONTEXT_DEFAULT, ipaddr) == RT_FALSE)
+    {
+        return RT_FALSE;
+    }
+
+    LOG_I("%s device context is active(%s), warm start.", device->name, ipaddr);
+
+    return RT_TRUE;
+}
+#endif /* AT_DEVICE_EC20_USING_WARM_START */
+
+/* get the configuration of the PDP context, RT_NULL: not configured */
+static const struct ec20_context_cfg *ec20_context_cfg_get(struct at_device *device, int context_id)
+{
+    rt_size_t i;
+    struct at_device_ec20 *ec20 = (struct at_device_ec20 *) device->user_data;
+
+    for (i = 0; i < ec20->context_num; i++)
+    {
+        if (ec20->contexts[i].id == context_id)
+        {
+            return &(ec20->contexts[i]);
+        }
+    }
+
+    return RT_NULL;
+}
+
+/* set the APN of the PDP context, the context type is IPv4 */
+static int ec20_context_config(struct at_device *device, at_response_t resp, const struct ec20_context_cfg *cfg)
+{
+    resp = at_resp_set_info(resp, 128, 0, rt_tick_from_millisecond(300));
+    return at_obj_exec_cmd(device->client, resp, "AT+QICSGP=%d,1,\"%s\",\"%s\",\"%s\",%d", cfg->id, cfg->apn,
+                           cfg->username ? cfg->username : "", cfg->password ? cfg->password : "", cfg->auth);
+}
+
+/**
+ * activate the configured PDP contexts besides the default one, the active
+ * contexts are kept and a failed context is left inactive.
+ *
+ * @param device the AT device
+ * @param resp the response object
+ */
+static void ec20_context_activate(struct at_device *device, at_response_t resp)
+{
+    int id = 0;
+    rt_size_t i;
+    char ipaddr[16] = {0};
+    rt_uint32_t active = 0;
+    const struct ec20_context_cfg *cfg = RT_NULL;
+    struct at_device_ec20 *ec20 = (struct at_device_ec20 *) device->user_data;
+
+    resp = at_resp_set_info(resp, EC20_CONTEXT_RESP_SIZE, 0, rt_tick_from_millisecond(300));
+    if (at_obj_exec_cmd(device->client, resp, "AT+QIACT?") == 0)
+    {
+        for (id = 1; id <= EC20_CONTEXT_ID_MAX; id++)
+        {
+            if (ec20_context_parse(resp, id, ipaddr))
+            {
+                active |= 1UL << id;
+            }
+        }
+    }
+
+    for (i = 0; i < ec20->context_num; i++)
+    {
+        cfg = &(ec20->contexts[i]);
+        if (cfg->id <= EC20_CONTEXT_DEFAULT || cfg->id > EC20_CONTEXT_ID_MAX || (active & (1UL << cfg->id)))
+        {
+            continue;
+        }
+
+        if (ec20_context_config(device, resp, cfg) < 0)
+        {
+            LOG_W("%s device context(%d) APN(%s) config failed.", device->name, cfg->id, cfg->apn);
+            continue;
+        }
+
+        resp = at_resp_set_info(resp, 128, 0, rt_tick_from_millisecond(150 * 1000));
+        if (at_obj_exec_cmd(device->client, resp, "AT+QIACT=%d", cfg->id) < 0)
+        {
+            LOG_W("%s device context(%d) APN(%s) activate failed.", device->name, cfg->id, cfg->apn);
+            continue;
+        }
+
+        LOG_I("%s device context(%d) APN(%s) is active.", device->name, cfg->id, cfg->apn);
+        active |= 1UL << cfg->id;
+    }
+
+    ec20->context_active = active;
+}
+
+/* boot steps check, the result line fields are "<stat>" or "<n>,<stat>" */
+static int ec20_boot_reg_stat(const char *line, const char *keyword)
+{
+    int value[2] = {0};
+    struct at_device_parser parser;
+
+    at_device_parser_init(&parser, line, rt_strlen(line));
+    if (at_device_parser_expect(&parser, keyword) < 0 || at_device_parser_int(&parser, &value[0]) < 0)
+    {
+        return 0;
+    }
+
+    if (at_device_parser_int(&parser, &value[1]) < 0)
+    {
+        /* the URC has the stat only */
+        value[1] = value[0];
+    }
+
+    return (value[1] == 1 || value[1] == 5) ? 1 : 0;
+}
+
+static int ec20_boot_cpin_check(struct at_device *device, const char *line)
+{
+    if (rt_strstr(line, "READY"))
+    {
+        return 1;
+    }
+
+    /* the SIM card needs PIN or PUK, it never becomes ready by waiting */
+    if (rt_strstr(line, "PIN") || rt_strstr(line, "PUK"))
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+static int ec20_boot_csq_check(struct at_device *device, const char *line)
+{
+    int rssi = 0, ber = 0;
+    struct at_device_parser parser;
+
+    at_device_parser_init(&parser, line, rt_strlen(line));
+    if (at_device_parser_expect(&parser, "+CSQ:") < 0 ||
+            at_device_parser_int(&parser, &rssi) < 0 ||
+            at_device_parser_int(&parser, &ber) < 0 || rssi == 99)
+    {
+        return 0;
+    }
+
+    LOG_D("%s device signal strength: %d, channel bit error rate: %d", device->name, rssi, ber);
+    at_device_metrics_set_signal(device, EC20_CSQ_TO_DBM(rssi));
+    return 1;
+}
+
+static int ec20_boot_creg_check(struct at_device *device, const char *line)
+{
+    return ec20_boot_reg_stat(line, "+CREG:");
+}
+
+static int ec20_boot_cgreg_check(struct at_device *device, const char *line)
+{
+    return ec20_boot_reg_stat(line, "+CGREG:");
+}
+
+/* the "+CGREG:" line is parsed by the link status check, so it is polled without URC */
+static const struct at_device_boot_step ec20_boot_steps[] =
+{
+    {"cpin",  "AT+CPIN?",  "+CPIN:",  0, AT_DEVICE_BOOT_STEP_URC, 5 * 1000, 10 * 1000, ec20_boot_cpin_check},
+    {"cimi",  "AT+CIMI",   RT_NULL,   0, 0,                       300,      10 * 1000, RT_NULL},
+    {"csq",   "AT+CSQ",    "+CSQ:",   0, 0,                       300,      20 * 1000, ec20_boot_csq_check},
+    {"creg",  "AT+CREG?",  "+CREG:",  0, AT_DEVICE_BOOT_STEP_URC, 300,      10 * 1000, ec20_boot_creg_check},
+    {"cgreg", "AT+CGREG?", "+CGREG:", 0, 0,                       300,      20 * 1000, ec20_boot_cgreg_check},
+};
+
+/* initialize the ec20 device network, the result is reported to the device initialization */
+static int ec20_net_init_run(struct at_device *device)
 {
 #define INIT_RETRY                     5
-#define CIMI_RETRY                     10
-#define CSQ_RETRY                      20
-#define CREG_RETRY                     10
-#define CGREG_RETRY                    20
 
-    int i, qi_arg[3] = {0};
+    int i;
     int retry_num = INIT_RETRY;
     char parsed_data[20] = {0};
     rt_err_t result = RT_EOK;
     at_response_t resp = RT_NULL;
-    struct at_device *device = (struct at_device *) parameter;
+    struct ec20_context_cfg apn_cfg;
+    const struct at_device_apn *apn = RT_NULL;
+    const struct ec20_context_cfg *cfg = RT_NULL;
     struct at_client *client = device->client;
+    struct at_device_ec20 *ec20 = (struct at_device_ec20 *) device->user_data;
 
     resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
-        return;
+        return -RT_ENOMEM;
     }
 
     LOG_D("start init %s device.", device->name);
 
+    /* the URC keywords of boot steps are registered before power on */
+    result = at_device_boot_init(device, ec20_boot_steps, sizeof(ec20_boot_steps) / sizeof(ec20_boot_steps[0]));
+    if (result < 0)
+    {
+        at_delete_resp(resp);
+        return result;
+    }
+
     while (retry_num--)
     {
-        /* power on the ec20 device */
+        /* the physical AT client is put back after CMUX stopped by power off */
+        client = device->client;
+        /* power on the ec20 device, the AT synchronization polls the module startup */
         ec20_power_on(device);
-        rt_thread_mdelay(1000);
+        at_device_boot_mark(device, "power");
 
         /* wait ec20 startup finish, send AT every 500ms, if receive OK, SYNC success*/
+#ifdef AT_DEVICE_EC20_BAUD_RATE_MAX
+        if (at_device_baud_sync(device, &ec20_baud_cfg, EC20_WAIT_CONNECT_TIME) != RT_EOK &&
+                at_client_obj_wait_connect(client, EC20_WAIT_CONNECT_TIME))
+#else
         if (at_client_obj_wait_connect(client, EC20_WAIT_CONNECT_TIME))
+#endif
         {
             result = -RT_ETIMEOUT;
             goto __exit;
         }
+        at_device_boot_mark(device, "sync");
 
         /* set response format to ATV1 */
         AT_SEND_CMD(client, resp, 0, 300, "ATV1");
@@ -737,125 +1144,76 @@ static void ec20_init_thread_entry(void *parameter)
         AT_SEND_CMD(client, resp, 0, 300, "AT+IPR?");
         at_resp_parse_line_args_by_kw(resp, "+IPR:", "+IPR: %d", &i);
         LOG_D("%s device baudrate %d", device->name, i);
-        /* get module version */
-        AT_SEND_CMD(client, resp, 0, 300, "ATI");
-        /* show module version */
-        for (i = 0; i < (int) resp->line_counts - 1; i++)
-        {
-            LOG_D("%s", at_resp_get_line(resp, i + 1));
-        }
-        /* Use AT+GSN to query the IMEI of module */
-        AT_SEND_CMD(client, resp, 0, 300, "AT+GSN");
 
-        /* check SIM card */
-        AT_SEND_CMD(client, resp, 2, 5 * 1000, "AT+CPIN?");
-        if (!at_resp_get_line_by_kw(resp, "READY"))
+#ifdef AT_DEVICE_EC20_BAUD_RATE_MAX
+        /* raise the baud rate and enable the flow control */
+        if (at_device_baud_negotiate(device, &ec20_baud_cfg) < 0)
         {
-            LOG_E("%s device SIM card detection failed.", device->name);
             result = -RT_ERROR;
             goto __exit;
         }
-        /* waiting for dirty data to be digested */
-        rt_thread_mdelay(10);
-
-
-        /* Use AT+CIMI to query the IMSI of SIM card */
-        // AT_SEND_CMD(client, resp, 2, 300, "AT+CIMI");
-        i = 0;
-        resp = at_resp_set_info(resp, 128, 0, rt_tick_from_millisecond(300));
-        while(at_obj_exec_cmd(device->client, resp, "AT+CIMI") < 0)
-        {
-            i++;
-            if(i > CIMI_RETRY)
-            {
-                LOG_E("%s device read CIMI failed.", device->name);
-                result = -RT_ERROR;
-                goto __exit;
-            }
-            rt_thread_mdelay(1000);
-        }
+#endif
 
-        /* Use AT+QCCID to query ICCID number of SIM card */
-        AT_SEND_CMD(client, resp, 0, 300, "AT+QCCID");
-        /* check signal strength */
-        for (i = 0; i < CSQ_RETRY; i++)
+#ifdef AT_DEVICE_EC20_USING_WARM_START
+        /* the module is still attached after the MCU reset, go to the network information directly */
+        if (ec20_warm_start_check(device, resp))
         {
-            AT_SEND_CMD(client, resp, 0, 300, "AT+CSQ");
-            at_resp_parse_line_args_by_kw(resp, "+CSQ:", "+CSQ: %d,%d", &qi_arg[0], &qi_arg[1]);
-            if (qi_arg[0] != 99)
+            /* the RAM cache is lost by the MCU reset, the SIM card is not changed with the context active */
+            if (ec20->iccid[0] == '\0')
             {
-                LOG_D("%s device signal strength: %d, channel bit error rate: %d",
-                        device->name, qi_arg[0], qi_arg[1]);
-                break;
+                ec20_iccid_query(device, resp);
             }
-            rt_thread_mdelay(1000);
+            goto __warm_start;
         }
-        if (i == CSQ_RETRY)
+#endif
+        /* get module version */
+        AT_SEND_CMD(client, resp, 0, 300, "ATI");
+        /* show module version */
+        for (i = 0; i < (int) resp->line_counts - 1; i++)
         {
-            LOG_E("%s device signal strength check failed (%s)", device->name, parsed_data);
-            result = -RT_ERROR;
-            goto __exit;
+            LOG_D("%s", at_resp_get_line(resp, i + 1));
         }
-        /* check the GSM network is registered */
-        for (i = 0; i < CREG_RETRY; i++)
+        /* Use AT+GSN to query the IMEI of module, it is read once and cached */
+        if (rt_strlen(ec20->imei) < EC20_IMEI_LEN)
         {
-            AT_SEND_CMD(client, resp, 0, 300, "AT+CREG?");
-            at_resp_parse_line_args_by_kw(resp, "+CREG:", "+CREG: %s", &parsed_data);
-            if (!rt_strncmp(parsed_data, "0,1", sizeof(parsed_data)) ||
-                    !rt_strncmp(parsed_data, "0,5", sizeof(parsed_data)))
-            {
-                LOG_D("%s device GSM is registered(%s)", device->name, parsed_data);
-                break;
-            }
-            rt_thread_mdelay(1000);
+            AT_SEND_CMD(client, resp, 0, 300, "AT+GSN");
+            at_resp_parse_line_args(resp, 2, "%15s", ec20->imei);
         }
-        if (i == CREG_RETRY)
+
+        /* report the GSM network registration changes, it wakes up the registration step */
+        AT_SEND_CMD(client, resp, 0, 300, "AT+CREG=1");
+        at_device_boot_mark(device, "ident");
+
+        /* wait for SIM card, signal and network registration ready */
+        result = at_device_boot_run(device);
+        if (result < 0)
         {
-            LOG_E("%s device GSM is register failed (%s)", device->name, parsed_data);
-            result = -RT_ERROR;
             goto __exit;
         }
-        /* check the GPRS network is registered */
-        for (i = 0; i < CGREG_RETRY; i++)
+        /* Use AT+QCCID to query ICCID number of SIM card, the card may be changed since the last initialize */
+        if (ec20_iccid_query(device, resp) < 0)
         {
-            AT_SEND_CMD(client, resp, 0, 300, "AT+CGREG?");
-            at_resp_parse_line_args_by_kw(resp, "+CGREG:", "+CGREG: %s", &parsed_data);
-            if (!rt_strncmp(parsed_data, "0,1", sizeof(parsed_data)) ||
-                    !rt_strncmp(parsed_data, "0,5", sizeof(parsed_data)))
-            {
-                LOG_D("%s device GPRS is registered(%s)", device->name, parsed_data);
-                break;
-            }
-            rt_thread_mdelay(1000);
-        }
-        if (i == CGREG_RETRY)
-        {
-            LOG_E("%s device GPRS is register failed (%s)", device->name, parsed_data);
             result = -RT_ERROR;
             goto __exit;
         }
         /*Use AT+CEREG? to query current EPS Network Registration Status*/
         AT_SEND_CMD(client, resp, 0, 300, "AT+CEREG?");
-        /* Use AT+COPS? to query current Network Operator */
-        AT_SEND_CMD(client, resp, 0, 300, "AT+COPS?");
-        at_resp_parse_line_args_by_kw(resp, "+COPS:", "+COPS: %*[^\"]\"%[^\"]", &parsed_data);
-        if(rt_strcmp(parsed_data,"CHINA MOBILE") == 0)
+        /* the APN is found by the PLMN of the SIM card, the configured one of the default context replaces it */
+        cfg = ec20_context_cfg_get(device, EC20_CONTEXT_DEFAULT);
+        if (cfg == RT_NULL && (apn = at_device_apn_query(device, client)) != RT_NULL)
         {
-            /* "CMCC" */
-            LOG_I("%s device network operator: %s", device->name, parsed_data);
-            AT_SEND_CMD(client, resp, 0, 300, QICSGP_CHINA_MOBILE);
+            apn_cfg.id = EC20_CONTEXT_DEFAULT;
+            apn_cfg.apn = apn->apn;
+            apn_cfg.username = apn->username;
+            apn_cfg.password = apn->password;
+            /* PAP or CHAP */
+            apn_cfg.auth = apn->username ? 3 : 0;
+            cfg = &apn_cfg;
         }
-        else if(strcmp(parsed_data,"CHN-UNICOM") == 0)
+        if (cfg && ec20_context_config(device, resp, cfg) < 0)
         {
-            /* "UNICOM" */
-            LOG_I("%s device network operator: %s", device->name, parsed_data);
-            AT_SEND_CMD(client, resp, 0, 300, QICSGP_CHINA_UNICOM);
-        }
-        else if(rt_strcmp(parsed_data,"CHN-CT") == 0)
-        {
-            /* "CT" */
-            LOG_I("%s device network operator: %s", device->name, parsed_data);
-            AT_SEND_CMD(client, resp, 0, 300, QICSGP_CHINA_TELECOM);
+            result = -RT_ERROR;
+            goto __exit;
         }
         /* Enable automatic time zone update via NITZ and update LOCAL time to RTC */
         AT_SEND_CMD(client, resp, 0, 300, "AT+CTZU=3");
@@ -870,8 +1228,43 @@ static void ec20_init_thread_entry(void *parameter)
         AT_SEND_CMD(client, resp, 0, 150 * 1000, "AT+QIACT?");
         at_resp_parse_line_args_by_kw(resp, "+QIACT:", "+QIACT: %*[^\"]\"%[^\"]", &parsed_data);
         LOG_I("%s device IP address: %s", device->name, parsed_data);
+        at_device_boot_mark(device, "context");
+
+#ifdef AT_DEVICE_EC20_USING_WARM_START
+    __warm_start:
+#endif
+        /* the other contexts carry the traffic selected by the sockets */
+        ec20_context_activate(device, resp);
+        at_device_boot_mark(device, "contexts");
+#ifdef AT_DEVICE_EC20_USING_CMUX
+        /* enter CMUX mode, the background commands do not queue behind the socket data */
+        if (at_device_cmux_start(device, &ec20_cmux_cfg) < 0)
+        {
+            result = -RT_ERROR;
+            goto __exit;
+        }
+#ifdef AT_USING_SOCKET
+        /* register URC to the data channel AT client */
+        ec20_socket_init(device);
+#endif
+#endif /* AT_DEVICE_EC20_USING_CMUX */
+
+#ifdef AT_DEVICE_USING_MQTT
+        /* the MQTT URCs are on the control client */
+        at_device_mqtt_init(device, &ec20_mqtt_dialect);
+#endif
+
+#ifdef AT_DEVICE_EC20_USING_PPP
+        /* the sockets use lwIP over the data call instead of the module TCP/IP stack */
+        if (at_device_ppp_start(device, &ec20_ppp_cfg) < 0)
+        {
+            result = -RT_ERROR;
+            goto __exit;
+        }
+#endif /* AT_DEVICE_EC20_USING_PPP */
 
         /* initialize successfully  */
+        at_device_boot_report(device);
         result = RT_EOK;
         break;
 
@@ -908,6 +1301,12 @@ static void ec20_init_thread_entry(void *parameter)
         LOG_E("%s device network initialize failed(%d).", device->name, result);
     }
 
+    return result;
+}
+
+static void ec20_init_thread_entry(void *parameter)
+{
+    ec20_net_init_run((struct at_device *) parameter);
 }
 
 /* ec20 device network initialize */
@@ -928,7 +1327,7 @@ static int ec20_net_init(struct at_device *device)
         return -RT_ERROR;
     }
 #else
-    ec20_init_thread_entry(device);
+    return ec20_net_init_run(device);
 #endif /* AT_DEVICE_EC20_INIT_ASYN */
 
     return RT_EOK;
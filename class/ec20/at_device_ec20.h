@@ -36,6 +36,28 @@ extern "C" {
 /* The maximum number of sockets supported by the ec20 device */
 #define AT_DEVICE_EC20_SOCKETS_NUM  5
 
+/* The PDP context ID is 1~16, context 1 is the default context of the netdev */
+#define EC20_CONTEXT_DEFAULT        1
+#define EC20_CONTEXT_ID_MAX         16
+
+/* ec20 PDP context configuration, the contexts are activated on the device initialize */
+struct ec20_context_cfg
+{
+    int id;                                      /* 1: replace the operator APN of the default context */
+    const char *apn;
+    const char *username;                        /* RT_NULL: no authentication */
+    const char *password;
+    int auth;                                    /* 0: none, 1: PAP, 2: CHAP, 3: PAP or CHAP */
+};
+
+/* ec20 PDP context information */
+struct ec20_context_info
+{
+    rt_bool_t is_active;
+    char ipaddr[16];
+    char dns_server[2][16];
+};
+
 struct at_device_ec20
 {
     char *device_name;
@@ -48,8 +70,28 @@ struct at_device_ec20
 
     void *socket_data;
     void *user_data;
+
+    /* the identities are cached in RAM, they are read from the module again after the MCU reset */
+    char imei[16];                               /* the cached IMEI, it never changes */
+    char iccid[21];                              /* the cached ICCID, it is read again when the SIM card is checked */
+
+    /* raw data read after "CONNECT <length>" on the control client */
+    char *xfer_buf;                              /* the buffer of data read after "CONNECT <length>" */
+    rt_size_t xfer_buf_size;
+    rt_size_t xfer_len;                          /* the data length read */
+
+    int app_result[3];                           /* the fields of the last application result URC */
+    rt_mutex_t app_lock;                         /* the module applications share the result event and app_result */
+    rt_size_t ftp_done;                          /* the on-module FTP(S) transferred length */
+
+    const struct ec20_context_cfg *contexts;     /* the PDP contexts activated on initialize, RT_NULL: default only */
+    rt_size_t context_num;
+    rt_uint32_t context_active;                  /* the active PDP contexts, bit n is the context n */
 };
 
+/* get the address and DNS servers of the PDP context */
+int ec20_context_get_info(struct at_device *device, int context_id, struct ec20_context_info *info);
+
 #ifdef AT_USING_SOCKET
 
 /* ec20 device socket initialize */
@@ -58,6 +100,104 @@ int ec20_socket_init(struct at_device *device);
 /* ec20 device class socket register */
 int ec20_socket_class_register(struct at_device_class *class);
 
+struct at_device_tls_cfg;
+
+/* the SSL context of the module applications, the socket SSL context is the socket number */
+#define EC20_APP_SSL_CTX               5
+
+/* configure the module SSL context */
+int ec20_ssl_config(struct at_device *device, int ssl_ctx, const struct at_device_tls_cfg *cfg);
+
+/* select the PDP context of the socket before connect, it is reset to the default one on close */
+int ec20_socket_set_context(struct at_socket *socket, int context_id);
+
+/* ec20 device file block sink, it is called in the caller thread, return < 0 to abort */
+typedef int (*ec20_file_sink_t)(void *user_data, const char *data, rt_size_t size);
+/* ec20 device file block source, it returns the size filled, 0: end of data, < 0: error */
+typedef int (*ec20_file_source_t)(void *user_data, char *buf, rt_size_t size);
+
+/* ec20 device UFS file access */
+int ec20_file_init(struct at_device *device);
+int ec20_file_upload(struct at_device *device, const char *name, const char *data, size_t size);
+int ec20_file_read(struct at_device *device, const char *name, rt_size_t offset, rt_size_t block_size,
+                   ec20_file_sink_t sink, void *user_data);
+int ec20_file_write(struct at_device *device, const char *name, rt_size_t block_size,
+                    ec20_file_source_t source, void *user_data);
+/* ec20 device UFS staging, the data is written in blocks and the MCU buffer can be freed after append */
+int ec20_file_open(struct at_device *device, const char *name);
+int ec20_file_append(struct at_device *device, int handle, const char *data, rt_size_t size);
+int ec20_file_close(struct at_device *device, int handle);
+int ec20_file_delete(struct at_device *device, const char *name);
+/* send the command which takes the data after "CONNECT", the device is taken by the caller */
+int ec20_file_xfer_write(struct at_device *device, at_response_t resp, rt_int32_t timeout,
+                         const char *data, rt_size_t size, const char *cmd_expr, ...);
+/* the application result URC, the fields are saved in app_result */
+void ec20_urc_app_result(struct at_client *client, const char *data, rt_size_t size);
+
+#ifdef EC20_USING_HTTP
+/* ec20 HTTP(S) request */
+struct ec20_http_request
+{
+    const char *url;                             /* "http://" or "https://" URL */
+    rt_size_t offset;                            /* get the body from the offset by range request, 0: whole body */
+    const struct at_device_tls_cfg *tls;         /* HTTPS configuration, RT_NULL: no server verification */
+    rt_size_t block_size;                        /* the body block size passed to the sink */
+    rt_int32_t timeout;                          /* the response timeout in second, 0: default */
+};
+
+/* ec20 HTTP(S) client, the response body is streamed to the sink in blocks */
+int ec20_http_init(struct at_device *device);
+int ec20_http_get(struct at_device *device, const struct ec20_http_request *req,
+                  ec20_file_sink_t sink, void *user_data);
+int ec20_http_post(struct at_device *device, const struct ec20_http_request *req, const char *body, rt_size_t size,
+                   ec20_file_sink_t sink, void *user_data);
+int ec20_http_post_file(struct at_device *device, const struct ec20_http_request *req, const char *file,
+                        ec20_file_sink_t sink, void *user_data);
+#endif /* EC20_USING_HTTP */
+
+#ifdef EC20_USING_FTP
+/* ec20 FTP(S) transfer phases */
+#define EC20_FTP_PHASE_REMOTE          0x01      /* between the server and the module UFS */
+#define EC20_FTP_PHASE_LOCAL           0x02      /* between the module UFS and the MCU */
+
+/* ec20 FTP(S) transfer progress, total is 0 if unknown, rate is in byte per second */
+typedef void (*ec20_ftp_progress_t)(void *user_data, int phase, rt_size_t done, rt_size_t total, rt_uint32_t rate);
+
+/* ec20 FTP(S) server */
+struct ec20_ftp_server
+{
+    const char *host;
+    int port;                                    /* 0: default 21 */
+    const char *user;
+    const char *password;
+    const struct at_device_tls_cfg *tls;         /* explicit FTPS configuration, RT_NULL: FTP */
+};
+
+/* ec20 FTP(S) file transfer */
+struct ec20_ftp_xfer
+{
+    const char *remote;                          /* the remote file name in the current directory */
+    rt_size_t block_size;                        /* the UART block size, 0: default */
+    rt_int32_t timeout;                          /* the on-module transfer timeout in second, 0: default */
+    ec20_ftp_progress_t progress;                /* optional, the progress notice */
+    void *user_data;                             /* the progress user data */
+};
+
+/* ec20 FTP(S) client, the file is transferred on module and then streamed over the UART in blocks */
+int ec20_ftp_init(struct at_device *device);
+int ec20_ftp_open(struct at_device *device, const struct ec20_ftp_server *server);
+int ec20_ftp_cwd(struct at_device *device, const char *dir);
+int ec20_ftp_close(struct at_device *device);
+int ec20_ftp_get(struct at_device *device, const struct ec20_ftp_xfer *xfer, ec20_file_sink_t sink, void *sink_data);
+int ec20_ftp_put(struct at_device *device, const struct ec20_ftp_xfer *xfer, rt_size_t size,
+                 ec20_file_source_t source, void *source_data);
+int ec20_ftp_put_staged(struct at_device *device, const struct ec20_ftp_xfer *xfer, const char *name);
+#ifdef RT_USING_DFS
+int ec20_ftp_get_file(struct at_device *device, const struct ec20_ftp_xfer *xfer, const char *path);
+int ec20_ftp_put_file(struct at_device *device, const struct ec20_ftp_xfer *xfer, const char *path);
+#endif /* RT_USING_DFS */
+#endif /* EC20_USING_FTP */
+
 #endif /* AT_USING_SOCKET */
 
 #ifdef __cplusplus
@@ -0,0 +1,608 @@
+/*
+ * File      : at_file_ec20.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include <at_device_ec20.h>
+#include <at_device_urc.h>
+#include <at_device_socket.h>
+#include <at_device_parser.h>
+#include <at_device_sched.h>
+
+#define LOG_TAG                        "at.file.ec20"
+#include <at_log.h>
+
+#if defined(AT_DEVICE_USING_EC20) && defined(AT_USING_SOCKET)
+
+/* the time in second the module waits for the upload or write data, about 10KB per second on UART */
+#define EC20_FILE_INPUT_TIME(size)     (5 + (int) ((size) / 10240))
+
+/* the maximum block size of the staging write */
+#ifndef EC20_FILE_BLOCK_SIZE
+#define EC20_FILE_BLOCK_SIZE           4096
+#endif
+
+/* the time in millisecond the module answers "CONNECT" */
+#define EC20_XFER_CONNECT_TIMEOUT      5000
+
+/**
+ * send the command which takes the data after "CONNECT", the data is written by
+ * the caller thread like the '>' prompt send. The last byte is sent by the command
+ * waiting for the final response, so the response can not arrive before it is waited.
+ * The device must be taken by the caller.
+ *
+ * @param device the AT device
+ * @param resp the response object, the final response is saved in it
+ * @param timeout the final response timeout in millisecond
+ * @param data the data
+ * @param size the data size
+ * @param cmd_expr the command expression
+ *
+ * @return  0: the final response is OK
+ *         -1: send AT commands error or no "CONNECT"
+ *         -2: wait response timeout
+ */
+int ec20_file_xfer_write(struct at_device *device, at_response_t resp, rt_int32_t timeout,
+                         const char *data, rt_size_t size, const char *cmd_expr, ...)
+{
+    va_list args;
+    char cmd[AT_CMD_MAX_LEN] = {0};
+    struct at_client *client = AT_DEVICE_CTRL_CLIENT(device);
+
+    RT_ASSERT(resp);
+    RT_ASSERT(data && size > 0);
+
+    va_start(args, cmd_expr);
+    rt_vsnprintf(cmd, sizeof(cmd), cmd_expr, args);
+    va_end(args);
+
+    /* "CONNECT" is on the second line after the empty line */
+    resp = at_resp_set_info(resp, resp->buf_size, 2, rt_tick_from_millisecond(EC20_XFER_CONNECT_TIMEOUT));
+    if (at_obj_exec_cmd(client, resp, "%s", cmd) < 0 || at_resp_get_line_by_kw(resp, "CONNECT") == RT_NULL)
+    {
+        return -RT_ERROR;
+    }
+
+    if (size > 1 && at_client_obj_send(client, data, size - 1) != size - 1)
+    {
+        return -RT_ERROR;
+    }
+
+    /* the line end after the last byte is ignored by module in command mode */
+    resp = at_resp_set_info(resp, resp->buf_size, 0, rt_tick_from_millisecond(timeout));
+    return at_obj_exec_cmd(client, resp, "%c", data[size - 1]);
+}
+
+/**
+ * write the file to the module UFS, the file with the same name is replaced.
+ *
+ * @param device the AT device
+ * @param name the file name
+ * @param data the file data
+ * @param size the file size
+ *
+ * @return  0: upload success
+ *         -1: send AT commands error or upload size error
+ *         -5: no memory
+ */
+int ec20_file_upload(struct at_device *device, const char *name, const char *data, size_t size)
+{
+    int result = RT_EOK, upload_size = 0;
+    at_response_t resp = RT_NULL;
+    const char *line = RT_NULL;
+    struct at_device_parser parser;
+
+    RT_ASSERT(name);
+    RT_ASSERT(data && size > 0);
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    at_device_sched_take(device, AT_DEVICE_CMD_BACKGROUND, RT_WAITING_FOREVER);
+
+    /* the file may not exist, ignore the result */
+    at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QFDEL=\"%s\"", name);
+
+    /* +QFUPL: <upload_size>,<checksum> */
+    result = ec20_file_xfer_write(device, resp, (EC20_FILE_INPUT_TIME(size) + 5) * 1000, data, size,
+                                  "AT+QFUPL=\"%s\",%d,%d", name, (int) size, EC20_FILE_INPUT_TIME(size));
+    if (result < 0 || (line = at_resp_get_line_by_kw(resp, "+QFUPL:")) == RT_NULL)
+    {
+        LOG_E("%s device upload file(%s) failed.", device->name, name);
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    at_device_parser_init(&parser, line, rt_strlen(line));
+    if (at_device_parser_expect(&parser, "+QFUPL:") < 0 ||
+            at_device_parser_int(&parser, &upload_size) < 0 || upload_size != (int) size)
+    {
+        LOG_E("%s device upload file(%s) size(%d) error.", device->name, name, upload_size);
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+__exit:
+    at_device_sched_release(device);
+
+    if (resp)
+    {
+        at_delete_resp(resp);
+    }
+
+    return result;
+}
+
+/**
+ * read the module UFS file in blocks, each block is passed to the sink in
+ * the caller thread, only one block is buffered.
+ *
+ * @param device the AT device
+ * @param name the file name
+ * @param offset the read start offset
+ * @param block_size the block size
+ * @param sink the block sink
+ * @param user_data the sink user data
+ *
+ * @return >=0: the size of read
+ *          -1: send AT commands error or the sink aborted
+ *          -5: no memory
+ */
+int ec20_file_read(struct at_device *device, const char *name, rt_size_t offset, rt_size_t block_size,
+                   ec20_file_sink_t sink, void *user_data)
+{
+    int handle = -1, result = RT_EOK;
+    rt_size_t total = 0, len = 0;
+    char *buf = RT_NULL;
+    at_response_t resp = RT_NULL;
+    struct at_device_ec20 *ec20 = (struct at_device_ec20 *) device->user_data;
+
+    RT_ASSERT(name);
+    RT_ASSERT(sink);
+    RT_ASSERT(block_size > 0);
+
+    buf = (char *) rt_malloc(block_size);
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(5000));
+    if (buf == RT_NULL || resp == RT_NULL)
+    {
+        LOG_E("no memory for file read buffer create.");
+        result = -RT_ENOMEM;
+        goto __exit;
+    }
+
+    /* open the existing file read only */
+    at_device_sched_take(device, AT_DEVICE_CMD_BACKGROUND, RT_WAITING_FOREVER);
+    if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QFOPEN=\"%s\",2", name) < 0 ||
+            at_resp_parse_line_args_by_kw(resp, "+QFOPEN:", "+QFOPEN: %d", &handle) <= 0 ||
+            (offset > 0 && at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QFSEEK=%d,%d,0",
+                                           handle, (int) offset) < 0))
+    {
+        at_device_sched_release(device);
+        LOG_E("%s device open file(%s) failed.", device->name, name);
+        result = -RT_ERROR;
+        goto __exit;
+    }
+    at_device_sched_release(device);
+
+    while (1)
+    {
+        /* the other commands go between the blocks */
+        at_device_sched_take(device, AT_DEVICE_CMD_BACKGROUND, RT_WAITING_FOREVER);
+        ec20->xfer_buf = buf;
+        ec20->xfer_buf_size = block_size;
+        ec20->xfer_len = 0;
+        result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QFREAD=%d,%d", handle, (int) block_size);
+        ec20->xfer_buf = RT_NULL;
+        len = ec20->xfer_len;
+        at_device_sched_release(device);
+
+        if (result < 0)
+        {
+            LOG_E("%s device read file(%s) failed.", device->name, name);
+            result = -RT_ERROR;
+            break;
+        }
+
+        /* "CONNECT 0" is the end of file */
+        if (len == 0)
+        {
+            break;
+        }
+
+        if (sink(user_data, buf, len) < 0)
+        {
+            LOG_W("%s device read file(%s) aborted at %d.", device->name, name, offset + total);
+            result = -RT_ERROR;
+            break;
+        }
+        total += len;
+    }
+
+    at_device_sched_take(device, AT_DEVICE_CMD_BACKGROUND, RT_WAITING_FOREVER);
+    at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QFCLOSE=%d", handle);
+    at_device_sched_release(device);
+
+__exit:
+    if (buf)
+    {
+        rt_free(buf);
+    }
+
+    if (resp)
+    {
+        at_delete_resp(resp);
+    }
+
+    return result < 0 ? result : (int) total;
+}
+
+/**
+ * open the module UFS file for the staging writes, the file with the same
+ * name is replaced.
+ *
+ * @param device the AT device
+ * @param name the file name
+ *
+ * @return >=0: the file handle
+ *          -1: send AT commands error
+ *          -5: no memory
+ */
+int ec20_file_open(struct at_device *device, const char *name)
+{
+    int handle = -1, result = RT_EOK;
+    at_response_t resp = RT_NULL;
+
+    RT_ASSERT(name);
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(5000));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    /* create the file or clear the existing one */
+    at_device_sched_take(device, AT_DEVICE_CMD_BACKGROUND, RT_WAITING_FOREVER);
+    if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QFOPEN=\"%s\",1", name) < 0 ||
+            at_resp_parse_line_args_by_kw(resp, "+QFOPEN:", "+QFOPEN: %d", &handle) <= 0)
+    {
+        LOG_E("%s device open file(%s) failed.", device->name, name);
+        result = -RT_ERROR;
+    }
+    at_device_sched_release(device);
+
+    at_delete_resp(resp);
+
+    return result < 0 ? result : handle;
+}
+
+/**
+ * append the data to the opened module UFS file in blocks, the device is put
+ * back between the blocks, so the socket data goes first. The data buffer can
+ * be freed after return.
+ *
+ * @param device the AT device
+ * @param handle the file handle
+ * @param data the data
+ * @param size the data size
+ *
+ * @return  0: append success
+ *         -1: send AT commands error or the written size error
+ *         -5: no memory
+ */
+int ec20_file_append(struct at_device *device, int handle, const char *data, rt_size_t size)
+{
+    int result = RT_EOK, written = 0;
+    rt_size_t len = 0, pos = 0;
+    at_response_t resp = RT_NULL;
+
+    RT_ASSERT(data);
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(5000));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    for (pos = 0; pos < size; pos += len)
+    {
+        len = (size - pos) > EC20_FILE_BLOCK_SIZE ? EC20_FILE_BLOCK_SIZE : (size - pos);
+
+        /* +QFWRITE: <written_length>,<total_length> */
+        at_device_sched_take(device, AT_DEVICE_CMD_BACKGROUND, RT_WAITING_FOREVER);
+        written = 0;
+        result = ec20_file_xfer_write(device, resp, (EC20_FILE_INPUT_TIME(len) + 5) * 1000, data + pos, len,
+                                      "AT+QFWRITE=%d,%d,%d", handle, (int) len, EC20_FILE_INPUT_TIME(len));
+        if (result == 0)
+        {
+            at_resp_parse_line_args_by_kw(resp, "+QFWRITE:", "+QFWRITE: %d", &written);
+        }
+        at_device_sched_release(device);
+
+        if (result < 0 || written != (int) len)
+        {
+            LOG_E("%s device write file(%d) failed.", device->name, handle);
+            result = -RT_ERROR;
+            break;
+        }
+    }
+
+    at_delete_resp(resp);
+
+    return result;
+}
+
+/**
+ * close the opened module UFS file.
+ *
+ * @param device the AT device
+ * @param handle the file handle
+ *
+ * @return  0: close success
+ *         -1: send AT commands error
+ *         -5: no memory
+ */
+int ec20_file_close(struct at_device *device, int handle)
+{
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    at_device_sched_take(device, AT_DEVICE_CMD_BACKGROUND, RT_WAITING_FOREVER);
+    result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QFCLOSE=%d", handle);
+    at_device_sched_release(device);
+
+    at_delete_resp(resp);
+
+    return result;
+}
+
+/**
+ * write the module UFS file in blocks taken from the source, the file with the
+ * same name is replaced, only one block is buffered.
+ *
+ * @param device the AT device
+ * @param name the file name
+ * @param block_size the block size
+ * @param source the block source
+ * @param user_data the source user data
+ *
+ * @return >=0: the size of written
+ *          -1: send AT commands error or the source failed
+ *          -5: no memory
+ */
+int ec20_file_write(struct at_device *device, const char *name, rt_size_t block_size,
+                    ec20_file_source_t source, void *user_data)
+{
+    int handle = -1, result = RT_EOK, len = 0;
+    rt_size_t total = 0;
+    char *buf = RT_NULL;
+
+    RT_ASSERT(source);
+    RT_ASSERT(block_size > 0);
+
+    buf = (char *) rt_malloc(block_size);
+    if (buf == RT_NULL)
+    {
+        LOG_E("no memory for file write buffer create.");
+        return -RT_ENOMEM;
+    }
+
+    handle = ec20_file_open(device, name);
+    if (handle < 0)
+    {
+        rt_free(buf);
+        return handle;
+    }
+
+    while (1)
+    {
+        /* the source is called without the device taken */
+        len = source(user_data, buf, block_size);
+        if (len <= 0)
+        {
+            result = (len < 0) ? -RT_ERROR : RT_EOK;
+            break;
+        }
+
+        result = ec20_file_append(device, handle, buf, len);
+        if (result < 0)
+        {
+            break;
+        }
+        total += len;
+    }
+
+    ec20_file_close(device, handle);
+    rt_free(buf);
+
+    return result < 0 ? result : (int) total;
+}
+
+/**
+ * delete the module UFS file.
+ *
+ * @param device the AT device
+ * @param name the file name
+ *
+ * @return  0: delete success
+ *         -1: send AT commands error
+ *         -5: no memory
+ */
+int ec20_file_delete(struct at_device *device, const char *name)
+{
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+
+    RT_ASSERT(name);
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    at_device_sched_take(device, AT_DEVICE_CMD_BACKGROUND, RT_WAITING_FOREVER);
+    result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QFDEL=\"%s\"", name);
+    at_device_sched_release(device);
+
+    at_delete_resp(resp);
+
+    return result;
+}
+
+/* "CONNECT <length>": read the following raw data, the data written after "CONNECT" is sent by the caller */
+static void urc_xfer_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    rt_int32_t timeout;
+    rt_size_t len = 0, temp_size = 0;
+    char temp[8] = {0};
+    struct at_device *device = RT_NULL;
+    struct at_device_ec20 *ec20 = RT_NULL;
+    struct at_device_parser parser;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_socket_get_device(client);
+    if (device == RT_NULL)
+    {
+        return;
+    }
+    ec20 = (struct at_device_ec20 *) device->user_data;
+
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "CONNECT") < 0)
+    {
+        return;
+    }
+
+    if (at_device_parser_size(&parser, &len) < 0)
+    {
+        return;
+    }
+
+    /* set receive timeout by receive buffer length, not less than 10 ms */
+    timeout = len > 10 ? len : 10;
+
+    if (ec20->xfer_buf && len <= ec20->xfer_buf_size)
+    {
+        ec20->xfer_len = at_client_obj_recv(client, ec20->xfer_buf, len, timeout);
+        return;
+    }
+
+    /* no reader, read and clean the coming data */
+    LOG_E("%s device drop the file data(%d).", device->name, len);
+    while (temp_size < len)
+    {
+        if (len - temp_size > sizeof(temp))
+        {
+            at_client_obj_recv(client, temp, sizeof(temp), timeout);
+        }
+        else
+        {
+            at_client_obj_recv(client, temp, len - temp_size, timeout);
+        }
+        temp_size += sizeof(temp);
+    }
+}
+
+/* the module application result URC, "+<name>: <err>[,<value>[,<value>]]" */
+void ec20_urc_app_result(struct at_client *client, const char *data, rt_size_t size)
+{
+    int i = 0, value = 0;
+    struct at_device *device = RT_NULL;
+    struct at_device_ec20 *ec20 = RT_NULL;
+    struct at_device_parser parser;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_socket_get_device(client);
+    if (device == RT_NULL)
+    {
+        return;
+    }
+    ec20 = (struct at_device_ec20 *) device->user_data;
+
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_skip_to(&parser, ':') < 0)
+    {
+        return;
+    }
+
+    rt_memset(ec20->app_result, 0x00, sizeof(ec20->app_result));
+    for (i = 0; i < sizeof(ec20->app_result) / sizeof(ec20->app_result[0]); i++)
+    {
+        if (at_device_parser_int(&parser, &value) < 0)
+        {
+            break;
+        }
+        ec20->app_result[i] = value;
+    }
+
+    at_device_socket_event_send(device, AT_DEVICE_SOCKET_EVENT_APP_OK);
+}
+
+static const struct at_urc file_urc_table[] =
+{
+    {"CONNECT ",    "\r\n",                 urc_xfer_func},
+};
+
+/* register the file URC to the control client, the data call "CONNECT" is on the other channel */
+int ec20_file_init(struct at_device *device)
+{
+    struct at_device_ec20 *ec20 = RT_NULL;
+
+    RT_ASSERT(device);
+
+    /* the HTTP(S) and FTP(S) commands are serialized, so one result URC is waited at a time */
+    ec20 = (struct at_device_ec20 *) device->user_data;
+    if (ec20->app_lock == RT_NULL)
+    {
+        ec20->app_lock = rt_mutex_create("ec20_app", RT_IPC_FLAG_PRIO);
+        if (ec20->app_lock == RT_NULL)
+        {
+            LOG_E("no memory for %s device application lock create.", device->name);
+            return -RT_ENOMEM;
+        }
+    }
+
+    return at_device_urc_set_table(AT_DEVICE_CTRL_CLIENT(device), file_urc_table,
+                                sizeof(file_urc_table) / sizeof(file_urc_table[0]));
+}
+
+#endif /* AT_DEVICE_USING_EC20 && AT_USING_SOCKET */
@@ -0,0 +1,751 @@
+/*
+ * File      : at_ftp_ec20.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <at_device_ec20.h>
+#include <at_device_urc.h>
+#include <at_device_socket.h>
+#include <at_device_parser.h>
+#include <at_device_sched.h>
+
+#ifdef RT_USING_DFS
+#include <dfs_posix.h>
+#endif
+
+#define LOG_TAG                        "at.ftp.ec20"
+#include <at_log.h>
+
+#if defined(AT_DEVICE_USING_EC20) && defined(AT_USING_SOCKET) && defined(EC20_USING_FTP)
+
+/* the file is staged in the module UFS between the server and the MCU */
+#define EC20_FTP_STAGE_FILE            "ftp_xfer.dat"
+
+#ifndef EC20_FTP_BLOCK_SIZE
+#define EC20_FTP_BLOCK_SIZE            4096
+#endif
+
+/* the default on-module transfer timeout in second */
+#ifndef EC20_FTP_TIMEOUT
+#define EC20_FTP_TIMEOUT               600
+#endif
+
+/* the FTP(S) command response timeout in second, it is also the module server response timeout */
+#define EC20_FTP_RSP_TIMEOUT           90
+
+static void at_ftp_errcode_parse(int result)//FTP
+{
+    switch(result)
+    {
+    case 0   : LOG_D("%d : Operation successful",         result); break;
+    case 601 : LOG_E("%d : Unknown error",                result); break;
+    case 602 : LOG_E("%d : FTP(S) server blocked",        result); break;
+    case 603 : LOG_E("%d : FTP(S) server busy",           result); break;
+    case 604 : LOG_E("%d : DNS parse failed",             result); break;
+    case 605 : LOG_E("%d : Network error",                result); break;
+    case 606 : LOG_E("%d : Control connection closed.",   result); break;
+    case 607 : LOG_E("%d : Data connection closed",       result); break;
+    case 608 : LOG_E("%d : Socket closed by peer",        result); break;
+    case 609 : LOG_E("%d : Timeout error",                result); break;
+    case 610 : LOG_E("%d : Invalid parameter",            result); break;
+    case 611 : LOG_E("%d : Failed to open file",          result); break;
+    case 612 : LOG_E("%d : File position invalid",        result); break;
+    case 613 : LOG_E("%d : File error",                   result); break;
+    case 614 : LOG_E("%d : Service not available, closing control connection", result); break;
+    case 615 : LOG_E("%d : Open data connection failed",  result); break;
+    case 616 : LOG_E("%d : Connection closed; transfer aborted", result); break;
+    case 617 : LOG_E("%d : Requested file action not taken", result); break;
+    case 618 : LOG_E("%d : Requested action aborted: local error in processing", result); break;
+    case 619 : LOG_E("%d : Requested action not taken: insufficient system storage", result); break;
+    case 620 : LOG_E("%d : Syntax error, command unrecognized", result); break;
+    case 621 : LOG_E("%d : Syntax error in parameters or arguments", result); break;
+    case 622 : LOG_E("%d : Command not implemented",      result); break;
+    case 623 : LOG_E("%d : Bad sequence of commands",     result); break;
+    case 624 : LOG_E("%d : Command parameter not implemented", result); break;
+    case 625 : LOG_E("%d : Not logged in",                result); break;
+    case 626 : LOG_E("%d : Need account for storing files", result); break;
+    case 627 : LOG_E("%d : Requested action not taken",   result); break;
+    case 628 : LOG_E("%d : Requested action aborted: page type unknown", result); break;
+    case 629 : LOG_E("%d : Requested file action aborted", result); break;
+    case 630 : LOG_E("%d : Requested file name invalid",  result); break;
+    case 631 : LOG_E("%d : SSL authentication failed",    result); break;
+    default  : LOG_E("%d : Unknown err code",             result); break;
+    }
+}
+
+static void at_ftp_protocol_errcode_parse(int result)//FTP_Protocol
+{
+    switch(result)
+    {
+    case 421 : LOG_E("%d : Service not available, closing control connection", result); break;
+    case 425 : LOG_E("%d : Open data connection failed",  result); break;
+    case 426 : LOG_E("%d : Connection closed; transfer aborted", result); break;
+    case 450 : LOG_E("%d : Requested file action not taken", result); break;
+    case 451 : LOG_E("%d : Requested action aborted: local error in processing", result); break;
+    case 452 : LOG_E("%d : Requested action not taken: insufficient system storage", result); break;
+    case 500 : LOG_E("%d : Syntax error, command unrecognized", result); break;
+    case 501 : LOG_E("%d : Syntax error in parameters or arguments", result); break;
+    case 502 : LOG_E("%d : Command not implemented",      result); break;
+    case 503 : LOG_E("%d : Bad sequence of commands",     result); break;
+    case 504 : LOG_E("%d : Command parameter not implemented", result); break;
+    case 530 : LOG_E("%d : Not logged in",                result); break;
+    case 532 : LOG_E("%d : Need account for storing files", result); break;
+    case 550 : LOG_E("%d : Requested action not taken: file unavailable", result); break;
+    case 551 : LOG_E("%d : Requested action aborted: page type unknown", result); break;
+    case 552 : LOG_E("%d : Requested file action aborted: exceeded storage allocation", result); break;
+    case 553 : LOG_E("%d : Requested action not taken: file name not allowed", result); break;
+    default  : LOG_E("%d : Unknown err code",             result); break;
+    }
+}
+
+/* the block transfer state between the module UFS and the MCU */
+struct ec20_ftp_stream
+{
+    const struct ec20_ftp_xfer *xfer;
+    ec20_file_sink_t sink;
+    ec20_file_source_t source;
+    void *user_data;
+    rt_size_t done;
+    rt_size_t total;
+    rt_tick_t start;
+};
+
+/* the transfer rate in byte per second since the start tick */
+static rt_uint32_t ec20_ftp_rate(rt_size_t done, rt_tick_t start)
+{
+    rt_tick_t ticks = rt_tick_get() - start;
+
+    return ticks ? (rt_uint32_t) ((rt_uint64_t) done * RT_TICK_PER_SECOND / ticks) : 0;
+}
+
+static void ec20_ftp_progress(const struct ec20_ftp_xfer *xfer, int phase, rt_size_t done, rt_size_t total, rt_tick_t start)
+{
+    if (xfer && xfer->progress)
+    {
+        xfer->progress(xfer->user_data, phase, done, total, ec20_ftp_rate(done, start));
+    }
+}
+
+/**
+ * wait for the result URC of the FTP(S) command sent, the device is not taken
+ * during waiting. The on-module transferred length is polled for the progress
+ * if the transfer is given.
+ *
+ * @param device the AT device
+ * @param xfer the transfer for the progress, RT_NULL: no progress
+ * @param total the transfer total size for the progress
+ * @param timeout the waiting time in second
+ *
+ * @return  0: the command success
+ *         -1: the command failed
+ *         -2: wait result timeout
+ */
+static int ec20_ftp_wait_result(struct at_device *device, const struct ec20_ftp_xfer *xfer, rt_size_t total, rt_int32_t timeout)
+{
+    rt_tick_t start = rt_tick_get();
+    at_response_t resp = RT_NULL;
+    struct at_device_ec20 *ec20 = (struct at_device_ec20 *) device->user_data;
+
+    if (xfer && xfer->progress)
+    {
+        resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    }
+
+    ec20->ftp_done = 0;
+    while (at_device_socket_event_recv(device, AT_DEVICE_SOCKET_EVENT_APP_OK,
+                                       RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
+    {
+        if (rt_tick_get() - start >= (rt_tick_t) timeout * RT_TICK_PER_SECOND)
+        {
+            LOG_E("%s device wait FTP(S) result timeout.", device->name);
+            if (resp)
+            {
+                at_delete_resp(resp);
+            }
+            return -RT_ETIMEOUT;
+        }
+
+        if (resp == RT_NULL)
+        {
+            continue;
+        }
+
+        /* the length is reported by "+QFTPLEN" URC, the last one is used */
+        ec20_ftp_progress(xfer, EC20_FTP_PHASE_REMOTE, ec20->ftp_done, total, start);
+        at_device_sched_take(device, AT_DEVICE_CMD_BACKGROUND, RT_WAITING_FOREVER);
+        at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QFTPLEN");
+        at_device_sched_release(device);
+    }
+
+    if (resp)
+    {
+        at_delete_resp(resp);
+    }
+
+    /* +QFTP<cmd>: <err>,<protocol_error> */
+    if (ec20->app_result[0] != 0)
+    {
+        at_ftp_errcode_parse(ec20->app_result[0]);
+        if (ec20->app_result[1] > 0)
+        {
+            at_ftp_protocol_errcode_parse(ec20->app_result[1]);
+        }
+        return -RT_ERROR;
+    }
+
+    return RT_EOK;
+}
+
+/**
+ * open the FTP(S) session, the module keeps one session at the same time.
+ *
+ * @param device the AT device
+ * @param server the FTP(S) server
+ *
+ * @return  0: open success
+ *         -1: send AT commands error or open failed
+ *         -2: wait result timeout
+ *         -5: no memory
+ */
+int ec20_ftp_open(struct at_device *device, const struct ec20_ftp_server *server)
+{
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+    struct at_device_ec20 *ec20 = (struct at_device_ec20 *) device->user_data;
+
+    RT_ASSERT(server && server->host);
+
+    if (ec20->app_lock == RT_NULL)
+    {
+        LOG_E("%s device FTP(S) client is not initialized.", device->name);
+        return -RT_ERROR;
+    }
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    rt_mutex_take(ec20->app_lock, RT_WAITING_FOREVER);
+    at_device_sched_take(device, AT_DEVICE_CMD_BACKGROUND, RT_WAITING_FOREVER);
+
+    /* binary file type and passive mode */
+    if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QFTPCFG=\"contextid\",1") < 0 ||
+            at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QFTPCFG=\"account\",\"%s\",\"%s\"",
+                            server->user ? server->user : "anonymous", server->password ? server->password : "") < 0 ||
+            at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QFTPCFG=\"filetype\",0") < 0 ||
+            at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QFTPCFG=\"transmode\",1") < 0 ||
+            at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QFTPCFG=\"rsptimeout\",%d", EC20_FTP_RSP_TIMEOUT) < 0 ||
+            at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QFTPCFG=\"ssltype\",%d", server->tls ? 2 : 0) < 0)
+    {
+        result = -RT_ERROR;
+        goto __release;
+    }
+
+    if (server->tls &&
+            (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QFTPCFG=\"sslctxid\",%d", EC20_APP_SSL_CTX) < 0 ||
+             ec20_ssl_config(device, EC20_APP_SSL_CTX, server->tls) < 0))
+    {
+        result = -RT_ERROR;
+        goto __release;
+    }
+
+    /* clear the result event */
+    at_device_socket_event_recv(device, AT_DEVICE_SOCKET_EVENT_APP_OK, 0, RT_EVENT_FLAG_OR);
+    result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QFTPOPEN=\"%s\",%d",
+                             server->host, server->port > 0 ? server->port : 21);
+
+__release:
+    at_device_sched_release(device);
+
+    if (result < 0 || ec20_ftp_wait_result(device, RT_NULL, 0, EC20_FTP_RSP_TIMEOUT + 5) < 0)
+    {
+        LOG_E("%s device open FTP(S) server(%s) failed.", device->name, server->host);
+        result = -RT_ERROR;
+    }
+
+    rt_mutex_release(ec20->app_lock);
+    at_delete_resp(resp);
+
+    return result;
+}
+
+/**
+ * change the current directory of the FTP(S) session.
+ *
+ * @param device the AT device
+ * @param dir the remote directory
+ *
+ * @return  0: change success
+ *         -1: send AT commands error or change failed
+ *         -2: wait result timeout
+ *         -5: no memory
+ */
+int ec20_ftp_cwd(struct at_device *device, const char *dir)
+{
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+    struct at_device_ec20 *ec20 = (struct at_device_ec20 *) device->user_data;
+
+    RT_ASSERT(dir);
+    RT_ASSERT(ec20->app_lock);
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    rt_mutex_take(ec20->app_lock, RT_WAITING_FOREVER);
+    at_device_sched_take(device, AT_DEVICE_CMD_BACKGROUND, RT_WAITING_FOREVER);
+    at_device_socket_event_recv(device, AT_DEVICE_SOCKET_EVENT_APP_OK, 0, RT_EVENT_FLAG_OR);
+    result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QFTPCWD=\"%s\"", dir);
+    at_device_sched_release(device);
+
+    if (result < 0 || ec20_ftp_wait_result(device, RT_NULL, 0, EC20_FTP_RSP_TIMEOUT + 5) < 0)
+    {
+        LOG_E("%s device change FTP(S) directory(%s) failed.", device->name, dir);
+        result = -RT_ERROR;
+    }
+
+    rt_mutex_release(ec20->app_lock);
+    at_delete_resp(resp);
+
+    return result;
+}
+
+/**
+ * close the FTP(S) session.
+ *
+ * @param device the AT device
+ *
+ * @return  0: close success
+ *         -1: send AT commands error or close failed
+ *         -2: wait result timeout
+ *         -5: no memory
+ */
+int ec20_ftp_close(struct at_device *device)
+{
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+    struct at_device_ec20 *ec20 = (struct at_device_ec20 *) device->user_data;
+
+    RT_ASSERT(ec20->app_lock);
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    rt_mutex_take(ec20->app_lock, RT_WAITING_FOREVER);
+    at_device_sched_take(device, AT_DEVICE_CMD_BACKGROUND, RT_WAITING_FOREVER);
+    at_device_socket_event_recv(device, AT_DEVICE_SOCKET_EVENT_APP_OK, 0, RT_EVENT_FLAG_OR);
+    result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QFTPCLOSE");
+    at_device_sched_release(device);
+
+    if (result < 0 || ec20_ftp_wait_result(device, RT_NULL, 0, EC20_FTP_RSP_TIMEOUT + 5) < 0)
+    {
+        result = -RT_ERROR;
+    }
+
+    rt_mutex_release(ec20->app_lock);
+    at_delete_resp(resp);
+
+    return result;
+}
+
+static int ec20_ftp_sink(void *user_data, const char *data, rt_size_t size)
+{
+    struct ec20_ftp_stream *stream = (struct ec20_ftp_stream *) user_data;
+
+    if (stream->sink(stream->user_data, data, size) < 0)
+    {
+        return -RT_ERROR;
+    }
+
+    stream->done += size;
+    ec20_ftp_progress(stream->xfer, EC20_FTP_PHASE_LOCAL, stream->done, stream->total, stream->start);
+
+    return RT_EOK;
+}
+
+static int ec20_ftp_source(void *user_data, char *buf, rt_size_t size)
+{
+    int len = 0;
+    struct ec20_ftp_stream *stream = (struct ec20_ftp_stream *) user_data;
+
+    len = stream->source(stream->user_data, buf, size);
+    if (len > 0)
+    {
+        stream->done += len;
+        ec20_ftp_progress(stream->xfer, EC20_FTP_PHASE_LOCAL, stream->done, stream->total, stream->start);
+    }
+
+    return len;
+}
+
+/**
+ * download the remote file, it is downloaded to the module UFS on module
+ * first, then streamed to the sink over the UART in blocks.
+ *
+ * @param device the AT device
+ * @param xfer the transfer
+ * @param sink the file block sink
+ * @param sink_data the sink user data
+ *
+ * @return >=0: the file size
+ *          -1: send AT commands error, transfer failed or the sink aborted
+ *          -2: wait result timeout
+ *          -5: no memory
+ */
+int ec20_ftp_get(struct at_device *device, const struct ec20_ftp_xfer *xfer, ec20_file_sink_t sink, void *sink_data)
+{
+    int result = RT_EOK;
+    rt_size_t total = 0;
+    at_response_t resp = RT_NULL;
+    struct ec20_ftp_stream stream = {0};
+    struct at_device_ec20 *ec20 = (struct at_device_ec20 *) device->user_data;
+
+    RT_ASSERT(xfer && xfer->remote);
+    RT_ASSERT(sink);
+    RT_ASSERT(ec20->app_lock);
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    rt_mutex_take(ec20->app_lock, RT_WAITING_FOREVER);
+
+    /* +QFTPSIZE: <err>,<file_size> */
+    at_device_sched_take(device, AT_DEVICE_CMD_BACKGROUND, RT_WAITING_FOREVER);
+    at_device_socket_event_recv(device, AT_DEVICE_SOCKET_EVENT_APP_OK, 0, RT_EVENT_FLAG_OR);
+    result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QFTPSIZE=\"%s\"", xfer->remote);
+    at_device_sched_release(device);
+    if (result < 0 || ec20_ftp_wait_result(device, RT_NULL, 0, EC20_FTP_RSP_TIMEOUT + 5) < 0)
+    {
+        LOG_E("%s device get FTP(S) file(%s) size failed.", device->name, xfer->remote);
+        result = -RT_ERROR;
+        goto __exit;
+    }
+    total = (rt_size_t) ec20->app_result[1];
+
+    /* +QFTPGET: <err>,<transferlen> */
+    stream.start = rt_tick_get();
+    at_device_sched_take(device, AT_DEVICE_CMD_BACKGROUND, RT_WAITING_FOREVER);
+    at_device_socket_event_recv(device, AT_DEVICE_SOCKET_EVENT_APP_OK, 0, RT_EVENT_FLAG_OR);
+    result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QFTPGET=\"%s\",\"UFS:%s\"",
+                             xfer->remote, EC20_FTP_STAGE_FILE);
+    at_device_sched_release(device);
+    if (result < 0 || ec20_ftp_wait_result(device, xfer, total,
+                                           xfer->timeout > 0 ? xfer->timeout : EC20_FTP_TIMEOUT) < 0)
+    {
+        LOG_E("%s device get FTP(S) file(%s) failed.", device->name, xfer->remote);
+        result = -RT_ERROR;
+        goto __delete;
+    }
+    total = (rt_size_t) ec20->app_result[1];
+    ec20_ftp_progress(xfer, EC20_FTP_PHASE_REMOTE, total, total, stream.start);
+    LOG_D("%s device FTP(S) file(%s) downloaded %d bytes, %d B/s.", device->name, xfer->remote,
+          total, ec20_ftp_rate(total, stream.start));
+
+    stream.xfer = xfer;
+    stream.sink = sink;
+    stream.user_data = sink_data;
+    stream.total = total;
+    stream.start = rt_tick_get();
+    result = ec20_file_read(device, EC20_FTP_STAGE_FILE, 0,
+                            xfer->block_size > 0 ? xfer->block_size : EC20_FTP_BLOCK_SIZE, ec20_ftp_sink, &stream);
+    if (result >= 0)
+    {
+        LOG_D("%s device FTP(S) file(%s) read %d bytes, %d B/s.", device->name, xfer->remote,
+              result, ec20_ftp_rate(result, stream.start));
+    }
+
+__delete:
+    ec20_file_delete(device, EC20_FTP_STAGE_FILE);
+
+__exit:
+    rt_mutex_release(ec20->app_lock);
+    at_delete_resp(resp);
+
+    return result;
+}
+
+/* upload the module UFS file on module, total is 0 if the size is unknown */
+static int ec20_ftp_put_ufs(struct at_device *device, const struct ec20_ftp_xfer *xfer, const char *name, rt_size_t total)
+{
+    int result = RT_EOK;
+    rt_tick_t start = rt_tick_get();
+    at_response_t resp = RT_NULL;
+    struct at_device_ec20 *ec20 = (struct at_device_ec20 *) device->user_data;
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    /* +QFTPPUT: <err>,<transferlen> */
+    at_device_sched_take(device, AT_DEVICE_CMD_BACKGROUND, RT_WAITING_FOREVER);
+    at_device_socket_event_recv(device, AT_DEVICE_SOCKET_EVENT_APP_OK, 0, RT_EVENT_FLAG_OR);
+    result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QFTPPUT=\"%s\",\"UFS:%s\",0",
+                             xfer->remote, name);
+    at_device_sched_release(device);
+    at_delete_resp(resp);
+
+    if (result < 0 || ec20_ftp_wait_result(device, xfer, total,
+                                           xfer->timeout > 0 ? xfer->timeout : EC20_FTP_TIMEOUT) < 0 ||
+            (total > 0 && (rt_size_t) ec20->app_result[1] != total))
+    {
+        LOG_E("%s device put FTP(S) file(%s) failed.", device->name, xfer->remote);
+        return -RT_ERROR;
+    }
+
+    total = (rt_size_t) ec20->app_result[1];
+    ec20_ftp_progress(xfer, EC20_FTP_PHASE_REMOTE, total, total, start);
+    LOG_D("%s device FTP(S) file(%s) uploaded %d bytes, %d B/s.", device->name, xfer->remote,
+          total, ec20_ftp_rate(total, start));
+
+    return (int) total;
+}
+
+/**
+ * upload the file to the server, the blocks from the source are written to
+ * the module UFS over the UART first, then uploaded on module.
+ *
+ * @param device the AT device
+ * @param xfer the transfer
+ * @param size the file size for the progress, 0: unknown
+ * @param source the file block source
+ * @param source_data the source user data
+ *
+ * @return >=0: the file size
+ *          -1: send AT commands error, transfer failed or the source failed
+ *          -2: wait result timeout
+ *          -5: no memory
+ */
+int ec20_ftp_put(struct at_device *device, const struct ec20_ftp_xfer *xfer, rt_size_t size,
+                 ec20_file_source_t source, void *source_data)
+{
+    int result = RT_EOK;
+    struct ec20_ftp_stream stream = {0};
+    struct at_device_ec20 *ec20 = (struct at_device_ec20 *) device->user_data;
+
+    RT_ASSERT(xfer && xfer->remote);
+    RT_ASSERT(source);
+    RT_ASSERT(ec20->app_lock);
+
+    rt_mutex_take(ec20->app_lock, RT_WAITING_FOREVER);
+
+    stream.xfer = xfer;
+    stream.source = source;
+    stream.user_data = source_data;
+    stream.total = size;
+    stream.start = rt_tick_get();
+    result = ec20_file_write(device, EC20_FTP_STAGE_FILE,
+                             xfer->block_size > 0 ? xfer->block_size : EC20_FTP_BLOCK_SIZE, ec20_ftp_source, &stream);
+    if (result < 0)
+    {
+        LOG_E("%s device write FTP(S) file(%s) failed.", device->name, xfer->remote);
+        goto __delete;
+    }
+    LOG_D("%s device FTP(S) file(%s) written %d bytes, %d B/s.", device->name, xfer->remote,
+          result, ec20_ftp_rate(result, stream.start));
+
+    result = ec20_ftp_put_ufs(device, xfer, EC20_FTP_STAGE_FILE, (rt_size_t) result);
+
+__delete:
+    ec20_file_delete(device, EC20_FTP_STAGE_FILE);
+
+    rt_mutex_release(ec20->app_lock);
+
+    return result;
+}
+
+/**
+ * upload the file staged in the module UFS by ec20_file_open/append/close,
+ * the staged file is kept after upload.
+ *
+ * @param device the AT device
+ * @param xfer the transfer
+ * @param name the staged UFS file name
+ *
+ * @return >=0: the file size
+ *          -1: send AT commands error or transfer failed
+ *          -2: wait result timeout
+ *          -5: no memory
+ */
+int ec20_ftp_put_staged(struct at_device *device, const struct ec20_ftp_xfer *xfer, const char *name)
+{
+    int result = RT_EOK;
+    struct at_device_ec20 *ec20 = (struct at_device_ec20 *) device->user_data;
+
+    RT_ASSERT(xfer && xfer->remote);
+    RT_ASSERT(name);
+    RT_ASSERT(ec20->app_lock);
+
+    rt_mutex_take(ec20->app_lock, RT_WAITING_FOREVER);
+    result = ec20_ftp_put_ufs(device, xfer, name, 0);
+    rt_mutex_release(ec20->app_lock);
+
+    return result;
+}
+
+#ifdef RT_USING_DFS
+static int ec20_ftp_file_sink(void *user_data, const char *data, rt_size_t size)
+{
+    int fd = (int) (rt_ubase_t) user_data;
+
+    return (write(fd, data, size) == (int) size) ? RT_EOK : -RT_ERROR;
+}
+
+static int ec20_ftp_file_source(void *user_data, char *buf, rt_size_t size)
+{
+    int fd = (int) (rt_ubase_t) user_data;
+
+    return read(fd, buf, size);
+}
+
+/**
+ * download the remote file to the DFS file, the local file is replaced.
+ *
+ * @param device the AT device
+ * @param xfer the transfer
+ * @param path the DFS file path
+ *
+ * @return >=0: the file size
+ *          -1: open the DFS file failed or transfer failed
+ *          -2: wait result timeout
+ *          -5: no memory
+ */
+int ec20_ftp_get_file(struct at_device *device, const struct ec20_ftp_xfer *xfer, const char *path)
+{
+    int fd = -1, result = RT_EOK;
+
+    RT_ASSERT(path);
+
+    fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0);
+    if (fd < 0)
+    {
+        LOG_E("open file(%s) failed.", path);
+        return -RT_ERROR;
+    }
+
+    result = ec20_ftp_get(device, xfer, ec20_ftp_file_sink, (void *) (rt_ubase_t) fd);
+    close(fd);
+
+    return result;
+}
+
+/**
+ * upload the DFS file to the server.
+ *
+ * @param device the AT device
+ * @param xfer the transfer
+ * @param path the DFS file path
+ *
+ * @return >=0: the file size
+ *          -1: open the DFS file failed or transfer failed
+ *          -2: wait result timeout
+ *          -5: no memory
+ */
+int ec20_ftp_put_file(struct at_device *device, const struct ec20_ftp_xfer *xfer, const char *path)
+{
+    int fd = -1, result = RT_EOK;
+    struct stat file_stat;
+
+    RT_ASSERT(path);
+
+    fd = open(path, O_RDONLY, 0);
+    if (fd < 0 || stat(path, &file_stat) < 0)
+    {
+        LOG_E("open file(%s) failed.", path);
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        return -RT_ERROR;
+    }
+
+    result = ec20_ftp_put(device, xfer, (rt_size_t) file_stat.st_size, ec20_ftp_file_source, (void *) (rt_ubase_t) fd);
+    close(fd);
+
+    return result;
+}
+#endif /* RT_USING_DFS */
+
+/* +QFTPLEN: <err>,<transferlen> */
+static void urc_ftp_len_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    int err = 0, len = 0;
+    struct at_device *device = RT_NULL;
+    struct at_device_parser parser;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_socket_get_device(client);
+    if (device == RT_NULL)
+    {
+        return;
+    }
+
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+QFTPLEN:") == 0 &&
+            at_device_parser_int(&parser, &err) == 0 && err == 0 &&
+            at_device_parser_int(&parser, &len) == 0)
+    {
+        ((struct at_device_ec20 *) device->user_data)->ftp_done = (rt_size_t) len;
+    }
+}
+
+static const struct at_urc ftp_urc_table[] =
+{
+    {"+QFTPOPEN:",       "\r\n",            ec20_urc_app_result},
+    {"+QFTPCLOSE:",      "\r\n",            ec20_urc_app_result},
+    {"+QFTPCWD:",        "\r\n",            ec20_urc_app_result},
+    {"+QFTPSIZE:",       "\r\n",            ec20_urc_app_result},
+    {"+QFTPGET:",        "\r\n",            ec20_urc_app_result},
+    {"+QFTPPUT:",        "\r\n",            ec20_urc_app_result},
+    {"+QFTPLEN:",        "\r\n",            urc_ftp_len_func},
+};
+
+int ec20_ftp_init(struct at_device *device)
+{
+    RT_ASSERT(device);
+
+    return at_device_urc_set_table(AT_DEVICE_CTRL_CLIENT(device), ftp_urc_table,
+                                sizeof(ftp_urc_table) / sizeof(ftp_urc_table[0]));
+}
+
+#endif /* AT_DEVICE_USING_EC20 && AT_USING_SOCKET && EC20_USING_FTP */
@@ -0,0 +1,420 @@
+/*
+ * File      : at_http_ec20.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <at_device_ec20.h>
+#include <at_device_urc.h>
+#include <at_device_socket.h>
+#include <at_device_parser.h>
+#include <at_device_sched.h>
+
+#define LOG_TAG                        "at.http.ec20"
+#include <at_log.h>
+
+#if defined(AT_DEVICE_USING_EC20) && defined(AT_USING_SOCKET) && defined(EC20_USING_HTTP)
+
+/* the response body is saved in the module UFS, then read in blocks */
+#define EC20_HTTP_BODY_FILE            "http_body.dat"
+
+#ifndef EC20_HTTP_BLOCK_SIZE
+#define EC20_HTTP_BLOCK_SIZE           1024
+#endif
+
+/* the default response time in second */
+#ifndef EC20_HTTP_TIMEOUT
+#define EC20_HTTP_TIMEOUT              60
+#endif
+
+/* the time in second the module waits for the URL, header or body input */
+#define EC20_HTTP_INPUT_TIME(size)     (5 + (int) ((size) / 10240))
+
+static void at_http_errcode_parse(int result)//HTTP
+{
+    switch(result)
+    {
+    case 0   : LOG_D("%d : Operation successful",         result); break;
+    case 701 : LOG_E("%d : HTTP(S) unknown error",        result); break;
+    case 702 : LOG_E("%d : HTTP(S) timeout",              result); break;
+    case 703 : LOG_E("%d : HTTP(S) busy",                 result); break;
+    case 704 : LOG_E("%d : HTTP(S) UART busy",            result); break;
+    case 705 : LOG_E("%d : HTTP(S) no GET/POST requests", result); break;
+    case 706 : LOG_E("%d : HTTP(S) network busy",         result); break;
+    case 707 : LOG_E("%d : HTTP(S) network open failed",  result); break;
+    case 708 : LOG_E("%d : HTTP(S) network no configuration", result); break;
+    case 709 : LOG_E("%d : HTTP(S) network deactivated",  result); break;
+    case 710 : LOG_E("%d : HTTP(S) network error",        result); break;
+    case 711 : LOG_E("%d : HTTP(S) URL error",            result); break;
+    case 712 : LOG_E("%d : HTTP(S) empty URL",            result); break;
+    case 713 : LOG_E("%d : HTTP(S) IP address error",     result); break;
+    case 714 : LOG_E("%d : HTTP(S) DNS error",            result); break;
+    case 715 : LOG_E("%d : HTTP(S) socket create error",  result); break;
+    case 716 : LOG_E("%d : HTTP(S) socket connect error", result); break;
+    case 717 : LOG_E("%d : HTTP(S) socket read error",    result); break;
+    case 718 : LOG_E("%d : HTTP(S) socket write error",   result); break;
+    case 719 : LOG_E("%d : HTTP(S) socket closed",        result); break;
+    case 720 : LOG_E("%d : HTTP(S) data encode error",    result); break;
+    case 721 : LOG_E("%d : HTTP(S) data decode error",    result); break;
+    case 722 : LOG_E("%d : HTTP(S) read timeout",         result); break;
+    case 723 : LOG_E("%d : HTTP(S) response failed",      result); break;
+    case 724 : LOG_E("%d : Incoming call busy",           result); break;
+    case 725 : LOG_E("%d : Voice call busy",              result); break;
+    case 726 : LOG_E("%d : Input timeout",                result); break;
+    case 727 : LOG_E("%d : Wait data timeout",            result); break;
+    case 728 : LOG_E("%d : Wait HTTP(S) response timeout", result); break;
+    case 729 : LOG_E("%d : Memory allocation failed",     result); break;
+    case 730 : LOG_E("%d : Invalid parameter",            result); break;
+    default  : LOG_E("%d : Unknown err code",             result); break;
+    }
+}
+
+static void at_http_rsponsecode_parse(int result)//HTTP
+{
+    switch(result)
+    {
+    case 200 : LOG_D("%d : OK",                           result); break;
+    case 206 : LOG_D("%d : Partial content",              result); break;
+    case 416 : LOG_E("%d : Range not satisfiable",        result); break;
+    case 400 : LOG_E("%d : Bad request",                  result); break;
+    case 403 : LOG_E("%d : Forbidden",                    result); break;
+    case 404 : LOG_E("%d : Not found",                    result); break;
+    case 409 : LOG_E("%d : Conflict",                     result); break;
+    case 411 : LOG_E("%d : Length required",              result); break;
+    case 500 : LOG_E("%d : Internal server error",        result); break;
+    case 502 : LOG_E("%d : Bad gate way",                 result); break;
+    default  : LOG_E("%d : Unknown err code",             result); break;
+    }
+}
+
+
+/* build the request header of the range request, the other fields are the module default */
+static char *ec20_http_range_header(const char *url, rt_size_t offset, rt_size_t *len)
+{
+    int host_len = 0, size = 0;
+    const char *host = RT_NULL, *path = RT_NULL;
+    char *header = RT_NULL;
+
+    host = strstr(url, "://");
+    host = host ? host + 3 : url;
+    path = strchr(host, '/');
+    host_len = path ? (int) (path - host) : (int) rt_strlen(host);
+    path = path ? path : "/";
+
+    size = rt_strlen(path) + host_len + 64;
+    header = (char *) rt_malloc(size);
+    if (header == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    *len = rt_snprintf(header, size, "GET %s HTTP/1.1\r\nHost: %.*s\r\nRange: bytes=%d-\r\n\r\n",
+                       path, host_len, host, (int) offset);
+
+    return header;
+}
+
+/* wait for the result URC of the request sent, the device is not taken during waiting */
+static int ec20_http_wait_result(struct at_device *device, rt_int32_t timeout)
+{
+    struct at_device_ec20 *ec20 = (struct at_device_ec20 *) device->user_data;
+
+    if (at_device_socket_event_recv(device, AT_DEVICE_SOCKET_EVENT_APP_OK,
+                                    (timeout + 5) * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
+    {
+        LOG_E("%s device wait HTTP(S) result timeout.", device->name);
+        return -RT_ETIMEOUT;
+    }
+
+    if (ec20->app_result[0] != 0)
+    {
+        at_http_errcode_parse(ec20->app_result[0]);
+        return -RT_ERROR;
+    }
+
+    return RT_EOK;
+}
+
+/**
+ * send the HTTP(S) request by the module HTTP(S) client, the response body is
+ * saved in the module UFS and streamed to the sink in blocks.
+ *
+ * @param device the AT device
+ * @param req the request
+ * @param body the POST body, RT_NULL: GET request
+ * @param size the POST body size
+ * @param file the staged UFS file of the POST body, RT_NULL: no file
+ * @param sink the body block sink, RT_NULL: drop the body
+ * @param user_data the sink user data
+ *
+ * @return >=0: the HTTP response code
+ *          -1: send AT commands error or request failed
+ *          -2: wait result timeout
+ *          -5: no memory
+ */
+static int ec20_http_request(struct at_device *device, const struct ec20_http_request *req, const char *body,
+                             rt_size_t size, const char *file, ec20_file_sink_t sink, void *user_data)
+{
+    static const struct at_device_tls_cfg tls_default = {0};
+    int result = RT_EOK, code = 0;
+    rt_int32_t timeout = 0;
+    rt_size_t header_len = 0;
+    char *header = RT_NULL;
+    at_response_t resp = RT_NULL;
+    struct at_device_ec20 *ec20 = (struct at_device_ec20 *) device->user_data;
+
+    RT_ASSERT(req && req->url);
+
+    if (ec20->app_lock == RT_NULL)
+    {
+        LOG_E("%s device HTTP(S) client is not initialized.", device->name);
+        return -RT_ERROR;
+    }
+
+    timeout = req->timeout > 0 ? req->timeout : EC20_HTTP_TIMEOUT;
+
+    /* the body is read from the offset if the server ignores the range */
+    if (body == RT_NULL && file == RT_NULL && req->offset > 0)
+    {
+        header = ec20_http_range_header(req->url, req->offset, &header_len);
+        if (header == RT_NULL)
+        {
+            LOG_E("no memory for HTTP(S) request header create.");
+            return -RT_ENOMEM;
+        }
+    }
+
+    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        rt_free(header);
+        return -RT_ENOMEM;
+    }
+
+    rt_mutex_take(ec20->app_lock, RT_WAITING_FOREVER);
+    at_device_sched_take(device, AT_DEVICE_CMD_BACKGROUND, RT_WAITING_FOREVER);
+
+    if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QHTTPCFG=\"contextid\",1") < 0 ||
+            at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QHTTPCFG=\"responseheader\",0") < 0 ||
+            at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QHTTPCFG=\"requestheader\",%d", header ? 1 : 0) < 0)
+    {
+        result = -RT_ERROR;
+        goto __release;
+    }
+
+    if (strncmp(req->url, "https://", 8) == 0 &&
+            (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QHTTPCFG=\"sslctxid\",%d", EC20_APP_SSL_CTX) < 0 ||
+             ec20_ssl_config(device, EC20_APP_SSL_CTX, req->tls ? req->tls : &tls_default) < 0))
+    {
+        LOG_E("%s device HTTPS configure failed.", device->name);
+        result = -RT_ERROR;
+        goto __release;
+    }
+
+    /* the URL, header and body are written after "CONNECT" */
+    if (ec20_file_xfer_write(device, resp, (EC20_HTTP_INPUT_TIME(0) + 5) * 1000, req->url, rt_strlen(req->url),
+                             "AT+QHTTPURL=%d,%d", (int) rt_strlen(req->url), EC20_HTTP_INPUT_TIME(0)) < 0)
+    {
+        LOG_E("%s device set HTTP(S) URL failed.", device->name);
+        result = -RT_ERROR;
+        goto __release;
+    }
+
+    /* clear the result event */
+    at_device_socket_event_recv(device, AT_DEVICE_SOCKET_EVENT_APP_OK, 0, RT_EVENT_FLAG_OR);
+
+    if (body)
+    {
+        result = ec20_file_xfer_write(device, resp, (EC20_HTTP_INPUT_TIME(size) + 5) * 1000, body, size,
+                                      "AT+QHTTPPOST=%d,%d,%d", (int) size, EC20_HTTP_INPUT_TIME(size), timeout);
+    }
+    else if (file)
+    {
+        /* the body is posted from the module UFS on module */
+        result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QHTTPPOSTFILE=\"UFS:%s\",%d", file, timeout);
+    }
+    else if (header)
+    {
+        result = ec20_file_xfer_write(device, resp, (EC20_HTTP_INPUT_TIME(header_len) + 5) * 1000, header, header_len,
+                                      "AT+QHTTPGET=%d,%d,%d", timeout, (int) header_len, EC20_HTTP_INPUT_TIME(0));
+    }
+    else
+    {
+        result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QHTTPGET=%d", timeout);
+    }
+
+__release:
+    at_device_sched_release(device);
+
+    if (result < 0)
+    {
+        LOG_E("%s device send HTTP(S) request failed.", device->name);
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    /* +QHTTPGET: <err>,<httprspcode>,<content_length> */
+    result = ec20_http_wait_result(device, timeout);
+    if (result < 0)
+    {
+        goto __exit;
+    }
+
+    code = ec20->app_result[1];
+    if (code != 200 && code != 206)
+    {
+        at_http_rsponsecode_parse(code);
+        result = code;
+        goto __exit;
+    }
+
+    if (sink == RT_NULL)
+    {
+        result = code;
+        goto __exit;
+    }
+
+    /* save the body to the module UFS, it is reported by "+QHTTPREADFILE: <err>" */
+    at_device_sched_take(device, AT_DEVICE_CMD_BACKGROUND, RT_WAITING_FOREVER);
+    at_device_socket_event_recv(device, AT_DEVICE_SOCKET_EVENT_APP_OK, 0, RT_EVENT_FLAG_OR);
+    result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QHTTPREADFILE=\"UFS:%s\",%d",
+                             EC20_HTTP_BODY_FILE, timeout);
+    at_device_sched_release(device);
+
+    if (result < 0 || ec20_http_wait_result(device, timeout) < 0)
+    {
+        LOG_E("%s device save HTTP(S) body failed.", device->name);
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    /* the whole body is returned if the range is ignored, skip to the offset */
+    result = ec20_file_read(device, EC20_HTTP_BODY_FILE, (code == 200) ? req->offset : 0,
+                            req->block_size > 0 ? req->block_size : EC20_HTTP_BLOCK_SIZE, sink, user_data);
+    ec20_file_delete(device, EC20_HTTP_BODY_FILE);
+    if (result >= 0)
+    {
+        result = code;
+    }
+
+__exit:
+    rt_mutex_release(ec20->app_lock);
+
+    if (header)
+    {
+        rt_free(header);
+    }
+
+    if (resp)
+    {
+        at_delete_resp(resp);
+    }
+
+    return result;
+}
+
+/**
+ * HTTP(S) GET request, the body is got from req->offset by range request for
+ * the resumed download, 206 is returned if the server supports the range.
+ *
+ * @param device the AT device
+ * @param req the request
+ * @param sink the body block sink, RT_NULL: drop the body
+ * @param user_data the sink user data
+ *
+ * @return >=0: the HTTP response code
+ *          -1: send AT commands error or request failed
+ *          -2: wait result timeout
+ *          -5: no memory
+ */
+int ec20_http_get(struct at_device *device, const struct ec20_http_request *req,
+                  ec20_file_sink_t sink, void *user_data)
+{
+    return ec20_http_request(device, req, RT_NULL, 0, RT_NULL, sink, user_data);
+}
+
+/**
+ * HTTP(S) POST request, the body is sent in one piece.
+ *
+ * @param device the AT device
+ * @param req the request, req->offset is not used
+ * @param body the POST body
+ * @param size the POST body size
+ * @param sink the response body block sink, RT_NULL: drop the response body
+ * @param user_data the sink user data
+ *
+ * @return >=0: the HTTP response code
+ *          -1: send AT commands error or request failed
+ *          -2: wait result timeout
+ *          -5: no memory
+ */
+int ec20_http_post(struct at_device *device, const struct ec20_http_request *req, const char *body, rt_size_t size,
+                   ec20_file_sink_t sink, void *user_data)
+{
+    RT_ASSERT(body);
+
+    return ec20_http_request(device, req, body, size, RT_NULL, sink, user_data);
+}
+
+/**
+ * HTTP(S) POST request, the body is the file staged in the module UFS by
+ * ec20_file_open/append/close, it is posted on module without the UART.
+ *
+ * @param device the AT device
+ * @param req the request, req->offset is not used
+ * @param file the staged UFS file name
+ * @param sink the response body block sink, RT_NULL: drop the response body
+ * @param user_data the sink user data
+ *
+ * @return >=0: the HTTP response code
+ *          -1: send AT commands error or request failed
+ *          -2: wait result timeout
+ *          -5: no memory
+ */
+int ec20_http_post_file(struct at_device *device, const struct ec20_http_request *req, const char *file,
+                        ec20_file_sink_t sink, void *user_data)
+{
+    RT_ASSERT(file);
+
+    return ec20_http_request(device, req, RT_NULL, 0, file, sink, user_data);
+}
+
+static const struct at_urc http_urc_table[] =
+{
+    {"+QHTTPGET:",       "\r\n",            ec20_urc_app_result},
+    {"+QHTTPPOST:",      "\r\n",            ec20_urc_app_result},
+    {"+QHTTPPOSTFILE:",  "\r\n",            ec20_urc_app_result},
+    {"+QHTTPREADFILE:",  "\r\n",            ec20_urc_app_result},
+};
+
+int ec20_http_init(struct at_device *device)
+{
+    RT_ASSERT(device);
+
+    return at_device_urc_set_table(AT_DEVICE_CTRL_CLIENT(device), http_urc_table,
+                                sizeof(http_urc_table) / sizeof(http_urc_table[0]));
+}
+
+#endif /* AT_DEVICE_USING_EC20 && AT_USING_SOCKET && EC20_USING_HTTP */
@@ -22,12 +22,17 @@
  * 2018-06-12     chenyong     first version
  * 2018-08-12     Marcus       port to ec20
  * 2019-05-13     chenyong     multi AT socket client support
+ * 2026-10-19     agent        use the shared socket engine
  */
 
 #include <stdio.h>
 #include <string.h>
 
 #include <at_device_ec20.h>
+#include <at_device_socket.h>
+#include <at_device_urc.h>
+#include <at_device_parser.h>
+#include <at_device_sched.h>
 
 #define LOG_TAG                        "at.skt.ec20"
 #include <at_log.h>
@@ -36,23 +41,6 @@
 
 #define EC20_MODULE_SEND_MAX_SIZE       1460
 
-/* set real event by current socket and current state */
-#define SET_EVENT(socket, event)       (((socket + 1) << 16) | (event))
-
-/* AT socket event type */
-#define EC20_EVENT_CONN_OK             (1L << 0)
-#define EC20_EVENT_SEND_OK             (1L << 1)
-#define EC20_EVENT_RECV_OK             (1L << 2)
-#define EC20_EVNET_CLOSE_OK            (1L << 3)
-#define EC20_EVENT_CONN_FAIL           (1L << 4)
-#define EC20_EVENT_SEND_FAIL           (1L << 5)
-#define EC20_EVENT_DOMAIN_OK           (1L << 6)
-
-static at_evt_cb_t at_evt_cb_set[] = {
-        [AT_SOCKET_EVT_RECV] = NULL,
-        [AT_SOCKET_EVT_CLOSED] = NULL,
-};
-
 static void at_tcp_ip_errcode_parse(int result)//TCP/IP_QIGETERROR
 {
     switch(result)
@@ -88,130 +76,6 @@ static void at_tcp_ip_errcode_parse(int result)//TCP/IP_QIGETERROR
     }
 }
 
-#ifdef EC20_USING_HTTP
-static void at_http_errcode_parse(int result)//HTTP
-{
-    switch(result)
-    {
-    case 0   : LOG_D("%d : Operation successful",         result); break;
-    case 701 : LOG_E("%d : HTTP(S) unknown error",        result); break;
-    case 702 : LOG_E("%d : HTTP(S) timeout",              result); break;
-    case 703 : LOG_E("%d : HTTP(S) busy",                 result); break;
-    case 704 : LOG_E("%d : HTTP(S) UART busy",            result); break;
-    case 705 : LOG_E("%d : HTTP(S) no GET/POST requests", result); break;
-    case 706 : LOG_E("%d : HTTP(S) network busy",         result); break;
-    case 707 : LOG_E("%d : HTTP(S) network open failed",  result); break;
-    case 708 : LOG_E("%d : HTTP(S) network no configuration", result); break;
-    case 709 : LOG_E("%d : HTTP(S) network deactivated",  result); break;
-    case 710 : LOG_E("%d : HTTP(S) network error",        result); break;
-    case 711 : LOG_E("%d : HTTP(S) URL error",            result); break;
-    case 712 : LOG_E("%d : HTTP(S) empty URL",            result); break;
-    case 713 : LOG_E("%d : HTTP(S) IP address error",     result); break;
-    case 714 : LOG_E("%d : HTTP(S) DNS error",            result); break;
-    case 715 : LOG_E("%d : HTTP(S) socket create error",  result); break;
-    case 716 : LOG_E("%d : HTTP(S) socket connect error", result); break;
-    case 717 : LOG_E("%d : HTTP(S) socket read error",    result); break;
-    case 718 : LOG_E("%d : HTTP(S) socket write error",   result); break;
-    case 719 : LOG_E("%d : HTTP(S) socket closed",        result); break;
-    case 720 : LOG_E("%d : HTTP(S) data encode error",    result); break;
-    case 721 : LOG_E("%d : HTTP(S) data decode error",    result); break;
-    case 722 : LOG_E("%d : HTTP(S) read timeout",         result); break;
-    case 723 : LOG_E("%d : HTTP(S) response failed",      result); break;
-    case 724 : LOG_E("%d : Incoming call busy",           result); break;
-    case 725 : LOG_E("%d : Voice call busy",              result); break;
-    case 726 : LOG_E("%d : Input timeout",                result); break;
-    case 727 : LOG_E("%d : Wait data timeout",            result); break;
-    case 728 : LOG_E("%d : Wait HTTP(S) response timeout", result); break;
-    case 729 : LOG_E("%d : Memory allocation failed",     result); break;
-    case 730 : LOG_E("%d : Invalid parameter",            result); break;
-    default  : LOG_E("%d : Unknown err code",             result); break;
-    }
-}
-
-static void at_http_rsponsecode_parse(int result)//HTTP
-{
-    switch(result)
-    {
-    case 200 : LOG_D("%d : OK",                           result); break;
-    case 400 : LOG_E("%d : Bad request",                  result); break;
-    case 403 : LOG_E("%d : Forbidden",                    result); break;
-    case 404 : LOG_E("%d : Not found",                    result); break;
-    case 409 : LOG_E("%d : Conflict",                     result); break;
-    case 411 : LOG_E("%d : Length required",              result); break;
-    case 500 : LOG_E("%d : Internal server error",        result); break;
-    case 502 : LOG_E("%d : Bad gate way",                 result); break;
-    default  : LOG_E("%d : Unknown err code",             result); break;
-    }
-}
-#endif /* EC20_USING_HTTP */
-
-#ifdef EC20_USING_FTP
-static void at_ftp_errcode_parse(int result)//FTP
-{
-    switch(result)
-    {
-    case 0   : LOG_D("%d : Operation successful",         result); break;
-    case 601 : LOG_E("%d : Unknown error",                result); break;
-    case 602 : LOG_E("%d : FTP(S) server blocked",        result); break;
-    case 603 : LOG_E("%d : FTP(S) server busy",           result); break;
-    case 604 : LOG_E("%d : DNS parse failed",             result); break;
-    case 605 : LOG_E("%d : Network error",                result); break;
-    case 606 : LOG_E("%d : Control connection closed.",   result); break;
-    case 607 : LOG_E("%d : Data connection closed",       result); break;
-    case 608 : LOG_E("%d : Socket closed by peer",        result); break;
-    case 609 : LOG_E("%d : Timeout error",                result); break;
-    case 610 : LOG_E("%d : Invalid parameter",            result); break;
-    case 611 : LOG_E("%d : Failed to open file",          result); break;
-    case 612 : LOG_E("%d : File position invalid",        result); break;
-    case 613 : LOG_E("%d : File error",                   result); break;
-    case 614 : LOG_E("%d : Service not available, closing control connection", result); break;
-    case 615 : LOG_E("%d : Open data connection failed",  result); break;
-    case 616 : LOG_E("%d : Connection closed; transfer aborted", result); break;
-    case 617 : LOG_E("%d : Requested file action not taken", result); break;
-    case 618 : LOG_E("%d : Requested action aborted: local error in processing", result); break;
-    case 619 : LOG_E("%d : Requested action not taken: insufficient system storage", result); break;
-    case 620 : LOG_E("%d : Syntax error, command unrecognized", result); break;
-    case 621 : LOG_E("%d : Syntax error in parameters or arguments", result); break;
-    case 622 : LOG_E("%d : Command not implemented",      result); break;
-    case 623 : LOG_E("%d : Bad sequence of commands",     result); break;
-    case 624 : LOG_E("%d : Command parameter not implemented", result); break;
-    case 625 : LOG_E("%d : Not logged in",                result); break;
-    case 626 : LOG_E("%d : Need account for storing files", result); break;
-    case 627 : LOG_E("%d : Requested action not taken",   result); break;
-    case 628 : LOG_E("%d : Requested action aborted: page type unknown", result); break;
-    case 629 : LOG_E("%d : Requested file action aborted", result); break;
-    case 630 : LOG_E("%d : Requested file name invalid",  result); break;
-    case 631 : LOG_E("%d : SSL authentication failed",    result); break;
-    default  : LOG_E("%d : Unknown err code",             result); break;
-    }
-}
-
-static void at_ftp_protocol_errcode_parse(int result)//FTP_Protocol
-{
-    switch(result)
-    {
-    case 421 : LOG_E("%d : Service not available, closing control connection", result); break;
-    case 425 : LOG_E("%d : Open data connection failed",  result); break;
-    case 426 : LOG_E("%d : Connection closed; transfer aborted", result); break;
-    case 450 : LOG_E("%d : Requested file action not taken", result); break;
-    case 451 : LOG_E("%d : Requested action aborted: local error in processing", result); break;
-    case 452 : LOG_E("%d : Requested action not taken: insufficient system storage", result); break;
-    case 500 : LOG_E("%d : Syntax error, command unrecognized", result); break;
-    case 501 : LOG_E("%d : Syntax error in parameters or arguments", result); break;
-    case 502 : LOG_E("%d : Command not implemented",      result); break;
-    case 503 : LOG_E("%d : Bad sequence of commands",     result); break;
-    case 504 : LOG_E("%d : Command parameter not implemented", result); break;
-    case 530 : LOG_E("%d : Not logged in",                result); break;
-    case 532 : LOG_E("%d : Need account for storing files", result); break;
-    case 550 : LOG_E("%d : Requested action not taken: file unavailable", result); break;
-    case 551 : LOG_E("%d : Requested action aborted: page type unknown", result); break;
-    case 552 : LOG_E("%d : Requested file action aborted: exceeded storage allocation", result); break;
-    case 553 : LOG_E("%d : Requested action not taken: file name not allowed", result); break;
-    default  : LOG_E("%d : Unknown err code",             result); break;
-    }
-}
-#endif /* EC20_USING_FTP */
-
 #ifdef EC20_USING_SMTP
 static void at_smtp_errcode_parse(int result)//Email
 {
@@ -279,52 +143,87 @@ static void at_smtp_protocol_errcode_parse(int result)//Email_Protocol
 }
 #endif /* EC20_USING_SMTP */
 
-static int ec20_socket_event_send(struct at_device *device, uint32_t event)
-{
-    return (int) rt_event_send(device->socket_event, event);
-}
+/* the PDP context of the socket, it is the default one if not selected */
+#define EC20_SOCKET_CONTEXT(device, device_socket)                                       \
+    ((device)->socket_info[(device_socket)].context ?                                    \
+     (device)->socket_info[(device_socket)].context : EC20_CONTEXT_DEFAULT)
 
-static int ec20_socket_event_recv(struct at_device *device, uint32_t event, uint32_t timeout, rt_uint8_t option)
+/**
+ * This function will select the PDP context of the socket, it is called
+ * before connect and the socket uses the default context after close.
+ *
+ * @param socket the AT socket object
+ * @param context_id the PDP context ID activated on initialize
+ *
+ * @return  0: select success
+ *         -1: the context is not active
+ */
+int ec20_socket_set_context(struct at_socket *socket, int context_id)
 {
-    int result = RT_EOK;
-    rt_uint32_t recved;
+    struct at_device *device = RT_NULL;
+    struct at_device_ec20 *ec20 = RT_NULL;
+
+    RT_ASSERT(socket);
 
-    result = rt_event_recv(device->socket_event, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
-    if (result != RT_EOK)
+    device = (struct at_device *) socket->device;
+    ec20 = (struct at_device_ec20 *) device->user_data;
+    if (context_id <= 0 || context_id > EC20_CONTEXT_ID_MAX || (ec20->context_active & (1UL << context_id)) == 0)
     {
-        return -RT_ETIMEOUT;
+        LOG_E("%s device context(%d) is not active.", device->name, context_id);
+        return -RT_ERROR;
     }
 
-    return recved;
+    device->socket_info[(int) socket->user_data].context = (rt_uint8_t) context_id;
+
+    return RT_EOK;
 }
 
 /**
- * close socket by AT commands.
+ * open the service on local port by AT commands, "TCP LISTENER" or "UDP SERVICE".
  *
- * @param current socket
+ * @param socket current socket
+ * @param service the service type
+ * @param port the local port
  *
- * @return  0: close socket success
- *         -1: send AT commands error
+ * @return  0: open success
+ *         -1: send AT commands error or open failed
  *         -2: wait socket event timeout
  *         -5: no memory
  */
-static int ec20_socket_close(struct at_socket *socket)
+static int ec20_socket_service_open(struct at_socket *socket, const char *service, int32_t port)
 {
+    uint32_t event = 0;
     int result = RT_EOK;
     at_response_t resp = RT_NULL;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
 
-    resp = at_create_resp(64, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_create_resp(128, 0, rt_tick_from_millisecond(5000));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
         return -RT_ENOMEM;
     }
 
-    /* default connection timeout is 10 seconds, but it set to 1 seconds is convenient to use.*/
-    result = at_obj_exec_cmd(device->client, resp, "AT+QICLOSE=%d,1", device_socket);
+    /* clear socket connect event */
+    event = AT_DEVICE_SOCKET_EVENT(device_socket, AT_DEVICE_SOCKET_EVENT_CONN_OK | AT_DEVICE_SOCKET_EVENT_CONN_FAIL);
+    at_device_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
+
+    /* the IP address of service must be "127.0.0.1", the remote port is ignored */
+    at_device_sched_take(device, AT_DEVICE_CMD_CONTROL, RT_WAITING_FOREVER);
+    result = at_obj_exec_cmd(device->client, resp, "AT+QIOPEN=%d,%d,\"%s\",\"127.0.0.1\",0,%d,1",
+                             EC20_SOCKET_CONTEXT(device, device_socket), device_socket, service, port);
+    at_device_sched_release(device);
+    if (result < 0)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
 
+    /* the open result is reported by "+QIOPEN" URC */
+    result = at_device_socket_connect_wait(device, device_socket);
+
+__exit:
     if (resp)
     {
         at_delete_resp(resp);
@@ -333,149 +232,85 @@ static int ec20_socket_close(struct at_socket *socket)
     return result;
 }
 
+/* start TCP server, the accepted connections are reported by the "incoming" URC */
+static int ec20_socket_listen(struct at_socket *socket, int32_t port)
+{
+    return ec20_socket_service_open(socket, "TCP LISTENER", port);
+}
+
+/* open UDP service, the datagrams are sent to and received from any peer */
+static int ec20_socket_open_udp(struct at_socket *socket, const char *ip, int32_t port, int32_t local_port)
+{
+    return ec20_socket_service_open(socket, "UDP SERVICE", local_port);
+}
+
 /**
- * create TCP/UDP client or server connect by AT commands.
+ * configure the module SSL context, the module supports 6 SSL contexts.
  *
- * @param socket current socket
- * @param ip server or client IP address
- * @param port server or client port
- * @param type connect socket type(tcp, udp)
- * @param is_client connection is client
+ * @param device the AT device
+ * @param ssl_ctx the SSL context number
+ * @param cfg the TLS configuration
  *
- * @return   0: connect success
- *          -1: connect failed, send commands error or type error
- *          -2: wait socket event timeout
- *          -5: no memory
+ * @return  0: config success
+ *         -1: send AT commands error
+ *         -5: no memory
  */
-static int ec20_socket_connect(struct at_socket *socket, char *ip, int32_t port,
-    enum at_socket_type type, rt_bool_t is_client)
+int ec20_ssl_config(struct at_device *device, int ssl_ctx, const struct at_device_tls_cfg *cfg)
 {
-    uint32_t event = 0;
-    rt_bool_t retryed = RT_FALSE;
+    int seclevel = 0, result = RT_EOK;
     at_response_t resp = RT_NULL;
-    int result = 0, event_result = 0;
-    int device_socket = (int) socket->user_data;
-    struct at_device *device = (struct at_device *) socket->device;
-
-    RT_ASSERT(ip);
-    RT_ASSERT(port >= 0);
 
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
         return -RT_ENOMEM;
     }
 
-__retry:
-    /* clear socket connect event */
-    event = SET_EVENT(device_socket, EC20_EVENT_CONN_OK | EC20_EVENT_CONN_FAIL);
-    ec20_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
-
-    if (is_client)
+    /* seclevel 0: no authentication, 1: server authentication, 2: server and client authentication */
+    if (cfg->ca_file)
     {
-        switch (type)
-        {
-        case AT_SOCKET_TCP:
-            /* send AT commands(AT+QIOPEN=<contextID>,<socket>,"<TCP/UDP>","<IP_address>/<domain_name>", */
-            /* <remote_port>,<local_port>,<access_mode>) to connect TCP server */
-            /* contextID   = 1 : use same contextID as AT+QICSGP & AT+QIACT */
-            /* local_port  = 0 : local port assigned automatically */
-            /* access_mode = 1 : Direct push mode */
-            if (at_obj_exec_cmd(device->client, resp,
-                                "AT+QIOPEN=1,%d,\"TCP\",\"%s\",%d,0,1", device_socket, ip, port) < 0)
-            {
-                result = -RT_ERROR;
-                goto __exit;
-            }
-            break;
-
-        case AT_SOCKET_UDP:
-            if (at_obj_exec_cmd(device->client, resp,
-                                "AT+QIOPEN=1,%d,\"UDP\",\"%s\",%d,0,1", device_socket, ip, port) < 0)
-            {
-                result = -RT_ERROR;
-                goto __exit;
-            }
-            break;
-
-        default:
-            LOG_E("not supported connect type : %d.", type);
-            return -RT_ERROR;
-        }
+        seclevel = cfg->cert_file ? 2 : 1;
     }
 
-    /* waiting result event from AT URC, the device default connection timeout is 75 seconds, but it set to 10 seconds is convenient to use.*/
-    if (ec20_socket_event_recv(device, SET_EVENT(device_socket, 0), 10 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
+    /* all the SSL versions and cipher suites, the server selects */
+    if (at_obj_exec_cmd(device->client, resp, "AT+QSSLCFG=\"sslversion\",%d,4", ssl_ctx) < 0 ||
+            at_obj_exec_cmd(device->client, resp, "AT+QSSLCFG=\"ciphersuite\",%d,0xFFFF", ssl_ctx) < 0 ||
+            at_obj_exec_cmd(device->client, resp, "AT+QSSLCFG=\"seclevel\",%d,%d", ssl_ctx, seclevel) < 0)
     {
-        LOG_E("%s device socket(%d) wait connect result timeout.", device->name, device_socket);
-        result = -RT_ETIMEOUT;
-        goto __exit;
-    }
-    /* waiting OK or failed result */
-    event_result = ec20_socket_event_recv(device,
-        EC20_EVENT_CONN_OK | EC20_EVENT_CONN_FAIL, 1 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
-    if (event_result < 0)
-    {
-        LOG_E("%s device socket(%d) wait connect OK|FAIL timeout.", device->name, device_socket);
-        result = -RT_ETIMEOUT;
-        goto __exit;
-    }
-    /* check result */
-    if (event_result & EC20_EVENT_CONN_FAIL)
-    {
-        if (retryed == RT_FALSE)
-        {
-            LOG_D("%s device socket(%d) connect failed, the socket was not be closed and now will connect retey.",
-                    device->name, device_socket);
-            /* default connection timeout is 10 seconds, but it set to 1 seconds is convenient to use.*/
-            if (ec20_socket_close(socket) < 0)
-            {
-                result = -RT_ERROR;
-                goto __exit;
-            }
-            retryed = RT_TRUE;
-            goto __retry;
-        }
-        LOG_E("%s device socket(%d) connect failed.", device->name, device_socket);
         result = -RT_ERROR;
         goto __exit;
     }
 
-__exit:
-    if (resp)
+    if (cfg->ca_file &&
+            at_obj_exec_cmd(device->client, resp, "AT+QSSLCFG=\"cacert\",%d,\"%s\"", ssl_ctx, cfg->ca_file) < 0)
     {
-        at_delete_resp(resp);
+        result = -RT_ERROR;
+        goto __exit;
     }
 
-    return result;
-}
-
-static int at_get_send_size(struct at_socket *socket, size_t *size, size_t *acked, size_t *nacked)
-{
-    int result = 0;
-    at_response_t resp = RT_NULL;
-    int device_socket = (int) socket->user_data;
-    struct at_device *device = (struct at_device *) socket->device;
-
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
-    if (resp == RT_NULL)
+    if (cfg->cert_file &&
+            (at_obj_exec_cmd(device->client, resp, "AT+QSSLCFG=\"clientcert\",%d,\"%s\"", ssl_ctx, cfg->cert_file) < 0 ||
+             (cfg->key_file &&
+              at_obj_exec_cmd(device->client, resp, "AT+QSSLCFG=\"clientkey\",%d,\"%s\"", ssl_ctx, cfg->key_file) < 0)))
     {
-        LOG_E("no memory for resp create.", device->name);
-        result = -RT_ENOMEM;
+        result = -RT_ERROR;
         goto __exit;
     }
 
-    if (at_obj_exec_cmd(device->client, resp, "AT+QISEND=%d,0", device_socket) < 0)
+    /* the server name is taken from the connect address */
+    if (cfg->hostname &&
+            at_obj_exec_cmd(device->client, resp, "AT+QSSLCFG=\"sni\",%d,1", ssl_ctx) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
     }
 
-    if (at_resp_parse_line_args_by_kw(resp, "+QISEND:", "+QISEND: %d,%d,%d", size, acked, nacked) <= 0)
+    /* the session resumption only saves the handshake, the connect works without it */
+    if (cfg->session_resume &&
+            at_obj_exec_cmd(device->client, resp, "AT+QSSLCFG=\"sessioncache\",%d,1", ssl_ctx) < 0)
     {
-        result = -RT_ERROR;
-        goto __exit;
+        LOG_W("%s device SSL context(%d) session resumption is not supported.", device->name, ssl_ctx);
     }
 
 __exit:
@@ -487,141 +322,34 @@ __exit:
     return result;
 }
 
-static int at_wait_send_finish(struct at_socket *socket, size_t settings_size)
+/* the SSL context number is the same as the socket number */
+static int ec20_socket_tls_config(struct at_socket *socket, const struct at_device_tls_cfg *cfg)
 {
-    /* get the timeout by the input data size */
-    rt_tick_t timeout = rt_tick_from_millisecond(settings_size);
-    rt_tick_t last_time = rt_tick_get();
-    size_t size = 0, acked = 0, nacked = 0xFFFF;
-
-    while (rt_tick_get() - last_time <= timeout)
-    {
-        at_get_send_size(socket, &size, &acked, &nacked);
-        if (nacked == 0)
-        {
-            return RT_EOK;
-        }
-        rt_thread_mdelay(50);
-    }
-
-    return -RT_ETIMEOUT;
+    return ec20_ssl_config((struct at_device *) socket->device, (int) socket->user_data, cfg);
 }
 
-/**
- * send data to server or client by AT commands.
- *
- * @param socket current socket
- * @param buff send buffer
- * @param bfsz send buffer size
- * @param type connect socket type(tcp, udp)
- *
- * @return >=0: the size of send success
- *          -1: send AT commands error or send data error
- *          -2: waited socket event timeout
- *          -5: no memory
- */
-static int ec20_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
+/* open the SSL client in direct push mode, the result is reported by "+QSSLOPEN" URC */
+static int ec20_socket_connect_tls(struct at_socket *socket, at_response_t resp, const char *ip, int32_t port,
+                                   const struct at_device_tls_cfg *cfg)
 {
-    uint32_t event = 0;
-    int result = 0, event_result = 0;
-    size_t cur_pkt_size = 0, sent_size = 0;
-    at_response_t resp = RT_NULL;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
-    struct at_device_ec20 *ec20 = (struct at_device_ec20 *) device->user_data;
-    rt_mutex_t lock = device->client->lock;
 
-    RT_ASSERT(buff);
-
-    resp = at_create_resp(128, 2, 5 * RT_TICK_PER_SECOND);
-    if (resp == RT_NULL)
-    {
-        LOG_E("no memory for resp create.");
-        return -RT_ENOMEM;
-    }
-
-    rt_mutex_take(lock, RT_WAITING_FOREVER);
-
-    /* set current socket for send URC event */
-    ec20->user_data = (void *) device_socket;
-
-    /* clear socket send event */
-    event = SET_EVENT(device_socket, EC20_EVENT_SEND_OK | EC20_EVENT_SEND_FAIL);
-    ec20_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
-
-    /* set AT client end sign to deal with '>' sign.*/
-    at_obj_set_end_sign(device->client, '>');
-
-    while (sent_size < bfsz)
-    {
-        if (bfsz - sent_size < EC20_MODULE_SEND_MAX_SIZE)
-        {
-            cur_pkt_size = bfsz - sent_size;
-        }
-        else
-        {
-            cur_pkt_size = EC20_MODULE_SEND_MAX_SIZE;
-        }
-
-        /* send the "AT+QISEND" commands to AT server than receive the '>' response on the first line. */
-        if (at_obj_exec_cmd(device->client, resp, "AT+QISEND=%d,%d", device_socket, cur_pkt_size) < 0)
-        {
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        /* send the real data to server or client */
-        result = (int) at_client_send(buff + sent_size, cur_pkt_size);
-        if (result == 0)
-        {
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        /* waiting result event from AT URC */
-        if (ec20_socket_event_recv(device, SET_EVENT(device_socket, 0), 10 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
-        {
-            result = -RT_ETIMEOUT;
-            goto __exit;
-        }
-        /* waiting OK or failed result */
-        event_result = ec20_socket_event_recv(device,
-            EC20_EVENT_SEND_OK | EC20_EVENT_SEND_FAIL, 1 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
-        if (event_result < 0)
-        {
-            LOG_E("%s device socket(%d) wait sned OK|FAIL timeout.", device->name, device_socket);
-            result = -RT_ETIMEOUT;
-            goto __exit;
-        }
-        /* check result */
-        if (event_result & EC20_EVENT_SEND_FAIL)
-        {
-            LOG_E("%s device socket(%d) send failed.", device->name, device_socket);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        if (type == AT_SOCKET_TCP)
-        {
-            // at_wait_send_finish(socket, cur_pkt_size);
-            rt_thread_mdelay(10);
-        }
-
-        sent_size += cur_pkt_size;
-    }
-
-__exit:
-    /* reset the end sign for data conflict */
-    at_obj_set_end_sign(device->client, 0);
-
-    rt_mutex_release(lock);
+    /* connect to the host name, so the module checks it with the server certificate */
+    return at_obj_exec_cmd(device->client, resp, "AT+QSSLOPEN=%d,%d,%d,\"%s\",%d,1",
+                           EC20_SOCKET_CONTEXT(device, device_socket), device_socket, device_socket,
+                           cfg->hostname ? cfg->hostname : ip, port);
+}
 
-    if (resp)
-    {
-        at_delete_resp(resp);
-    }
+/* open the TCP client on the PDP context of the socket, the result is reported by "+QIOPEN" URC */
+static int ec20_socket_connect_cmd(struct at_socket *socket, at_response_t resp, const char *ip, int32_t port,
+                                   enum at_socket_type type)
+{
+    int device_socket = (int) socket->user_data;
+    struct at_device *device = (struct at_device *) socket->device;
 
-    return result > 0 ? sent_size : result;
+    return at_obj_exec_cmd(device->client, resp, "AT+QIOPEN=%d,%d,\"TCP\",\"%s\",%d,0,1",
+                           EC20_SOCKET_CONTEXT(device, device_socket), device_socket, ip, port);
 }
 
 /**
@@ -661,10 +389,13 @@ static int ec20_domain_resolve(const char *name, char ip[16])
         return -RT_ENOMEM;
     }
 
-    /* clear EC20_EVENT_DOMAIN_OK */
-    ec20_socket_event_recv(device, EC20_EVENT_DOMAIN_OK, 0, RT_EVENT_FLAG_OR);
+    /* clear domain resolve event */
+    at_device_socket_event_recv(device, AT_DEVICE_SOCKET_EVENT_DOMAIN_OK, 0, RT_EVENT_FLAG_OR);
 
+    /* the result is reported by URC, only the command is scheduled */
+    at_device_sched_take(device, AT_DEVICE_CMD_CONTROL, RT_WAITING_FOREVER);
     result = at_obj_exec_cmd(device->client, resp, "AT+QIDNSGIP=1,\"%s\"", name);
+    at_device_sched_release(device);
     if (result < 0)
     {
         goto __exit;
@@ -675,7 +406,7 @@ static int ec20_domain_resolve(const char *name, char ip[16])
         for(i = 0; i < RESOLVE_RETRY; i++)
         {
             /* waiting result event from AT URC, the device default connection timeout is 60 seconds.*/
-            if (ec20_socket_event_recv(device, EC20_EVENT_DOMAIN_OK, 10 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
+            if (at_device_socket_event_recv(device, AT_DEVICE_SOCKET_EVENT_DOMAIN_OK, 10 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
             {
                 continue;
             }
@@ -718,188 +449,155 @@ static int ec20_domain_resolve(const char *name, char ip[16])
 
 }
 
-/**
- * set AT socket event notice callback
- *
- * @param event notice event
- * @param cb notice callback
- */
-static void ec20_socket_set_event_cb(at_socket_evt_t event, at_evt_cb_t cb)
-{
-    if (event < sizeof(at_evt_cb_set) / sizeof(at_evt_cb_set[1]))
-    {
-        at_evt_cb_set[event] = cb;
-    }
-}
-
 static void urc_connect_func(struct at_client *client, const char *data, rt_size_t size)
 {
     int device_socket = 0, result = 0;
     struct at_device *device = RT_NULL;
-    char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_socket_get_device(client);
     if (device == RT_NULL)
     {
-        LOG_E("get device(%s) failed.", client_name);
         return;
     }
 
-    sscanf(data, "+QIOPEN: %d,%d", &device_socket , &result);
-
-    if (result == 0)
+    /* the SSL client reports the same fields as the TCP/IP socket */
+    at_device_parser_init(&parser, data, size);
+    if ((at_device_parser_expect(&parser, "+QIOPEN:") < 0 && at_device_parser_expect(&parser, "+QSSLOPEN:") < 0) ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_int(&parser, &result) < 0)
     {
-        ec20_socket_event_send(device, SET_EVENT(device_socket, EC20_EVENT_CONN_OK));
+        return;
     }
-    else
+
+    if (result != 0)
     {
         at_tcp_ip_errcode_parse(result);
-        ec20_socket_event_send(device, SET_EVENT(device_socket, EC20_EVENT_CONN_FAIL));
     }
+    at_device_socket_connect_notice(device, device_socket, result == 0);
 }
 
-static void urc_send_func(struct at_client *client, const char *data, rt_size_t size)
+static void urc_close_func(struct at_client *client, const char *data, rt_size_t size)
 {
-    int device_socket = 0;
+    int device_socket = -1;
     struct at_device *device = RT_NULL;
-    struct at_device_ec20 *ec20 = RT_NULL;
-    char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_socket_get_device(client);
     if (device == RT_NULL)
     {
-        LOG_E("get device(%s) failed.", client_name);
         return;
     }
-    ec20 = (struct at_device_ec20 *) device->user_data;
-    device_socket = (int) ec20->user_data;
 
-    if (rt_strstr(data, "SEND OK"))
-    {
-        ec20_socket_event_send(device, SET_EVENT(device_socket, EC20_EVENT_SEND_OK));
-    }
-    else if (rt_strstr(data, "SEND FAIL"))
+    at_device_parser_init(&parser, data, size);
+    if ((at_device_parser_expect(&parser, "+QIURC: \"closed\",") < 0 &&
+            at_device_parser_expect(&parser, "+QSSLURC: \"closed\",") < 0) ||
+            at_device_parser_int(&parser, &device_socket) < 0)
     {
-        ec20_socket_event_send(device, SET_EVENT(device_socket, EC20_EVENT_SEND_FAIL));
+        return;
     }
+
+    /* notice the socket is disconnect by remote */
+    at_device_socket_closed_notice(device, device_socket);
 }
 
-static void urc_close_func(struct at_client *client, const char *data, rt_size_t size)
+static void urc_incoming_func(struct at_client *client, const char *data, rt_size_t size)
 {
-    int device_socket = 0;
-    struct at_socket *socket = RT_NULL;
+    int device_socket = -1, server_socket = -1;
     struct at_device *device = RT_NULL;
-    char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_socket_get_device(client);
     if (device == RT_NULL)
     {
-        LOG_E("get device(%s) failed.", client_name);
         return;
     }
 
-    sscanf(data, "+QIURC: \"closed\",%d", &device_socket);
-    /* get at socket object by device socket descriptor */
-    socket = &(device->sockets[device_socket]);
-
-    /* notice the socket is disconnect by remote */
-    if (at_evt_cb_set[AT_SOCKET_EVT_CLOSED])
+    /* +QIURC: "incoming",<connectID>,<serverID>,<remoteIP>,<remote_port> */
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+QIURC: \"incoming\",") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_int(&parser, &server_socket) < 0)
     {
-        at_evt_cb_set[AT_SOCKET_EVT_CLOSED](socket, AT_SOCKET_EVT_CLOSED, NULL, 0);
+        return;
     }
+
+    LOG_D("%s device socket(%d) accepted connection(%d).", device->name, server_socket, device_socket);
+    at_device_socket_accept_notice(device, device_socket);
 }
 
 static void urc_recv_func(struct at_client *client, const char *data, rt_size_t size)
 {
-    int device_socket = 0;
-    rt_int32_t timeout;
-    rt_size_t bfsz = 0, temp_size = 0;
-    char *recv_buf = RT_NULL, temp[8] = {0};
-    struct at_socket *socket = RT_NULL;
+    char remote_ip[16] = {0};
+    int device_socket = -1, bfsz = 0, remote_port = 0;
     struct at_device *device = RT_NULL;
-    char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_socket_get_device(client);
     if (device == RT_NULL)
     {
-        LOG_E("get device(%s) failed.", client_name);
         return;
     }
 
     /* get the current socket and receive buffer size by receive data */
-    sscanf(data, "+QIURC: \"recv\",%d,%d", &device_socket, (int *) &bfsz);
-    /* set receive timeout by receive buffer length, not less than 10 ms */
-    timeout = bfsz > 10 ? bfsz : 10;
-
-    if (device_socket < 0 || bfsz == 0)
-    {
-        return;
-    }
-
-    recv_buf = (char *) rt_calloc(1, bfsz);
-    if (recv_buf == RT_NULL)
+    at_device_parser_init(&parser, data, size);
+    if ((at_device_parser_expect(&parser, "+QIURC: \"recv\",") < 0 &&
+            at_device_parser_expect(&parser, "+QSSLURC: \"recv\",") < 0) ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_int(&parser, &bfsz) < 0 || bfsz < 0)
     {
-        LOG_E("no memory for URC receive buffer(%d).", bfsz);
-        /* read and clean the coming data */
-        while (temp_size < bfsz)
-        {
-            if (bfsz - temp_size > sizeof(temp))
-            {
-                at_client_obj_recv(client, temp, sizeof(temp), timeout);
-            }
-            else
-            {
-                at_client_obj_recv(client, temp, bfsz - temp_size, timeout);
-            }
-            temp_size += sizeof(temp);
-        }
         return;
     }
 
-    /* sync receive data */
-    if (at_client_obj_recv(client, recv_buf, bfsz, timeout) != bfsz)
+    /* the UDP service reports the source address: +QIURC: "recv",<connectID>,<length>,<remoteIP>,<remote_port> */
+    if (at_device_parser_ipv4(&parser, remote_ip) == 0 && at_device_parser_int(&parser, &remote_port) == 0)
     {
-        LOG_E("%s device receive size(%d) data failed.", device->name, bfsz);
-        rt_free(recv_buf);
-        return;
+        at_device_socket_set_from(device, device_socket, remote_ip, remote_port);
     }
 
-    /* get at socket object by device socket descriptor */
-    socket = &(device->sockets[device_socket]);
-
-    /* notice the receive buffer and buffer size */
-    if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
-    {
-        at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
-    }
+    /* read the raw data and notice it to the socket */
+    at_device_socket_recv_push(client, device, device_socket, bfsz);
 }
 
 static void urc_pdpdeact_func(struct at_client *client, const char *data, rt_size_t size)
 {
     int connectID = 0;
+    struct at_device *device = RT_NULL;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
-    sscanf(data, "+QIURC: \"pdpdeact\",%d", &connectID);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+QIURC: \"pdpdeact\",") < 0 ||
+            at_device_parser_int(&parser, &connectID) < 0)
+    {
+        return;
+    }
 
     LOG_E("context (%d) is deactivated.", connectID);
+
+    device = at_device_socket_get_device(client);
+    if (device && connectID > 0 && connectID <= EC20_CONTEXT_ID_MAX)
+    {
+        ((struct at_device_ec20 *) device->user_data)->context_active &= ~(1UL << connectID);
+    }
 }
 
 static void urc_dnsqip_func(struct at_client *client, const char *data, rt_size_t size)
 {
-    int i = 0, j = 0;
+    int result = 0;
     char recv_ip[16] = {0};
-    int result, ip_count, dns_ttl;
     struct at_device *device = RT_NULL;
     struct at_device_ec20 *ec20 = RT_NULL;
+    struct at_device_parser parser;
     char *client_name = client->device->parent.name;
 
     RT_ASSERT(data && size);
@@ -912,17 +610,15 @@ static void urc_dnsqip_func(struct at_client *client, const char *data, rt_size_
     }
     ec20 = (struct at_device_ec20 *) device->user_data;
 
-    for (i = 0; i < size; i++)
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+QIURC: \"dnsgip\",") < 0)
     {
-        if (*(data + i) == '.')
-            j++;
+        return;
     }
+
     /* There would be several dns result, we just pickup one */
-    if (j == 3)
+    if (at_device_parser_ipv4(&parser, recv_ip) == 0)
     {
-        sscanf(data, "+QIURC: \"dnsgip\",\"%[^\"]", recv_ip);
-        recv_ip[15] = '\0';
-
         /* set ec20 information socket data */
         if (ec20->socket_data == RT_NULL)
         {
@@ -935,15 +631,12 @@ static void urc_dnsqip_func(struct at_client *client, const char *data, rt_size_
         rt_memcpy(ec20->socket_data, recv_ip, sizeof(recv_ip));
 
 
-        ec20_socket_event_send(device, EC20_EVENT_DOMAIN_OK);
+        at_device_socket_event_send(device, AT_DEVICE_SOCKET_EVENT_DOMAIN_OK);
     }
-    else
+    else if (at_device_parser_int(&parser, &result) == 0 && result)
     {
-        sscanf(data, "+QIURC: \"dnsgip\",%d,%d,%d", &result, &ip_count, &dns_ttl);
-        if (result)
-        {
-            at_tcp_ip_errcode_parse(result);
-        }
+        /* +QIURC: "dnsgip",<err>,<IP_count>,<DNS_ttl> */
+        at_tcp_ip_errcode_parse(result);
     }
 }
 
@@ -954,35 +647,84 @@ static void urc_func(struct at_client *client, const char *data, rt_size_t size)
     LOG_I("URC data : %.*s", size, data);
 }
 
+/* +QIURC: "<type>" sub-URCs, dispatched by the prefix trie */
+static const struct at_urc qiurc_table[] =
+{
+    {"+QIURC: \"closed\"",    "\r\n",         urc_close_func},
+    {"+QIURC: \"recv\"",      "\r\n",         urc_recv_func},
+    {"+QIURC: \"incoming\"",  "\r\n",         urc_incoming_func},
+    {"+QIURC: \"pdpdeact\"",  "\r\n",         urc_pdpdeact_func},
+    {"+QIURC: \"dnsgip\"",    "\r\n",         urc_dnsqip_func},
+};
+
+static struct at_device_urc_dispatcher *qiurc_dispatcher = RT_NULL;
+
 static void urc_qiurc_func(struct at_client *client, const char *data, rt_size_t size)
 {
     RT_ASSERT(data && size);
 
-    switch(*(data + 9))
+    if (qiurc_dispatcher == RT_NULL || at_device_urc_exec(qiurc_dispatcher, client, data, size) < 0)
     {
-    case 'c' : urc_close_func(client, data, size); break;//+QIURC: "closed"
-    case 'r' : urc_recv_func(client, data, size); break;//+QIURC: "recv"
-    case 'p' : urc_pdpdeact_func(client, data, size); break;//+QIURC: "pdpdeact"
-    case 'd' : urc_dnsqip_func(client, data, size); break;//+QIURC: "dnsgip"
-    default  : urc_func(client, data, size);      break;
+        urc_func(client, data, size);
     }
 }
 
 static const struct at_urc urc_table[] =
 {
-    {"SEND OK",     "\r\n",                 urc_send_func},
-    {"SEND FAIL",   "\r\n",                 urc_send_func},
+    {"SEND OK",     "\r\n",                 at_device_socket_urc_send},
+    {"SEND FAIL",   "\r\n",                 at_device_socket_urc_send},
     {"+QIOPEN:",    "\r\n",                 urc_connect_func},
     {"+QIURC:",     "\r\n",                 urc_qiurc_func},
+    {"+QSSLOPEN:",  "\r\n",                 urc_connect_func},
+    {"+QSSLURC: \"recv\"",   "\r\n",        urc_recv_func},
+    {"+QSSLURC: \"closed\"", "\r\n",        urc_close_func},
+};
+
+/* AT+QIOPEN=<contextID>,<socket>,"<TCP/UDP>","<IP_address>/<domain_name>",<remote_port>,<local_port>,<access_mode>
+ * contextID   : the context of the socket, the TCP client is opened by ec20_socket_connect_cmd()
+ * local_port  = 0 : local port assigned automatically
+ * access_mode = 1 : Direct push mode
+ */
+static const struct at_device_socket_dialect ec20_socket_dialect =
+{
+    .close           = "AT+QICLOSE=%d,1",
+    .send            = "AT+QISEND=%d,%d",
+    .send_udp        = "AT+QISEND=%d,%d,\"%s\",%d",
+    .send_tls        = "AT+QSSLSEND=%d,%d",
+    .close_tls       = "AT+QSSLCLOSE=%d,1",
+    .urc_table       = urc_table,
+    .urc_table_size  = sizeof(urc_table) / sizeof(urc_table[0]),
+    .send_max_size   = EC20_MODULE_SEND_MAX_SIZE,
+    .connect_style   = AT_DEVICE_SOCKET_CONN_URC,
+    .send_style      = AT_DEVICE_SOCKET_SEND_PROMPT,
+    .recv_style      = AT_DEVICE_SOCKET_RECV_PUSH,
+    .connect_retry   = 1,
+    .flags           = AT_DEVICE_SOCKET_FLAG_CLOSE_RETRY | AT_DEVICE_SOCKET_FLAG_TCP_SEND_DELAY,
+    .cmd_timeout     = 5000,
+    /* the default close timeout is 10 seconds, the command requests 1 second */
+    .close_timeout   = 5000,
+    /* the default connect timeout is 75 seconds, but 10 seconds is convenient to use */
+    .connect_timeout = 10000,
+    .send_timeout    = 10000,
+    .listen          = ec20_socket_listen,
+    .open_udp        = ec20_socket_open_udp,
+    .connect_tls     = ec20_socket_connect_tls,
+    .connect_cmd     = ec20_socket_connect_cmd,
+};
+
+static const struct at_device_socket_tls ec20_socket_tls =
+{
+    ec20_socket_tls_config,
+    ec20_file_upload,
 };
 
 static const struct at_socket_ops ec20_socket_ops =
 {
-    ec20_socket_connect,
-    ec20_socket_close,
-    ec20_socket_send,
+    at_device_socket_connect,
+    at_device_socket_close,
+    at_device_socket_send,
     ec20_domain_resolve,
-    ec20_socket_set_event_cb,
+    at_device_socket_set_event_cb,
 #if defined(AT_SW_VERSION_NUM) && AT_SW_VERSION_NUM > 0x10300
     RT_NULL,
 #endif
@@ -990,12 +732,40 @@ static const struct at_socket_ops ec20_socket_ops =
 
 int ec20_socket_init(struct at_device *device)
 {
+    rt_base_t level;
+    struct at_device_urc_dispatcher *dispatcher = RT_NULL;
+
     RT_ASSERT(device);
 
-    /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    if (qiurc_dispatcher == RT_NULL)
+    {
+        dispatcher = at_device_urc_dispatcher_create(qiurc_table, sizeof(qiurc_table) / sizeof(qiurc_table[0]));
 
-    return RT_EOK;
+        /* the devices initialize in parallel, the dispatcher is shared and only the first one is kept */
+        level = rt_hw_interrupt_disable();
+        if (qiurc_dispatcher == RT_NULL)
+        {
+            qiurc_dispatcher = dispatcher;
+            dispatcher = RT_NULL;
+        }
+        rt_hw_interrupt_enable(level);
+
+        if (dispatcher)
+        {
+            at_device_urc_dispatcher_delete(dispatcher);
+        }
+    }
+
+    /* the file, HTTP(S) and FTP(S) URCs are on the control client */
+    ec20_file_init(device);
+#ifdef EC20_USING_HTTP
+    ec20_http_init(device);
+#endif
+#ifdef EC20_USING_FTP
+    ec20_ftp_init(device);
+#endif
+
+    return at_device_socket_init(device);
 }
 
 int ec20_socket_class_register(struct at_device_class *class)
@@ -1004,9 +774,10 @@ int ec20_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_EC20_SOCKETS_NUM;
     class->socket_ops = &ec20_socket_ops;
+    class->socket_dialect = &ec20_socket_dialect;
+    class->socket_tls = &ec20_socket_tls;
 
     return RT_EOK;
 }
 
-
 #endif /* AT_DEVICE_USING_EC20 && AT_USING_SOCKET */
@@ -26,6 +26,10 @@
 #include <string.h>
 
 #include <at_device_ec200x.h>
+#include <at_device_baud.h>
+#include <at_device_cmux.h>
+#include <at_device_ppp.h>
+#include <at_device_mqtt.h>
 
 #define LOG_TAG                         "at.dev.ec200x"
 #include <at_log.h>
@@ -80,6 +84,11 @@ static int ec200x_power_off(struct at_device *device)
 
     ec200x = (struct at_device_ec200x *)device->user_data;
 
+#ifdef AT_DEVICE_EC200X_USING_CMUX
+    /* the module boots in AT command mode, leave CMUX mode before it is powered off */
+    at_device_cmux_stop(device);
+#endif
+
     if (ec200x->power_pin == -1)//no power on pin
     {
         return(RT_EOK);
@@ -106,7 +115,7 @@ static int ec200x_power_off(struct at_device *device)
     }
     else
     {
-        at_obj_exec_cmd(device->client, RT_NULL, "AT+QPOWD=0");
+        at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), RT_NULL, "AT+QPOWD=0");
         rt_thread_mdelay(5*1000);
     }
 
@@ -142,7 +151,7 @@ static int ec200x_sleep(struct at_device *device)
         return(-RT_ERROR);
     }
 
-    if (at_obj_exec_cmd(device->client, resp, "AT+QSCLK=1") != RT_EOK)//enable sleep mode
+    if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QSCLK=1") != RT_EOK)//enable sleep mode
 
     {
         LOG_D("enable sleep fail.\"AT+QSCLK=1\" execute fail.");
@@ -186,7 +195,7 @@ static int ec200x_wakeup(struct at_device *device)
         LOG_D("no memory for resp create.");
         return(-RT_ERROR);
     }
-    if (at_obj_exec_cmd(device->client, resp, "AT+QSCLK=0") != RT_EOK)//disable sleep mode
+    if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QSCLK=0") != RT_EOK)//disable sleep mode
     {
         LOG_D("wake up fail. \"AT+QSCLK=0\" execute fail.");
         at_delete_resp(resp);
@@ -226,7 +235,7 @@ static int ec200x_check_link_status(struct at_device *device)
     }
 
     result = -RT_ERROR;
-    if (at_obj_exec_cmd(device->client, resp, "AT+CGREG?") == RT_EOK)
+    if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+CGREG?") == RT_EOK)
     {
         int link_stat = 0;
         if (at_resp_parse_line_args_by_kw(resp, "+CGREG:", "+CGREG: %*d,%d", &link_stat) > 0)
@@ -292,7 +301,7 @@ static int ec200x_netdev_set_info(struct netdev *netdev)
         int i = 0, j = 0;
 
         /* send "AT+GSN" commond to get device IMEI */
-        if (at_obj_exec_cmd(device->client, resp, "AT+GSN") != RT_EOK)
+        if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+GSN") != RT_EOK)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -328,7 +337,7 @@ static int ec200x_netdev_set_info(struct netdev *netdev)
         char ipaddr[IP_ADDR_SIZE_MAX] = {0};
 
         /* send "AT+CGPADDR=1" commond to get IP address */
-        if (at_obj_exec_cmd(device->client, resp, "AT+CGPADDR=1") != RT_EOK)
+        if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+CGPADDR=1") != RT_EOK)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -355,7 +364,7 @@ static int ec200x_netdev_set_info(struct netdev *netdev)
         char dns_server1[DNS_ADDR_SIZE_MAX] = {0}, dns_server2[DNS_ADDR_SIZE_MAX] = {0};
 
         /* send "AT+QIDNSCFG=1" commond to get DNS servers address */
-        if (at_obj_exec_cmd(device->client, resp, "AT+QIDNSCFG=1") != RT_EOK)
+        if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QIDNSCFG=1") != RT_EOK)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -514,7 +523,7 @@ static int ec200x_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num,
     }
 
     /* send "AT+QIDNSCFG=<pri_dns>[,<sec_dns>]" commond to set dns servers */
-    if (at_obj_exec_cmd(device->client, resp, "AT+QIDNSCFG=%d,%s",
+    if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QIDNSCFG=%d,%s",
         dns_num, inet_ntoa(*dns_server)) != RT_EOK)
     {
         result = -RT_ERROR;
@@ -565,7 +574,7 @@ static int ec200x_netdev_ping(struct netdev *netdev, const char *host,
     }
 
     /* send "AT+QPING=<contextID>"<host>"[,[<timeout>][,<pingnum>]]" commond to send ping request */
-    if (at_obj_exec_cmd(device->client, resp, "AT+QPING=1,%s,%d,1", host, timeout / RT_TICK_PER_SECOND) < 0)
+    if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QPING=1,%s,%d,1", host, timeout / RT_TICK_PER_SECOND) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -664,6 +673,53 @@ static struct netdev *ec200x_netdev_add(const char *netdev_name)
 
 /* =============================  ec200x device operations ============================= */
 
+#ifdef AT_DEVICE_EC200X_BAUD_RATE_MAX
+/* the baud rate is saved by the module, it starts at the negotiated baud rate on the next boot */
+static const struct at_device_baud_cfg ec200x_baud_cfg =
+{
+    "AT+IPR=%d;&W",
+    "AT+IFC=2,2;&W",
+    AT_DEVICE_EC200X_BAUD_RATE_MAX,
+#ifdef AT_DEVICE_EC200X_FLOW_CONTROL
+    RT_TRUE,
+#else
+    RT_FALSE,
+#endif
+    100,
+};
+#endif /* AT_DEVICE_EC200X_BAUD_RATE_MAX */
+
+#ifdef AT_DEVICE_EC200X_USING_CMUX
+/* the socket data and URC use the first channel, the control commands use the second one */
+static const struct at_device_cmux_cfg ec200x_cmux_cfg =
+{
+    "AT+CMUX=0,0,5,127",
+    "ATE0;+CMEE=2",
+    127,
+    1024,
+};
+#endif /* AT_DEVICE_EC200X_USING_CMUX */
+
+#ifdef AT_DEVICE_EC200X_USING_PPP
+#ifndef AT_DEVICE_EC200X_USING_CMUX
+#error "EC200X PPP data call needs the CMUX control channel, please define AT_DEVICE_EC200X_USING_CMUX."
+#endif
+/* the data call uses the default PDP context, release it from the module TCP/IP stack first */
+static const struct at_device_ppp_cfg ec200x_ppp_cfg =
+{
+    "AT+QIDEACT=1",
+    "ATD*99#",
+};
+#endif /* AT_DEVICE_EC200X_USING_PPP */
+
+#ifdef AT_DEVICE_USING_MQTT
+/* the module MQTT client, the payload is written after the '>' prompt */
+static const struct at_device_mqtt_dialect ec200x_mqtt_dialect =
+{
+    "AT+QMTPUBEX=%d,%d,%d,%d,\"%s\",%d",
+};
+#endif /* AT_DEVICE_USING_MQTT */
+
 /* initialize for ec200x */
 static void ec200x_init_thread_entry(void *parameter)
 {
@@ -692,26 +748,33 @@ static void ec200x_init_thread_entry(void *parameter)
 
     while (retry_num--)
     {
+        /* the physical AT client is put back after CMUX stopped by power off */
+        client = device->client;
         /* power on the ec200x device */
         ec200x_power_on(device);
         rt_thread_mdelay(1000);
 
         /* wait ec200x startup finish, send AT every 500ms, if receive OK, SYNC success*/
+#ifdef AT_DEVICE_EC200X_BAUD_RATE_MAX
+        if (at_device_baud_sync(device, &ec200x_baud_cfg, EC200X_WAIT_CONNECT_TIME) != RT_EOK &&
+                at_client_obj_wait_connect(client, EC200X_WAIT_CONNECT_TIME))
+#else
         if (at_client_obj_wait_connect(client, EC200X_WAIT_CONNECT_TIME))
+#endif
         {
             result = -RT_ETIMEOUT;
             goto __exit;
         }
 
         /* disable echo */
-        if (at_obj_exec_cmd(device->client, resp, "ATE0") != RT_EOK)
+        if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "ATE0") != RT_EOK)
         {
             result = -RT_ERROR;
             goto __exit;
         }
 
         /* Get the baudrate */
-        if (at_obj_exec_cmd(device->client, resp, "AT+IPR?") != RT_EOK)
+        if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+IPR?") != RT_EOK)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -719,8 +782,17 @@ static void ec200x_init_thread_entry(void *parameter)
         at_resp_parse_line_args_by_kw(resp, "+IPR:", "+IPR: %d", &i);
         LOG_D("%s device baudrate %d", device->name, i);
 
+#ifdef AT_DEVICE_EC200X_BAUD_RATE_MAX
+        /* raise the baud rate and enable the flow control */
+        if (at_device_baud_negotiate(device, &ec200x_baud_cfg) < 0)
+        {
+            result = -RT_ERROR;
+            goto __exit;
+        }
+#endif
+
         /* get module version */
-        if (at_obj_exec_cmd(device->client, resp, "ATI") != RT_EOK)
+        if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "ATI") != RT_EOK)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -734,7 +806,7 @@ static void ec200x_init_thread_entry(void *parameter)
         for (i = 0; i < CPIN_RETRY; i++)
         {
             rt_thread_mdelay(1000);
-            if (at_obj_exec_cmd(device->client, resp, "AT+CPIN?") == RT_EOK)
+            if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+CPIN?") == RT_EOK)
             {
                 if (at_resp_get_line_by_kw(resp, "READY") != RT_NULL)
                     break;
@@ -751,7 +823,7 @@ static void ec200x_init_thread_entry(void *parameter)
         for (i = 0; i < CSQ_RETRY; i++)
         {
             rt_thread_mdelay(1000);
-            if (at_obj_exec_cmd(device->client, resp, "AT+CSQ") == RT_EOK)
+            if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+CSQ") == RT_EOK)
             {
                 int signal_strength = 0, err_rate = 0;
 
@@ -777,7 +849,7 @@ static void ec200x_init_thread_entry(void *parameter)
         for (i = 0; i < CGREG_RETRY; i++)
         {
             rt_thread_mdelay(1000);
-            if (at_obj_exec_cmd(device->client, resp, "AT+CGREG?") == RT_EOK)
+            if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+CGREG?") == RT_EOK)
             {
                 int link_stat = 0;
 
@@ -800,7 +872,7 @@ static void ec200x_init_thread_entry(void *parameter)
 
         if (((struct at_device_ec200x *)(device->user_data))->wakeup_pin != -1)//use wakeup pin
         {
-            if (at_obj_exec_cmd(device->client, resp, "AT+QSCLK=1") != RT_EOK)// enable sleep mode fail
+            if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QSCLK=1") != RT_EOK)// enable sleep mode fail
             {
                 result = -RT_ERROR;
                 goto __exit;
@@ -808,7 +880,7 @@ static void ec200x_init_thread_entry(void *parameter)
         }
 
         /* Close Echo the Data */
-        if (at_obj_exec_cmd(device->client, resp, "AT+QISDE=0") != RT_EOK)
+        if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QISDE=0") != RT_EOK)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -816,7 +888,7 @@ static void ec200x_init_thread_entry(void *parameter)
 
         /* Deactivate context profile */
         resp = at_resp_set_info(resp, RESP_SIZE, 0, rt_tick_from_millisecond(40*1000));
-        if (at_obj_exec_cmd(device->client, resp, "AT+QIDEACT=1") != RT_EOK)
+        if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QIDEACT=1") != RT_EOK)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -824,11 +896,38 @@ static void ec200x_init_thread_entry(void *parameter)
 
         /* Activate context profile */
         resp = at_resp_set_info(resp, RESP_SIZE, 0, rt_tick_from_millisecond(150*1000));
-        if (at_obj_exec_cmd(device->client, resp, "AT+QIACT=1") != RT_EOK)
+        if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QIACT=1") != RT_EOK)
+        {
+            result = -RT_ERROR;
+            goto __exit;
+        }
+
+#ifdef AT_DEVICE_EC200X_USING_CMUX
+        /* enter CMUX mode, the background commands do not queue behind the socket data */
+        if (at_device_cmux_start(device, &ec200x_cmux_cfg) < 0)
+        {
+            result = -RT_ERROR;
+            goto __exit;
+        }
+#ifdef AT_USING_SOCKET
+        /* register URC to the data channel AT client */
+        ec200x_socket_init(device);
+#endif
+#endif /* AT_DEVICE_EC200X_USING_CMUX */
+
+#ifdef AT_DEVICE_USING_MQTT
+        /* the MQTT URCs are on the control client */
+        at_device_mqtt_init(device, &ec200x_mqtt_dialect);
+#endif
+
+#ifdef AT_DEVICE_EC200X_USING_PPP
+        /* the sockets use lwIP over the data call instead of the module TCP/IP stack */
+        if (at_device_ppp_start(device, &ec200x_ppp_cfg) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
         }
+#endif /* AT_DEVICE_EC200X_USING_PPP */
 
         /* initialize successfully  */
         result = RT_EOK;
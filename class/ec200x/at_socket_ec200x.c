@@ -26,6 +26,9 @@
 #include <string.h>
 
 #include <at_device_ec200x.h>
+#include <at_device_urc.h>
+#include <at_device_socket.h>
+#include <at_device_parser.h>
 
 #define LOG_TAG                        "at.skt.ec200x"
 #include <at_log.h>
@@ -33,6 +36,8 @@
 #if defined(AT_DEVICE_USING_EC200X) && defined(AT_USING_SOCKET)
 
 #define EC200X_MODULE_SEND_MAX_SIZE       1460
+/* the time in second the module waits for the upload file data */
+#define EC200X_FILE_UPLOAD_TIMEOUT        10
 
 /* set real event by current socket and current state */
 #define SET_EVENT(socket, event)       (((socket + 1) << 16) | (event))
@@ -45,6 +50,7 @@
 #define EC200X_EVENT_CONN_FAIL           (1L << 4)
 #define EC200X_EVENT_SEND_FAIL           (1L << 5)
 #define EC200X_EVENT_DOMAIN_OK           (1L << 6)
+#define EC200X_EVENT_FILE_OK             (1L << 8)
 
 static at_evt_cb_t at_evt_cb_set[] = {
         [AT_SOCKET_EVT_RECV] = NULL,
@@ -130,13 +136,102 @@ static int ec200x_socket_close(struct at_socket *socket)
         return -RT_ENOMEM;
     }
 
-    result = at_obj_exec_cmd(device->client, resp, "AT+QICLOSE=%d", device_socket);
+    if (device->socket_info[device_socket].tls)
+    {
+        result = at_obj_exec_cmd(device->client, resp, "AT+QSSLCLOSE=%d,1", device_socket);
+    }
+    else
+    {
+        result = at_obj_exec_cmd(device->client, resp, "AT+QICLOSE=%d", device_socket);
+    }
+    device->socket_info[device_socket].is_listen = RT_FALSE;
+    device->socket_info[device_socket].tls = RT_NULL;
 
     at_delete_resp(resp);
 
     return result;
 }
 
+/**
+ * configure the SSL context of the socket, the SSL context number is the same
+ * as the socket number, the module supports 6 SSL contexts.
+ *
+ * @param socket current socket
+ * @param cfg the TLS configuration
+ *
+ * @return  0: config success
+ *         -1: send AT commands error
+ *         -5: no memory
+ */
+static int ec200x_socket_tls_config(struct at_socket *socket, const struct at_device_tls_cfg *cfg)
+{
+    int seclevel = 0, result = RT_EOK;
+    at_response_t resp = RT_NULL;
+    int device_socket = (int) socket->user_data;
+    struct at_device *device = (struct at_device *) socket->device;
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    /* seclevel 0: no authentication, 1: server authentication, 2: server and client authentication */
+    if (cfg->ca_file)
+    {
+        seclevel = cfg->cert_file ? 2 : 1;
+    }
+
+    /* all the SSL versions and cipher suites, the server selects */
+    if (at_obj_exec_cmd(device->client, resp, "AT+QSSLCFG=\"sslversion\",%d,4", device_socket) < 0 ||
+            at_obj_exec_cmd(device->client, resp, "AT+QSSLCFG=\"ciphersuite\",%d,0xFFFF", device_socket) < 0 ||
+            at_obj_exec_cmd(device->client, resp, "AT+QSSLCFG=\"seclevel\",%d,%d", device_socket, seclevel) < 0)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    if (cfg->ca_file &&
+            at_obj_exec_cmd(device->client, resp, "AT+QSSLCFG=\"cacert\",%d,\"%s\"", device_socket, cfg->ca_file) < 0)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    if (cfg->cert_file &&
+            (at_obj_exec_cmd(device->client, resp, "AT+QSSLCFG=\"clientcert\",%d,\"%s\"", device_socket, cfg->cert_file) < 0 ||
+             (cfg->key_file &&
+              at_obj_exec_cmd(device->client, resp, "AT+QSSLCFG=\"clientkey\",%d,\"%s\"", device_socket, cfg->key_file) < 0)))
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    /* the server name is taken from the address of "AT+QSSLOPEN" */
+    if (cfg->hostname &&
+            at_obj_exec_cmd(device->client, resp, "AT+QSSLCFG=\"sni\",%d,1", device_socket) < 0)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    /* the session resumption only saves the handshake, the connect works without it */
+    if (cfg->session_resume &&
+            at_obj_exec_cmd(device->client, resp, "AT+QSSLCFG=\"sessioncache\",%d,1", device_socket) < 0)
+    {
+        LOG_W("%s device socket(%d) session resumption is not supported.", device->name, device_socket);
+    }
+
+__exit:
+    if (resp)
+    {
+        at_delete_resp(resp);
+    }
+
+    return result;
+}
+
 /**
  * create TCP/UDP client or server connect by AT commands.
  *
@@ -158,17 +253,20 @@ static int ec200x_socket_connect(struct at_socket *socket, char *ip, int32_t por
 
     int i = 0;
     const char *type_str = RT_NULL;
+    int32_t remote_port = port, local_port = 0;
     uint32_t event = 0;
     at_response_t resp = RT_NULL;
     int result = 0, event_result = 0;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
+    const struct at_device_tls_cfg *tls = device->socket_info[device_socket].tls;
 
     RT_ASSERT(ip);
     RT_ASSERT(port >= 0);
 
-    if ( ! is_client)
+    if (tls && (type != AT_SOCKET_TCP || !is_client))
     {
+        LOG_E("%s device socket(%d) TLS only support TCP client.", device->name, device_socket);
         return -RT_ERROR;
     }
 
@@ -176,8 +274,21 @@ static int ec200x_socket_connect(struct at_socket *socket, char *ip, int32_t por
     {
         case AT_SOCKET_TCP:
             type_str = "TCP";
+            if ( ! is_client)
+            {
+                /* the IP address of listener must be "127.0.0.1", the remote port is ignored */
+                type_str = "TCP LISTENER";
+                ip = "127.0.0.1";
+                remote_port = 0;
+                local_port = port;
+            }
             break;
         case AT_SOCKET_UDP:
+            if ( ! is_client)
+            {
+                LOG_E("%s device socket(%d) not support UDP server mode.", device->name, device_socket);
+                return -RT_ERROR;
+            }
             type_str = "UDP";
             break;
         default:
@@ -192,14 +303,31 @@ static int ec200x_socket_connect(struct at_socket *socket, char *ip, int32_t por
         return -RT_ENOMEM;
     }
 
+    if (tls && ec200x_socket_tls_config(socket, tls) < 0)
+    {
+        LOG_E("%s device socket(%d) TLS config failed.", device->name, device_socket);
+        at_delete_resp(resp);
+        return -RT_ERROR;
+    }
+
     for(i=0; i<CONN_RETRY; i++)
     {
         /* clear socket connect event */
         event = SET_EVENT(device_socket, EC200X_EVENT_CONN_OK | EC200X_EVENT_CONN_FAIL);
         ec200x_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
 
-        if (at_obj_exec_cmd(device->client, resp, "AT+QIOPEN=1,%d,\"%s\",\"%s\",%d,0,1",
-                            device_socket, type_str, ip, port) < 0)
+        if (tls)
+        {
+            /* the SSL client connects to the host name, the module checks it with the server certificate */
+            result = at_obj_exec_cmd(device->client, resp, "AT+QSSLOPEN=1,%d,%d,\"%s\",%d,1",
+                                     device_socket, device_socket, tls->hostname ? tls->hostname : ip, remote_port);
+        }
+        else
+        {
+            result = at_obj_exec_cmd(device->client, resp, "AT+QIOPEN=1,%d,\"%s\",\"%s\",%d,%d,1",
+                                     device_socket, type_str, ip, remote_port, local_port);
+        }
+        if (result < 0)
         {
             result = -RT_ERROR;
             break;
@@ -236,6 +364,8 @@ static int ec200x_socket_connect(struct at_socket *socket, char *ip, int32_t por
             result = -RT_ERROR;
             break;
         }
+        /* the retry connects with the same TLS configuration */
+        device->socket_info[device_socket].tls = tls;
     }
 
     if (i == CONN_RETRY)
@@ -243,6 +373,10 @@ static int ec200x_socket_connect(struct at_socket *socket, char *ip, int32_t por
         LOG_E("%s device socket(%d) connect failed.", device->name, device_socket);
         result = -RT_ERROR;
     }
+    else if (result == RT_EOK && !is_client)
+    {
+        device->socket_info[device_socket].is_listen = RT_TRUE;
+    }
 
     if (resp)
     {
@@ -364,7 +498,8 @@ static int ec200x_socket_send(struct at_socket *socket, const char *buff, size_t
         }
 
         /* send the "AT+QISEND" commands to AT server than receive the '>' response on the first line. */
-        if (at_obj_exec_cmd(device->client, resp, "AT+QISEND=%d,%d", device_socket, (int)cur_pkt_size) < 0)
+        if (at_obj_exec_cmd(device->client, resp, device->socket_info[device_socket].tls ? "AT+QSSLSEND=%d,%d" : "AT+QISEND=%d,%d",
+                            device_socket, (int)cur_pkt_size) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -429,6 +564,79 @@ __exit:
     return result > 0 ? sent_size : result;
 }
 
+/**
+ * write the file to the module UFS, the file with the same name is replaced.
+ *
+ * @param device the AT device
+ * @param name the file name
+ * @param data the file data
+ * @param size the file size
+ *
+ * @return  0: upload success
+ *         -1: send AT commands error or send data error
+ *         -2: wait upload result timeout
+ *         -5: no memory
+ */
+static int ec200x_file_upload(struct at_device *device, const char *name, const char *data, size_t size)
+{
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+    rt_mutex_t lock = device->client->lock;
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    rt_mutex_take(lock, RT_WAITING_FOREVER);
+
+    /* the file may not exist, ignore the result */
+    at_obj_exec_cmd(device->client, resp, "AT+QFDEL=\"%s\"", name);
+
+    /* clear file upload event */
+    ec200x_socket_event_recv(device, EC200X_EVENT_FILE_OK, 0, RT_EVENT_FLAG_OR);
+
+    /* the module enters the data mode after "CONNECT" */
+    resp = at_resp_set_info(resp, 64, 1, rt_tick_from_millisecond(5000));
+    if (at_obj_exec_cmd(device->client, resp, "AT+QFUPL=\"%s\",%d,%d", name, (int) size, EC200X_FILE_UPLOAD_TIMEOUT) < 0 ||
+            at_resp_get_line_by_kw(resp, "CONNECT") == RT_NULL)
+    {
+        LOG_E("%s device upload file(%s) failed.", device->name, name);
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    if (at_client_obj_send(device->client, data, size) != size)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    /* the upload result is reported by "+QFUPL" URC */
+    if (ec200x_socket_event_recv(device, EC200X_EVENT_FILE_OK,
+                                 EC200X_FILE_UPLOAD_TIMEOUT * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
+    {
+        LOG_E("%s device upload file(%s) wait result timeout.", device->name, name);
+        result = -RT_ETIMEOUT;
+        goto __exit;
+    }
+
+    /* the "OK" follows the URC, let it pass before the next command */
+    rt_thread_mdelay(10);
+
+__exit:
+    rt_mutex_release(lock);
+
+    if (resp)
+    {
+        at_delete_resp(resp);
+    }
+
+    return result;
+}
+
 /**
  * domain resolve by AT commands.
  *
@@ -527,6 +735,9 @@ static void ec200x_socket_set_event_cb(at_socket_evt_t event, at_evt_cb_t cb)
     {
         at_evt_cb_set[event] = cb;
     }
+
+    /* the accepted connection is noticed by the shared socket helper */
+    at_device_socket_set_event_cb(event, cb);
 }
 
 static void urc_connect_func(struct at_client *client, const char *data, rt_size_t size)
@@ -534,6 +745,7 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
     int device_socket = 0, result = 0;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -544,7 +756,14 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
         return;
     }
 
-    sscanf(data, "+QIOPEN: %d,%d", &device_socket , &result);
+    /* the SSL client reports the same fields as the TCP/IP socket */
+    at_device_parser_init(&parser, data, size);
+    if ((at_device_parser_expect(&parser, "+QIOPEN:") < 0 && at_device_parser_expect(&parser, "+QSSLOPEN:") < 0) ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_int(&parser, &result) < 0)
+    {
+        return;
+    }
 
     if (result == 0)
     {
@@ -592,6 +811,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
     struct at_socket *socket = RT_NULL;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -602,9 +822,19 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    sscanf(data, "+QIURC: \"closed\",%d", &device_socket);
+    at_device_parser_init(&parser, data, size);
+    if ((at_device_parser_expect(&parser, "+QIURC: \"closed\",") < 0 &&
+            at_device_parser_expect(&parser, "+QSSLURC: \"closed\",") < 0) ||
+            at_device_parser_int(&parser, &device_socket) < 0)
+    {
+        return;
+    }
     /* get at socket object by device socket descriptor */
-    socket = &(device->sockets[device_socket]);
+    socket = at_device_socket_get(device, device_socket);
+    if (socket == RT_NULL)
+    {
+        return;
+    }
 
     /* notice the socket is disconnect by remote */
     if (at_evt_cb_set[AT_SOCKET_EVT_CLOSED])
@@ -622,6 +852,7 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     struct at_socket *socket = RT_NULL;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -633,7 +864,14 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     }
 
     /* get the current socket and receive buffer size by receive data */
-    sscanf(data, "+QIURC: \"recv\",%d,%d", &device_socket, (int *) &bfsz);
+    at_device_parser_init(&parser, data, size);
+    if ((at_device_parser_expect(&parser, "+QIURC: \"recv\",") < 0 &&
+            at_device_parser_expect(&parser, "+QSSLURC: \"recv\",") < 0) ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_size(&parser, &bfsz) < 0)
+    {
+        return;
+    }
     /* set receive timeout by receive buffer length, not less than 10 ms */
     timeout = bfsz > 10 ? bfsz : 10;
 
@@ -671,7 +909,12 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     }
 
     /* get at socket object by device socket descriptor */
-    socket = &(device->sockets[device_socket]);
+    socket = at_device_socket_get(device, device_socket);
+    if (socket == RT_NULL)
+    {
+        rt_free(recv_buf);
+        return;
+    }
 
     /* notice the receive buffer and buffer size */
     if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
@@ -680,24 +923,59 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     }
 }
 
+static void urc_incoming_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    int device_socket = -1, server_socket = -1;
+    struct at_device *device = RT_NULL;
+    char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    if (device == RT_NULL)
+    {
+        LOG_E("get device(%s) failed.", client_name);
+        return;
+    }
+
+    /* +QIURC: "incoming",<connectID>,<serverID>,<remoteIP>,<remote_port> */
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+QIURC: \"incoming\",") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_int(&parser, &server_socket) < 0)
+    {
+        return;
+    }
+
+    LOG_D("%s device socket(%d) accepted connection(%d).", device->name, server_socket, device_socket);
+    at_device_socket_accept_notice(device, device_socket);
+}
+
 static void urc_pdpdeact_func(struct at_client *client, const char *data, rt_size_t size)
 {
     int connectID = 0;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
-    sscanf(data, "+QIURC: \"pdpdeact\",%d", &connectID);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+QIURC: \"pdpdeact\",") < 0 ||
+            at_device_parser_int(&parser, &connectID) < 0)
+    {
+        return;
+    }
 
     LOG_E("context (%d) is deactivated.", connectID);
 }
 
 static void urc_dnsqip_func(struct at_client *client, const char *data, rt_size_t size)
 {
-    int i = 0, j = 0;
     char recv_ip[16] = {0};
-    int result, ip_count, dns_ttl;
+    int result = 0;
     struct at_device *device = RT_NULL;
     struct at_device_ec200x *ec200x = RT_NULL;
+    struct at_device_parser parser;
     char *client_name = client->device->parent.name;
 
     RT_ASSERT(data && size);
@@ -716,31 +994,53 @@ static void urc_dnsqip_func(struct at_client *client, const char *data, rt_size_
         return;
     }
 
-    for (i = 0; i < size; i++)
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+QIURC: \"dnsgip\",") < 0)
     {
-        if (*(data + i) == '.')
-            j++;
+        return;
     }
+
     /* There would be several dns result, we just pickup one */
-    if (j == 3)
+    if (at_device_parser_ipv4(&parser, recv_ip) == 0)
     {
-        sscanf(data, "+QIURC: \"dnsgip\",\"%[^\"]", recv_ip);
-        recv_ip[15] = '\0';
-
         rt_memcpy(ec200x->socket_data, recv_ip, sizeof(recv_ip));
 
         ec200x_socket_event_send(device, EC200X_EVENT_DOMAIN_OK);
     }
-    else
+    else if (at_device_parser_int(&parser, &result) == 0 && result)
     {
-        sscanf(data, "+QIURC: \"dnsgip\",%d,%d,%d", &result, &ip_count, &dns_ttl);
-        if (result)
-        {
-            at_tcp_ip_errcode_parse(result);
-        }
+        /* +QIURC: "dnsgip",<err>,<IP_count>,<DNS_ttl> */
+        at_tcp_ip_errcode_parse(result);
     }
 }
 
+static void urc_file_upload_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    int upload_size = 0;
+    struct at_device *device = RT_NULL;
+    char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    if (device == RT_NULL)
+    {
+        LOG_E("get device(%s) failed.", client_name);
+        return;
+    }
+
+    /* +QFUPL: <upload_size>,<checksum> */
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+QFUPL:") < 0 || at_device_parser_int(&parser, &upload_size) < 0)
+    {
+        return;
+    }
+
+    LOG_D("%s device file uploaded(%d).", device->name, upload_size);
+    ec200x_socket_event_send(device, EC200X_EVENT_FILE_OK);
+}
+
 static void urc_func(struct at_client *client, const char *data, rt_size_t size)
 {
     RT_ASSERT(data);
@@ -756,6 +1056,7 @@ static void urc_qiurc_func(struct at_client *client, const char *data, rt_size_t
     {
     case 'c' : urc_close_func(client, data, size); break;//+QIURC: "closed"
     case 'r' : urc_recv_func(client, data, size); break;//+QIURC: "recv"
+    case 'i' : urc_incoming_func(client, data, size); break;//+QIURC: "incoming"
     case 'p' : urc_pdpdeact_func(client, data, size); break;//+QIURC: "pdpdeact"
     case 'd' : urc_dnsqip_func(client, data, size); break;//+QIURC: "dnsgip"
     default  : urc_func(client, data, size);      break;
@@ -768,6 +1069,16 @@ static const struct at_urc urc_table[] =
     {"SEND FAIL",   "\r\n",                 urc_send_func},
     {"+QIOPEN:",    "\r\n",                 urc_connect_func},
     {"+QIURC:",     "\r\n",                 urc_qiurc_func},
+    {"+QSSLOPEN:",  "\r\n",                 urc_connect_func},
+    {"+QSSLURC: \"recv\"",   "\r\n",        urc_recv_func},
+    {"+QSSLURC: \"closed\"", "\r\n",        urc_close_func},
+    {"+QFUPL:",     "\r\n",                 urc_file_upload_func},
+};
+
+static const struct at_device_socket_tls ec200x_socket_tls =
+{
+    ec200x_socket_tls_config,
+    ec200x_file_upload,
 };
 
 static const struct at_socket_ops ec200x_socket_ops =
@@ -787,7 +1098,7 @@ int ec200x_socket_init(struct at_device *device)
     RT_ASSERT(device);
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
     return RT_EOK;
 }
@@ -798,6 +1109,7 @@ int ec200x_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_EC200X_SOCKETS_NUM;
     class->socket_ops = &ec200x_socket_ops;
+    class->socket_tls = &ec200x_socket_tls;
 
     return RT_EOK;
 }
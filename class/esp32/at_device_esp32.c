@@ -26,6 +26,7 @@
 #include <string.h>
 
 #include <at_device_esp32.h>
+#include <at_device_urc.h>
 
 #define LOG_TAG                        "at.dev.esp32"
 
@@ -800,7 +801,7 @@ static int esp32_init(struct at_device *device)
     }
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
 #ifdef AT_USING_SOCKET
     esp32_socket_init(device);
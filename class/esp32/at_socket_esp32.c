@@ -24,9 +24,13 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <at_device_esp32.h>
+#include <at_device_urc.h>
+#include <at_device_socket.h>
+#include <at_device_parser.h>
 
 #define LOG_TAG                       "at.skt.esp32"
 #include <at_log.h>
@@ -93,7 +97,17 @@ static int esp32_socket_close(struct at_socket *socket)
         return -RT_ENOMEM;
     }
 
-    result = at_obj_exec_cmd(device->client, resp, "AT+CIPCLOSE=%d", device_socket);
+    if (device->socket_info[device_socket].is_listen)
+    {
+        /* the ESP32 supports only one server, delete it */
+        result = at_obj_exec_cmd(device->client, resp, "AT+CIPSERVER=0");
+        device->socket_info[device_socket].is_listen = RT_FALSE;
+    }
+    else
+    {
+        result = at_obj_exec_cmd(device->client, resp, "AT+CIPCLOSE=%d", device_socket);
+    }
+    device->socket_info[device_socket].tls = RT_NULL;
 
     if (resp)
     {
@@ -103,6 +117,71 @@ static int esp32_socket_close(struct at_socket *socket)
     return result;
 }
 
+/**
+ * configure the SSL client of the link, the certificates and keys are provisioned
+ * in the module flash, so the file names are the PKI numbers, such as "0".
+ *
+ * @param socket current socket
+ * @param cfg the TLS configuration
+ *
+ * @return  0: config success
+ *         -1: send AT commands error
+ *         -5: no memory
+ */
+static int esp32_socket_tls_config(struct at_socket *socket, const struct at_device_tls_cfg *cfg)
+{
+    int result = RT_EOK;
+    int auth_mode = 0, pki_number = 0, ca_number = 0;
+    at_response_t resp = RT_NULL;
+    int device_socket = (int) socket->user_data;
+    struct at_device *device = (struct at_device *) socket->device;
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    /* auth_mode bit0: provide the client certificate, bit1: verify the server certificate */
+    if (cfg->cert_file)
+    {
+        auth_mode |= 0x01;
+        pki_number = atoi(cfg->cert_file);
+    }
+    if (cfg->ca_file)
+    {
+        auth_mode |= 0x02;
+        ca_number = atoi(cfg->ca_file);
+    }
+
+    if (at_obj_exec_cmd(device->client, resp, "AT+CIPSSLCCONF=%d,%d,%d,%d",
+                        device_socket, auth_mode, pki_number, ca_number) < 0)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    if (cfg->hostname && at_obj_exec_cmd(device->client, resp, "AT+CIPSSLCSNI=%d,\"%s\"", device_socket, cfg->hostname) < 0)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    if (cfg->session_resume)
+    {
+        LOG_D("%s device socket(%d) session resumption is managed by the module.", device->name, device_socket);
+    }
+
+__exit:
+    if (resp)
+    {
+        at_delete_resp(resp);
+    }
+
+    return result;
+}
+
 /**
  * create TCP/UDP client or server connect by AT commands.
  *
@@ -124,10 +203,17 @@ static int esp32_socket_connect(struct at_socket *socket, char *ip, int32_t port
     at_response_t resp = RT_NULL;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
+    const struct at_device_tls_cfg *tls = device->socket_info[device_socket].tls;
 
     RT_ASSERT(ip);
     RT_ASSERT(port >= 0);
 
+    if (tls && (type != AT_SOCKET_TCP || !is_client))
+    {
+        LOG_E("%s device socket(%d) TLS only support TCP client.", device->name, device_socket);
+        return -RT_ERROR;
+    }
+
     resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
@@ -141,6 +227,18 @@ __retry:
         switch (type)
         {
         case AT_SOCKET_TCP:
+            if (tls)
+            {
+                /* the SSL link connects to the host name if set, the handshake is done in the command */
+                if (esp32_socket_tls_config(socket, tls) < 0 ||
+                        at_obj_exec_cmd(device->client, resp, "AT+CIPSTART=%d,\"SSL\",\"%s\",%d,60",
+                                        device_socket, tls->hostname ? tls->hostname : ip, port) < 0)
+                {
+                    result = -RT_ERROR;
+                }
+                break;
+            }
+
             /* send AT commands to connect TCP server */
             if (at_obj_exec_cmd(device->client, resp,
                                 "AT+CIPSTART=%d,\"TCP\",\"%s\",%d,60", device_socket, ip, port) < 0)
@@ -163,6 +261,23 @@ __retry:
             goto __exit;
         }
     }
+    else
+    {
+        if (type != AT_SOCKET_TCP)
+        {
+            LOG_E("not supported server type %d.", type);
+            result = -RT_ERROR;
+            goto __exit;
+        }
+
+        /* the server accepts the connections on the free link IDs */
+        if (at_obj_exec_cmd(device->client, resp, "AT+CIPSERVER=1,%d", port) < 0)
+        {
+            result = -RT_ERROR;
+            goto __exit;
+        }
+        device->socket_info[device_socket].is_listen = RT_TRUE;
+    }
 
     if (result != RT_EOK && retryed == RT_FALSE)
     {
@@ -172,6 +287,8 @@ __retry:
         {
             goto __exit;
         }
+        /* the retry connects with the same TLS configuration */
+        device->socket_info[device_socket].tls = tls;
         retryed = RT_TRUE;
         result = RT_EOK;
         goto __retry;
@@ -384,6 +501,9 @@ static void esp32_socket_set_event_cb(at_socket_evt_t event, at_evt_cb_t cb)
     {
         at_evt_cb_set[event] = cb;
     }
+
+    /* the accepted connection is noticed by the shared socket helper */
+    at_device_socket_set_event_cb(event, cb);
 }
 
 static const struct at_socket_ops esp32_socket_ops =
@@ -429,10 +549,15 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
 static void urc_send_bfsz_func(struct at_client *client, const char *data, rt_size_t size)
 {
     static int cur_send_bfsz = 0;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
-    sscanf(data, "Recv %d bytes", &cur_send_bfsz);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "Recv") == 0)
+    {
+        at_device_parser_int(&parser, &cur_send_bfsz);
+    }
 }
 
 static void urc_close_func(struct at_client *client, const char *data, rt_size_t size)
@@ -441,6 +566,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
     struct at_socket *socket = RT_NULL;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -451,8 +577,16 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    sscanf(data, "%d,CLOSED", &index);
-    socket = &(device->sockets[index]);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_int(&parser, &index) < 0)
+    {
+        return;
+    }
+    socket = at_device_socket_get(device, index);
+    if (socket == RT_NULL)
+    {
+        return;
+    }
 
     /* notice the socket is disconnect by remote */
     if (at_evt_cb_set[AT_SOCKET_EVT_CLOSED])
@@ -461,6 +595,35 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
     }
 }
 
+#ifdef AT_USING_SOCKET_SERVER
+/* the accepted connection of the TCP server */
+static void urc_connect_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    int index = -1;
+    struct at_device *device = RT_NULL;
+    char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    if (device == RT_NULL)
+    {
+        LOG_E("get device(%s) failed.", client_name);
+        return;
+    }
+
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_int(&parser, &index) < 0)
+    {
+        return;
+    }
+
+    /* the client connection reports it too, it is ignored by the socket in use */
+    at_device_socket_accept_notice(device, index);
+}
+#endif /* AT_USING_SOCKET_SERVER */
+
 static void urc_recv_func(struct at_client *client, const char *data, rt_size_t size)
 {
     int device_socket = 0;
@@ -470,6 +633,7 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     struct at_socket *socket = RT_NULL;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -481,7 +645,13 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     }
 
     /* get the at deveice socket and receive buffer size by receive data */
-    sscanf(data, "+IPD,%d,%d:", &device_socket, (int *) &bfsz);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+IPD,") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_size(&parser, &bfsz) < 0)
+    {
+        return;
+    }
 
     /* set receive timeout by receive buffer length, not less than 10ms */
     timeout = bfsz > 10 ? bfsz : 10;
@@ -518,7 +688,12 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     }
 
     /* get at socket object by device socket descriptor */
-    socket = &(device->sockets[device_socket]);
+    socket = at_device_socket_get(device, device_socket);
+    if (socket == RT_NULL)
+    {
+        rt_free(recv_buf);
+        return;
+    }
 
     /* notice the receive buffer and buffer size */
     if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
@@ -533,15 +708,25 @@ static const struct at_urc urc_table[] =
     {"SEND FAIL",        "\r\n",           urc_send_func},
     {"Recv",             "bytes\r\n",      urc_send_bfsz_func},
     {"",                 ",CLOSED\r\n",    urc_close_func},
+#ifdef AT_USING_SOCKET_SERVER
+    {"",                 ",CONNECT\r\n",   urc_connect_func},
+#endif
     {"+IPD",             ":",              urc_recv_func},
 };
 
+/* the certificates are provisioned in the module flash, no file upload */
+static const struct at_device_socket_tls esp32_socket_tls =
+{
+    esp32_socket_tls_config,
+    RT_NULL,
+};
+
 int esp32_socket_init(struct at_device *device)
 {
     RT_ASSERT(device);
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
     return RT_EOK;
 }
@@ -552,6 +737,7 @@ int esp32_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_ESP32_SOCKETS_NUM;
     class->socket_ops = &esp32_socket_ops;
+    class->socket_tls = &esp32_socket_tls;
 
     return RT_EOK;
 }
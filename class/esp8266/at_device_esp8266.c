@@ -27,6 +27,7 @@
 #include <string.h>
 
 #include <at_device_esp8266.h>
+#include <at_device_urc.h>
 
 #define LOG_TAG                        "at.dev.esp"
 
@@ -661,6 +662,8 @@ static void esp8266_init_thread_entry(void *parameter)
         }
 
         AT_SEND_CMD(client, resp, "AT+CIPMUX=1");
+        /* show the remote address in the receive URC */
+        AT_SEND_CMD(client, resp, "AT+CIPDINFO=1");
 
         /* initialize successfully  */
         result = RT_EOK;
@@ -801,7 +804,7 @@ static int esp8266_init(struct at_device *device)
     }
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
 #ifdef AT_USING_SOCKET
     esp8266_socket_init(device);
@@ -21,12 +21,15 @@
  * Date           Author       Notes
  * 2018-06-20     chenyong     first version
  * 2019-05-09     chenyong     multi AT socket client support
+ * 2026-10-19     agent        use the shared socket engine
  */
 
 #include <stdio.h>
 #include <string.h>
 
 #include <at_device_esp8266.h>
+#include <at_device_socket.h>
+#include <at_device_parser.h>
 
 #define LOG_TAG                       "at.skt.esp"
 #include <at_log.h>
@@ -34,267 +37,6 @@
 #if defined(AT_DEVICE_USING_ESP8266) && defined(AT_USING_SOCKET)
 
 #define ESP8266_MODULE_SEND_MAX_SIZE   2048
-/* set real event by current socket and current state */
-#define SET_EVENT(socket, event)       (((socket + 1) << 16) | (event))
-
-/* AT socket event type */
-#define ESP8266_EVENT_CONN_OK          (1L << 0)
-#define ESP8266_EVENT_SEND_OK          (1L << 1)
-#define ESP8266_EVENT_RECV_OK          (1L << 2)
-#define ESP8266_EVNET_CLOSE_OK         (1L << 3)
-#define ESP8266_EVENT_CONN_FAIL        (1L << 4)
-#define ESP8266_EVENT_SEND_FAIL        (1L << 5)
-
-static at_evt_cb_t at_evt_cb_set[] = {
-        [AT_SOCKET_EVT_RECV] = NULL,
-        [AT_SOCKET_EVT_CLOSED] = NULL,
-};
-
-static int esp8266_socket_event_send(struct at_device *device, uint32_t event)
-{
-    return (int) rt_event_send(device->socket_event, event);
-}
-
-static int esp8266_socket_event_recv(struct at_device *device, uint32_t event, uint32_t timeout, rt_uint8_t option)
-{
-    int result = 0;
-    rt_uint32_t recved;
-
-    result = rt_event_recv(device->socket_event, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
-    if (result != RT_EOK)
-    {
-        return -RT_ETIMEOUT;
-    }
-
-    return recved;
-}
-
-/**
- * close socket by AT commands.
- *
- * @param current socket
- *
- * @return  0: close socket success
- *         -1: send AT commands error
- *         -2: wait socket event timeout
- *         -5: no memory
- */
-static int esp8266_socket_close(struct at_socket *socket)
-{
-    int result = RT_EOK;
-    at_response_t resp = RT_NULL;
-    int device_socket = (int) socket->user_data;
-    struct at_device *device = (struct at_device *) socket->device;
-
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
-    if (resp == RT_NULL)
-    {
-        LOG_E("no memory for resp create.");
-        return -RT_ENOMEM;
-    }
-
-    result = at_obj_exec_cmd(device->client, resp, "AT+CIPCLOSE=%d", device_socket);
-
-    if (resp)
-    {
-        at_delete_resp(resp);
-    }
-
-    return result;
-}
-
-/**
- * create TCP/UDP client or server connect by AT commands.
- *
- * @param socket current socket
- * @param ip server or client IP address
- * @param port server or client port
- * @param type connect socket type(tcp, udp)
- * @param is_client connection is client
- *
- * @return   0: connect success
- *          -1: connect failed, send commands error or type error
- *          -2: wait socket event timeout
- *          -5: no memory
- */
-static int esp8266_socket_connect(struct at_socket *socket, char *ip, int32_t port, enum at_socket_type type, rt_bool_t is_client)
-{
-    int result = RT_EOK;
-    rt_bool_t retryed = RT_FALSE;
-    at_response_t resp = RT_NULL;
-    int device_socket = (int) socket->user_data;
-    struct at_device *device = (struct at_device *) socket->device;
-
-    RT_ASSERT(ip);
-    RT_ASSERT(port >= 0);
-
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
-    if (resp == RT_NULL)
-    {
-        LOG_E("no memory for resp create.");
-        return -RT_ENOMEM;
-    }
-
-__retry:
-    if (is_client)
-    {
-        switch (type)
-        {
-        case AT_SOCKET_TCP:
-            /* send AT commands to connect TCP server */
-            if (at_obj_exec_cmd(device->client, resp,
-                                "AT+CIPSTART=%d,\"TCP\",\"%s\",%d,60", device_socket, ip, port) < 0)
-            {
-                result = -RT_ERROR;
-            }
-            break;
-
-        case AT_SOCKET_UDP:
-            if (at_obj_exec_cmd(device->client, resp,
-                                "AT+CIPSTART=%d,\"UDP\",\"%s\",%d", device_socket, ip, port) < 0)
-            {
-                result = -RT_ERROR;
-            }
-            break;
-
-        default:
-            LOG_E("not supported connect type %d.", type);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-    }
-
-    if (result != RT_EOK && retryed == RT_FALSE)
-    {
-        LOG_D("%s device socket (%d) connect failed, the socket was not be closed and now will connect retry.",
-                device->name, device_socket);
-        if (esp8266_socket_close(socket) < 0)
-        {
-            goto __exit;
-        }
-        retryed = RT_TRUE;
-        result = RT_EOK;
-        goto __retry;
-    }
-
-__exit:
-    if (resp)
-    {
-        at_delete_resp(resp);
-    }
-
-    return result;
-}
-
-/**
- * send data to server or client by AT commands.
- *
- * @param socket current socket
- * @param buff send buffer
- * @param bfsz send buffer size
- * @param type connect socket type(tcp, udp)
- *
- * @return >=0: the size of send success
- *          -1: send AT commands error or send data error
- *          -2: waited socket event timeout
- *          -5: no memory
- */
-static int esp8266_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
-{
-    int result = RT_EOK;
-    int event_result = 0;
-    size_t cur_pkt_size = 0, sent_size = 0;
-    at_response_t resp = RT_NULL;
-    int device_socket = (int) socket->user_data;
-    struct at_device *device = (struct at_device *) socket->device;
-    struct at_device_esp8266 *esp8266 = (struct at_device_esp8266 *) device->user_data;
-    rt_mutex_t lock = device->client->lock;
-
-    RT_ASSERT(buff);
-    RT_ASSERT(bfsz > 0);
-
-    resp = at_create_resp(128, 2, 5 * RT_TICK_PER_SECOND);
-    if (resp == RT_NULL)
-    {
-        LOG_E("no memory for resp create.");
-        return -RT_ENOMEM;
-    }
-
-    rt_mutex_take(lock, RT_WAITING_FOREVER);
-
-    /* set current socket for send URC event */
-    esp8266->user_data = (void *) device_socket;
-
-    /* set AT client end sign to deal with '>' sign */
-    at_obj_set_end_sign(device->client, '>');
-
-    while (sent_size < bfsz)
-    {
-        if (bfsz - sent_size < ESP8266_MODULE_SEND_MAX_SIZE)
-        {
-            cur_pkt_size = bfsz - sent_size;
-        }
-        else
-        {
-            cur_pkt_size = ESP8266_MODULE_SEND_MAX_SIZE;
-        }
-
-        /* send the "AT+CIPSEND" commands to AT server than receive the '>' response on the first line */
-        if (at_obj_exec_cmd(device->client, resp, "AT+CIPSEND=%d,%d", device_socket, cur_pkt_size) < 0)
-        {
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        /* send the real data to server or client */
-        result = (int) at_client_obj_send(device->client, buff + sent_size, cur_pkt_size);
-        if (result == 0)
-        {
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        /* waiting result event from AT URC */
-        if (esp8266_socket_event_recv(device, SET_EVENT(device_socket, 0),
-                                      10 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
-        {
-            LOG_E("%s device socket(%d) wait connect result timeout.", device->name, device_socket);
-            result = -RT_ETIMEOUT;
-            goto __exit;
-        }
-        /* waiting OK or failed result */
-        event_result = esp8266_socket_event_recv(device, ESP8266_EVENT_SEND_OK | ESP8266_EVENT_SEND_FAIL,
-                                                 5 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
-        if (event_result < 0)
-        {
-            LOG_E("%s device socket(%d) wait connect OK|FAIL timeout.", device->name, device_socket);
-            result = -RT_ETIMEOUT;
-            goto __exit;
-        }
-        /* check result */
-        if (event_result & ESP8266_EVENT_SEND_FAIL)
-        {
-            LOG_E("%s device socket(%d) send failed.", device->name, device_socket);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        sent_size += cur_pkt_size;
-    }
-
-__exit:
-    /* reset the end sign for data */
-    at_obj_set_end_sign(device->client, 0);
-
-    rt_mutex_release(lock);
-
-    if (resp)
-    {
-        at_delete_resp(resp);
-    }
-
-    return result > 0 ? sent_size : result;
-}
 
 /**
  * domain resolve by AT commands.
@@ -373,177 +115,227 @@ __exit:
 }
 
 /**
- * set AT socket event notice callback
+ * start TCP server by AT commands, the module supports only one server and
+ * the accepted connections are reported by the "<link ID>,CONNECT" URC.
  *
- * @param event notice event
- * @param cb notice callback
+ * @param socket current socket
+ * @param port the local port
+ *
+ * @return  0: listen success
+ *         -1: send AT commands error
+ *         -5: no memory
+ */
+static int esp8266_socket_listen(struct at_socket *socket, int32_t port)
+{
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+    struct at_device *device = (struct at_device *) socket->device;
+
+    resp = at_create_resp(64, 0, 5 * RT_TICK_PER_SECOND);
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    if (at_obj_exec_cmd(device->client, resp, "AT+CIPSERVER=1,%d", port) < 0)
+    {
+        result = -RT_ERROR;
+    }
+
+    at_delete_resp(resp);
+
+    return result;
+}
+
+/**
+ * open the connectionless UDP socket by AT commands, the UDP mode 2 accepts the
+ * datagrams from any peer and the destination is given by every send command.
+ *
+ * @param socket current socket
+ * @param ip the remote IP address
+ * @param port the remote port
+ * @param local_port the local port
+ *
+ * @return  0: open success
+ *         -1: send AT commands error
+ *         -5: no memory
  */
-static void esp8266_socket_set_event_cb(at_socket_evt_t event, at_evt_cb_t cb)
+static int esp8266_socket_open_udp(struct at_socket *socket, const char *ip, int32_t port, int32_t local_port)
 {
-    if (event < sizeof(at_evt_cb_set) / sizeof(at_evt_cb_set[1]))
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+    int device_socket = (int) socket->user_data;
+    struct at_device *device = (struct at_device *) socket->device;
+
+    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    if (resp == RT_NULL)
     {
-        at_evt_cb_set[event] = cb;
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    if (at_obj_exec_cmd(device->client, resp, "AT+CIPSTART=%d,\"UDP\",\"%s\",%d,%d,2",
+                        device_socket, ip, port, local_port) < 0)
+    {
+        result = -RT_ERROR;
     }
+
+    at_delete_resp(resp);
+
+    return result;
 }
 
 static const struct at_socket_ops esp8266_socket_ops =
 {
-    esp8266_socket_connect,
-    esp8266_socket_close,
-    esp8266_socket_send,
+    at_device_socket_connect,
+    at_device_socket_close,
+    at_device_socket_send,
     esp8266_domain_resolve,
-    esp8266_socket_set_event_cb,
+    at_device_socket_set_event_cb,
 #if defined(AT_SW_VERSION_NUM) && AT_SW_VERSION_NUM > 0x10300
     RT_NULL,
 #endif
 };
 
-static void urc_send_func(struct at_client *client, const char *data, rt_size_t size)
+static void urc_send_bfsz_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    static int cur_send_bfsz = 0;
+    struct at_device_parser parser;
+
+    RT_ASSERT(data && size);
+
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "Recv") == 0)
+    {
+        at_device_parser_int(&parser, &cur_send_bfsz);
+    }
+}
+
+static void urc_close_func(struct at_client *client, const char *data, rt_size_t size)
 {
-    int device_socket = 0;
+    int index = -1;
     struct at_device *device = RT_NULL;
-    struct at_device_esp8266 *esp8266 = RT_NULL;
-    char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_socket_get_device(client);
     if (device == RT_NULL)
     {
-        LOG_E("get device(%s) failed.", client_name);
         return;
     }
-    esp8266 = (struct at_device_esp8266 *) device->user_data;
-    device_socket = (int) esp8266->user_data;
 
-    if (rt_strstr(data, "SEND OK"))
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_int(&parser, &index) < 0)
     {
-        esp8266_socket_event_send(device, SET_EVENT(device_socket, ESP8266_EVENT_SEND_OK));
-    }
-    else if (rt_strstr(data, "SEND FAIL"))
-    {
-        esp8266_socket_event_send(device, SET_EVENT(device_socket, ESP8266_EVENT_SEND_FAIL));
+        return;
     }
-}
-
-static void urc_send_bfsz_func(struct at_client *client, const char *data, rt_size_t size)
-{
-    static int cur_send_bfsz = 0;
-
-    RT_ASSERT(data && size);
 
-    sscanf(data, "Recv %d bytes", &cur_send_bfsz);
+    /* notice the socket is disconnect by remote */
+    at_device_socket_closed_notice(device, index);
 }
 
-static void urc_close_func(struct at_client *client, const char *data, rt_size_t size)
+#ifdef AT_USING_SOCKET_SERVER
+/* the accepted connection of the TCP server */
+static void urc_connect_func(struct at_client *client, const char *data, rt_size_t size)
 {
-    int index = 0;
-    struct at_socket *socket = RT_NULL;
+    int index = -1;
     struct at_device *device = RT_NULL;
-    char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_socket_get_device(client);
     if (device == RT_NULL)
     {
-        LOG_E("get device(%s) failed.", client_name);
         return;
     }
 
-    sscanf(data, "%d,CLOSED", &index);
-    socket = &(device->sockets[index]);
-
-    /* notice the socket is disconnect by remote */
-    if (at_evt_cb_set[AT_SOCKET_EVT_CLOSED])
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_int(&parser, &index) < 0)
     {
-        at_evt_cb_set[AT_SOCKET_EVT_CLOSED](socket, AT_SOCKET_EVT_CLOSED, RT_NULL, 0);
+        return;
     }
+
+    /* the client connection reports it too, it is ignored by the socket in use */
+    at_device_socket_accept_notice(device, index);
 }
+#endif /* AT_USING_SOCKET_SERVER */
 
 static void urc_recv_func(struct at_client *client, const char *data, rt_size_t size)
 {
-    int device_socket = 0;
-    rt_int32_t timeout = 0;
-    rt_size_t bfsz = 0, temp_size = 0;
-    char *recv_buf = RT_NULL, temp[8] = {0};
-    struct at_socket *socket = RT_NULL;
+    char remote_ip[16] = {0};
+    int device_socket = -1, bfsz = 0, remote_port = 0;
     struct at_device *device = RT_NULL;
-    char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_socket_get_device(client);
     if (device == RT_NULL)
     {
-        LOG_E("get device(%s) failed.", client_name);
         return;
     }
 
     /* get the at deveice socket and receive buffer size by receive data */
-    sscanf(data, "+IPD,%d,%d:", &device_socket, (int *) &bfsz);
-
-    /* set receive timeout by receive buffer length, not less than 10ms */
-    timeout = bfsz > 10 ? bfsz : 10;
-
-    if (device_socket < 0 || bfsz == 0)
-        return;
-
-    recv_buf = (char *) rt_calloc(1, bfsz);
-    if (recv_buf == RT_NULL)
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+IPD,") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_int(&parser, &bfsz) < 0 || bfsz < 0)
     {
-        LOG_E("no memory receive buffer(%d).", bfsz);
-        /* read and clean the coming data */
-        while (temp_size < bfsz)
-        {
-            if (bfsz - temp_size > sizeof(temp))
-            {
-                at_client_obj_recv(client, temp, sizeof(temp), timeout);
-            }
-            else
-            {
-                at_client_obj_recv(client, temp, bfsz - temp_size, timeout);
-            }
-            temp_size += sizeof(temp);
-        }
         return;
     }
 
-    /* sync receive data */
-    if (at_client_obj_recv(client, recv_buf, bfsz, timeout) != bfsz)
+    /* the source address is reported when AT+CIPDINFO=1: +IPD,<link ID>,<len>,<remote IP>,<remote port>: */
+    if (at_device_parser_ipv4(&parser, remote_ip) == 0 && at_device_parser_int(&parser, &remote_port) == 0)
     {
-        LOG_E("%s device receive size(%d) data failed.", device->name, bfsz);
-        rt_free(recv_buf);
-        return;
+        at_device_socket_set_from(device, device_socket, remote_ip, remote_port);
     }
 
-    /* get at socket object by device socket descriptor */
-    socket = &(device->sockets[device_socket]);
-
-    /* notice the receive buffer and buffer size */
-    if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
-    {
-        at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
-    }
+    /* read the raw data and notice it to the socket */
+    at_device_socket_recv_push(client, device, device_socket, bfsz);
 }
 
 static const struct at_urc urc_table[] =
 {
-    {"SEND OK",          "\r\n",           urc_send_func},
-    {"SEND FAIL",        "\r\n",           urc_send_func},
+    {"SEND OK",          "\r\n",           at_device_socket_urc_send},
+    {"SEND FAIL",        "\r\n",           at_device_socket_urc_send},
     {"Recv",             "bytes\r\n",      urc_send_bfsz_func},
     {"",                 ",CLOSED\r\n",    urc_close_func},
+#ifdef AT_USING_SOCKET_SERVER
+    {"",                 ",CONNECT\r\n",   urc_connect_func},
+#endif
     {"+IPD",             ":",              urc_recv_func},
 };
 
+static const struct at_device_socket_dialect esp8266_socket_dialect =
+{
+    .connect_tcp     = "AT+CIPSTART=%d,\"TCP\",\"%s\",%d,60",
+    .close           = "AT+CIPCLOSE=%d",
+    .close_listen    = "AT+CIPSERVER=0",
+    .send            = "AT+CIPSEND=%d,%d",
+    .send_udp        = "AT+CIPSEND=%d,%d,\"%s\",%d",
+    .urc_table       = urc_table,
+    .urc_table_size  = sizeof(urc_table) / sizeof(urc_table[0]),
+    .send_max_size   = ESP8266_MODULE_SEND_MAX_SIZE,
+    .connect_style   = AT_DEVICE_SOCKET_CONN_SYNC,
+    .send_style      = AT_DEVICE_SOCKET_SEND_PROMPT,
+    .recv_style      = AT_DEVICE_SOCKET_RECV_PUSH,
+    .connect_retry   = 1,
+    .flags           = AT_DEVICE_SOCKET_FLAG_CLOSE_RETRY,
+    .cmd_timeout     = 5000,
+    .close_timeout   = 300,
+    .send_timeout    = 10000,
+    .listen          = esp8266_socket_listen,
+    .open_udp        = esp8266_socket_open_udp,
+};
+
 int esp8266_socket_init(struct at_device *device)
 {
     RT_ASSERT(device);
 
-    /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
-
-    return RT_EOK;
+    return at_device_socket_init(device);
 }
 
 int esp8266_socket_class_register(struct at_device_class *class)
@@ -552,6 +344,7 @@ int esp8266_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_ESP8266_SOCKETS_NUM;
     class->socket_ops = &esp8266_socket_ops;
+    class->socket_dialect = &esp8266_socket_dialect;
 
     return RT_EOK;
 }
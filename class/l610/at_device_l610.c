@@ -28,6 +28,10 @@
 #include <ctype.h>
 
 #include <at_device_l610.h>
+#include <at_device_urc.h>
+#include <at_device_apn.h>
+#include <at_device_parser.h>
+#include <at_device_boot.h>
 
 #define LOG_TAG                     "at.dev.l610"
 #include <at_log.h>
@@ -46,11 +50,6 @@
 
 
 
-static char *CSTT_CHINA_MOBILE  = "AT+MIPCALL=1,\"CMNET\"";
-static char *CSTT_CHINA_UNICOM  = "AT+MIPCALL=1,\"3GNET\"";
-static char *CSTT_CHINA_TELECOM = "AT+MIPCALL=1,\"CTNET\"";
-
-
 static int l610_power_on(struct at_device *device)
 {
     struct at_device_l610 *l610= RT_NULL;
@@ -676,23 +675,80 @@ static struct netdev *l610_netdev_add(const char *netdev_name)
         }                                                                                          \
     } while(0)                                                                                     \
 
-/* init for l610 */
+/* boot steps check, the result line fields are "<n>,<stat>" */
+static int l610_boot_reg_stat(const char *line, const char *keyword)
+{
+    int n = 0, stat = 0;
+    struct at_device_parser parser;
+
+    at_device_parser_init(&parser, line, rt_strlen(line));
+    if (at_device_parser_expect(&parser, keyword) < 0 ||
+            at_device_parser_int(&parser, &n) < 0 || at_device_parser_int(&parser, &stat) < 0)
+    {
+        return 0;
+    }
 
+    return (stat == 1 || stat == 5) ? 1 : 0;
+}
 
+static int l610_boot_cpin_check(struct at_device *device, const char *line)
+{
+    if (rt_strstr(line, "READY"))
+    {
+        LOG_D("%s device SIM card detection success.", device->name);
+        return 1;
+    }
 
+    return 0;
+}
+
+static int l610_boot_creg_check(struct at_device *device, const char *line)
+{
+    return l610_boot_reg_stat(line, "+CREG:");
+}
+
+static int l610_boot_cgreg_check(struct at_device *device, const char *line)
+{
+    return l610_boot_reg_stat(line, "+CGREG:");
+}
+
+static int l610_boot_csq_check(struct at_device *device, const char *line)
+{
+    int rssi = 0, ber = 0;
+    struct at_device_parser parser;
+
+    at_device_parser_init(&parser, line, rt_strlen(line));
+    if (at_device_parser_expect(&parser, "+CSQ:") < 0 ||
+            at_device_parser_int(&parser, &rssi) < 0 ||
+            at_device_parser_int(&parser, &ber) < 0 || rssi == 99)
+    {
+        return 0;
+    }
 
+    LOG_D("%s device signal strength: %d,%d", device->name, rssi, ber);
+    return 1;
+}
+
+/* the SIM card, network registration and signal strength are polled with the adaptive interval */
+static const struct at_device_boot_step l610_boot_steps[] =
+{
+    {"cpin",  "AT+CPIN?",  "+CPIN:",  2, 0, 5 * 1000, 10 * 1000, l610_boot_cpin_check},
+    {"creg",  "AT+CREG?",  "+CREG:",  0, 0, 300,      10 * 1000, l610_boot_creg_check},
+    {"cgreg", "AT+CGREG?", "+CGREG:", 0, 0, 300,      20 * 1000, l610_boot_cgreg_check},
+    {"csq",   "AT+CSQ",    "+CSQ:",   0, 0, 300,      10 * 1000, l610_boot_csq_check},
+};
+
+/* init for l610 */
 static void l610_init_thread_entry(void *parameter)
 {
 #define INIT_RETRY                      5
-#define CPIN_RETRY                      10
-#define CSQ_RETRY                       10
-#define CREG_RETRY                      10
 #define CGREG_RETRY                     20
 
     int i, qimux, retry_num = INIT_RETRY;
     char parsed_data[32] = {0};
     rt_err_t result = RT_EOK;
     at_response_t resp = RT_NULL;
+    const struct at_device_apn *apn = RT_NULL;
     struct at_device *device = (struct at_device *)parameter;
     struct at_client *client = device->client;
 
@@ -704,6 +760,14 @@ static void l610_init_thread_entry(void *parameter)
         return;
     }
 
+    result = at_device_boot_init(device, l610_boot_steps, sizeof(l610_boot_steps) / sizeof(l610_boot_steps[0]));
+    if (result < 0)
+    {
+        LOG_E("%s device network initialize failed(%d)!", device->name, result);
+        at_delete_resp(resp);
+        return;
+    }
+
     while (retry_num--)
     {
         rt_memset(parsed_data, 0, sizeof(parsed_data));
@@ -711,6 +775,7 @@ static void l610_init_thread_entry(void *parameter)
         l610_power_on(device);
 
         rt_thread_mdelay(1000);
+        at_device_boot_mark(device, "power");
 
         /* wait l610 startup finish */
         if (at_client_obj_wait_connect(client, L610_WAIT_CONNECT_TIME))
@@ -718,6 +783,7 @@ static void l610_init_thread_entry(void *parameter)
             result = -RT_ETIMEOUT;
             goto __exit;
         }
+        at_device_boot_mark(device, "sync");
 
         /* disable echo */
         AT_SEND_CMD(client, resp, 0, 300, "ATE0");
@@ -728,84 +794,12 @@ static void l610_init_thread_entry(void *parameter)
         {
             LOG_D("%s", at_resp_get_line(resp, i + 1));
         }
-        /* check SIM card */
-        for (i = 0; i < CPIN_RETRY; i++)
-        {
-          AT_SEND_CMD(client, resp, 2, 5 * RT_TICK_PER_SECOND, "AT+CPIN?");
-            if (at_resp_get_line_by_kw(resp, "READY"))
-            {
-                LOG_D("%s device SIM card detection success.", device->name);
-                break;
-            }
-            rt_thread_mdelay(1000);
-        }
-        if (i == CPIN_RETRY)
-        {
-            LOG_E("%s device SIM card detection failed.", device->name);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-        /* waiting for dirty data to be digested */
-        rt_thread_mdelay(10);
+        at_device_boot_mark(device, "ident");
 
-        /* check the GSM network is registered */
-        for (i = 0; i < CREG_RETRY; i++)
+        /* check the SIM card, the network registration and the signal strength */
+        result = at_device_boot_run(device);
+        if (result < 0)
         {
-            AT_SEND_CMD(client, resp, 0, 300, "AT+CREG?");
-
-            at_resp_parse_line_args_by_kw(resp, "+CREG:", "+CREG: %s", &parsed_data);
-            if (!strncmp(parsed_data, "0,1", sizeof(parsed_data)) ||
-                !strncmp(parsed_data, "0,5", sizeof(parsed_data)))
-            {
-
-                LOG_D("%s device GSM is registered(%s),", device->name, parsed_data);
-                break;
-            }
-            rt_thread_mdelay(1000);
-        }
-        if (i == CREG_RETRY)
-        {
-            LOG_E("%s device GSM is register failed(%s).", device->name, parsed_data);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-        /* check the GPRS network is registered */
-        for (i = 0; i < CGREG_RETRY; i++)
-        {
-            AT_SEND_CMD(client, resp, 0, 300, "AT+CGREG?");
-
-            at_resp_parse_line_args_by_kw(resp, "+CGREG:", "+CGREG: %s", &parsed_data);
-            if (!strncmp(parsed_data, "0,1", sizeof(parsed_data)) ||
-                !strncmp(parsed_data, "0,5", sizeof(parsed_data)))
-            {
-                LOG_D("%s device GPRS is registered(%s).", device->name, parsed_data);
-                break;
-            }
-            rt_thread_mdelay(1000);
-        }
-        if (i == CGREG_RETRY)
-        {
-            LOG_E("%s device GPRS is register failed(%s).", device->name, parsed_data);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        /* check signal strength */
-        for (i = 0; i < CSQ_RETRY; i++)
-        {
-            AT_SEND_CMD(client, resp, 0, 300, "AT+CSQ?");
-            at_resp_parse_line_args_by_kw(resp, "+CSQ:", "+CSQ: %s", &parsed_data);
-            if (strncmp(parsed_data, "99,99", sizeof(parsed_data)))
-            {
-                LOG_D("%s device signal strength: %s", device->name, parsed_data);
-                break;
-            }
-            rt_thread_mdelay(1000);
-        }
-        if (i == CSQ_RETRY)
-        {
-            LOG_E("%s device signal strength check failed (%s)", device->name, parsed_data);
-            result = -RT_ERROR;
             goto __exit;
         }
 
@@ -825,27 +819,17 @@ static void l610_init_thread_entry(void *parameter)
 
         if (qimux == 0)
         {
-        AT_SEND_CMD(client, resp, 0, 300, "AT+COPS?");
-        at_resp_parse_line_args_by_kw(resp, "+COPS:", "+COPS: %*[^\"]\"%[^\"]", &parsed_data);
-
-        if (rt_strcmp(parsed_data, "CHINA MOBILE") == 0)
-        {
-            /* "CMCC" */
-            LOG_I("%s device network operator: %s", device->name, parsed_data);
-            AT_SEND_CMD(client, resp, 0, 300, CSTT_CHINA_MOBILE);
-
-        }
-        else if (rt_strcmp(parsed_data, "CHN-UNICOM") == 0)
+        /* the APN is found by the PLMN of the SIM card, the built-in table has the L610 China Unicom "3GNET" */
+        apn = at_device_apn_query(device, client);
+        if (apn)
         {
-            /* "UNICOM" */
-            LOG_I("%s device network operator: %s", device->name, parsed_data);
-            AT_SEND_CMD(client, resp, 0, 300, CSTT_CHINA_UNICOM);
-        }
-        else if (rt_strcmp(parsed_data, "CHN-CT") == 0)
-        {
-            AT_SEND_CMD(client, resp, 0, 300, CSTT_CHINA_TELECOM);
-            /* "CT" */
-            LOG_I("%s device network operator: %s", device->name, parsed_data);
+            resp = at_resp_set_info(resp, 128, 0, rt_tick_from_millisecond(300));
+            if (at_obj_exec_cmd(client, resp, "AT+MIPCALL=1,\"%s\",\"%s\",\"%s\"",
+                                apn->apn, apn->username ? apn->username : "", apn->password ? apn->password : "") < 0)
+            {
+                result = -RT_ERROR;
+                goto __exit;
+            }
         }
 
             }
@@ -870,6 +854,8 @@ static void l610_init_thread_entry(void *parameter)
             goto __exit;
         }
 
+        at_device_boot_mark(device, "dial");
+
         /* initialize successfully  */
         result = RT_EOK;
         break;
@@ -900,6 +886,7 @@ static void l610_init_thread_entry(void *parameter)
             l610_netdev_check_link_status(device->netdev);
         }
 
+        at_device_boot_report(device);
         LOG_I("%s device network initialize success!", device->name);
 
     }
@@ -960,7 +947,7 @@ static int l610_init(struct at_device *device)
     }
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
 #ifdef AT_USING_SOCKET
 
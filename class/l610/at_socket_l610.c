@@ -26,6 +26,9 @@
 #include <string.h>
 
 #include <at_device_l610.h>
+#include <at_device_urc.h>
+#include <at_device_parser.h>
+#include <at_device_work.h>
 
 #define LOG_TAG                     "at.skt.l610"
 #include <at_log.h>
@@ -455,6 +458,7 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
     int result;
+    struct at_device_parser parser;
 
 
     RT_ASSERT(data && size);
@@ -467,7 +471,13 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
     }
 
     /* get the current socket by receive data */
-    sscanf(data, "+MIPPUSH: %d,%d", &device_socket,&result);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+MIPPUSH:") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_int(&parser, &result) < 0)
+    {
+        return;
+    }
 
 
     if (rt_strstr(data, "+MIPPUSH: ")){
@@ -489,6 +499,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
     int result;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -499,7 +510,13 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
     /* get the current socket by receive data */
-    sscanf(data, "+MIPCLOSE: %d,%d", &device_socket,&result);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+MIPCLOSE:") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_int(&parser, &result) < 0)
+    {
+        return;
+    }
 
     if(result==0)
     {
@@ -521,6 +538,23 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 }
 
 
+/* read request for the device work queue */
+struct l610_read_req
+{
+    int sock;
+    rt_size_t size;
+};
+
+static void l610_socket_read(struct at_device *device, void *arg)
+{
+    struct l610_read_req *req = (struct l610_read_req *) arg;
+
+    if (at_obj_exec_cmd(device->client, RT_NULL, "AT+MIPREAD=%d,%d", req->sock, req->size) < 0)
+    {
+        LOG_E("%s device socket(%d) read failed.", device->name, req->sock);
+    }
+}
+
 //Receive data from buffer
 static void urc_recv_cmd(struct at_client *client, const char *data, rt_size_t size)
 {
@@ -528,6 +562,7 @@ static void urc_recv_cmd(struct at_client *client, const char *data, rt_size_t s
     rt_size_t bfsz;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
 
     RT_ASSERT(data && size);
@@ -539,15 +574,23 @@ static void urc_recv_cmd(struct at_client *client, const char *data, rt_size_t s
         return;
     }
 
-    sscanf(data,"+MIPREAD: %d,%d", &sock, (int *) &bfsz);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+MIPREAD:") < 0 ||
+            at_device_parser_int(&parser, &sock) < 0 ||
+            at_device_parser_size(&parser, &bfsz) < 0)
+    {
+        return;
+    }
 
-    if(bfsz>0)
+    if (bfsz > 0)
     {
-        if (at_obj_exec_cmd(client, NULL, "AT+MIPREAD=%d,%d", sock,bfsz) < 0)
-            {
-                LOG_E("send (%s) failed.", client_name);
-                return;
-            }
+        struct l610_read_req req = {sock, bfsz};
+
+        /* the AT client lock may be held by a command waiting for this thread, read in the work queue */
+        if (at_device_work_submit(device, l610_socket_read, &req, sizeof(req)) < 0)
+        {
+            LOG_E("%s device socket(%d) read submit failed.", device->name, sock);
+        }
     }
 }
 
@@ -565,10 +608,17 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     int sock = -1;
     rt_size_t data_len;
     RT_ASSERT(data && size);
+    struct at_device_parser parser;
 
 
     /* get the current socket and receive buffer size by receive data */
-    sscanf(data,"+MIPDATA: %d,%d", &sock, (int *) &bfsz);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+MIPDATA:") < 0 ||
+            at_device_parser_int(&parser, &sock) < 0 ||
+            at_device_parser_size(&parser, &bfsz) < 0)
+    {
+        return;
+    }
 
     device_socket = l610_get_socket_idx(sock);
 
@@ -660,9 +710,9 @@ int l610_socket_init(struct at_device *device)
     RT_ASSERT(device);
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
-    return RT_EOK;
+    return at_device_work_init(device);
 }
 
 int l610_socket_class_register(struct at_device_class *class)
@@ -27,6 +27,8 @@
 #include <string.h>
 
 #include <at_device_m26.h>
+#include <at_device_urc.h>
+#include <at_device_cmux.h>
 
 #define LOG_TAG                        "at.dev.m26"
 #include <at_log.h>
@@ -68,6 +70,11 @@ static void m26_power_off(struct at_device *device)
 
     m26 = (struct at_device_m26 *) device->user_data;
 
+#ifdef AT_DEVICE_M26_USING_CMUX
+    /* the module boots in AT command mode, leave CMUX mode before it is powered off */
+    at_device_cmux_stop(device);
+#endif
+
     /* not nead to set pin configuration for m26 device power on */
     if (m26->power_pin == -1 || m26->power_status_pin == -1)
     {
@@ -263,7 +270,7 @@ static void check_link_status_entry(void *parameter)
     {
 
         /* send "AT+QNSTATUS" commond  to check netweork interface device link status */
-        if (at_obj_exec_cmd(device->client, resp, "AT+QNSTATUS") < 0)
+        if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QNSTATUS") < 0)
         {
             rt_thread_mdelay(M26_LINK_DELAY_TIME);
 
@@ -429,7 +436,7 @@ static int m26_netdev_ping(struct netdev *netdev, const char *host,
         return  -RT_ENOMEM;
     }
     /* send "AT+QPING="<host>"[,[<timeout>][,<pingnum>]]" commond to send ping request */
-    if (at_obj_exec_cmd(device->client, resp, "AT+QPING=\"%s\",%d,1", host, M26_PING_TIMEO / RT_TICK_PER_SECOND) < 0)
+    if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QPING=\"%s\",%d,1", host, M26_PING_TIMEO / RT_TICK_PER_SECOND) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -537,6 +544,17 @@ static struct netdev *m26_netdev_add(const char *netdev_name)
         }                                                                                          \
     } while(0);                                                                                    \
 
+#ifdef AT_DEVICE_M26_USING_CMUX
+/* the socket data and URC use the first channel, the control commands use the second one */
+static const struct at_device_cmux_cfg m26_cmux_cfg =
+{
+    "AT+CMUX=0,0,5,127",
+    "ATE0;+CMEE=2",
+    127,
+    1024,
+};
+#endif /* AT_DEVICE_M26_USING_CMUX */
+
 /* init for m26 or mc20 */
 static void m26_init_thread_entry(void *parameter)
 {
@@ -565,6 +583,8 @@ static void m26_init_thread_entry(void *parameter)
 
     while (retry_num--)
     {
+        /* the physical AT client is put back after CMUX stopped by power off */
+        client = device->client;
         /* power on the m26 device */
         m26_power_on(device);
         rt_thread_mdelay(1000);
@@ -690,6 +710,19 @@ static void m26_init_thread_entry(void *parameter)
 
         AT_SEND_CMD(client, resp, 2, 300, "AT+QILOCIP");
 
+#ifdef AT_DEVICE_M26_USING_CMUX
+        /* enter CMUX mode, the background commands do not queue behind the socket data */
+        if (at_device_cmux_start(device, &m26_cmux_cfg) < 0)
+        {
+            result = -RT_ERROR;
+            goto __exit;
+        }
+#ifdef AT_USING_SOCKET
+        /* register URC to the data channel AT client */
+        m26_socket_init(device);
+#endif
+#endif /* AT_DEVICE_M26_USING_CMUX */
+
         /* initialize successfully  */
         result = RT_EOK;
         break;
@@ -779,7 +812,7 @@ static int m26_init(struct at_device *device)
     }
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
 #ifdef AT_USING_SOCKET
     m26_socket_init(device);
@@ -27,6 +27,8 @@
 #include <string.h>
 
 #include <at_device_m26.h>
+#include <at_device_urc.h>
+#include <at_device_parser.h>
 
 #define LOG_TAG                        "at.skt.m26"
 #include <at_log.h>
@@ -487,6 +489,7 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
     int device_socket = 0;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -497,7 +500,11 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
         return;
     }
 
-    sscanf(data, "%d%*[^0-9]", &device_socket);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_int(&parser, &device_socket) < 0)
+    {
+        return;
+    }
 
     if (rt_strstr(data, "CONNECT OK"))
     {
@@ -542,6 +549,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
     int device_socket = 0;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -552,7 +560,11 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    sscanf(data, "%d%*s", &device_socket);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_int(&parser, &device_socket) < 0)
+    {
+        return;
+    }
 
     if (rt_strstr(data, "CLOSE OK"))
     {
@@ -582,6 +594,7 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     struct at_socket *socket = RT_NULL;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -593,7 +606,13 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     }
 
     /* get the current socket and receive buffer size by receive data */
-    sscanf(data, "+RECEIVE: %d, %d", &device_socket, (int *) &bfsz);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+RECEIVE:") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_size(&parser, &bfsz) < 0)
+    {
+        return;
+    }
 
     /* set receive timeout by receive buffer length, not less than 10 ms */
     timeout = bfsz > 10 ? bfsz : 10;
@@ -669,7 +688,7 @@ int m26_socket_init(struct at_device *device)
     RT_ASSERT(device);
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
     return RT_EOK;
 }
@@ -0,0 +1,380 @@
+/*
+ * File      : at_coap_m5311.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <at_device_m5311.h>
+#include <at_device_coap.h>
+#include <at_device_parser.h>
+#include <at_device_sched.h>
+#include <at_device_work.h>
+
+#define LOG_TAG                        "at.coap.m5311"
+#include <at_log.h>
+
+#if defined(AT_DEVICE_USING_M5311) && defined(AT_DEVICE_USING_COAP)
+
+/* the OneNET LwM2M instance, the payload is the opaque resource 3200/0/5750 */
+#define M5311_MIPL_REF                 0
+#define M5311_MIPL_OBJ                 3200
+#define M5311_MIPL_RES                 5750
+#define M5311_MIPL_OPAQUE              2
+
+/* the default lifetime in second */
+#define M5311_MIPL_LIFETIME            3600
+
+/* the platform request which is responded in the work queue */
+#define M5311_MIPL_OBSERVE             0
+#define M5311_MIPL_DISCOVER            1
+#define M5311_MIPL_WRITE               2
+
+struct m5311_mipl_req
+{
+    int type;
+    int msgid;
+};
+
+/* respond the platform request, the AT client parser thread can not wait for the response */
+static void m5311_mipl_respond(struct at_device *device, void *arg)
+{
+    struct m5311_mipl_req *req = (struct m5311_mipl_req *) arg;
+    at_response_t resp = RT_NULL;
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(5000));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return;
+    }
+
+    at_device_sched_take(device, AT_DEVICE_CMD_CONTROL, RT_WAITING_FOREVER);
+    switch (req->type)
+    {
+    case M5311_MIPL_OBSERVE:
+        if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+MIPLOBSERVERSP=%d,%d,1",
+                            M5311_MIPL_REF, req->msgid) == RT_EOK)
+        {
+            /* the notify is accepted by the platform after the observe */
+            at_device_coap_notify(device, AT_DEVICE_COAP_EVENT_OPEN, 0);
+        }
+        break;
+    case M5311_MIPL_DISCOVER:
+        at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+MIPLDISCOVERRSP=%d,%d,1,%d,\"%d\"",
+                        M5311_MIPL_REF, req->msgid, 4, M5311_MIPL_RES);
+        break;
+    case M5311_MIPL_WRITE:
+        at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+MIPLWRITERSP=%d,%d,2", M5311_MIPL_REF, req->msgid);
+        break;
+    default:
+        break;
+    }
+    at_device_sched_release(device);
+
+    at_delete_resp(resp);
+}
+
+/* +MIPLEVENT: <ref>,<evtid>[,<extend>] */
+static void urc_event_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    int ref = 0, evtid = 0;
+    struct at_device_parser parser;
+    struct at_device *device = RT_NULL;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_coap_get_device(client);
+    if (device == RT_NULL)
+    {
+        return;
+    }
+
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+MIPLEVENT:") < 0 ||
+            at_device_parser_int(&parser, &ref) < 0 || at_device_parser_int(&parser, &evtid) < 0)
+    {
+        return;
+    }
+
+    switch (evtid)
+    {
+    case 7:     /* register failed */
+    case 8:     /* register timeout */
+        at_device_coap_notify(device, AT_DEVICE_COAP_EVENT_OPEN, evtid);
+        break;
+    case 9:     /* lifetime timeout */
+    case 15:    /* deregister done */
+        at_device_coap_notify(device, AT_DEVICE_COAP_EVENT_CLOSE, 0);
+        break;
+    case 25:    /* notify failed */
+        at_device_coap_notify(device, AT_DEVICE_COAP_EVENT_SEND, evtid);
+        break;
+    case 26:    /* notify acknowledged */
+        at_device_coap_notify(device, AT_DEVICE_COAP_EVENT_SEND, 0);
+        break;
+    default:
+        LOG_D("%s device OneNET event(%d).", device->name, evtid);
+        break;
+    }
+}
+
+/* +MIPLOBSERVE: <ref>,<msgid>,<flag>,<objid>,<insid>,<resid> */
+static void urc_observe_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    int ref = 0, flag = 0;
+    struct m5311_mipl_req req = {M5311_MIPL_OBSERVE, 0};
+    struct at_device_parser parser;
+    struct at_device *device = RT_NULL;
+    struct at_device_m5311 *m5311 = RT_NULL;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_coap_get_device(client);
+    if (device == RT_NULL)
+    {
+        return;
+    }
+    m5311 = (struct at_device_m5311 *) device->user_data;
+
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+MIPLOBSERVE:") < 0 || at_device_parser_int(&parser, &ref) < 0 ||
+            at_device_parser_int(&parser, &(req.msgid)) < 0 || at_device_parser_int(&parser, &flag) < 0)
+    {
+        return;
+    }
+
+    /* the notify carries the observe message id */
+    if (flag == 1)
+    {
+        m5311->coap_msgid = req.msgid;
+    }
+
+    if (at_device_work_submit(device, m5311_mipl_respond, &req, sizeof(req)) < 0)
+    {
+        LOG_E("%s device OneNET observe respond failed.", device->name);
+    }
+}
+
+/* +MIPLDISCOVER: <ref>,<msgid>,<objid> */
+static void urc_discover_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    int ref = 0;
+    struct m5311_mipl_req req = {M5311_MIPL_DISCOVER, 0};
+    struct at_device_parser parser;
+    struct at_device *device = RT_NULL;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_coap_get_device(client);
+    if (device == RT_NULL)
+    {
+        return;
+    }
+
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+MIPLDISCOVER:") < 0 || at_device_parser_int(&parser, &ref) < 0 ||
+            at_device_parser_int(&parser, &(req.msgid)) < 0)
+    {
+        return;
+    }
+
+    if (at_device_work_submit(device, m5311_mipl_respond, &req, sizeof(req)) < 0)
+    {
+        LOG_E("%s device OneNET discover respond failed.", device->name);
+    }
+}
+
+/* +MIPLWRITE: <ref>,<msgid>,<objid>,<insid>,<resid>,<type>,<len>,<value>,<flag>,<index> */
+static void urc_write_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    int ref = 0, type = 0;
+    rt_size_t len = 0, hex_len = 0;
+    const char *hex = RT_NULL;
+    struct m5311_mipl_req req = {M5311_MIPL_WRITE, 0};
+    struct at_device_parser parser;
+    struct at_device *device = RT_NULL;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_coap_get_device(client);
+    if (device == RT_NULL)
+    {
+        return;
+    }
+
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+MIPLWRITE:") < 0 || at_device_parser_int(&parser, &ref) < 0 ||
+            at_device_parser_int(&parser, &(req.msgid)) < 0 || at_device_parser_skip(&parser) < 0 ||
+            at_device_parser_skip(&parser) < 0 || at_device_parser_skip(&parser) < 0 ||
+            at_device_parser_int(&parser, &type) < 0 || at_device_parser_size(&parser, &len) < 0)
+    {
+        return;
+    }
+
+    if (at_device_work_submit(device, m5311_mipl_respond, &req, sizeof(req)) < 0)
+    {
+        LOG_E("%s device OneNET write respond failed.", device->name);
+    }
+
+    /* the opaque value is the hex string, the flag and the index follow it */
+    if (type == M5311_MIPL_OPAQUE)
+    {
+        at_device_parser_expect(&parser, "\"");
+        hex = data + parser.pos;
+        hex_len = size - parser.pos;
+        at_device_coap_recv_hex(device, hex, hex_len, len);
+    }
+}
+
+static const struct at_urc urc_table[] =
+{
+    {"+MIPLEVENT:",     "\r\n",         urc_event_func},
+    {"+MIPLOBSERVE:",   "\r\n",         urc_observe_func},
+    {"+MIPLDISCOVER:",  "\r\n",         urc_discover_func},
+    {"+MIPLWRITE:",     "\r\n",         urc_write_func},
+};
+
+/* the OneNET server and the endpoint are set by the module bootstrap configuration */
+static int m5311_coap_open(struct at_device *device, const struct at_device_coap_cfg *cfg)
+{
+    int result = RT_EOK;
+    struct at_client *client = AT_DEVICE_CTRL_CLIENT(device);
+    struct at_device_m5311 *m5311 = (struct at_device_m5311 *) device->user_data;
+    at_response_t resp = RT_NULL;
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(5000));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    m5311->coap_msgid = -1;
+    m5311->coap_ackid = 0;
+
+    /* the instance is left by the last session, delete it */
+    at_obj_exec_cmd(client, resp, "AT+MIPLDELETE=%d", M5311_MIPL_REF);
+
+    if (at_obj_exec_cmd(client, resp, "AT+MIPLCREATE") < 0 ||
+            at_obj_exec_cmd(client, resp, "AT+MIPLADDOBJ=%d,%d,1,\"1\",1,0", M5311_MIPL_REF, M5311_MIPL_OBJ) < 0 ||
+            at_obj_exec_cmd(client, resp, "AT+MIPLOPEN=%d,%d,30", M5311_MIPL_REF,
+                            cfg->lifetime > 0 ? (int) cfg->lifetime : M5311_MIPL_LIFETIME) < 0)
+    {
+        result = -RT_ERROR;
+    }
+
+    at_delete_resp(resp);
+
+    return result;
+}
+
+static int m5311_coap_close(struct at_device *device)
+{
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(5000));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+MIPLCLOSE=%d", M5311_MIPL_REF);
+
+    at_delete_resp(resp);
+
+    return result;
+}
+
+/* AT+MIPLNOTIFY=<ref>,<msgid>,<objid>,<insid>,<resid>,<type>,<len>,<value>,<index>,<flag>[,<ackid>] */
+static int m5311_coap_send(struct at_device *device, const char *hex, rt_size_t len, int type)
+{
+    int result = RT_EOK;
+    struct at_client *client = AT_DEVICE_CTRL_CLIENT(device);
+    struct at_device_m5311 *m5311 = (struct at_device_m5311 *) device->user_data;
+    at_response_t resp = RT_NULL;
+
+    if (m5311->coap_msgid < 0)
+    {
+        LOG_E("%s device OneNET resource is not observed.", device->name);
+        return -RT_ERROR;
+    }
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(5000));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    /* the notify with the ack id is confirmable */
+    if (type == AT_DEVICE_COAP_CON)
+    {
+        if (++m5311->coap_ackid == 0)
+        {
+            m5311->coap_ackid = 1;
+        }
+        result = at_obj_exec_cmd(client, resp, "AT+MIPLNOTIFY=%d,%d,%d,0,%d,%d,%d,%s,0,0,%d",
+                                 M5311_MIPL_REF, m5311->coap_msgid, M5311_MIPL_OBJ, M5311_MIPL_RES,
+                                 M5311_MIPL_OPAQUE, (int) len, hex, m5311->coap_ackid);
+    }
+    else
+    {
+        result = at_obj_exec_cmd(client, resp, "AT+MIPLNOTIFY=%d,%d,%d,0,%d,%d,%d,%s,0,0",
+                                 M5311_MIPL_REF, m5311->coap_msgid, M5311_MIPL_OBJ, M5311_MIPL_RES,
+                                 M5311_MIPL_OPAQUE, (int) len, hex);
+    }
+
+    at_delete_resp(resp);
+
+    return result;
+}
+
+static const struct at_device_coap_ops m5311_coap_ops =
+{
+    m5311_coap_open,
+    m5311_coap_close,
+    m5311_coap_send,
+    urc_table,
+    sizeof(urc_table) / sizeof(urc_table[0]),
+};
+
+int m5311_coap_init(struct at_device *device)
+{
+    int result = RT_EOK;
+
+    RT_ASSERT(device);
+
+    /* the platform requests are responded in the work queue */
+    result = at_device_work_init(device);
+    if (result < 0)
+    {
+        return result;
+    }
+
+    return at_device_coap_init(device, &m5311_coap_ops);
+}
+
+#endif /* AT_DEVICE_USING_M5311 && AT_DEVICE_USING_COAP */
@@ -736,6 +736,10 @@ static int m5311_init(struct at_device *device)
     m5311_socket_init(device);
 #endif
 
+#ifdef AT_DEVICE_USING_COAP
+    m5311_coap_init(device);
+#endif
+
     /* add m5311 netdev to the netdev list */
     device->netdev = m5311_netdev_add(m5311->device_name);
     if (device->netdev == RT_NULL)
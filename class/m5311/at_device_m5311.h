@@ -46,6 +46,10 @@ struct at_device_m5311{
 
         void *socket_data;
         void *user_data;
+#ifdef AT_DEVICE_USING_COAP
+        int coap_msgid;                 /* the OneNET observe message id, -1: not observed */
+        rt_uint16_t coap_ackid;         /* the last confirmable notify ack id */
+#endif
 };
 
 #ifdef AT_USING_SOCKET
@@ -57,6 +61,11 @@ int m5311_socket_class_register(struct at_device_class *class);
 
 #endif /* AT_USING_SOCKET */
 
+#ifdef AT_DEVICE_USING_COAP
+/* m5311 device OneNET CoAP session initialize */
+int m5311_coap_init(struct at_device *device);
+#endif /* AT_DEVICE_USING_COAP */
+
 #ifdef __cplusplus
 }
 #endif
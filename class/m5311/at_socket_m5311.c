@@ -28,6 +28,8 @@
 #include <string.h>
 
 #include <at_device_m5311.h>
+#include <at_device_urc.h>
+#include <at_device_parser.h>
 
 #define LOG_TAG                        "at.skt.m5311"
 #include <at_log.h>
@@ -82,42 +84,6 @@ static int str_to_hex(const char *source, char *dest, int max_dest_len)
     return j;
 }
 
-/**
- * convert data from Hex string to ASCII string.
- *
- * @param hex  input Hex string
- * @param str  output ASCII string
- * @param len  length of str, or the size you want to convert
- *
- * @return =0: convert failed, or no data need to convert
- *         >0: the size of convert success
- */
-static int hex_to_string(const char *hex, char *str, const rt_size_t len)
-{
-    RT_ASSERT(hex && str);
-
-    int hex_len = rt_strlen(hex);
-    int pos = 0, left, right, i;
-
-    if (len < 1 || hex_len/2 < len)
-    {
-        return 0;
-    }
-
-    for (i = 0; i < len*2; i++, pos++)
-    {
-        left = hex[i++];
-        right = hex[i];
-
-        left  = (left  < 58) ? (left  - 48) : (left  - 55);
-        right = (right < 58) ? (right - 48) : (right - 55);
-
-        str[pos] = (left << 4) | right;
-    }
-
-    return pos;
-}
-
 static at_evt_cb_t at_evt_cb_set[] =
 {
     [AT_SOCKET_EVT_RECV]    = NULL,
@@ -529,6 +495,7 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
     int device_socket = 0, data_size = 0;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -539,7 +506,13 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    sscanf(data, "+IPSEND: %d,%d", &device_socket, &data_size);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+IPSEND:") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_int(&parser, &data_size) < 0)
+    {
+        return;
+    }
 
     if (data_size > 0)
     {
@@ -557,6 +530,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
     struct at_socket *socket = RT_NULL;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -567,7 +541,12 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    sscanf(data, "+IPCLOSE: %d", &device_socket);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+IPCLOSE:") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0)
+    {
+        return;
+    }
     socket = &(device->sockets[device_socket]);
 
     if (at_evt_cb_set[AT_SOCKET_EVT_CLOSED])
@@ -579,14 +558,14 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 static void urc_recv_func(struct at_client *client, const char *data, rt_size_t size)
 {
     int device_socket = 0;
-    rt_int32_t timeout;
-    rt_size_t bfsz = 0, temp_size = 0;
-    char *recv_buf = RT_NULL, *hex_buf = RT_NULL, temp[8] = {0};
+    rt_size_t bfsz = 0;
+    char *recv_buf = RT_NULL;
     char remote_addr[16] = {0};
     int remote_port = -1;
 
     struct at_socket *socket = RT_NULL;
     struct at_device *device = RT_NULL;
+    struct at_device_parser parser;
     char *client_name = client->device->parent.name;
 
     RT_ASSERT(data && size);
@@ -598,45 +577,38 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    hex_buf = (char *) rt_calloc(1, M5311_MODULE_RECV_MAX_SIZE * 2 + 1);
-
     /* get the current socket and receive buffer size by receive data */
     /* mode 2 => +IPRD: <socket>,<remote_addr>, <remote_port>,<length>,<data> */
-    sscanf(data, "+IPRD: %d,\"%[0-9.]\",%d,%d,%s", &device_socket, remote_addr, &remote_port, (int *) &bfsz, hex_buf);
-
-    /* set receive timeout by receive buffer length, not less than 10 ms */
-    timeout = bfsz > 10 ? bfsz : 10;
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+IPRD:") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_ipv4(&parser, remote_addr) < 0 ||
+            at_device_parser_int(&parser, &remote_port) < 0 ||
+            at_device_parser_size(&parser, &bfsz) < 0)
+    {
+        return;
+    }
 
-    if (device_socket < 0 || bfsz == 0)
+    if (device_socket < 0 || device_socket >= AT_DEVICE_M5311_SOCKETS_NUM ||
+            bfsz == 0 || bfsz > M5311_MODULE_RECV_MAX_SIZE)
+    {
         return;
+    }
 
     recv_buf = (char *) rt_calloc(1, bfsz + 1);
-
-    if (recv_buf == RT_NULL || hex_buf == RT_NULL)
+    if (recv_buf == RT_NULL)
     {
         LOG_E("no memory for URC receive buffer(%d).", bfsz);
-        /* read and clean the coming data */
-        while (temp_size < bfsz)
-        {
-            if (bfsz - temp_size > sizeof(temp))
-            {
-                at_client_obj_recv(client, temp, sizeof(temp), timeout);
-            }
-            else
-            {
-                at_client_obj_recv(client, temp, bfsz - temp_size, timeout);
-            }
-            temp_size += sizeof(temp);
-        }
-
-        if (recv_buf) rt_free(recv_buf);
-        if (hex_buf)  rt_free(hex_buf);
         return;
     }
 
     /* convert receive data */
-    hex_to_string(hex_buf, recv_buf, bfsz);
-    rt_free(hex_buf);
+    if (at_device_parser_hex(&parser, recv_buf, bfsz) < 0)
+    {
+        LOG_E("%s device socket(%d) receive invalid hex data.", device->name, device_socket);
+        rt_free(recv_buf);
+        return;
+    }
 
     /* get at socket object by device socket descriptor */
     socket = &(device->sockets[device_socket]);
@@ -646,6 +618,10 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     {
         at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
     }
+    else
+    {
+        rt_free(recv_buf);
+    }
 }
 
 static const struct at_urc urc_table[] =
@@ -672,7 +648,7 @@ int m5311_socket_init(struct at_device *device)
     RT_ASSERT(device);
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
     return RT_EOK;
 }
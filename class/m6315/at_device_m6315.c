@@ -28,6 +28,8 @@
 #include <ctype.h>
 
 #include <at_device_m6315.h>
+#include <at_device_urc.h>
+#include <at_device_cmux.h>
 
 #define LOG_TAG                        "at.dev.m6315"
 #include <at_log.h>
@@ -70,6 +72,11 @@ static void m6315_power_off(struct at_device *device)
 
     m6315 = (struct at_device_m6315 *) device->user_data;
 
+#ifdef AT_DEVICE_M6315_USING_CMUX
+    /* the module boots in AT command mode, leave CMUX mode before it is powered off */
+    at_device_cmux_stop(device);
+#endif
+
     /* not nead to set pin configuration for m6315 device power on */
     if (m6315->power_pin == -1 || m6315->power_status_pin == -1)
     {
@@ -135,7 +142,7 @@ static int m6315_netdev_set_info(struct netdev *netdev)
         int i = 0, j = 0;
 
         /* send "AT+GSN" commond to get device IMEI */
-        if (at_obj_exec_cmd(device->client, resp, "AT+GSN") < 0)
+        if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+GSN") < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -173,7 +180,7 @@ static int m6315_netdev_set_info(struct netdev *netdev)
         at_resp_set_info(resp, M6315_IPADDR_RESP_SIZE, 2, M6315_INFO_RESP_TIMO);
 
         /* send "AT+QILOCIP" commond to get IP address */
-        if (at_obj_exec_cmd(device->client, resp, "AT+QILOCIP") < 0)
+        if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QILOCIP") < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -201,7 +208,7 @@ static int m6315_netdev_set_info(struct netdev *netdev)
         at_resp_set_info(resp, M6315_DNS_RESP_SIZE, 0, M6315_INFO_RESP_TIMO);
 
         /* send "AT+QIDNSCFG?" commond to get DNS servers address */
-        if (at_obj_exec_cmd(device->client, resp, "AT+QIDNSCFG?") < 0)
+        if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QIDNSCFG?") < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -263,7 +270,7 @@ static void check_link_status_entry(void *parameter)
     while (1)
     {
         /* send "AT+CGREG?" commond  to check netweork interface device link status */
-        if (at_obj_exec_cmd(device->client, resp, "AT+CGREG?") < 0)
+        if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+CGREG?") < 0)
         {
             rt_thread_mdelay(M6315_LINK_DELAY_TIME);
 
@@ -382,7 +389,7 @@ static int m6315_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, i
     }
 
     /* send "AT+QIDNSCFG=<pri_dns>[,<sec_dns>]" commond to set dns servers */
-    if (at_obj_exec_cmd(device->client, resp, "AT+QIDNSCFG=\"%s\"", inet_ntoa(*dns_server)) < 0)
+    if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QIDNSCFG=\"%s\"", inet_ntoa(*dns_server)) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -435,7 +442,7 @@ static int m6315_netdev_ping(struct netdev *netdev, const char *host,
     }
 
     /* send "AT+QPING="<host>"[,[<timeout>][,<pingnum>]]" timeout:1-255 second, pingnum:1-10, commond to send ping request */
-    at_obj_exec_cmd(device->client, resp, "AT+QPING= \"%s\", 100, 1", host);
+    at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QPING= \"%s\", 100, 1", host);
     sscanf(at_resp_get_line_by_kw(resp, "+QPING:"), "+QPING:%d,%*s", &response);
     switch (response)
     {
@@ -547,6 +554,17 @@ static struct netdev *m6315_netdev_add(const char *netdev_name)
         }                                                                                          \
     } while(0)                                                                                     \
 
+#ifdef AT_DEVICE_M6315_USING_CMUX
+/* the socket data and URC use the first channel, the control commands use the second one */
+static const struct at_device_cmux_cfg m6315_cmux_cfg =
+{
+    "AT+CMUX=0,0,5,127",
+    "ATE0;+CMEE=2",
+    127,
+    1024,
+};
+#endif /* AT_DEVICE_M6315_USING_CMUX */
+
 /* init for m6315 */
 static void m6315_init_thread_entry(void *parameter)
 {
@@ -577,6 +595,8 @@ static void m6315_init_thread_entry(void *parameter)
 
     while (retry_num--)
     {
+        /* the physical AT client is put back after CMUX stopped by power off */
+        client = device->client;
         rt_memset(parsed_data, 0, sizeof(parsed_data));
         rt_thread_mdelay(500);
         m6315_power_on(device);
@@ -663,7 +683,7 @@ static void m6315_init_thread_entry(void *parameter)
         /* Define PDP Context */
         for (i = 0; i < COMMON_RETRY; i++)
         {
-            if (at_obj_exec_cmd(device->client, resp, "AT+CGDCONT=1,\"IP\",\"CMNET\"") == RT_EOK)
+            if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+CGDCONT=1,\"IP\",\"CMNET\"") == RT_EOK)
             {
                 LOG_D("%s device Define PDP Context Success.", device->name);
                 break;
@@ -680,7 +700,7 @@ static void m6315_init_thread_entry(void *parameter)
         /* PDP Context Activate*/
         for (i = 0; i < COMMON_RETRY; i++)
         {
-            if (at_obj_exec_cmd(device->client, resp, "AT+CGACT=1,1") == RT_EOK)
+            if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+CGACT=1,1") == RT_EOK)
             {
                 LOG_D("%s device PDP Context Activate Success.", device->name);
                 break;
@@ -736,7 +756,7 @@ static void m6315_init_thread_entry(void *parameter)
         /* check the GPRS network IP address */
         for (i = 0; i < IPADDR_RETRY; i++)
         {
-            if (at_obj_exec_cmd(device->client, resp, "AT+CGPADDR=1") == RT_EOK)
+            if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+CGPADDR=1") == RT_EOK)
             {
                 #define IP_ADDR_SIZE_MAX    16
                 char ipaddr[IP_ADDR_SIZE_MAX] = {0};
@@ -777,7 +797,7 @@ static void m6315_init_thread_entry(void *parameter)
         }
 
         /* Start task & set entry point default apn,username,password */
-        if (at_obj_exec_cmd(device->client, resp, "AT+QIREGAPP") < 0)
+        if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QIREGAPP") < 0)
         {
             LOG_E("%s device Start task & set default params failed.", device->name);
             result = -RT_ERROR;
@@ -785,13 +805,26 @@ static void m6315_init_thread_entry(void *parameter)
         }
 
         /* PDP Context Activate */
-        if (at_obj_exec_cmd(device->client, resp, "AT+QIACT") < 0)
+        if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QIACT") < 0)
         {
             LOG_E("%s device PDP Context Activate failed.", device->name);
             result = -RT_ERROR;
             goto __exit;
         }
 
+#ifdef AT_DEVICE_M6315_USING_CMUX
+        /* enter CMUX mode, the background commands do not queue behind the socket data */
+        if (at_device_cmux_start(device, &m6315_cmux_cfg) < 0)
+        {
+            result = -RT_ERROR;
+            goto __exit;
+        }
+#ifdef AT_USING_SOCKET
+        /* register URC to the data channel AT client */
+        m6315_socket_init(device);
+#endif
+#endif /* AT_DEVICE_M6315_USING_CMUX */
+
         /* initialize successfully  */
         result = RT_EOK;
         break;
@@ -884,7 +917,7 @@ static int m6315_init(struct at_device *device)
     }
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
 #ifdef AT_USING_SOCKET
     m6315_socket_init(device);
@@ -27,6 +27,8 @@
 #include <string.h>
 
 #include <at_device_m6315.h>
+#include <at_device_urc.h>
+#include <at_device_parser.h>
 
 #define LOG_TAG                        "at.skt.m6315"
 #include <at_log.h>
@@ -430,6 +432,7 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
     int device_socket = 0;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -447,7 +450,11 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
     }
 
     /* get the current socket by receive data */
-    sscanf(data, "%d,%*s", &device_socket);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_int(&parser, &device_socket) < 0)
+    {
+        return;
+    }
 
     if (strstr(data, "CONNECT OK"))
     {
@@ -474,9 +481,6 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    /* get the current socket by receive data */
-//    sscanf(data, "%d,%*s", &device_socket);
-
     if (rt_strstr(data, "SEND OK"))
     {
         m6315_socket_event_send(device, SET_EVENT(device_socket, M6315_EVENT_SEND_OK));
@@ -492,6 +496,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
     int device_socket = 0;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -503,7 +508,11 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
     }
 
     /* get the current socket by receive data */
-    sscanf(data, "%d,%*s", &device_socket);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_int(&parser, &device_socket) < 0)
+    {
+        return;
+    }
 
     if (rt_strstr(data, "CLOSE OK"))
     {
@@ -533,11 +542,18 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     struct at_socket *socket = RT_NULL;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
     /* get the current socket and receive buffer size by receive data */
-    sscanf(data, "+RECEIVE:%d,%d:", &device_socket, (int *) &bfsz);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+RECEIVE:") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_size(&parser, &bfsz) < 0)
+    {
+        return;
+    }
     /* set receive timeout by receive buffer length, not less than 10 ms */
     timeout = bfsz > 10 ? bfsz : 10;
 
@@ -621,7 +637,7 @@ int m6315_socket_init(struct at_device *device)
     RT_ASSERT(device);
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
     return RT_EOK;
 }
@@ -26,6 +26,8 @@
 #include <string.h>
 
 #include <at_device_me3616.h>
+#include <at_device_urc.h>
+#include <at_device_parser.h>
 
 #define LOG_TAG                        "at.skt.me3616"
 #include <at_log.h>
@@ -434,6 +436,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
     struct at_socket *socket = RT_NULL;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -444,7 +447,13 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    sscanf(data, "+ESOERR=%d,%d", &sock, &err_code);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+ESOERR=") < 0 ||
+            at_device_parser_int(&parser, &sock) < 0 ||
+            at_device_parser_int(&parser, &err_code) < 0)
+    {
+        return;
+    }
 
     device_socket = me3616_get_socket_idx(sock);
     if (device_socket < 0 || err_code < 0 || err_code > 4)
@@ -472,6 +481,7 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     struct at_socket *socket = RT_NULL;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -482,7 +492,12 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    sscanf(data, "+ESONMI=%d,", &sock);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+ESONMI=") < 0 ||
+            at_device_parser_int(&parser, &sock) < 0)
+    {
+        return;
+    }
     device_socket = me3616_get_socket_idx(sock);
     if (device_socket < 0)
     {
@@ -504,7 +519,11 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    sscanf(temp, "%d", (int *)&bfsz);
+    at_device_parser_init(&parser, temp, temp_size);
+    if (at_device_parser_size(&parser, &bfsz) < 0)
+    {
+        return;
+    }
     if(bfsz == 0)
     {
         return;
@@ -578,7 +597,7 @@ int me3616_socket_init(struct at_device *device)
     rt_memset(me3616_socket_fd, -1, sizeof(me3616_socket_fd));
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
     return RT_EOK;
 }
@@ -26,6 +26,7 @@
 #include <string.h>
 
 #include <at_device_mw31.h>
+#include <at_device_urc.h>
 
 #define LOG_TAG                        "at.dev.mw31"
 
@@ -606,7 +607,7 @@ static int mw31_init(struct at_device *device)
     }
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
 #ifdef AT_USING_SOCKET
     mw31_socket_init(device);
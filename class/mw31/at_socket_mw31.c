@@ -26,6 +26,8 @@
 #include <string.h>
 
 #include <at_device_mw31.h>
+#include <at_device_urc.h>
+#include <at_device_parser.h>
 
 #define LOG_TAG                       "at.skt.mw31"
 #include <at_log.h>
@@ -381,6 +383,7 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
     rt_uint8_t i;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -393,14 +396,26 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
 
     at_client_obj_recv(client, temp, 2, 1000);
     /* get the at deveice socket and receive buffer size by receive data */
-    sscanf(temp, "%d,", &device_socket);
+    at_device_parser_init(&parser, temp, 2);
+    if (at_device_parser_int(&parser, &device_socket) < 0)
+    {
+        return;
+    }
     temp[0] = 0;
     temp[1] = 0;
-    for (i = 0; i < 6 && temp[i - 1] != ','; i++)
+    for (i = 0; i < 6; i++)
     {
         at_client_obj_recv(client, &temp[i], 1, 1000);
+        if (temp[i] == ',')
+        {
+            break;
+        }
+    }
+    at_device_parser_init(&parser, temp, i);
+    if (at_device_parser_size(&parser, &bfsz) < 0)
+    {
+        return;
     }
-    sscanf(temp, "%ld,", &bfsz);
 
     LOG_D("socket:%d, size:%ld\n", device_socket, bfsz);
     /* set receive timeout by receive buffer length, not less than 10 ms */
@@ -458,7 +473,7 @@ int mw31_socket_init(struct at_device *device)
     RT_ASSERT(device);
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
     return RT_EOK;
 }
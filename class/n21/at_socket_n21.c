@@ -25,6 +25,8 @@
 #include <stdio.h>
 #include <string.h>
 #include <at_device_n21.h>
+#include <at_device_urc.h>
+#include <at_device_parser.h>
 
 #if !defined(AT_SW_VERSION_NUM) || AT_SW_VERSION_NUM < 0x10300
 #error "This AT Client version is older, please check and update latest AT Client!"
@@ -459,6 +461,7 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
     char constat[16] = {0};
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -470,7 +473,13 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
     }
 
     /* get the current socket by receive data */
-    sscanf(data, "%*[^ ]%d,%s\r\n", &device_socket, constat);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_skip_to(&parser, ' ') < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_str(&parser, constat, sizeof(constat)) < 0)
+    {
+        return;
+    }
 
     LOG_D("data:%s", data);
 
@@ -493,6 +502,7 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
     int device_socket = 0;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -504,7 +514,12 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
     }
 
     /* get the current socket by receive data */
-    sscanf(data, "%*[^ ] %d,%*d", &device_socket);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_skip_to(&parser, ' ') < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0)
+    {
+        return;
+    }
 
     if (rt_strstr(data, "OPERATION"))
     {
@@ -526,6 +541,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
     int device_socket = 0;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -538,7 +554,12 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 
     /* get the current socket by receive data */
     /* +TCPCLOSE: 1,OK */
-    sscanf(data, "%*[^ ]%d,%*s", &device_socket);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_skip_to(&parser, ' ') < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0)
+    {
+        return;
+    }
 
     if (rt_strstr(data, "OK"))
     {
@@ -568,11 +589,19 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     struct at_socket *socket = RT_NULL;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
     /* get the current socket and receive buffer size by receive data */
-    sscanf(data, "%*[^ ] %d,%d,", &device_socket, (int *)&bfsz);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_skip_to(&parser, ' ') < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_size(&parser, &bfsz) < 0 ||
+            bfsz + 2 >= size)
+    {
+        return;
+    }
 
     recv_buf = (char *)rt_calloc(1, bfsz + 1);
 
@@ -645,7 +674,7 @@ int n21_socket_init(struct at_device *device)
     RT_ASSERT(device);
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
     return RT_EOK;
 }
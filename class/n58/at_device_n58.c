@@ -26,6 +26,9 @@
 #include <string.h>
 #include <ctype.h>
 #include <at_device_n58.h>
+#include <at_device_urc.h>
+#include <at_device_parser.h>
+#include <at_device_boot.h>
 
 #if !defined(AT_SW_VERSION_NUM) || AT_SW_VERSION_NUM < 0x10300
 #error "This AT Client version is older, please check and update latest AT Client!"
@@ -607,18 +610,71 @@ static struct netdev *n58_netdev_add(const char *netdev_name)
         }                                                                                       \
     } while (0)
 
+/* boot steps check, the result line fields are "<n>,<stat>" */
+static int n58_boot_reg_stat(const char *line, const char *keyword)
+{
+    int n = 0, stat = 0;
+    struct at_device_parser parser;
+
+    at_device_parser_init(&parser, line, rt_strlen(line));
+    if (at_device_parser_expect(&parser, keyword) < 0 ||
+            at_device_parser_int(&parser, &n) < 0 || at_device_parser_int(&parser, &stat) < 0)
+    {
+        return 0;
+    }
+
+    return (stat == 1 || stat == 5) ? 1 : 0;
+}
+
+static int n58_boot_ccid_check(struct at_device *device, const char *line)
+{
+    LOG_I("n58 device(%s) SIM card detection success.", device->name);
+    LOG_I("%s", line);
+    return 1;
+}
+
+static int n58_boot_creg_check(struct at_device *device, const char *line)
+{
+    return n58_boot_reg_stat(line, "+CREG:");
+}
+
+static int n58_boot_cereg_check(struct at_device *device, const char *line)
+{
+    return n58_boot_reg_stat(line, "+CEREG:");
+}
+
+static int n58_boot_csq_check(struct at_device *device, const char *line)
+{
+    int rssi = 0, ber = 0;
+    struct at_device_parser parser;
+
+    at_device_parser_init(&parser, line, rt_strlen(line));
+    if (at_device_parser_expect(&parser, "+CSQ:") < 0 ||
+            at_device_parser_int(&parser, &rssi) < 0 ||
+            at_device_parser_int(&parser, &ber) < 0 || rssi == 99)
+    {
+        return 0;
+    }
+
+    LOG_I("n58 device(%s) signal strength: %d,%d", device->name, rssi, ber);
+    return 1;
+}
+
+/* the SIM card, network registration and signal strength are polled with the adaptive interval */
+static const struct at_device_boot_step n58_boot_steps[] =
+{
+    {"ccid",  "AT+CCID",   "+CCID:",  2, 0, 5 * 1000, 10 * 1000, n58_boot_ccid_check},
+    {"creg",  "AT+CREG?",  "+CREG:",  0, 0, 1000, 60 * 1000, n58_boot_creg_check},
+    {"cereg", "AT+CEREG?", "+CEREG:", 0, 0, 300, 30 * 1000, n58_boot_cereg_check},
+    {"csq",   "AT+CSQ",    "+CSQ:",   0, 0, 300, 10 * 1000, n58_boot_csq_check},
+};
+
 /* init for n58 */
 static void n58_init_thread_entry(void *parameter)
 {
 #define INIT_RETRY 5
-#define CPIN_RETRY 10
-#define CSQ_RETRY 10
-#define CREG_RETRY 60
-#define CEREG_RETRY 30
-#define CCID_SIZE 20
 
     int i, retry_num = INIT_RETRY;
-    char ccid[CCID_SIZE] = {0};
     char parsed_data[10] = {0};
     rt_err_t result = RT_EOK;
     at_response_t resp = RT_NULL;
@@ -632,6 +688,14 @@ static void n58_init_thread_entry(void *parameter)
         return;
     }
 
+    result = at_device_boot_init(device, n58_boot_steps, sizeof(n58_boot_steps) / sizeof(n58_boot_steps[0]));
+    if (result < 0)
+    {
+        LOG_E("n58 device(%s) network initialize failed(%d)!", device->name, result);
+        at_delete_resp(resp);
+        return;
+    }
+
     while (retry_num--)
     {
         rt_memset(parsed_data, 0, sizeof(parsed_data));
@@ -640,12 +704,14 @@ static void n58_init_thread_entry(void *parameter)
         rt_thread_mdelay(5000); //check the n58 hardware manual, when we use the pow_key to start n58, it takes about 20s,so we put 25s here to ensure starting n58 normally.
 
         LOG_I("start initializing the n58 device(%s)", device->name);
+        at_device_boot_mark(device, "power");
         /* wait n58 startup finish */
         if (at_client_obj_wait_connect(client, N58_WAIT_CONNECT_TIME))
         {
             result = -RT_ETIMEOUT;
             goto __exit;
         }
+        at_device_boot_mark(device, "sync");
 
         /* disable echo */
         AT_SEND_CMD(client, resp, 0, 300, "ATE0");
@@ -656,92 +722,12 @@ static void n58_init_thread_entry(void *parameter)
         {
             LOG_I("%s", at_resp_get_line(resp, i + 1));
         }
-        /* check SIM card */
-        for (i = 0; i < CPIN_RETRY; i++)
-        {
-            at_resp_set_info(resp, 128, 2, 5 * RT_TICK_PER_SECOND);
-            if (at_obj_exec_cmd(client, resp, "AT+CCID") < 0)
-            {
-                LOG_E("AT+CCID ERROR! retry:%d.", i);
-                rt_thread_mdelay(1000);
-                continue;
-            }
+        at_device_boot_mark(device, "ident");
 
-            if (at_resp_parse_line_args_by_kw(resp, "+CCID:", "+CCID: %s", ccid))
-            {
-                LOG_I("n58 device(%s) SIM card detection success.", device->name);
-                LOG_I("CCID: %s", ccid);
-                break;
-            }
-            rt_thread_mdelay(1000);
-        }
-        if (i == CPIN_RETRY)
-        {
-            LOG_E("n58 device(%s) SIM card detection failed.", device->name);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        /* waiting for dirty data to be digested */
-        rt_thread_mdelay(500);
-        LOG_I("register network!");
-        /* check the GSM network is registered */
-        for (i = 0; i < CREG_RETRY; i++)
-        {
-            AT_SEND_CMD(client, resp, 0, 1000, "AT+CREG?");
-            at_resp_parse_line_args_by_kw(resp, "+CREG:", "+CREG: %s", &parsed_data);
-            if (!strncmp(parsed_data, "0,1", sizeof(parsed_data)) ||
-                !strncmp(parsed_data, "0,5", sizeof(parsed_data)))
-            {
-                LOG_I("n58 device(%s) network is registered(%s),", device->name, parsed_data);
-                break;
-            }
-            rt_thread_mdelay(1000);
-            LOG_W("AT+CREG? Retry:%d", i);
-        }
-        if (i == CREG_RETRY)
-        {
-            LOG_E("n58 device(%s) network is register failed(%s).", device->name, parsed_data);
-            rt_thread_mdelay(10);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-        /* check the GPRS network is registered */
-        for (i = 0; i < CEREG_RETRY; i++)
+        /* check the SIM card, the network registration and the signal strength */
+        result = at_device_boot_run(device);
+        if (result < 0)
         {
-            AT_SEND_CMD(client, resp, 0, 300, "AT+CEREG?");
-            at_resp_parse_line_args_by_kw(resp, "+CEREG:", "+CEREG: %s", &parsed_data);
-            if (!strncmp(parsed_data, "0,1", sizeof(parsed_data)) ||
-                !strncmp(parsed_data, "0,5", sizeof(parsed_data)))
-            {
-                LOG_I("n58 device(%s) GPRS network is registered(%s).", device->name, parsed_data);
-                break;
-            }
-            rt_thread_mdelay(1000);
-        }
-        if (i == CEREG_RETRY)
-        {
-            LOG_E("n58 device(%s) GPRS network is register failed(%s).", device->name, parsed_data);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        /* check signal strength */
-        for (i = 0; i < CSQ_RETRY; i++)
-        {
-            AT_SEND_CMD(client, resp, 0, 300, "AT+CSQ");
-            at_resp_parse_line_args_by_kw(resp, "+CSQ:", "+CSQ: %s", &parsed_data);
-            if (strncmp(parsed_data, "99,99", sizeof(parsed_data)))
-            {
-                LOG_I("n58 device(%s) signal strength: %s", device->name, parsed_data);
-                break;
-            }
-            rt_thread_mdelay(1000);
-        }
-        if (i == CSQ_RETRY)
-        {
-            LOG_E("n58 device(%s) signal strength check failed (%s)", device->name, parsed_data);
-            result = -RT_ERROR;
             goto __exit;
         }
 
@@ -772,6 +758,7 @@ static void n58_init_thread_entry(void *parameter)
         AT_SEND_CMD(client, resp, 0, 20 * 1000, "AT+XIIC=1");
 
         AT_SEND_CMD(client, resp, 0, 300, "AT+XIIC?");
+        at_device_boot_mark(device, "dial");
         if (at_resp_get_line_by_kw(resp, "ERROR") != RT_NULL)
         {
             LOG_E("n58 device(%s) get the local address failed.", device->name);
@@ -809,6 +796,7 @@ static void n58_init_thread_entry(void *parameter)
         /* set network interface device status and address information */
         n58_netdev_set_info(device->netdev);
         n58_netdev_check_link_status(device->netdev);
+        at_device_boot_report(device);
         LOG_I("n58 device(%s) network initialize success!", device->name);
     }
     else
@@ -868,7 +856,7 @@ static int n58_init(struct at_device *device)
     }
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
 #ifdef AT_USING_SOCKET
     n58_socket_init(device);
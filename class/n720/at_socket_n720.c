@@ -26,6 +26,9 @@
 #include <string.h>
 
 #include <at_device_n720.h>
+#include <at_device_urc.h>
+#include <at_device_parser.h>
+#include <at_device_work.h>
 
 #define LOG_TAG                        "at.skt.n720"
 #include <at_log.h>
@@ -393,6 +396,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
     struct at_socket *socket = RT_NULL;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -403,7 +407,12 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    sscanf(data, "$MYURCCLOSE: %d", &device_socket);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "$MYURCCLOSE:") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0)
+    {
+        return;
+    }
     /* get at socket object by device socket descriptor */
     socket = &(device->sockets[device_socket]);
 
@@ -414,18 +423,23 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
     }
 }
 
-static void send_net_read(struct at_client *client, int device_socket)
+static void n720_socket_read(struct at_device *device, void *arg)
 {
-    char *send_buf = (char *) rt_malloc(128);
-    if (send_buf == RT_NULL)
+    int device_socket = *(int *) arg;
+
+    if (at_obj_exec_cmd(device->client, RT_NULL, "AT$MYNETREAD=%d,%d", device_socket, N720_MODULE_SEND_MAX_SIZE) < 0)
     {
-        return;
+        LOG_E("%s device socket(%d) read failed.", device->name, device_socket);
     }
+}
 
-    rt_sprintf(send_buf, "AT$MYNETREAD=%d,%d\r\n", device_socket, N720_MODULE_SEND_MAX_SIZE);
-    at_client_obj_send(client, send_buf, strlen(send_buf));
-
-    rt_free(send_buf);
+/* the read command must hold the AT client lock, send it in the work queue, not in the URC function */
+static void send_net_read(struct at_device *device, int device_socket)
+{
+    if (at_device_work_submit(device, n720_socket_read, &device_socket, sizeof(device_socket)) < 0)
+    {
+        LOG_E("%s device socket(%d) read submit failed.", device->name, device_socket);
+    }
 }
 
 static void urc_recv_func(struct at_client *client, const char *data, rt_size_t size)
@@ -433,6 +447,7 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     int device_socket = 0;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -443,12 +458,14 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    if (sscanf(data, "$MYURCREAD: %d", &device_socket) <= 0)
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "$MYURCREAD:") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0)
     {
         return;
     }
 
-    send_net_read(client, device_socket);
+    send_net_read(device, device_socket);
 }
 
 static void read_ack_func(struct at_client *client, const char *data, rt_size_t size)
@@ -460,6 +477,7 @@ static void read_ack_func(struct at_client *client, const char *data, rt_size_t
     struct at_socket *socket = RT_NULL;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -471,11 +489,17 @@ static void read_ack_func(struct at_client *client, const char *data, rt_size_t
     }
 
     /* get the current socket and receive buffer size by receive data */
-    sscanf(data, "$MYNETREAD: %d,%d", &device_socket, &bfsz);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "$MYNETREAD:") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_int(&parser, &bfsz) < 0)
+    {
+        return;
+    }
     /* set receive timeout by receive buffer length, not less than 10 ms */
     timeout = bfsz > 10 ? bfsz : 10;
 
-    if (device_socket < 0 || bfsz == 0)
+    if (device_socket < 0 || bfsz <= 0)
     {
         return;
     }
@@ -517,7 +541,7 @@ static void read_ack_func(struct at_client *client, const char *data, rt_size_t
         at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
     }
     
-    send_net_read(client, device_socket);
+    send_net_read(device, device_socket);
 }
 
 static const struct at_urc urc_table[] =
@@ -541,9 +565,9 @@ int n720_socket_init(struct at_device *device)
     RT_ASSERT(device);
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
-    return RT_EOK;
+    return at_device_work_init(device);
 }
 
 int n720_socket_class_register(struct at_device_class *class)
@@ -27,6 +27,7 @@
 #include <string.h>
 
 #include <at_device_rw007.h>
+#include <at_device_urc.h>
 
 #define LOG_TAG                        "at.dev.rw007"
 
@@ -255,7 +256,7 @@ static int rw007_init(struct at_device *device)
     }
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
 #ifdef AT_USING_SOCKET
     rw007_socket_init(device);
@@ -27,6 +27,8 @@
 #include <string.h>
 
 #include <at_device_rw007.h>
+#include <at_device_urc.h>
+#include <at_device_parser.h>
 
 #define LOG_TAG                       "at.skt.rw007"
 #include <at_log.h>
@@ -428,10 +430,15 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
 static void urc_send_bfsz_func(struct at_client *client, const char *data, rt_size_t size)
 {
     static int cur_send_bfsz = 0;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
-    sscanf(data, "Recv %d bytes", &cur_send_bfsz);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "Recv") == 0)
+    {
+        at_device_parser_int(&parser, &cur_send_bfsz);
+    }
 }
 
 static void urc_close_func(struct at_client *client, const char *data, rt_size_t size)
@@ -440,6 +447,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
     struct at_socket *socket = RT_NULL;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -450,7 +458,11 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    sscanf(data, "%d,CLOSED", &device_socket);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_int(&parser, &device_socket) < 0)
+    {
+        return;
+    }
     /* get at socket object by device socket descriptor */
     socket = &(device->sockets[device_socket]);
 
@@ -470,6 +482,7 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     struct at_socket *socket = RT_NULL;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -481,7 +494,13 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     }
 
     /* get the current socket and receive buffer size by receive data */
-    sscanf(data, "+IPD,%d,%d:", &device_socket, (int *) &bfsz);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+IPD,") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_size(&parser, &bfsz) < 0)
+    {
+        return;
+    }
     /* set receive timeout by receive buffer length, not less than 10 ms */
     timeout = bfsz > 10 ? bfsz : 10;
 
@@ -542,7 +561,7 @@ int rw007_socket_init(struct at_device *device)
     RT_ASSERT(device);
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
     return RT_EOK;
 }
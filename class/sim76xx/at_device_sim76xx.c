@@ -30,6 +30,8 @@
 #include <string.h>
 
 #include <at_device_sim76xx.h>
+#include <at_device_cmux.h>
+#include <at_device_ppp.h>
 
 #define LOG_TAG                        "at.dev.sim76"
 #include <at_log.h>
@@ -73,6 +75,11 @@ static void sim76xx_power_off(struct at_device *device)
 
     sim76xx = (struct at_device_sim76xx *) device->user_data;
 
+#ifdef AT_DEVICE_SIM76XX_USING_CMUX
+    /* the module boots in AT command mode, leave CMUX mode before it is powered off */
+    at_device_cmux_stop(device);
+#endif
+
     /* not nead to set pin configuration for m26 device power on */
     if (sim76xx->power_pin == -1 || sim76xx->power_status_pin == -1)
     {
@@ -138,7 +145,7 @@ static int sim76xx_netdev_set_info(struct netdev *netdev)
         int i = 0, j = 0;
 
         /* send "ATI" commond to get device IMEI */
-        if (at_obj_exec_cmd(device->client, resp, "ATI") < 0)
+        if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "ATI") < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -176,7 +183,7 @@ static int sim76xx_netdev_set_info(struct netdev *netdev)
         at_resp_set_info(resp, SIM76XX_IPADDR_RESP_SIZE, 2, SIM76XX_INFO_RESP_TIMO);
 
         /* send "AT+IPADDR" commond to get IP address */
-        if (at_obj_exec_cmd(device->client, resp, "AT+IPADDR") < 0)
+        if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+IPADDR") < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -246,7 +253,7 @@ static void check_link_status_entry(void *parameter)
     while (1)
     {
         /* send "AT+CGREG?" commond  to check netweork interface device link status */
-        if (at_obj_exec_cmd(device->client, resp, "AT+CGREG?") < 0)
+        if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+CGREG?") < 0)
         {
             rt_thread_mdelay(SIM76XX_LINK_DELAY_TIME);
 
@@ -375,7 +382,7 @@ static int sim76xx_netdev_ping(struct netdev *netdev, const char *host,
 
     /* send "AT+CIPPING=<dest_addr>,<dest_addr_type>[,<num_pings>[,<package_size>[,<interval_time>[,<wait_timer>[,<TTL>]]]]]"
        commond to send ping request */
-    if (at_obj_exec_cmd(device->client, resp, "AT+CPING=\"%s\",1,1,%d,,,64", host, data_len) < 0)
+    if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+CPING=\"%s\",1,1,%d,,,64", host, data_len) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -476,6 +483,29 @@ static struct netdev *sim76xx_netdev_add(const char *netdev_name)
         }                                                                       \
     } while(0)                                                                  \
 
+#ifdef AT_DEVICE_SIM76XX_USING_CMUX
+/* the socket data and URC use the first channel, the control commands use the second one */
+static const struct at_device_cmux_cfg sim76xx_cmux_cfg =
+{
+    "AT+CMUX=0,0,5,127",
+    "ATE0;+CMEE=2",
+    127,
+    1024,
+};
+#endif /* AT_DEVICE_SIM76XX_USING_CMUX */
+
+#ifdef AT_DEVICE_SIM76XX_USING_PPP
+#ifndef AT_DEVICE_SIM76XX_USING_CMUX
+#error "SIM76XX PPP data call needs the CMUX control channel, please define AT_DEVICE_SIM76XX_USING_CMUX."
+#endif
+/* the data call uses the default PDP context, release it from the module TCP/IP stack first */
+static const struct at_device_ppp_cfg sim76xx_ppp_cfg =
+{
+    "AT+NETCLOSE",
+    "ATD*99#",
+};
+#endif /* AT_DEVICE_SIM76XX_USING_PPP */
+
 /* initialize the sim76xx device network connection by command */
 static void sim76xx_init_thread_entry(void *parameter)
 {
@@ -506,6 +536,8 @@ static void sim76xx_init_thread_entry(void *parameter)
 
     while (retry_num--)
     {
+        /* the physical AT client is put back after CMUX stopped by power off */
+        client = device->client;
         /* power-up sim76xx */
         sim76xx_power_on(device);
 
@@ -658,7 +690,7 @@ static void sim76xx_init_thread_entry(void *parameter)
 
         for (i = 0; i < CCLK_RETRY; i++)
         {
-            if (at_obj_exec_cmd(device->client, at_resp_set_info(resp, 256, 0, 5 * RT_TICK_PER_SECOND), "AT+CCLK?") < 0)
+            if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), at_resp_set_info(resp, 256, 0, 5 * RT_TICK_PER_SECOND), "AT+CCLK?") < 0)
             {
                 rt_thread_mdelay(500);
                 continue;
@@ -686,6 +718,28 @@ static void sim76xx_init_thread_entry(void *parameter)
         }
 #endif /* RT_USING_RTC */
 
+#ifdef AT_DEVICE_SIM76XX_USING_CMUX
+        /* enter CMUX mode, the background commands do not queue behind the socket data */
+        if (at_device_cmux_start(device, &sim76xx_cmux_cfg) < 0)
+        {
+            result = -RT_ERROR;
+            goto __exit;
+        }
+#ifdef AT_USING_SOCKET
+        /* register URC to the data channel AT client */
+        sim76xx_socket_init(device);
+#endif
+#endif /* AT_DEVICE_SIM76XX_USING_CMUX */
+
+#ifdef AT_DEVICE_SIM76XX_USING_PPP
+        /* the sockets use lwIP over the data call instead of the module TCP/IP stack */
+        if (at_device_ppp_start(device, &sim76xx_ppp_cfg) < 0)
+        {
+            result = -RT_ERROR;
+            goto __exit;
+        }
+#endif /* AT_DEVICE_SIM76XX_USING_PPP */
+
         /* initialize successfully  */
         result = RT_EOK;
         break;
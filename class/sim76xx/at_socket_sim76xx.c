@@ -30,6 +30,8 @@
 #include <string.h>
 
 #include <at_device_sim76xx.h>
+#include <at_device_urc.h>
+#include <at_device_parser.h>
 
 #define LOG_TAG                        "at.skt.sim76"
 #include <at_log.h>
@@ -522,6 +524,7 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
     int device_socket = 0, rqst_size, cnf_size;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -532,7 +535,14 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    sscanf(data, "+CIPSEND: %d,%d,%d", &device_socket, &rqst_size, &cnf_size);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+CIPSEND:") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_int(&parser, &rqst_size) < 0 ||
+            at_device_parser_int(&parser, &cnf_size) < 0)
+    {
+        return;
+    }
     sim76xx_socket_event_send(device, SET_EVENT(device_socket, SIM76XX_EVENT_SEND_OK));
 }
 
@@ -541,6 +551,7 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
     int device_socket = 0, result = 0;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -551,7 +562,13 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
         return;
     }
 
-    sscanf(data, "+CIPOPEN: %d,%d", &device_socket, &result);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+CIPOPEN:") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_int(&parser, &result) < 0)
+    {
+        return;
+    }
 
     if (result == 0)
     {
@@ -570,6 +587,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
     struct at_socket *socket = RT_NULL;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -580,7 +598,13 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    sscanf(data, "+IPCLOSE %d,%d", &device_socket, &reason);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+IPCLOSE ") < 0 ||
+            at_device_parser_int(&parser, &device_socket) < 0 ||
+            at_device_parser_int(&parser, &reason) < 0)
+    {
+        return;
+    }
     /* get AT socket object by device socket descriptor */
     socket = &(device->sockets[device_socket]);
 
@@ -601,6 +625,7 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     struct at_device *device = RT_NULL;
     struct at_device_sim76xx *sim76xx = RT_NULL;
     char *client_name = client->device->parent.name;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -614,7 +639,12 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     device_socket = (int) sim76xx->user_data;
 
     /* get the current socket and receive buffer size by receive data */
-    sscanf(data, "+IPD%d:", (int *)&bfsz);
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+IPD") < 0 ||
+            at_device_parser_size(&parser, &bfsz) < 0)
+    {
+        return;
+    }
     /* get receive timeout by receive buffer length */
     timeout = bfsz * 10;
 
@@ -687,7 +717,7 @@ int sim76xx_socket_init(struct at_device *device)
     RT_ASSERT(device);
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
     return RT_EOK;
 }
@@ -29,6 +29,8 @@
 #include <ctype.h>
 
 #include <at_device_sim800c.h>
+#include <at_device_urc.h>
+#include <at_device_apn.h>
 
 #define LOG_TAG                        "at.dev.sim800"
 #include <at_log.h>
@@ -39,11 +41,6 @@
 #define SIM800C_THREAD_STACK_SIZE      2048
 #define SIM800C_THREAD_PRIORITY        (RT_THREAD_PRIORITY_MAX/2)
 
-/* AT+CSTT command default*/
-static char *CSTT_CHINA_MOBILE  = "AT+CSTT=\"CMNET\"";
-static char *CSTT_CHINA_UNICOM  = "AT+CSTT=\"UNINET\"";
-static char *CSTT_CHINA_TELECOM = "AT+CSTT=\"CTNET\"";
-
 static void sim800c_power_on(struct at_device *device)
 {
     struct at_device_sim800c *sim800c = RT_NULL;
@@ -622,6 +619,7 @@ static void sim800c_init_thread_entry(void *parameter)
     char parsed_data[32] = {0};
     rt_err_t result = RT_EOK;
     at_response_t resp = RT_NULL;
+    const struct at_device_apn *apn = RT_NULL;
     struct at_device *device = (struct at_device *)parameter;
     struct at_client *client = device->client;
 
@@ -747,30 +745,21 @@ static void sim800c_init_thread_entry(void *parameter)
             AT_SEND_CMD(client, resp, 0, 300, "AT+CIPMUX=1");
         }
 
-        AT_SEND_CMD(client, resp, 0, 300, "AT+COPS?");
-        at_resp_parse_line_args_by_kw(resp, "+COPS:", "+COPS: %*[^\"]\"%[^\"]", &parsed_data);
-        if (rt_strcmp(parsed_data, "CHINA MOBILE") == 0)
-        {
-            /* "CMCC" */
-            LOG_I("%s device network operator: %s", device->name, parsed_data);
-            AT_SEND_CMD(client, resp, 0, 300, CSTT_CHINA_MOBILE);
-        }
-        else if (rt_strcmp(parsed_data, "CHN-UNICOM") == 0)
+        /* the APN is found by the PLMN of the SIM card, the unknown one uses the network default */
+        apn = at_device_apn_query(device, client);
+        if (apn)
         {
-            /* "UNICOM" */
-            LOG_I("%s device network operator: %s", device->name, parsed_data);
-            AT_SEND_CMD(client, resp, 0, 300, CSTT_CHINA_UNICOM);
-        }
-        else if (rt_strcmp(parsed_data, "CHN-CT") == 0)
-        {
-            AT_SEND_CMD(client, resp, 0, 300, CSTT_CHINA_TELECOM);
-            /* "CT" */
-            LOG_I("%s device network operator: %s", device->name, parsed_data);
+            resp = at_resp_set_info(resp, 128, 0, rt_tick_from_millisecond(300));
+            if (at_obj_exec_cmd(client, resp, "AT+CSTT=\"%s\",\"%s\",\"%s\"", apn->apn,
+                                apn->username ? apn->username : "", apn->password ? apn->password : "") < 0)
+            {
+                result = -RT_ERROR;
+                goto __exit;
+            }
         }
         else
         {
             AT_SEND_CMD(client, resp, 0, 300, "AT+CSTT");
-            LOG_I("%s device network operator: %s", device->name, parsed_data);
         }
 
         /* the device default response timeout is 150 seconds, but it set to 20 seconds is convenient to use. */
@@ -874,7 +863,7 @@ static int sim800c_init(struct at_device *device)
     }
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
 #ifdef AT_USING_SOCKET
     sim800c_socket_init(device);
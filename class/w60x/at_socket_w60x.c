@@ -27,6 +27,8 @@
 #include <string.h>
 
 #include <at_device_w60x.h>
+#include <at_device_urc.h>
+#include <at_device_parser.h>
 
 #define LOG_TAG                       "at.skt.w60x"
 #include <at_log.h>
@@ -127,7 +129,7 @@ static int w60x_socket_connect(struct at_socket *socket, char *ip, int32_t port,
         case AT_SOCKET_TCP:
             /* send AT commands */
             if (at_obj_exec_cmd(device->client, resp,
-                                "AT+SKCT=0,%d,%s,%d", is_client ? 0 : 1, is_client ? ip : 0, port) < 0)
+                                "AT+SKCT=0,%d,%s,%d", is_client ? 0 : 1, ip, port) < 0)
             {
                 result = -RT_ERROR;
             }
@@ -135,7 +137,7 @@ static int w60x_socket_connect(struct at_socket *socket, char *ip, int32_t port,
 
         case AT_SOCKET_UDP:
             if (at_obj_exec_cmd(device->client, resp,
-                                "AT+SKCT=1,%d,%s,%d", is_client ? 0 : 1, is_client ? ip : 0, port) < 0)
+                                "AT+SKCT=1,%d,%s,%d", is_client ? 0 : 1, ip, port) < 0)
             {
                 result = -RT_ERROR;
             }
@@ -275,6 +277,7 @@ static int w60x_domain_resolve(const char *name, char ip[16])
     char recv_ip[16] = { 0 };
     at_response_t resp = RT_NULL;
     struct at_device *device = RT_NULL;
+    struct at_device_parser parser;
     char *pos;
 
     RT_ASSERT(name);
@@ -312,9 +315,9 @@ static int w60x_domain_resolve(const char *name, char ip[16])
             continue;
         }
 
-        sscanf(pos, "+OK=\"%[^\"]\"", recv_ip);
-
-        if (rt_strlen(recv_ip) < 8)
+        at_device_parser_init(&parser, pos, rt_strlen(pos));
+        if (at_device_parser_expect(&parser, "+OK=") < 0 ||
+                at_device_parser_ipv4(&parser, recv_ip) < 0)
         {
             rt_thread_mdelay(100);
             /* resolve failed, maybe receive an URC CRLF */
@@ -375,10 +378,11 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
     char recv_ip[16] = { 0 };
-    rt_int32_t recv_port = 0;
+    int recv_port = 0;
     rt_uint8_t i;
     char *pos;
     int wsk;
+    struct at_device_parser parser;
 
     RT_ASSERT(data && size);
 
@@ -391,7 +395,20 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
 
     /* get the at deveice socket and receive buffer size by receive data */
     pos = rt_strstr(data, "+SKTRPT=");
-    sscanf(pos, "+SKTRPT=%d,%d,%[^,],%d", &wsk, (int *) &bfsz, recv_ip, &recv_port);
+    if (pos == RT_NULL)
+    {
+        return;
+    }
+
+    at_device_parser_init(&parser, pos, size - (pos - data));
+    if (at_device_parser_expect(&parser, "+SKTRPT=") < 0 ||
+            at_device_parser_int(&parser, &wsk) < 0 ||
+            at_device_parser_size(&parser, &bfsz) < 0 ||
+            at_device_parser_ipv4(&parser, recv_ip) < 0 ||
+            at_device_parser_int(&parser, &recv_port) < 0)
+    {
+        return;
+    }
 
     for (i = 0; i < AT_DEVICE_W60X_SOCKETS_NUM; i++)
     {
@@ -462,7 +479,7 @@ int w60x_socket_init(struct at_device *device)
     RT_ASSERT(device);
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    at_device_urc_set_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
     return RT_EOK;
 }
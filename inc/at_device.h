@@ -86,6 +86,18 @@ extern "C" {
 #define AT_DEVICE_NAMETYPE_CLIENT      0x03
 
 struct at_device;
+struct at_device_cmux;
+struct at_device_ppp;
+struct at_device_sched;
+struct at_device_boot;
+struct at_device_mqtt;
+struct at_device_coap;
+struct rt_workqueue;
+#ifdef AT_USING_SOCKET
+struct at_device_socket_dialect;
+struct at_device_socket_info;
+struct at_device_socket_tls;
+#endif
 
 /* AT device wifi ssid and password information */
 struct at_device_ssid_pwd
@@ -94,6 +106,26 @@ struct at_device_ssid_pwd
     char *password;
 };
 
+/* AT device connection scheduler policy, the device with the lowest score is selected */
+#define AT_DEVICE_SELECT_ROUND_ROBIN   0x00      /* the times selected */
+#define AT_DEVICE_SELECT_LEAST_SOCKETS 0x01      /* the active sockets */
+#define AT_DEVICE_SELECT_BEST_SIGNAL   0x02      /* the signal strength, unknown is the worst */
+#define AT_DEVICE_SELECT_LOWEST_RTT    0x03      /* the smoothed connect time, unknown is tried first */
+#define AT_DEVICE_SELECT_CUSTOM        0x04      /* the score function set by user */
+
+/* AT device live metrics used by the connection scheduler */
+struct at_device_metrics
+{
+    int signal;                                  /* the signal strength in dBm, 0: unknown */
+    rt_uint32_t rtt;                             /* the smoothed connect round trip time in millisecond, 0: unknown,
+                                                    it is measured from the command sent, not the scheduler queueing */
+    rt_uint32_t selected;                        /* the times selected by the connection scheduler */
+};
+
+/* the score of the ready device for a new connection, it is called in the thread context with interrupt
+ * enabled and the device list is not locked, it should return quickly and not send AT commands */
+typedef rt_int32_t (*at_device_select_score_t)(struct at_device *device);
+
 /* AT device operations */
 struct at_device_ops
 {
@@ -109,6 +141,8 @@ struct at_device_class
 #ifdef AT_USING_SOCKET
     uint32_t socket_num;                         /* The maximum number of sockets support */
     const struct at_socket_ops *socket_ops;      /* AT device socket operations */
+    const struct at_device_socket_dialect *socket_dialect; /* AT device socket commands dialect */
+    const struct at_device_socket_tls *socket_tls; /* AT device socket TLS offload, RT_NULL: not supported */
 #endif
     rt_slist_t list;                             /* AT device class list */
 };
@@ -122,13 +156,29 @@ struct at_device
     struct netdev *netdev;                       /* Network interface device for AT device */
 #ifdef AT_USING_SOCKET
     rt_event_t socket_event;                     /* AT device socket event */
+    rt_event_t conn_event;                       /* AT device non-blocking connect finished event */
     struct at_socket *sockets;                   /* AT device sockets list */
+    struct at_device_socket_info *socket_info;   /* AT device sockets runtime information */
+    int send_socket;                             /* AT device socket which is sending data */
+    rt_bool_t link_down;                         /* AT device link down noticed by the failover manager */
 #endif
+    struct at_client *ctrl_client;               /* AT Client object for control commands, RT_NULL: use client */
+    struct at_device_cmux *cmux;                 /* AT device serial multiplexer */
+    struct at_device_ppp *ppp;                   /* AT device PPP data call */
+    struct at_device_sched *sched;               /* AT device command scheduler */
+    struct at_device_boot *boot;                 /* AT device boot steps and time records */
+    struct at_device_mqtt *mqtt;                 /* AT device module MQTT client */
+    struct at_device_coap *coap;                 /* AT device module CoAP session */
+    struct rt_workqueue *workqueue;              /* AT device deferred work queue */
+    struct at_device_metrics metrics;            /* AT device live metrics */
     rt_slist_t list;                             /* AT device list */
 
     void *user_data;                             /* User-specific data */
 };
 
+/* Get the AT client for control and background commands */
+#define AT_DEVICE_CTRL_CLIENT(device)  ((device)->ctrl_client ? (device)->ctrl_client : (device)->client)
+
 /* Get AT device object */
 struct at_device *at_device_get_first_initialized(void);
 struct at_device *at_device_get_by_name(int type, const char *name);
@@ -136,6 +186,20 @@ struct at_device *at_device_get_by_name(int type, const char *name);
 struct at_device *at_device_get_by_socket(int at_socket);
 #endif
 
+/* AT device connection scheduler, select the ready device for a new connection by the policy */
+int at_device_select_policy(int policy, at_device_select_score_t score);
+struct at_device *at_device_select(void);
+#if defined(AT_USING_SOCKET) && defined(RT_USING_SAL)
+/* bind the SAL socket to the device or the selected device before connect */
+int at_device_bind(int socket, struct at_device *device);
+int at_device_select_bind(int socket);
+#endif
+void at_device_metrics_set_signal(struct at_device *device, int signal);
+void at_device_metrics_update_rtt(struct at_device *device, rt_uint32_t rtt);
+#ifdef AT_USING_SOCKET
+int at_device_active_sockets(struct at_device *device);
+#endif
+
 /* AT device control operaions */
 int at_device_control(struct at_device *device, int cmd, void *arg);
 /* Register AT device class object */
@@ -0,0 +1,61 @@
+/*
+ * File      : at_device_apn.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#ifndef __AT_DEVICE_APN_H__
+#define __AT_DEVICE_APN_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <at_device.h>
+
+/* the PLMN of the IMSI, the MCC and MNC digits as a number, e.g. 46000 or 310410 */
+#define AT_DEVICE_APN_PLMN(mcc, mnc, mnc_digits)                                           \
+    ((mnc_digits) == 3 ? (mcc) * 1000UL + (mnc) : (mcc) * 100UL + (mnc))
+
+/* AT device APN entry, the tables are sorted by the PLMN for the binary search */
+struct at_device_apn
+{
+    rt_uint32_t plmn;
+    const char *apn;
+    const char *username;                        /* RT_NULL: no authentication */
+    const char *password;
+    uint16_t class_id;                           /* 0: all classes, or the class this entry is used for */
+};
+
+/* set the user APN table, it is searched before the built-in one and must be valid until replaced,
+ * the class entry of a PLMN is used by that class instead of the entry for all classes */
+int at_device_apn_set_table(const struct at_device_apn *table, rt_size_t num);
+
+/* find the APN of the IMSI for the class, the 3 digits MNC is tried before the 2 digits one, RT_NULL: unknown */
+const struct at_device_apn *at_device_apn_find(const char *imsi, uint16_t class_id);
+/* query the IMSI by "AT+CIMI" on the client and find the APN */
+const struct at_device_apn *at_device_apn_query(struct at_device *device, struct at_client *client);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AT_DEVICE_APN_H__ */
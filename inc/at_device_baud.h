@@ -0,0 +1,53 @@
+/*
+ * File      : at_device_baud.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#ifndef __AT_DEVICE_BAUD_H__
+#define __AT_DEVICE_BAUD_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <at_device.h>
+
+/* AT device UART baud rate negotiation configuration */
+struct at_device_baud_cfg
+{
+    const char *set_baud;                        /* set and save baud rate command, the argument is baud rate */
+    const char *set_flow;                        /* set and save RTS/CTS flow control command, RT_NULL: not support */
+    rt_uint32_t baud_max;                        /* the maximum baud rate to negotiate */
+    rt_bool_t flow_control;                      /* enable RTS/CTS flow control */
+    rt_uint32_t switch_delay;                    /* delay(ms) for the module switching baud rate */
+};
+
+/* synchronize with the module at the saved negotiated baud rate */
+int at_device_baud_sync(struct at_device *device, const struct at_device_baud_cfg *cfg, rt_uint32_t timeout);
+/* raise the module and host baud rate to the configured maximum */
+int at_device_baud_negotiate(struct at_device *device, const struct at_device_baud_cfg *cfg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AT_DEVICE_BAUD_H__ */
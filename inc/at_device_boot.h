@@ -0,0 +1,84 @@
+/*
+ * File      : at_device_boot.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#ifndef __AT_DEVICE_BOOT_H__
+#define __AT_DEVICE_BOOT_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <at_device.h>
+
+/* the adaptive poll interval range in millisecond, it doubles after each poll */
+#ifndef AT_DEVICE_BOOT_POLL_MIN
+#define AT_DEVICE_BOOT_POLL_MIN        50
+#endif
+
+#ifndef AT_DEVICE_BOOT_POLL_MAX
+#define AT_DEVICE_BOOT_POLL_MAX        1000
+#endif
+
+/* the maximum number of boot time records */
+#ifndef AT_DEVICE_BOOT_RECORD_MAX
+#define AT_DEVICE_BOOT_RECORD_MAX      16
+#endif
+
+/* the maximum size of the recorded URC line */
+#define AT_DEVICE_BOOT_LINE_SIZE       48
+
+/* the maximum size of the step keyword woken up by URC */
+#define AT_DEVICE_BOOT_KEYWORD_SIZE    16
+
+/* AT device boot step flags */
+#define AT_DEVICE_BOOT_STEP_URC        (1U << 0) /* the keyword line is reported by URC, it wakes up the step */
+
+/* AT device boot step, the step is ready when the query command succeeds and the keyword line passes check */
+struct at_device_boot_step
+{
+    const char *name;                            /* step name in the boot time report */
+    const char *cmd;                             /* query command */
+    const char *keyword;                         /* keyword of the result line, RT_NULL: the command OK is ready */
+    rt_uint8_t resp_line;                        /* the response line number, 0: until OK */
+    rt_uint8_t flags;
+    rt_int32_t timeout;                          /* the command response timeout in millisecond */
+    rt_int32_t wait;                             /* the maximum time in millisecond for the step ready */
+    /* optional, check the result line, return > 0: ready, 0: not ready, < 0: failed */
+    int (*check)(struct at_device *device, const char *line);
+};
+
+/* prepare the boot steps, the URC keywords are registered before the module power on */
+int at_device_boot_init(struct at_device *device, const struct at_device_boot_step *steps, rt_size_t num);
+/* run the boot steps in order */
+int at_device_boot_run(struct at_device *device);
+
+/* boot time instrumentation, record the time spent since the previous mark */
+void at_device_boot_mark(struct at_device *device, const char *name);
+void at_device_boot_report(struct at_device *device);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AT_DEVICE_BOOT_H__ */
@@ -0,0 +1,65 @@
+/*
+ * File      : at_device_cmux.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#ifndef __AT_DEVICE_CMUX_H__
+#define __AT_DEVICE_CMUX_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <at_device.h>
+
+/* 3GPP 27.010 CMUX virtual channels of the AT device */
+#define AT_DEVICE_CMUX_DLCI_DATA       1         /* socket data and URC, the device AT client */
+#define AT_DEVICE_CMUX_DLCI_CTRL       2         /* control and background commands, the device control AT client */
+#define AT_DEVICE_CMUX_CHANNEL_NUM     2
+
+#ifndef AT_DEVICE_CMUX_THREAD_STACK_SIZE
+#define AT_DEVICE_CMUX_THREAD_STACK_SIZE 1024
+#endif
+
+#ifndef AT_DEVICE_CMUX_THREAD_PRIORITY
+#define AT_DEVICE_CMUX_THREAD_PRIORITY (RT_THREAD_PRIORITY_MAX / 3 - 1)
+#endif
+
+/* AT device CMUX configuration */
+struct at_device_cmux_cfg
+{
+    const char *start_cmd;                       /* enter CMUX basic option mode command */
+    const char *channel_init_cmd;                /* command sent on each channel after it opened, RT_NULL: none */
+    rt_uint16_t frame_size;                      /* maximum information field length (N1) */
+    rt_uint16_t channel_bufsz;                   /* receive buffer size of each channel */
+};
+
+/* enter CMUX mode, the AT device uses the channel AT clients after it */
+int at_device_cmux_start(struct at_device *device, const struct at_device_cmux_cfg *cfg);
+/* leave CMUX mode before power off or reset, the device uses the physical AT client again */
+int at_device_cmux_stop(struct at_device *device);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AT_DEVICE_CMUX_H__ */
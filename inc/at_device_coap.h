@@ -0,0 +1,124 @@
+/*
+ * File      : at_device_coap.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#ifndef __AT_DEVICE_COAP_H__
+#define __AT_DEVICE_COAP_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <at_device.h>
+
+#ifdef AT_DEVICE_USING_COAP
+
+/* the longest module send command without the hex string payload, with the CRLF */
+#define AT_DEVICE_COAP_CMD_HEADER_SIZE 64
+
+/* the maximum payload size of one message, the send and receive buffers are allocated once on init.
+ * The payload is sent as hex string in one AT command, increase AT_CMD_MAX_LEN for the larger message */
+#ifndef AT_DEVICE_COAP_SEND_MAX_SIZE
+#define AT_DEVICE_COAP_SEND_MAX_SIZE   ((AT_CMD_MAX_LEN - AT_DEVICE_COAP_CMD_HEADER_SIZE) / 2)
+#endif
+
+#if AT_CMD_MAX_LEN <= AT_DEVICE_COAP_CMD_HEADER_SIZE
+#error "AT_CMD_MAX_LEN is too small for the CoAP send command, please increase it"
+#elif AT_DEVICE_COAP_SEND_MAX_SIZE > (AT_CMD_MAX_LEN - AT_DEVICE_COAP_CMD_HEADER_SIZE) / 2
+#error "AT_DEVICE_COAP_SEND_MAX_SIZE hex string does not fit in AT_CMD_MAX_LEN, please increase AT_CMD_MAX_LEN"
+#endif
+
+#ifndef AT_DEVICE_COAP_RECV_BUFSZ
+#define AT_DEVICE_COAP_RECV_BUFSZ      512
+#endif
+
+/* the maximum time in second waiting for the module registration and the confirmable ACK */
+#ifndef AT_DEVICE_COAP_OPEN_TIMEOUT
+#define AT_DEVICE_COAP_OPEN_TIMEOUT    90
+#endif
+
+#ifndef AT_DEVICE_COAP_TIMEOUT
+#define AT_DEVICE_COAP_TIMEOUT         60
+#endif
+
+/* AT device CoAP message type */
+#define AT_DEVICE_COAP_CON             0         /* confirmable, retransmitted by module until ACK */
+#define AT_DEVICE_COAP_NON             1         /* non-confirmable */
+
+/* AT device CoAP session state */
+#define AT_DEVICE_COAP_STATE_CLOSED    0x00
+#define AT_DEVICE_COAP_STATE_OPENED    0x01      /* the module is registered to the platform */
+
+/* AT device CoAP module result events, they are noticed by the class URCs */
+#define AT_DEVICE_COAP_EVENT_OPEN      (1L << 0)
+#define AT_DEVICE_COAP_EVENT_CLOSE     (1L << 1)
+#define AT_DEVICE_COAP_EVENT_SEND      (1L << 2)
+#define AT_DEVICE_COAP_EVENT_ALL       0x07
+
+/* AT device CoAP session configuration */
+struct at_device_coap_cfg
+{
+    const char *host;                            /* the platform address */
+    int port;                                    /* 0: default 5683 */
+    const char *endpoint;                        /* RT_NULL: the module default, the IMEI mostly */
+    rt_uint32_t lifetime;                        /* the registration lifetime in second, 0: module default */
+};
+
+/* AT device CoAP operations of the module, the commands run with the device taken by the core */
+struct at_device_coap_ops
+{
+    /* start the registration, the success is noticed by the AT_DEVICE_COAP_EVENT_OPEN */
+    int (*open)(struct at_device *device, const struct at_device_coap_cfg *cfg);
+    /* start the deregistration, the success is noticed by the AT_DEVICE_COAP_EVENT_CLOSE */
+    int (*close)(struct at_device *device);
+    /* send the hex string payload, the confirmable ACK is noticed by the AT_DEVICE_COAP_EVENT_SEND */
+    int (*send)(struct at_device *device, const char *hex, rt_size_t len, int type);
+
+    const struct at_urc *urc_table;              /* the module result and downlink URCs */
+    rt_size_t urc_num;
+};
+
+/* downlink message notice, it is called in the AT parser thread and the buffer is reused after return */
+typedef void (*at_device_coap_recv_cb_t)(struct at_device *device, const char *data, rt_size_t len, void *user_data);
+
+/* prepare the CoAP session and register the module URCs to the control client */
+int at_device_coap_init(struct at_device *device, const struct at_device_coap_ops *ops);
+void at_device_coap_set_recv_cb(struct at_device *device, at_device_coap_recv_cb_t cb, void *user_data);
+
+int at_device_coap_open(struct at_device *device, const struct at_device_coap_cfg *cfg);
+int at_device_coap_close(struct at_device *device);
+int at_device_coap_send(struct at_device *device, const char *data, rt_size_t len, int type);
+int at_device_coap_state(struct at_device *device);
+
+/* the class URCs notice the module result and the downlink hex string payload */
+struct at_device *at_device_coap_get_device(struct at_client *client);
+void at_device_coap_notify(struct at_device *device, rt_uint32_t event, int result);
+void at_device_coap_recv_hex(struct at_device *device, const char *hex, rt_size_t hex_len, rt_size_t len);
+
+#endif /* AT_DEVICE_USING_COAP */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AT_DEVICE_COAP_H__ */
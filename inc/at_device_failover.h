@@ -0,0 +1,99 @@
+/*
+ * File      : at_device_failover.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#ifndef __AT_DEVICE_FAILOVER_H__
+#define __AT_DEVICE_FAILOVER_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <at_device.h>
+
+#if defined(AT_DEVICE_USING_FAILOVER) && defined(AT_USING_SOCKET) && defined(RT_USING_SAL)
+
+/* the maximum number of the devices watched */
+#ifndef AT_DEVICE_FAILOVER_DEVICE_NUM
+#define AT_DEVICE_FAILOVER_DEVICE_NUM  4
+#endif
+
+/* the retry interval in millisecond of the connections failed to reopen */
+#ifndef AT_DEVICE_FAILOVER_RETRY_INTERVAL
+#define AT_DEVICE_FAILOVER_RETRY_INTERVAL 30000
+#endif
+
+#ifndef AT_DEVICE_FAILOVER_STACK_SIZE
+#define AT_DEVICE_FAILOVER_STACK_SIZE  2048
+#endif
+
+#ifndef AT_DEVICE_FAILOVER_PRIORITY
+#define AT_DEVICE_FAILOVER_PRIORITY    (RT_THREAD_PRIORITY_MAX / 2 - 1)
+#endif
+
+struct at_device_failover_conn;
+
+/* the connection is reopened on another device, the old socket is closed after return, -1: it was pending */
+typedef void (*at_device_failover_cb_t)(struct at_device_failover_conn *conn, int old_socket);
+
+/* AT device failover managed connection, it must be valid until closed */
+struct at_device_failover_conn
+{
+    const char *host;                            /* the host name, it is resolved again on failover */
+    int port;
+    int type;                                    /* SOCK_STREAM or SOCK_DGRAM */
+    at_device_failover_cb_t reopen_cb;           /* RT_NULL: the application reads the socket again */
+    void *user_data;
+
+    /* the runtime information, it is updated by the failover manager */
+    int socket;                                  /* the SAL socket, -1: pending, it is retried on link up */
+    struct at_device *device;                    /* the device of the connection */
+    rt_slist_t list;
+};
+
+/* AT device failover metrics */
+struct at_device_failover_stats
+{
+    rt_uint32_t link_down;                       /* the link down events */
+    rt_uint32_t reopened;                        /* the connections reopened on another device */
+    rt_uint32_t failed;                          /* the reopen attempts failed, the connection is pending */
+    rt_uint32_t last_latency;                    /* the time in millisecond from the link down to the connections reopened */
+    rt_uint32_t max_latency;
+};
+
+/* start the failover manager and watch the link of the registered devices */
+int at_device_failover_init(void);
+/* watch the link of the device registered after the manager started */
+int at_device_failover_attach(struct at_device *device);
+
+int at_device_failover_open(struct at_device_failover_conn *conn);
+int at_device_failover_close(struct at_device_failover_conn *conn);
+void at_device_failover_stats_get(struct at_device_failover_stats *stats);
+
+#endif /* AT_DEVICE_USING_FAILOVER && AT_USING_SOCKET && RT_USING_SAL */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AT_DEVICE_FAILOVER_H__ */
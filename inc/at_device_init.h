@@ -0,0 +1,69 @@
+/*
+ * File      : at_device_init.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#ifndef __AT_DEVICE_INIT_H__
+#define __AT_DEVICE_INIT_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <at_device.h>
+
+#ifdef AT_DEVICE_USING_INIT_SCHED
+
+/* the maximum number of devices initialize at the same time */
+#ifndef AT_DEVICE_INIT_SCHED_WORKERS
+#define AT_DEVICE_INIT_SCHED_WORKERS   2
+#endif
+
+#ifndef AT_DEVICE_INIT_SCHED_STACK_SIZE
+#define AT_DEVICE_INIT_SCHED_STACK_SIZE 2048
+#endif
+
+#ifndef AT_DEVICE_INIT_SCHED_PRIORITY
+#define AT_DEVICE_INIT_SCHED_PRIORITY  (RT_THREAD_PRIORITY_MAX / 2)
+#endif
+
+/* AT device initialization wait options */
+#define AT_DEVICE_INIT_WAIT_ANY        0x01      /* any device initialized successfully */
+#define AT_DEVICE_INIT_WAIT_ALL        0x02      /* all devices finished initialization */
+
+/* AT device initialization finished notice, result < 0: initialize failed */
+typedef void (*at_device_init_cb_t)(struct at_device *device, int result);
+
+/* initialize the device in the init scheduler workers, it is called by device register */
+int at_device_init_submit(struct at_device *device);
+/* set the initialization finished notice callback */
+void at_device_init_set_cb(at_device_init_cb_t cb);
+/* wait for any or all registered devices finished initialization */
+int at_device_init_wait(rt_uint8_t option, rt_int32_t timeout, struct at_device **device);
+
+#endif /* AT_DEVICE_USING_INIT_SCHED */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AT_DEVICE_INIT_H__ */
@@ -0,0 +1,114 @@
+/*
+ * File      : at_device_mqtt.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#ifndef __AT_DEVICE_MQTT_H__
+#define __AT_DEVICE_MQTT_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <at_device.h>
+
+#ifdef AT_DEVICE_USING_MQTT
+
+/* the inbound message buffers, they are allocated once on init */
+#ifndef AT_DEVICE_MQTT_RECV_BUFSZ
+#define AT_DEVICE_MQTT_RECV_BUFSZ      1024
+#endif
+
+#ifndef AT_DEVICE_MQTT_TOPIC_SIZE
+#define AT_DEVICE_MQTT_TOPIC_SIZE      128
+#endif
+
+/* the maximum time in second waiting for the module result URC */
+#ifndef AT_DEVICE_MQTT_TIMEOUT
+#define AT_DEVICE_MQTT_TIMEOUT         30
+#endif
+
+/* the maximum publishes sent before waiting for the results */
+#ifndef AT_DEVICE_MQTT_PUB_WINDOW
+#define AT_DEVICE_MQTT_PUB_WINDOW      8
+#endif
+
+/* AT device MQTT connection state */
+#define AT_DEVICE_MQTT_STATE_CLOSED    0x00
+#define AT_DEVICE_MQTT_STATE_OPENED    0x01      /* the network is opened */
+#define AT_DEVICE_MQTT_STATE_CONNECTED 0x02      /* the MQTT session is connected */
+
+/* AT device MQTT commands dialect of the module */
+struct at_device_mqtt_dialect
+{
+    /* publish with the '>' prompt: <client_idx>,<msgid>,<qos>,<retain>,"<topic>",<length> */
+    const char *pub;
+};
+
+/* AT device MQTT connection configuration */
+struct at_device_mqtt_cfg
+{
+    const char *host;
+    int port;                                    /* 0: default 1883 */
+    const char *client_id;
+    const char *user;                            /* RT_NULL: no authentication */
+    const char *password;
+    rt_uint16_t keepalive;                       /* the keepalive in second handled by module, 0: default 120 */
+    rt_bool_t clean_session;
+};
+
+/* AT device MQTT publish message */
+struct at_device_mqtt_msg
+{
+    const char *topic;
+    const char *payload;
+    rt_size_t len;
+    rt_uint8_t qos;
+    rt_bool_t retain;
+};
+
+/* inbound message notice, it is called in the AT parser thread and the buffers are reused after return */
+typedef void (*at_device_mqtt_recv_cb_t)(struct at_device *device, const char *topic,
+                                         const char *payload, rt_size_t len, void *user_data);
+
+/* prepare the MQTT client and register the URCs to the control client */
+int at_device_mqtt_init(struct at_device *device, const struct at_device_mqtt_dialect *dialect);
+void at_device_mqtt_set_recv_cb(struct at_device *device, at_device_mqtt_recv_cb_t cb, void *user_data);
+
+int at_device_mqtt_connect(struct at_device *device, const struct at_device_mqtt_cfg *cfg);
+int at_device_mqtt_disconnect(struct at_device *device);
+int at_device_mqtt_subscribe(struct at_device *device, const char *topic, rt_uint8_t qos);
+int at_device_mqtt_unsubscribe(struct at_device *device, const char *topic);
+
+/* publish the messages and wait for the results together, it returns the number of messages published */
+int at_device_mqtt_publish(struct at_device *device, const struct at_device_mqtt_msg *msg);
+int at_device_mqtt_publish_batch(struct at_device *device, const struct at_device_mqtt_msg *msgs, rt_size_t num);
+
+int at_device_mqtt_state(struct at_device *device);
+
+#endif /* AT_DEVICE_USING_MQTT */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AT_DEVICE_MQTT_H__ */
@@ -0,0 +1,65 @@
+/*
+ * File      : at_device_parser.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#ifndef __AT_DEVICE_PARSER_H__
+#define __AT_DEVICE_PARSER_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <rtthread.h>
+
+/* AT response or URC line field parser, it never reads over the line size */
+struct at_device_parser
+{
+    const char *buf;                             /* line buffer, not need '\0' terminated */
+    rt_size_t size;                              /* line buffer size */
+    rt_size_t pos;                               /* current parse position */
+};
+
+void at_device_parser_init(struct at_device_parser *parser, const char *buf, rt_size_t size);
+
+/* skip the literal string, or skip over the next character */
+int at_device_parser_expect(struct at_device_parser *parser, const char *str);
+int at_device_parser_skip_to(struct at_device_parser *parser, char ch);
+
+/* parse one field, the leading spaces and the trailing ',' of the field are skipped */
+int at_device_parser_int(struct at_device_parser *parser, int *value);
+int at_device_parser_size(struct at_device_parser *parser, rt_size_t *value);
+int at_device_parser_str(struct at_device_parser *parser, char *str, rt_size_t size);
+int at_device_parser_ipv4(struct at_device_parser *parser, char ip[16]);
+int at_device_parser_skip(struct at_device_parser *parser);
+
+/* decode hex string to binary data, the data size is given by the caller */
+int at_device_parser_hex(struct at_device_parser *parser, char *data, rt_size_t size);
+
+/* get the rest of line, the tailing CR/LF is not included */
+const char *at_device_parser_rest(struct at_device_parser *parser, rt_size_t *size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AT_DEVICE_PARSER_H__ */
@@ -0,0 +1,64 @@
+/*
+ * File      : at_device_ppp.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#ifndef __AT_DEVICE_PPP_H__
+#define __AT_DEVICE_PPP_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <at_device.h>
+
+#ifndef AT_DEVICE_PPP_THREAD_STACK_SIZE
+#define AT_DEVICE_PPP_THREAD_STACK_SIZE 1536
+#endif
+
+#ifndef AT_DEVICE_PPP_THREAD_PRIORITY
+#define AT_DEVICE_PPP_THREAD_PRIORITY  (RT_THREAD_PRIORITY_MAX / 3 - 1)
+#endif
+
+/* AT device PPP data call configuration */
+struct at_device_ppp_cfg
+{
+    const char *release_cmd;                     /* release the PDP context from the module TCP/IP stack, RT_NULL: none */
+    const char *dial_cmd;                        /* start data call command */
+};
+
+/* dial the PPP data call on the CMUX data channel, the control channel keeps AT commands */
+int at_device_ppp_start(struct at_device *device, const struct at_device_ppp_cfg *cfg);
+int at_device_ppp_stop(struct at_device *device);
+
+#if defined(RT_USING_LWIP) && defined(RT_LWIP_PPP)
+/* the data channel is taken by the data call, the AT sockets can not use it */
+rt_bool_t at_device_ppp_is_running(struct at_device *device);
+#else
+#define at_device_ppp_is_running(device)   RT_FALSE
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AT_DEVICE_PPP_H__ */
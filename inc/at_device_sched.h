@@ -0,0 +1,72 @@
+/*
+ * File      : at_device_sched.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#ifndef __AT_DEVICE_SCHED_H__
+#define __AT_DEVICE_SCHED_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <at_device.h>
+
+/* AT command priority class, the smaller value has the higher priority */
+#define AT_DEVICE_CMD_DATA             0         /* socket data send */
+#define AT_DEVICE_CMD_CONTROL          1         /* socket connect/close, DNS, network setting */
+#define AT_DEVICE_CMD_BACKGROUND       2         /* link status polling, network information refresh, ping */
+#define AT_DEVICE_CMD_CLASS_NUM        3
+
+/* AT command queueing statistics of one priority class */
+struct at_device_sched_stat
+{
+    rt_uint32_t count;                           /* commands got the device */
+    rt_uint32_t timeout;                         /* commands dropped at the deadline */
+    rt_tick_t wait_total;                        /* total queueing delay */
+    rt_tick_t wait_max;                          /* maximum queueing delay */
+};
+
+/* AT device command scheduler */
+struct at_device_sched
+{
+    rt_mutex_t lock;                             /* scheduler state lock */
+    rt_thread_t owner;                           /* thread which is executing commands */
+    rt_uint16_t nest;                            /* owner nested take count */
+    rt_uint16_t waiting[AT_DEVICE_CMD_CLASS_NUM];
+    rt_sem_t sem[AT_DEVICE_CMD_CLASS_NUM];       /* wake up the waiting commands of each class */
+    struct at_device_sched_stat stat[AT_DEVICE_CMD_CLASS_NUM];
+};
+
+int at_device_sched_init(struct at_device *device);
+
+/* get and put back the device for the commands of the priority class */
+int at_device_sched_take(struct at_device *device, int cmd_class, rt_int32_t timeout);
+void at_device_sched_release(struct at_device *device);
+
+int at_device_sched_stat_get(struct at_device *device, int cmd_class, struct at_device_sched_stat *stat);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AT_DEVICE_SCHED_H__ */
@@ -0,0 +1,217 @@
+/*
+ * File      : at_device_socket.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#ifndef __AT_DEVICE_SOCKET_H__
+#define __AT_DEVICE_SOCKET_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <at_device.h>
+
+#ifdef AT_USING_SOCKET
+
+/* set real event by current socket and current state */
+#define AT_DEVICE_SOCKET_EVENT(socket, event)  ((((socket) + 1) << 16) | (event))
+
+/* AT device socket event type */
+#define AT_DEVICE_SOCKET_EVENT_CONN_OK         (1L << 0)
+#define AT_DEVICE_SOCKET_EVENT_SEND_OK         (1L << 1)
+#define AT_DEVICE_SOCKET_EVENT_RECV_OK         (1L << 2)
+#define AT_DEVICE_SOCKET_EVENT_CLOSE_OK        (1L << 3)
+#define AT_DEVICE_SOCKET_EVENT_CONN_FAIL       (1L << 4)
+#define AT_DEVICE_SOCKET_EVENT_SEND_FAIL       (1L << 5)
+#define AT_DEVICE_SOCKET_EVENT_DOMAIN_OK       (1L << 6)
+#define AT_DEVICE_SOCKET_EVENT_DOMAIN_FAIL     (1L << 7)
+#define AT_DEVICE_SOCKET_EVENT_APP_OK          (1L << 8) /* module application (HTTP, FTP) result URC */
+
+/* AT device non-blocking connect finished event, one bit of each device socket */
+#define AT_DEVICE_SOCKET_CONN_DONE(socket)     (1UL << (socket))
+
+/* the error of the socket operations failed by the device link down */
+#define AT_DEVICE_SOCKET_ELINKDOWN             RT_EIO
+
+/* AT device socket connect result style */
+#define AT_DEVICE_SOCKET_CONN_SYNC             0x01U     /* result code of the connect command */
+#define AT_DEVICE_SOCKET_CONN_URC              0x02U     /* result reported by the connect URC */
+
+/* AT device socket send style */
+#define AT_DEVICE_SOCKET_SEND_PROMPT           0x01U     /* command, wait '>' prompt, write raw data */
+#define AT_DEVICE_SOCKET_SEND_HEX              0x02U     /* hex string data carried in the command */
+
+/* AT device socket receive style */
+#define AT_DEVICE_SOCKET_RECV_PUSH             0x01U     /* raw data follows the receive URC */
+#define AT_DEVICE_SOCKET_RECV_HEX              0x02U     /* hex string data carried in the receive URC */
+#define AT_DEVICE_SOCKET_RECV_PULL             0x03U     /* receive URC only notices, data read by command */
+
+/* AT device socket dialect flags */
+#define AT_DEVICE_SOCKET_FLAG_CLOSE_RETRY      (1U << 0) /* close the socket before connect retry */
+#define AT_DEVICE_SOCKET_FLAG_CONN_TIMEO_OK    (1U << 1) /* no connect URC in time means connected */
+#define AT_DEVICE_SOCKET_FLAG_TCP_SEND_DELAY   (1U << 2) /* pause 10ms after each TCP packet sent */
+
+/* the local port of connectionless UDP socket opened without bind */
+#define AT_DEVICE_SOCKET_UDP_LOCAL_PORT(socket)  (49152 + (socket))
+
+/* AT device socket scatter-gather send segment, the same layout as struct iovec */
+struct at_device_iovec
+{
+    void *iov_base;                              /* segment data */
+    size_t iov_len;                              /* segment size */
+};
+
+/* AT device socket TLS configuration, the certificate and key files are stored in the module */
+struct at_device_tls_cfg
+{
+    const char *ca_file;                         /* CA certificate to verify the server, RT_NULL: no verification */
+    const char *cert_file;                       /* client certificate, RT_NULL: no client authentication */
+    const char *key_file;                        /* client private key */
+    const char *hostname;                        /* server name for SNI, the module connects to it if set */
+    rt_bool_t session_resume;                    /* resume the previous session with the same server */
+};
+
+/* AT device socket TLS offload, the TLS is terminated by the module */
+struct at_device_socket_tls
+{
+    /* configure the module TLS context of the socket, it is called before the TLS connect */
+    int (*config)(struct at_socket *socket, const struct at_device_tls_cfg *cfg);
+    /* optional, write the certificate or key file to the module file system */
+    int (*file_upload)(struct at_device *device, const char *name, const char *data, size_t size);
+};
+
+/* AT device socket runtime information */
+struct at_device_socket_info
+{
+    char remote_ip[16];                          /* remote address for connectionless socket */
+    int32_t remote_port;                         /* remote port for connectionless socket */
+    char from_ip[16];                            /* source address of the last received datagram */
+    int32_t from_port;                           /* source port of the last received datagram */
+    rt_bool_t is_listen;                         /* the socket is a TCP server */
+    rt_bool_t is_opened;                         /* the connectionless UDP socket is opened */
+    rt_bool_t is_nonblock;                       /* connect returns without waiting the result */
+    rt_bool_t is_connecting;                     /* the non-blocking connect is in progress */
+    int conn_result;                             /* the non-blocking connect result */
+    rt_tick_t conn_tick;                         /* the connect start tick */
+    const struct at_device_tls_cfg *tls;         /* the TLS configuration, RT_NULL: plain TCP */
+    rt_uint8_t context;                          /* the module PDP context of the socket, 0: the class default */
+};
+
+/* AT device socket dialect, describes how a module speaks the socket commands */
+struct at_device_socket_dialect
+{
+    /* command templates, all the arguments start with the device socket number */
+    const char *connect_tcp;                     /* (socket, ip, port), RT_NULL: connect_cmd sends it */
+    const char *connect_udp;                     /* (socket, ip, port), RT_NULL: UDP is connectionless */
+    const char *close;                           /* (socket) */
+    const char *send;                            /* PROMPT: (socket, size), HEX: (socket, size, hex) */
+    const char *send_udp;                        /* PROMPT: (socket, size, ip, port), HEX: (socket, ip, port, size, hex),
+                                                    RT_NULL: use send */
+    const char *close_listen;                    /* close the TCP server: (), RT_NULL: use close */
+    const char *send_tls;                        /* PROMPT: (socket, size), RT_NULL: use send */
+    const char *close_tls;                       /* (socket), RT_NULL: use close */
+
+    /* URC patterns */
+    const struct at_urc *urc_table;
+    rt_size_t urc_table_size;
+
+    rt_uint16_t send_max_size;                   /* the maximum data size of one send command */
+    rt_uint8_t connect_style;
+    rt_uint8_t send_style;
+    rt_uint8_t recv_style;
+    rt_uint8_t connect_retry;                    /* connect retry times after a failure */
+    rt_uint16_t flags;
+
+    /* timeouts in millisecond */
+    rt_int32_t cmd_timeout;                      /* connect and send commands response */
+    rt_int32_t close_timeout;                    /* close command response */
+    rt_int32_t connect_timeout;                  /* connect URC */
+    rt_int32_t send_timeout;                     /* send result URC */
+
+    /* optional, check the send command response, return < 0 for failure */
+    int (*send_check)(struct at_socket *socket, at_response_t resp, size_t size);
+    /* optional, start the TCP server on the local port, RT_NULL: server mode is not supported */
+    int (*listen)(struct at_socket *socket, int32_t port);
+    /* optional, open the connectionless UDP socket once, every datagram carries the destination by send_udp */
+    int (*open_udp)(struct at_socket *socket, const char *ip, int32_t port, int32_t local_port);
+    /* optional, send the TLS connect command, the result is the same as connect_tcp, RT_NULL: TLS is not supported */
+    int (*connect_tls)(struct at_socket *socket, at_response_t resp, const char *ip, int32_t port,
+                       const struct at_device_tls_cfg *cfg);
+    /* optional, send the plain connect command when the template arguments are not enough, RT_NULL: use the
+       connect_tcp and connect_udp templates */
+    int (*connect_cmd)(struct at_socket *socket, at_response_t resp, const char *ip, int32_t port,
+                       enum at_socket_type type);
+};
+
+/* AT device socket operations implemented with the class dialect */
+int at_device_socket_connect(struct at_socket *socket, char *ip, int32_t port,
+                             enum at_socket_type type, rt_bool_t is_client);
+int at_device_socket_close(struct at_socket *socket);
+int at_device_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type);
+int at_device_socket_sendv(struct at_socket *socket, const struct at_device_iovec *iov, int iovcnt,
+                           enum at_socket_type type);
+void at_device_socket_set_event_cb(at_socket_evt_t event, at_evt_cb_t cb);
+
+/* AT device socket event send and receive */
+int at_device_socket_event_send(struct at_device *device, uint32_t event);
+int at_device_socket_event_recv(struct at_device *device, uint32_t event, uint32_t timeout, rt_uint8_t option);
+/* wait the connect or listen result reported by URC */
+int at_device_socket_connect_wait(struct at_device *device, int device_socket);
+
+/* non-blocking connect, the result is got by at_device_socket_connect_result() */
+int at_device_socket_set_nonblock(struct at_socket *socket, rt_bool_t nonblock);
+int at_device_socket_connect_result(struct at_socket *socket, rt_int32_t timeout);
+
+/* TLS offload, the socket connects with TLS after it is set, and the files are uploaded to the module */
+int at_device_socket_set_tls(struct at_socket *socket, const struct at_device_tls_cfg *cfg);
+int at_device_socket_tls_upload(struct at_device *device, const char *name, const char *data, size_t size);
+
+/* helpers for class URC execution functions */
+struct at_device *at_device_socket_get_device(struct at_client *client);
+struct at_socket *at_device_socket_get(struct at_device *device, int device_socket);
+void at_device_socket_recv_push(struct at_client *client, struct at_device *device,
+                                int device_socket, rt_size_t bfsz);
+void at_device_socket_recv_hex(struct at_device *device, int device_socket,
+                               const char *hex, rt_size_t hex_len, rt_size_t bfsz);
+void at_device_socket_closed_notice(struct at_device *device, int device_socket);
+void at_device_socket_accept_notice(struct at_device *device, int device_socket);
+void at_device_socket_connect_notice(struct at_device *device, int device_socket, rt_bool_t success);
+void at_device_socket_set_from(struct at_device *device, int device_socket, const char *ip, int32_t port);
+void at_device_socket_urc_send(struct at_client *client, const char *data, rt_size_t size);
+
+/* fail the in-flight operations of the device sockets, it is called when the device link is down */
+void at_device_socket_link_down(struct at_device *device);
+
+/* get the source address of the last datagram received by the connectionless socket */
+int at_device_socket_get_from(struct at_socket *socket, char ip[16], int32_t *port);
+
+/* register the class dialect URC table to the device AT client */
+int at_device_socket_init(struct at_device *device);
+
+#endif /* AT_USING_SOCKET */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AT_DEVICE_SOCKET_H__ */
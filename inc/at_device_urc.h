@@ -0,0 +1,80 @@
+/*
+ * File      : at_device_urc.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#ifndef __AT_DEVICE_URC_H__
+#define __AT_DEVICE_URC_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <at_device.h>
+
+/* AT device URC prefix trie node */
+struct at_device_urc_node
+{
+    char ch;                                     /* prefix character of this node */
+    rt_int16_t child;                            /* first child node index, -1: none */
+    rt_int16_t sibling;                          /* next sibling node index, -1: none */
+    rt_int16_t entry;                            /* first URC entry ends on this node, -1: none */
+};
+
+/* AT device URC dispatcher, compiled from an URC table */
+struct at_device_urc_dispatcher
+{
+    const struct at_urc *urc;                    /* source URC table */
+    rt_size_t urc_size;
+    struct at_device_urc_node *nodes;            /* prefix trie, node 0 is the root (empty prefix) */
+    rt_size_t node_num;
+    rt_int16_t *next;                            /* next URC entry on the same node, in table order */
+};
+
+/* AT device URC table registered to the AT client */
+struct at_device_urc_table
+{
+    struct at_client *client;                    /* AT client the table registered to */
+    const struct at_urc *urc;                    /* source URC table */
+    struct at_urc *table;                        /* registered entries, RT_NULL: source table registered */
+    rt_size_t num;                               /* registered entries number */
+    rt_slist_t list;
+};
+
+/* compile and delete the URC dispatcher */
+struct at_device_urc_dispatcher *at_device_urc_dispatcher_create(const struct at_urc *urc, rt_size_t size);
+void at_device_urc_dispatcher_delete(struct at_device_urc_dispatcher *dispatcher);
+
+/* match and execute the URC line with the dispatcher */
+const struct at_urc *at_device_urc_match(struct at_device_urc_dispatcher *dispatcher,
+                                         const char *data, rt_size_t size);
+int at_device_urc_exec(struct at_device_urc_dispatcher *dispatcher, struct at_client *client,
+                       const char *data, rt_size_t size);
+
+/* register the URC table to the AT client once, without duplicate and unreachable entries */
+int at_device_urc_set_table(struct at_client *client, const struct at_urc *urc, rt_size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AT_DEVICE_URC_H__ */
@@ -0,0 +1,55 @@
+/*
+ * File      : at_device_work.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#ifndef __AT_DEVICE_WORK_H__
+#define __AT_DEVICE_WORK_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <at_device.h>
+
+#ifndef AT_DEVICE_WORK_STACK_SIZE
+#define AT_DEVICE_WORK_STACK_SIZE      2048
+#endif
+
+#ifndef AT_DEVICE_WORK_PRIORITY
+#define AT_DEVICE_WORK_PRIORITY        (RT_THREAD_PRIORITY_MAX / 2)
+#endif
+
+/* AT device deferred work function, the argument is a copy owned by the work */
+typedef void (*at_device_work_func_t)(struct at_device *device, void *arg);
+
+/* create the AT device deferred work queue */
+int at_device_work_init(struct at_device *device);
+/* run the function in the AT device work queue, out of the AT client parser thread */
+int at_device_work_submit(struct at_device *device, at_device_work_func_t func,
+                          const void *arg, rt_size_t arg_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AT_DEVICE_WORK_H__ */
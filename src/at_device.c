@@ -26,6 +26,14 @@
 #include <string.h>
 
 #include <at_device.h>
+#include <at_device_socket.h>
+#include <at_device_sched.h>
+#include <at_device_init.h>
+#include <at_device_ppp.h>
+
+#if defined(AT_USING_SOCKET) && defined(RT_USING_SAL)
+#include <sys/socket.h>
+#endif
 
 #define DBG_TAG              "at.dev"
 #define DBG_LVL              DBG_INFO
@@ -93,8 +101,11 @@ struct at_device *at_device_get_by_name(int type, const char *name)
                 rt_hw_interrupt_enable(level);
                 return device;
             }
-            else if ((type == AT_DEVICE_NAMETYPE_CLIENT) &&
-                (rt_strncmp(device->client->device->parent.name, name, rt_strlen(name)) == 0))
+            /* the AT client is created in the device initialization, it may be not finished */
+            else if ((type == AT_DEVICE_NAMETYPE_CLIENT) && device->client &&
+                ((rt_strncmp(device->client->device->parent.name, name, rt_strlen(name)) == 0) ||
+                (device->ctrl_client &&
+                rt_strncmp(device->ctrl_client->device->parent.name, name, rt_strlen(name)) == 0)))
             {
                 rt_hw_interrupt_enable(level);
                 return device;
@@ -127,7 +138,7 @@ struct at_device *at_device_get_by_ipaddr(ip_addr_t *ip_addr)
     rt_slist_for_each(node, &at_device_list)
     {
         device = rt_slist_entry(node, struct at_device, list);
-        if (device && ip_addr_cmp(ip_addr, &(device->netdev->ip_addr)))
+        if (device && device->netdev && ip_addr_cmp(ip_addr, &(device->netdev->ip_addr)))
         {
            rt_hw_interrupt_enable(level);
            return device;
@@ -141,6 +152,244 @@ struct at_device *at_device_get_by_ipaddr(ip_addr_t *ip_addr)
 }
 #endif /* AT_USING_SOCKET */
 
+/* the score of the unknown signal, it is worse than any signal in dBm */
+#define AT_DEVICE_SELECT_SCORE_MAX     0x7FFF
+
+/* the connection scheduler policy and the custom score function */
+static int select_policy = AT_DEVICE_SELECT_ROUND_ROBIN;
+static at_device_select_score_t select_score = RT_NULL;
+
+#ifdef AT_USING_SOCKET
+/**
+ * This function will get the number of the sockets in use on the AT device.
+ *
+ * @param device the AT device
+ *
+ * @return the number of the sockets in use
+ */
+int at_device_active_sockets(struct at_device *device)
+{
+    int count = 0;
+    uint32_t i = 0;
+
+    for (i = 0; i < device->class->socket_num; i++)
+    {
+        if (device->sockets[i].magic)
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+#endif /* AT_USING_SOCKET */
+
+/**
+ * This function will record the signal strength of the AT device, it is called
+ * by the class when the signal is queried.
+ *
+ * @param device the AT device
+ * @param signal the signal strength in dBm, 0: unknown
+ */
+void at_device_metrics_set_signal(struct at_device *device, int signal)
+{
+    device->metrics.signal = signal;
+}
+
+/**
+ * This function will smooth the round trip time sample of the AT device, the
+ * new sample is weighted 1/8 as the TCP smoothed RTT.
+ *
+ * @param device the AT device
+ * @param rtt the round trip time sample in millisecond
+ */
+void at_device_metrics_update_rtt(struct at_device *device, rt_uint32_t rtt)
+{
+    rt_uint32_t srtt = device->metrics.rtt;
+
+    srtt = (srtt == 0) ? rtt : (srtt * 7 + rtt) / 8;
+    device->metrics.rtt = (srtt > 0) ? srtt : 1;
+}
+
+static rt_int32_t at_device_select_score(struct at_device *device, int policy, at_device_select_score_t score)
+{
+    switch (policy)
+    {
+#ifdef AT_USING_SOCKET
+    case AT_DEVICE_SELECT_LEAST_SOCKETS:
+        return at_device_active_sockets(device);
+#endif
+    case AT_DEVICE_SELECT_BEST_SIGNAL:
+        return device->metrics.signal ? -device->metrics.signal : AT_DEVICE_SELECT_SCORE_MAX;
+    case AT_DEVICE_SELECT_LOWEST_RTT:
+        return (rt_int32_t) device->metrics.rtt;
+    case AT_DEVICE_SELECT_CUSTOM:
+        return score(device);
+    default:
+        return (rt_int32_t) device->metrics.selected;
+    }
+}
+
+/* the device is initialized, the link is up and it has a free socket */
+static rt_bool_t at_device_select_ready(struct at_device *device)
+{
+    if (device->is_init == RT_FALSE || device->netdev == RT_NULL ||
+            netdev_is_up(device->netdev) == RT_FALSE || netdev_is_link_up(device->netdev) == RT_FALSE)
+    {
+        return RT_FALSE;
+    }
+
+    /* the AT sockets can not use the data channel of the data call */
+    if (at_device_ppp_is_running(device))
+    {
+        return RT_FALSE;
+    }
+
+#ifdef AT_USING_SOCKET
+    if (at_device_active_sockets(device) >= (int) device->class->socket_num)
+    {
+        return RT_FALSE;
+    }
+#endif
+
+    return RT_TRUE;
+}
+
+/**
+ * This function will set the connection scheduler policy.
+ *
+ * @param policy the policy, AT_DEVICE_SELECT_*
+ * @param score the score function for AT_DEVICE_SELECT_CUSTOM, the lowest is selected
+ *
+ * @return  0: set success
+ *         -1: the policy is invalid or the custom score function is not given
+ */
+int at_device_select_policy(int policy, at_device_select_score_t score)
+{
+    rt_base_t level;
+
+    if (policy < AT_DEVICE_SELECT_ROUND_ROBIN || policy > AT_DEVICE_SELECT_CUSTOM ||
+            (policy == AT_DEVICE_SELECT_CUSTOM && score == RT_NULL))
+    {
+        LOG_E("invalid AT device select policy(%d).", policy);
+        return -RT_ERROR;
+    }
+
+    level = rt_hw_interrupt_disable();
+    select_score = score;
+    select_policy = policy;
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+/**
+ * This function will select the ready AT device for a new connection by the
+ * policy, the devices with the same score are selected in turn.
+ *
+ * @return the AT device structure pointer, RT_NULL: no device is ready
+ */
+struct at_device *at_device_select(void)
+{
+    int policy;
+    rt_base_t level;
+    rt_int32_t score = 0, best_score = 0;
+    rt_slist_t *node = RT_NULL;
+    at_device_select_score_t score_fn = RT_NULL;
+    struct at_device *device = RT_NULL, *best = RT_NULL;
+
+    level = rt_hw_interrupt_disable();
+    policy = select_policy;
+    score_fn = select_score;
+    node = at_device_list.next;
+    rt_hw_interrupt_enable(level);
+
+    /* the device list only grows, the next node is read in the critical section and
+       the score function of the application runs with interrupts enabled */
+    while (node)
+    {
+        device = rt_slist_entry(node, struct at_device, list);
+        if (at_device_select_ready(device))
+        {
+            score = at_device_select_score(device, policy, score_fn);
+            if (best == RT_NULL || score < best_score ||
+                    (score == best_score && device->metrics.selected < best->metrics.selected))
+            {
+                best = device;
+                best_score = score;
+            }
+        }
+
+        level = rt_hw_interrupt_disable();
+        node = node->next;
+        rt_hw_interrupt_enable(level);
+    }
+
+    if (best)
+    {
+        level = rt_hw_interrupt_disable();
+        best->metrics.selected++;
+        rt_hw_interrupt_enable(level);
+    }
+
+    return best;
+}
+
+#if defined(AT_USING_SOCKET) && defined(RT_USING_SAL)
+/**
+ * This function will bind the SAL socket to the address of the AT device, the
+ * socket is moved to that device and connects through it.
+ *
+ * @param socket the SAL socket descriptor, it is not connected
+ * @param device the AT device
+ *
+ * @return  0: bind success
+ *         -1: bind failed
+ */
+int at_device_bind(int socket, struct at_device *device)
+{
+    struct sockaddr_in addr;
+
+    RT_ASSERT(device && device->netdev);
+
+    rt_memset(&addr, 0x00, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = 0;
+    addr.sin_addr.s_addr = ip4_addr_get_u32(ip_2_ip4(&(device->netdev->ip_addr)));
+
+    if (bind(socket, (struct sockaddr *) &addr, sizeof(addr)) < 0)
+    {
+        LOG_E("bind socket(%d) to %s device failed.", socket, device->name);
+        return -RT_ERROR;
+    }
+
+    return RT_EOK;
+}
+
+/**
+ * This function will bind the SAL socket to the AT device selected by the
+ * connection scheduler.
+ *
+ * @param socket the SAL socket descriptor, it is not connected
+ *
+ * @return  0: bind success
+ *         -1: no device is ready or bind failed
+ */
+int at_device_select_bind(int socket)
+{
+    struct at_device *device = RT_NULL;
+
+    device = at_device_select();
+    if (device == RT_NULL)
+    {
+        LOG_E("no AT device is ready for the new connection.");
+        return -RT_ERROR;
+    }
+
+    LOG_D("socket(%d) is scheduled to %s device.", socket, device->name);
+    return at_device_bind(socket, device);
+}
+#endif /* AT_USING_SOCKET && RT_USING_SAL */
 
 /**
  * This function will perform a variety of control functions on AT devices.
@@ -263,6 +512,15 @@ int at_device_register(struct at_device *device, const char *device_name,
         goto __exit;
     }
 
+    device->socket_info = (struct at_device_socket_info *) rt_calloc(class->socket_num,
+                                                                      sizeof(struct at_device_socket_info));
+    if (device->socket_info == RT_NULL)
+    {
+        LOG_E("no memory for AT Socket information(%d) create.", class->socket_num);
+        result = -RT_ENOMEM;
+        goto __exit;
+    }
+
     /* create AT device socket event */
     rt_snprintf(name, RT_NAME_MAX, "at_se%d", device_counts++);
     device->socket_event = rt_event_create(name, RT_IPC_FLAG_FIFO);
@@ -272,9 +530,26 @@ int at_device_register(struct at_device *device, const char *device_name,
         result = -RT_ENOMEM;
         goto __exit;
     }
+
+    /* one event bit of each socket for the non-blocking connect result */
+    RT_ASSERT(class->socket_num <= 32);
+    rt_snprintf(name, RT_NAME_MAX, "at_ce%d", device_counts - 1);
+    device->conn_event = rt_event_create(name, RT_IPC_FLAG_FIFO);
+    if (device->conn_event == RT_NULL)
+    {
+        LOG_E("no memory for AT device(%s) connect event create.", device_name);
+        result = -RT_ENOMEM;
+        goto __exit;
+    }
 #endif /* AT_USING_SOCKET */
 
     rt_memcpy(device->name, device_name, rt_strlen(device_name));
+
+    result = at_device_sched_init(device);
+    if (result < 0)
+    {
+        goto __exit;
+    }
     device->class = class;
     device->user_data = user_data;
 
@@ -289,7 +564,19 @@ int at_device_register(struct at_device *device, const char *device_name,
     rt_hw_interrupt_enable(level);
 
     /* Initialize AT device */
+#ifdef AT_DEVICE_USING_INIT_SCHED
+    /* the device initializes with others at the same time, is_init is set by the init scheduler */
+    result = at_device_init_submit(device);
+    if (result == RT_EOK)
+    {
+        return RT_EOK;
+    }
+
+    /* no memory for the init scheduler, initialize in the caller thread */
+    result = class->device_ops->init(device);
+#else
     result = class->device_ops->init(device);
+#endif /* AT_DEVICE_USING_INIT_SCHED */
     if (result < 0)
     {
         goto __exit;
@@ -0,0 +1,258 @@
+/*
+ * File      : at_device_apn.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#include <string.h>
+
+#include <at_device_apn.h>
+
+#define LOG_TAG                        "at.dev.apn"
+#include <at_log.h>
+
+#define AT_DEVICE_IMSI_LEN             15
+
+/* the APN of the common operators, sorted by the PLMN. The class entry follows the
+ * operator entry of the same PLMN, it overrides the operator APN for that class only */
+static const struct at_device_apn at_device_apn_builtin[] =
+{
+    {20404,  "live.vodafone.com",    RT_NULL,    RT_NULL},
+    {20801,  "orange",               "orange",   "orange"},
+    {20810,  "sl2sfr",               RT_NULL,    RT_NULL},
+    {20820,  "mmsbouygtel.com",      RT_NULL,    RT_NULL},
+    {21401,  "airtelwap.es",         "wap@wap",  "wap125"},
+    {21407,  "movistar.es",          "MOVISTAR", "MOVISTAR"},
+    {22201,  "ibox.tim.it",          RT_NULL,    RT_NULL},
+    {22210,  "web.omnitel.it",       RT_NULL,    RT_NULL},
+    {23410,  "mobile.o2.co.uk",      "o2web",    "password"},
+    {23415,  "internet",             "web",      "web"},
+    {23420,  "three.co.uk",          RT_NULL,    RT_NULL},
+    {23430,  "everywhere",           "eesecure", "secure"},
+    {24001,  "online.telia.se",      RT_NULL,    RT_NULL},
+    {25001,  "internet.mts.ru",      "mts",      "mts"},
+    {25099,  "internet.beeline.ru",  "beeline",  "beeline"},
+    {26201,  "internet.telekom",     "t-mobile", "tm"},
+    {26202,  "web.vodafone.de",      RT_NULL,    RT_NULL},
+    {26203,  "internet",             RT_NULL,    RT_NULL},
+    {28601,  "internet",             RT_NULL,    RT_NULL},
+    {40445,  "airtelgprs.com",       RT_NULL,    RT_NULL},
+    {44010,  "spmode.ne.jp",         RT_NULL,    RT_NULL},
+    {46000,  "CMNET",                RT_NULL,    RT_NULL},
+    {46001,  "UNINET",               RT_NULL,    RT_NULL},
+    {46001,  "3GNET",                RT_NULL,    RT_NULL,    AT_DEVICE_CLASS_L610},
+    {46002,  "CMNET",                RT_NULL,    RT_NULL},
+    {46003,  "CTNET",                RT_NULL,    RT_NULL},
+    {46004,  "CMNET",                RT_NULL,    RT_NULL},
+    {46006,  "UNINET",               RT_NULL,    RT_NULL},
+    {46006,  "3GNET",                RT_NULL,    RT_NULL,    AT_DEVICE_CLASS_L610},
+    {46007,  "CMNET",                RT_NULL,    RT_NULL},
+    {46008,  "CMNET",                RT_NULL,    RT_NULL},
+    {46009,  "UNINET",               RT_NULL,    RT_NULL},
+    {46009,  "3GNET",                RT_NULL,    RT_NULL,    AT_DEVICE_CLASS_L610},
+    {46011,  "CTNET",                RT_NULL,    RT_NULL},
+    {46692,  "internet",             RT_NULL,    RT_NULL},
+    {50501,  "telstra.internet",     RT_NULL,    RT_NULL},
+    {52501,  "e-ideas",              RT_NULL,    RT_NULL},
+    {72405,  "claro.com.br",         "claro",    "claro"},
+    {302720, "ltemobile.apn",        RT_NULL,    RT_NULL},
+    {310260, "fast.t-mobile.com",    RT_NULL,    RT_NULL},
+    {310410, "broadband",            RT_NULL,    RT_NULL},
+    {311480, "vzwinternet",          RT_NULL,    RT_NULL},
+    {334020, "internet.itelcel.com", "webgprs",  "webgprs2002"},
+};
+
+static const struct at_device_apn *at_device_apn_user = RT_NULL;
+static rt_size_t at_device_apn_user_num = 0;
+
+/* binary search the first entry of the PLMN in the sorted table, the class entry is preferred */
+static const struct at_device_apn *at_device_apn_search(const struct at_device_apn *table, rt_size_t num,
+                                                        rt_uint32_t plmn, uint16_t class_id)
+{
+    rt_size_t low = 0, high = num, mid = 0;
+    const struct at_device_apn *entry = RT_NULL;
+
+    while (low < high)
+    {
+        mid = low + (high - low) / 2;
+        if (table[mid].plmn < plmn)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    for (; low < num && table[low].plmn == plmn; low++)
+    {
+        if (table[low].class_id == class_id && class_id != 0)
+        {
+            return &table[low];
+        }
+        else if (table[low].class_id == 0 && entry == RT_NULL)
+        {
+            entry = &table[low];
+        }
+    }
+
+    return entry;
+}
+
+/* search the user table before the built-in one, the user entry is not overridden by the class entry */
+static const struct at_device_apn *at_device_apn_lookup(rt_uint32_t plmn, uint16_t class_id)
+{
+    const struct at_device_apn *entry = RT_NULL;
+
+    if (at_device_apn_user)
+    {
+        entry = at_device_apn_search(at_device_apn_user, at_device_apn_user_num, plmn, class_id);
+    }
+    if (entry == RT_NULL)
+    {
+        entry = at_device_apn_search(at_device_apn_builtin,
+                                     sizeof(at_device_apn_builtin) / sizeof(at_device_apn_builtin[0]), plmn, class_id);
+    }
+
+    return entry;
+}
+
+/**
+ * This function will set the user APN table, the entries override the
+ * built-in ones of the same PLMN.
+ *
+ * @param table the APN table sorted by the PLMN, RT_NULL: remove the user table
+ * @param num the number of entries
+ *
+ * @return  0: set success
+ *         -1: the table is not sorted
+ */
+int at_device_apn_set_table(const struct at_device_apn *table, rt_size_t num)
+{
+    rt_size_t i;
+
+    for (i = 1; table && i < num; i++)
+    {
+        if (table[i - 1].plmn > table[i].plmn)
+        {
+            LOG_E("APN table is not sorted at the PLMN(%d).", table[i].plmn);
+            return -RT_ERROR;
+        }
+    }
+
+    at_device_apn_user = table;
+    at_device_apn_user_num = table ? num : 0;
+
+    return RT_EOK;
+}
+
+/**
+ * This function will find the APN of the IMSI. The MNC length is not in the
+ * IMSI, so the 3 digits MNC is tried before the 2 digits one.
+ *
+ * @param imsi the IMSI digits
+ * @param class_id the AT device class ID, 0: the operator entry only
+ *
+ * @return the APN entry, RT_NULL: unknown PLMN
+ */
+const struct at_device_apn *at_device_apn_find(const char *imsi, uint16_t class_id)
+{
+    int i;
+    rt_uint32_t plmn = 0;
+    const struct at_device_apn *entry = RT_NULL;
+
+    RT_ASSERT(imsi);
+
+    for (i = 0; i < 6; i++)
+    {
+        if (imsi[i] < '0' || imsi[i] > '9')
+        {
+            return RT_NULL;
+        }
+        plmn = plmn * 10 + (imsi[i] - '0');
+    }
+
+    entry = at_device_apn_lookup(plmn, class_id);
+    if (entry == RT_NULL)
+    {
+        entry = at_device_apn_lookup(plmn / 10, class_id);
+    }
+
+    return entry;
+}
+
+/**
+ * This function will query the IMSI of the SIM card and find the APN, it is
+ * called after the SIM card is ready.
+ *
+ * @param device the AT device
+ * @param client the AT client sending the command
+ *
+ * @return the APN entry, RT_NULL: query failed or unknown PLMN
+ */
+const struct at_device_apn *at_device_apn_query(struct at_device *device, struct at_client *client)
+{
+    rt_size_t i;
+    const char *line = RT_NULL;
+    at_response_t resp = RT_NULL;
+    const struct at_device_apn *entry = RT_NULL;
+
+    RT_ASSERT(device && client);
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return RT_NULL;
+    }
+
+    if (at_obj_exec_cmd(client, resp, "AT+CIMI") < 0)
+    {
+        LOG_E("%s device query IMSI failed.", device->name);
+        goto __exit;
+    }
+
+    /* the IMSI line is the digits only */
+    for (i = 1; i <= resp->line_counts; i++)
+    {
+        line = at_resp_get_line(resp, i);
+        if (line[0] >= '0' && line[0] <= '9' && rt_strlen(line) >= AT_DEVICE_IMSI_LEN)
+        {
+            entry = at_device_apn_find(line, device->class->class_id);
+            break;
+        }
+    }
+
+    if (entry)
+    {
+        LOG_I("%s device PLMN(%d) APN: %s", device->name, entry->plmn, entry->apn);
+    }
+    else
+    {
+        LOG_W("%s device PLMN is unknown, use the network default APN.", device->name);
+    }
+
+__exit:
+    at_delete_resp(resp);
+
+    return entry;
+}
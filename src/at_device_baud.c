@@ -0,0 +1,199 @@
+/*
+ * File      : at_device_baud.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#include <rtdevice.h>
+
+#include <at_device_baud.h>
+
+#define LOG_TAG                        "at.dev.baud"
+#include <at_log.h>
+
+#define AT_DEVICE_BAUD_VERIFY_TIME     1000
+#define AT_DEVICE_BAUD_MIN             BAUD_RATE_115200
+
+static rt_uint32_t baud_host_get(struct at_device *device)
+{
+    return ((struct rt_serial_device *) device->client->device)->config.baud_rate;
+}
+
+/* reconfigure the host serial device of the AT client */
+static int baud_host_set(struct at_device *device, rt_uint32_t baud_rate, rt_bool_t flow_control)
+{
+    struct rt_serial_device *serial = (struct rt_serial_device *) device->client->device;
+    struct serial_configure config = serial->config;
+
+    config.baud_rate = baud_rate;
+#ifdef RT_SERIAL_FLOWCONTROL_CTSRTS
+    config.flowcontrol = flow_control ? RT_SERIAL_FLOWCONTROL_CTSRTS : RT_SERIAL_FLOWCONTROL_NONE;
+#endif
+
+    return rt_device_control(&(serial->parent), RT_DEVICE_CTRL_CONFIG, &config);
+}
+
+static rt_bool_t baud_host_flow_get(struct at_device *device)
+{
+#ifdef RT_SERIAL_FLOWCONTROL_CTSRTS
+    return ((struct rt_serial_device *) device->client->device)->config.flowcontrol == RT_SERIAL_FLOWCONTROL_CTSRTS;
+#else
+    return RT_FALSE;
+#endif
+}
+
+/* switch the module baud rate, then the host, and check the link by "AT" */
+static int baud_switch(struct at_device *device, const struct at_device_baud_cfg *cfg,
+                       at_response_t resp, rt_uint32_t baud_rate, rt_bool_t flow_control)
+{
+    /* the module responds "OK" at the current baud rate and switches after it */
+    if (at_obj_exec_cmd(device->client, resp, cfg->set_baud, baud_rate) < 0)
+    {
+        return -RT_ERROR;
+    }
+
+    rt_thread_mdelay(cfg->switch_delay);
+    if (baud_host_set(device, baud_rate, flow_control) != RT_EOK)
+    {
+        return -RT_ERROR;
+    }
+
+    return at_client_obj_wait_connect(device->client, AT_DEVICE_BAUD_VERIFY_TIME);
+}
+
+/**
+ * This function will try to synchronize with the module at the configured maximum
+ * baud rate, which is saved in the module by the last negotiation. The host serial
+ * device is restored when the module does not respond.
+ *
+ * @param device the AT device
+ * @param cfg the baud rate negotiation configuration
+ * @param timeout the timeout of waiting for the module response
+ *
+ * @return  0: synchronize success at the maximum baud rate
+ *         -2: no response, the host serial device is restored
+ */
+int at_device_baud_sync(struct at_device *device, const struct at_device_baud_cfg *cfg, rt_uint32_t timeout)
+{
+    rt_uint32_t baud_rate = baud_host_get(device);
+    rt_bool_t flow_control = baud_host_flow_get(device);
+
+    RT_ASSERT(cfg);
+
+    if (baud_rate == cfg->baud_max)
+    {
+        return at_client_obj_wait_connect(device->client, timeout);
+    }
+
+    baud_host_set(device, cfg->baud_max, cfg->flow_control && cfg->set_flow != RT_NULL);
+    if (at_client_obj_wait_connect(device->client, timeout) == RT_EOK)
+    {
+        LOG_D("%s device synchronize at baud rate %d.", device->name, cfg->baud_max);
+        return RT_EOK;
+    }
+
+    baud_host_set(device, baud_rate, flow_control);
+
+    return -RT_ETIMEOUT;
+}
+
+/**
+ * This function will enable the RTS/CTS flow control and raise the baud rate of
+ * the module and the host serial device to the configured maximum. It steps down
+ * to the lower standard baud rates when the link does not work, and falls back to
+ * the current baud rate when none works. The set commands of the configuration
+ * should save the setting, so the module starts at the negotiated baud rate on
+ * the next boot, see at_device_baud_sync().
+ *
+ * @param device the AT device
+ * @param cfg the baud rate negotiation configuration
+ *
+ * @return  0: negotiate success or the baud rate is not changed
+ *         -1: the link is lost
+ *         -5: no memory
+ */
+int at_device_baud_negotiate(struct at_device *device, const struct at_device_baud_cfg *cfg)
+{
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+    rt_uint32_t baud_rate, old_baud_rate = baud_host_get(device);
+    rt_bool_t flow_control = RT_FALSE, old_flow_control = baud_host_flow_get(device);
+
+    RT_ASSERT(cfg);
+    RT_ASSERT(cfg->set_baud);
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    /* enable flow control first, the high baud rate needs it */
+    if (cfg->flow_control && cfg->set_flow && old_flow_control == RT_FALSE)
+    {
+        if (at_obj_exec_cmd(device->client, resp, cfg->set_flow) == RT_EOK &&
+                baud_host_set(device, old_baud_rate, RT_TRUE) == RT_EOK &&
+                at_client_obj_wait_connect(device->client, AT_DEVICE_BAUD_VERIFY_TIME) == RT_EOK)
+        {
+            old_flow_control = RT_TRUE;
+        }
+        else
+        {
+            LOG_W("%s device enable flow control failed.", device->name);
+            baud_host_set(device, old_baud_rate, RT_FALSE);
+        }
+    }
+    flow_control = old_flow_control;
+
+    for (baud_rate = cfg->baud_max; baud_rate > old_baud_rate && baud_rate >= AT_DEVICE_BAUD_MIN; baud_rate /= 2)
+    {
+        if (baud_switch(device, cfg, resp, baud_rate, flow_control) == RT_EOK)
+        {
+            LOG_I("%s device baud rate %d -> %d, flow control %s.", device->name, old_baud_rate, baud_rate,
+                  flow_control ? "on" : "off");
+            goto __exit;
+        }
+
+        LOG_W("%s device baud rate %d does not work, fall back.", device->name, baud_rate);
+
+        /* the module may not switch, or switch but the link does not work */
+        baud_host_set(device, old_baud_rate, flow_control);
+        if (at_client_obj_wait_connect(device->client, AT_DEVICE_BAUD_VERIFY_TIME) != RT_EOK)
+        {
+            baud_host_set(device, baud_rate, flow_control);
+            at_obj_exec_cmd(device->client, resp, cfg->set_baud, old_baud_rate);
+            rt_thread_mdelay(cfg->switch_delay);
+            baud_host_set(device, old_baud_rate, flow_control);
+            if (at_client_obj_wait_connect(device->client, AT_DEVICE_BAUD_VERIFY_TIME) != RT_EOK)
+            {
+                LOG_E("%s device link is lost at baud rate %d.", device->name, old_baud_rate);
+                result = -RT_ERROR;
+                goto __exit;
+            }
+        }
+    }
+
+__exit:
+    at_delete_resp(resp);
+
+    return result;
+}
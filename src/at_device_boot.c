@@ -0,0 +1,476 @@
+/*
+ * File      : at_device_boot.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#include <at_device_boot.h>
+#include <at_device_urc.h>
+
+#define LOG_TAG                        "at.dev.boot"
+#include <at_log.h>
+
+#define AT_DEVICE_BOOT_TICK_TO_MS(tick)  ((rt_uint32_t) ((rt_uint64_t) (tick) * 1000 / RT_TICK_PER_SECOND))
+
+/* the AT client finishes the CR LF as an empty line, the URC with this prefix never matches */
+#define AT_DEVICE_BOOT_URC_OFF         "\r\n"
+
+struct at_device_boot_record
+{
+    const char *name;
+    rt_uint32_t time;                            /* the time spent in millisecond */
+};
+
+/* the URC keyword of the step */
+struct at_device_boot_urc
+{
+    const char *keyword;
+    char prefix[AT_DEVICE_BOOT_KEYWORD_SIZE];    /* the URC prefix, it is the keyword only while the step is waiting */
+    char line[AT_DEVICE_BOOT_LINE_SIZE];         /* the latest line of the keyword */
+};
+
+struct at_device_boot
+{
+    const struct at_device_boot_step *steps;
+    rt_size_t step_num;
+
+    /* the URC keywords of steps, the AT client keeps the table */
+    struct at_urc *urc;
+    struct at_device_boot_urc *urcs;
+    rt_size_t urc_num;
+    struct rt_semaphore notice;
+
+    rt_tick_t start_tick;
+    rt_tick_t mark_tick;
+    struct at_device_boot_record records[AT_DEVICE_BOOT_RECORD_MAX];
+    rt_size_t record_num;
+};
+
+/* get the URC index of the step, -1: the step is not woken up by URC */
+static int at_device_boot_urc_index(struct at_device_boot *boot, const struct at_device_boot_step *step)
+{
+    rt_size_t i;
+
+    if (step->keyword == RT_NULL || (step->flags & AT_DEVICE_BOOT_STEP_URC) == 0)
+    {
+        return -1;
+    }
+
+    for (i = 0; i < boot->urc_num; i++)
+    {
+        if (rt_strcmp(boot->urcs[i].keyword, step->keyword) == 0)
+        {
+            return (int) i;
+        }
+    }
+
+    return -1;
+}
+
+/* the URC entry can not be removed from the AT client, it is matched only while the step is waiting,
+   so the keyword line in the other command responses is not taken after boot */
+static void at_device_boot_urc_enable(struct at_device_boot *boot, int index, rt_bool_t enable)
+{
+    if (index < 0)
+    {
+        return;
+    }
+
+    rt_enter_critical();
+    rt_strncpy(boot->urcs[index].prefix, enable ? boot->urcs[index].keyword : AT_DEVICE_BOOT_URC_OFF,
+               AT_DEVICE_BOOT_KEYWORD_SIZE);
+    rt_exit_critical();
+}
+
+static void at_device_boot_urc_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    rt_size_t i, len;
+    struct at_device *device = RT_NULL;
+    struct at_device_boot *boot = RT_NULL;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client->device->parent.name);
+    if (device == RT_NULL || device->boot == RT_NULL)
+    {
+        return;
+    }
+    boot = device->boot;
+
+    for (i = 0; i < boot->urc_num; i++)
+    {
+        len = rt_strlen(boot->urcs[i].keyword);
+        if (size >= len && rt_strncmp(data, boot->urcs[i].keyword, len) == 0)
+        {
+            /* remove the tailing CR LF */
+            for (len = size; len > 0 && (data[len - 1] == '\r' || data[len - 1] == '\n'); len--);
+            if (len > AT_DEVICE_BOOT_LINE_SIZE - 1)
+            {
+                len = AT_DEVICE_BOOT_LINE_SIZE - 1;
+            }
+
+            rt_enter_critical();
+            rt_memcpy(boot->urcs[i].line, data, len);
+            boot->urcs[i].line[len] = '\0';
+            rt_exit_critical();
+
+            rt_sem_release(&(boot->notice));
+            break;
+        }
+    }
+}
+
+/**
+ * This function will prepare the boot steps of the device. The URC keywords of
+ * steps are registered to the AT client, so it should be called before the module
+ * power on. A keyword is matched only while its step is waiting, and the keyword
+ * line of the query command response is reported by URC too.
+ *
+ * @param device the AT device
+ * @param steps the boot steps, it must be valid when the device is running
+ * @param num the number of boot steps
+ *
+ * @return  0: prepare success
+ *         -1: the device is prepared with other steps
+ *         -5: no memory
+ */
+int at_device_boot_init(struct at_device *device, const struct at_device_boot_step *steps, rt_size_t num)
+{
+    rt_size_t i, urc_num = 0;
+    struct at_device_boot *boot = RT_NULL;
+
+    RT_ASSERT(device);
+    RT_ASSERT(steps);
+
+    if (device->boot)
+    {
+        /* the AT client URC table can not be removed, only the same steps run again */
+        if (device->boot->steps != steps)
+        {
+            LOG_E("%s device boot steps can not be changed.", device->name);
+            return -RT_ERROR;
+        }
+
+        device->boot->record_num = 0;
+        device->boot->start_tick = device->boot->mark_tick = rt_tick_get();
+        return RT_EOK;
+    }
+
+    for (i = 0; i < num; i++)
+    {
+        if (steps[i].keyword && (steps[i].flags & AT_DEVICE_BOOT_STEP_URC))
+        {
+            if (rt_strlen(steps[i].keyword) >= AT_DEVICE_BOOT_KEYWORD_SIZE)
+            {
+                LOG_W("%s device boot step(%s) keyword is too long, it is polled.", device->name, steps[i].name);
+                continue;
+            }
+            urc_num++;
+        }
+    }
+
+    boot = (struct at_device_boot *) rt_calloc(1, sizeof(struct at_device_boot));
+    if (boot == RT_NULL)
+    {
+        goto __nomem;
+    }
+
+    if (urc_num > 0)
+    {
+        boot->urc = (struct at_urc *) rt_calloc(urc_num, sizeof(struct at_urc));
+        boot->urcs = (struct at_device_boot_urc *) rt_calloc(urc_num, sizeof(struct at_device_boot_urc));
+        if (boot->urc == RT_NULL || boot->urcs == RT_NULL)
+        {
+            goto __nomem;
+        }
+    }
+
+    boot->steps = steps;
+    boot->step_num = num;
+    for (i = 0; i < num; i++)
+    {
+        if (steps[i].keyword && (steps[i].flags & AT_DEVICE_BOOT_STEP_URC) &&
+                rt_strlen(steps[i].keyword) < AT_DEVICE_BOOT_KEYWORD_SIZE)
+        {
+            /* the entry is registered with the keyword, then it is off until the step waits */
+            boot->urcs[boot->urc_num].keyword = steps[i].keyword;
+            rt_strncpy(boot->urcs[boot->urc_num].prefix, steps[i].keyword, AT_DEVICE_BOOT_KEYWORD_SIZE);
+            boot->urc[boot->urc_num].cmd_prefix = boot->urcs[boot->urc_num].prefix;
+            boot->urc[boot->urc_num].cmd_suffix = "\r\n";
+            boot->urc[boot->urc_num].func = at_device_boot_urc_func;
+            boot->urc_num++;
+        }
+    }
+
+    rt_sem_init(&(boot->notice), "at_boot", 0, RT_IPC_FLAG_FIFO);
+    boot->start_tick = boot->mark_tick = rt_tick_get();
+    device->boot = boot;
+
+    if (boot->urc_num > 0 && at_device_urc_set_table(device->client, boot->urc, boot->urc_num) < 0)
+    {
+        LOG_W("%s device boot URC register failed, the steps are polled.", device->name);
+    }
+
+    for (i = 0; i < boot->urc_num; i++)
+    {
+        at_device_boot_urc_enable(boot, (int) i, RT_FALSE);
+    }
+
+    return RT_EOK;
+
+__nomem:
+    LOG_E("no memory for %s device boot create.", device->name);
+    if (boot)
+    {
+        if (boot->urc)
+        {
+            rt_free(boot->urc);
+        }
+        if (boot->urcs)
+        {
+            rt_free(boot->urcs);
+        }
+        rt_free(boot);
+    }
+
+    return -RT_ENOMEM;
+}
+
+/* get the result line of the step, the line reported by URC is preferred */
+static rt_bool_t at_device_boot_line_get(struct at_device_boot *boot, int index, at_response_t resp,
+                                         const char *keyword, char *line)
+{
+    const char *resp_line = RT_NULL;
+
+    line[0] = '\0';
+    if (index >= 0)
+    {
+        rt_enter_critical();
+        rt_strncpy(line, boot->urcs[index].line, AT_DEVICE_BOOT_LINE_SIZE);
+        rt_exit_critical();
+    }
+
+    if (line[0] == '\0')
+    {
+        resp_line = at_resp_get_line_by_kw(resp, keyword);
+        if (resp_line)
+        {
+            rt_strncpy(line, resp_line, AT_DEVICE_BOOT_LINE_SIZE - 1);
+            line[AT_DEVICE_BOOT_LINE_SIZE - 1] = '\0';
+        }
+    }
+
+    return line[0] != '\0';
+}
+
+/* query until the step ready, the URC wakes it up and the adaptive poll is the fallback */
+static int at_device_boot_step_wait(struct at_device *device, at_response_t resp,
+                                    const struct at_device_boot_step *step, int index)
+{
+    int ready = 0;
+    rt_tick_t start = rt_tick_get(), elapsed = 0;
+    rt_tick_t wait_tick = rt_tick_from_millisecond(step->wait), delay_tick = 0;
+    rt_int32_t delay = AT_DEVICE_BOOT_POLL_MIN;
+    struct at_device_boot *boot = device->boot;
+    char line[AT_DEVICE_BOOT_LINE_SIZE] = {0};
+
+    while (1)
+    {
+        if (index >= 0)
+        {
+            rt_enter_critical();
+            boot->urcs[index].line[0] = '\0';
+            rt_exit_critical();
+        }
+
+        resp = at_resp_set_info(resp, 128, step->resp_line, rt_tick_from_millisecond(step->timeout));
+        if (at_obj_exec_cmd(device->client, resp, step->cmd) == RT_EOK)
+        {
+            ready = 1;
+            if (step->keyword)
+            {
+                ready = at_device_boot_line_get(boot, index, resp, step->keyword, line) ? 1 : 0;
+                if (ready && step->check)
+                {
+                    ready = step->check(device, line);
+                }
+            }
+
+            if (ready < 0)
+            {
+                LOG_E("%s device boot step(%s) check failed(%s).", device->name, step->name, line);
+                return -RT_ERROR;
+            }
+            else if (ready > 0)
+            {
+                return RT_EOK;
+            }
+        }
+
+        elapsed = rt_tick_get() - start;
+        if (elapsed >= wait_tick)
+        {
+            LOG_E("%s device boot step(%s) wait timeout(%s).", device->name, step->name, line);
+            return -RT_ETIMEOUT;
+        }
+
+        delay_tick = rt_tick_from_millisecond(delay);
+        if (delay_tick > wait_tick - elapsed)
+        {
+            delay_tick = wait_tick - elapsed;
+        }
+
+        if (index >= 0)
+        {
+            rt_sem_take(&(boot->notice), delay_tick);
+        }
+        else
+        {
+            rt_thread_delay(delay_tick);
+        }
+
+        delay = (delay * 2 < AT_DEVICE_BOOT_POLL_MAX) ? delay * 2 : AT_DEVICE_BOOT_POLL_MAX;
+    }
+}
+
+static int at_device_boot_step_run(struct at_device *device, at_response_t resp,
+                                   const struct at_device_boot_step *step)
+{
+    int result = RT_EOK, index = -1;
+    struct at_device_boot *boot = device->boot;
+
+    index = at_device_boot_urc_index(boot, step);
+
+    /* drop the notices before this step */
+    while (rt_sem_trytake(&(boot->notice)) == RT_EOK);
+
+    at_device_boot_urc_enable(boot, index, RT_TRUE);
+    result = at_device_boot_step_wait(device, resp, step, index);
+    at_device_boot_urc_enable(boot, index, RT_FALSE);
+
+    return result;
+}
+
+/**
+ * This function will run the prepared boot steps in order, the time spent
+ * in each step is recorded.
+ *
+ * @param device the AT device
+ *
+ * @return  0: all steps ready
+ *         -1: the step check failed or not prepared
+ *         -2: the step wait timeout
+ *         -5: no memory
+ */
+int at_device_boot_run(struct at_device *device)
+{
+    rt_size_t i;
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+    struct at_device_boot *boot = RT_NULL;
+
+    RT_ASSERT(device);
+
+    boot = device->boot;
+    if (boot == RT_NULL)
+    {
+        LOG_E("%s device boot steps are not prepared.", device->name);
+        return -RT_ERROR;
+    }
+
+    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    for (i = 0; i < boot->step_num; i++)
+    {
+        result = at_device_boot_step_run(device, resp, &(boot->steps[i]));
+        at_device_boot_mark(device, boot->steps[i].name);
+        if (result < 0)
+        {
+            break;
+        }
+    }
+
+    at_delete_resp(resp);
+
+    return result;
+}
+
+/**
+ * This function will record the time spent since the previous mark.
+ *
+ * @param device the AT device
+ * @param name the phase name, it must be a constant string
+ */
+void at_device_boot_mark(struct at_device *device, const char *name)
+{
+    rt_tick_t now = rt_tick_get();
+    struct at_device_boot *boot = RT_NULL;
+
+    RT_ASSERT(device);
+
+    boot = device->boot;
+    if (boot == RT_NULL)
+    {
+        return;
+    }
+
+    if (boot->record_num < AT_DEVICE_BOOT_RECORD_MAX)
+    {
+        boot->records[boot->record_num].name = name;
+        boot->records[boot->record_num].time = AT_DEVICE_BOOT_TICK_TO_MS(now - boot->mark_tick);
+        boot->record_num++;
+    }
+    boot->mark_tick = now;
+}
+
+/**
+ * This function will show where the boot time is spent, and restart the records.
+ *
+ * @param device the AT device
+ */
+void at_device_boot_report(struct at_device *device)
+{
+    rt_size_t i;
+    rt_tick_t now = rt_tick_get();
+    struct at_device_boot *boot = RT_NULL;
+
+    RT_ASSERT(device);
+
+    boot = device->boot;
+    if (boot == RT_NULL)
+    {
+        return;
+    }
+
+    for (i = 0; i < boot->record_num; i++)
+    {
+        LOG_I("%s device boot %-8s %6d ms", device->name, boot->records[i].name, boot->records[i].time);
+    }
+    LOG_I("%s device boot total    %6d ms", device->name, AT_DEVICE_BOOT_TICK_TO_MS(now - boot->start_tick));
+
+    boot->record_num = 0;
+    boot->start_tick = boot->mark_tick = now;
+}
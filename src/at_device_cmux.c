@@ -0,0 +1,897 @@
+/*
+ * File      : at_device_cmux.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#include <at_device_cmux.h>
+#include <at_device_ppp.h>
+
+#define LOG_TAG                        "at.dev.cmux"
+#include <at_log.h>
+
+/* 3GPP 27.010 basic option frame */
+#define CMUX_FLAG                      0xF9
+#define CMUX_EA                        0x01
+#define CMUX_CR                        0x02
+#define CMUX_PF                        0x10
+
+#define CMUX_SABM                      0x2F
+#define CMUX_UA                        0x63
+#define CMUX_DM                        0x0F
+#define CMUX_DISC                      0x43
+#define CMUX_UIH                       0xEF
+#define CMUX_UI                        0x03
+
+/* multiplexer control channel message type */
+#define CMUX_MSG_MSC                   0xE0
+#define CMUX_MSG_CLD                   0xC0
+#define CMUX_MSG_NSC                   0x10
+
+/* modem status: flow control off, ready to communicate, ready to receive */
+#define CMUX_MSC_V24_SIGNAL            0x0D
+
+#define CMUX_HEADER_MAX                5
+#define CMUX_DLCI_MAX                  (AT_DEVICE_CMUX_CHANNEL_NUM + 1)
+#define CMUX_OPEN_RETRY                3
+#define CMUX_OPEN_TIMEOUT              3000
+#define CMUX_CLOSE_TIMEOUT             1000
+
+#define CMUX_EVENT_UA(dlci)            (1 << (dlci))
+#define CMUX_EVENT_DM(dlci)            (1 << ((dlci) + 8))
+#define CMUX_EVENT_CLD                 (1 << 16)
+
+/* receive frame parser state */
+enum cmux_state
+{
+    CMUX_STATE_FLAG,
+    CMUX_STATE_ADDR,
+    CMUX_STATE_CTRL,
+    CMUX_STATE_LEN,
+    CMUX_STATE_LEN2,
+    CMUX_STATE_INFO,
+    CMUX_STATE_FCS,
+    CMUX_STATE_END,
+};
+
+struct at_device_cmux;
+
+/* CMUX virtual channel, it is a character device for the channel AT client */
+struct at_device_cmux_channel
+{
+    struct rt_device parent;
+    struct at_device_cmux *cmux;
+    rt_uint8_t dlci;
+    struct rt_ringbuffer *rx_rb;
+};
+
+struct at_device_cmux
+{
+    struct at_device *device;
+    rt_device_t serial;                          /* physical serial device */
+    rt_mutex_t tx_lock;
+    rt_sem_t rx_notice;
+    rt_event_t event;
+    rt_thread_t parser;
+    rt_uint16_t frame_size;
+    rt_bool_t is_running;                        /* the frame parser owns the serial */
+    rt_err_t (*serial_rx_ind)(rt_device_t dev, rt_size_t size);
+
+    /* the channel AT clients can not be removed, they are reused by the next start */
+    struct at_client *clients[AT_DEVICE_CMUX_CHANNEL_NUM];
+    struct at_client *phy_client;                /* physical AT client, it is put back when CMUX stops */
+    struct at_client *phy_ctrl_client;
+
+    /* receive frame, the header is kept for frame check sequence */
+    rt_uint8_t *frame;
+    rt_uint8_t header_len;
+    rt_size_t info_len;
+    rt_size_t recv_len;
+    enum cmux_state state;
+
+    struct at_device_cmux_channel channels[AT_DEVICE_CMUX_CHANNEL_NUM];
+    rt_slist_t list;
+};
+
+/* multiplexers list, the serial receive indicate looks up the multiplexer by it */
+static rt_slist_t cmux_list = RT_SLIST_OBJECT_INIT(cmux_list);
+
+/* reversed CRC-8 with polynomial x^8 + x^2 + x + 1, the header has only 2~4 bytes */
+static rt_uint8_t cmux_fcs(const rt_uint8_t *data, rt_size_t len)
+{
+    int i;
+    rt_uint8_t crc = 0xFF;
+
+    while (len--)
+    {
+        crc ^= *data++;
+        for (i = 0; i < 8; i++)
+        {
+            crc = (crc & 0x01) ? (rt_uint8_t) ((crc >> 1) ^ 0xE0) : (rt_uint8_t) (crc >> 1);
+        }
+    }
+
+    return (rt_uint8_t) (0xFF - crc);
+}
+
+static int cmux_frame_send(struct at_device_cmux *cmux, rt_uint8_t dlci, rt_uint8_t control,
+                           const rt_uint8_t *info, rt_size_t len)
+{
+    rt_size_t header_len = 4;
+    rt_uint8_t header[CMUX_HEADER_MAX], tail[2];
+
+    RT_ASSERT(len <= cmux->frame_size);
+
+    header[0] = CMUX_FLAG;
+    header[1] = (rt_uint8_t) ((dlci << 2) | CMUX_CR | CMUX_EA);
+    header[2] = control;
+    if (len < 0x80)
+    {
+        header[3] = (rt_uint8_t) ((len << 1) | CMUX_EA);
+    }
+    else
+    {
+        header[3] = (rt_uint8_t) ((len & 0x7F) << 1);
+        header[4] = (rt_uint8_t) (len >> 7);
+        header_len = 5;
+    }
+
+    tail[0] = cmux_fcs(&header[1], header_len - 1);
+    tail[1] = CMUX_FLAG;
+
+    rt_mutex_take(cmux->tx_lock, RT_WAITING_FOREVER);
+    if (rt_device_write(cmux->serial, 0, header, header_len) != header_len ||
+            (len > 0 && rt_device_write(cmux->serial, 0, info, len) != len) ||
+            rt_device_write(cmux->serial, 0, tail, sizeof(tail)) != sizeof(tail))
+    {
+        rt_mutex_release(cmux->tx_lock);
+        return -RT_ERROR;
+    }
+    rt_mutex_release(cmux->tx_lock);
+
+    return RT_EOK;
+}
+
+/* send the multiplexer control channel message */
+static int cmux_msg_send(struct at_device_cmux *cmux, rt_uint8_t type, const rt_uint8_t *value, rt_size_t len)
+{
+    rt_uint8_t msg[8];
+
+    RT_ASSERT(len + 2 <= sizeof(msg));
+
+    msg[0] = type | CMUX_EA;
+    msg[1] = (rt_uint8_t) ((len << 1) | CMUX_EA);
+    if (len > 0)
+    {
+        rt_memcpy(&msg[2], value, len);
+    }
+
+    return cmux_frame_send(cmux, 0, CMUX_UIH, msg, len + 2);
+}
+
+static int cmux_dlci_open(struct at_device_cmux *cmux, rt_uint8_t dlci)
+{
+    int retry = 0;
+    rt_uint32_t event = 0;
+
+    for (retry = 0; retry < CMUX_OPEN_RETRY; retry++)
+    {
+        rt_event_recv(cmux->event, CMUX_EVENT_UA(dlci) | CMUX_EVENT_DM(dlci),
+                      RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR, 0, RT_NULL);
+
+        if (cmux_frame_send(cmux, dlci, CMUX_SABM | CMUX_PF, RT_NULL, 0) < 0)
+        {
+            return -RT_ERROR;
+        }
+
+        if (rt_event_recv(cmux->event, CMUX_EVENT_UA(dlci) | CMUX_EVENT_DM(dlci),
+                          RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR, rt_tick_from_millisecond(CMUX_OPEN_TIMEOUT), &event) == RT_EOK)
+        {
+            if (event & CMUX_EVENT_UA(dlci))
+            {
+                return RT_EOK;
+            }
+
+            LOG_E("%s device CMUX DLCI(%d) open is rejected.", cmux->device->name, dlci);
+            return -RT_ERROR;
+        }
+    }
+
+    LOG_E("%s device CMUX DLCI(%d) open timeout.", cmux->device->name, dlci);
+
+    return -RT_ETIMEOUT;
+}
+
+static struct at_device_cmux_channel *cmux_channel_get(struct at_device_cmux *cmux, rt_uint8_t dlci)
+{
+    int i;
+
+    for (i = 0; i < AT_DEVICE_CMUX_CHANNEL_NUM; i++)
+    {
+        if (cmux->channels[i].dlci == dlci)
+        {
+            return &(cmux->channels[i]);
+        }
+    }
+
+    return RT_NULL;
+}
+
+/* answer the commands from module on the control channel, the response is the command with C/R cleared */
+static void cmux_control_handle(struct at_device_cmux *cmux, rt_uint8_t *info, rt_size_t len)
+{
+    rt_uint8_t type;
+
+    if (len < 2)
+    {
+        return;
+    }
+
+    type = info[0] & ~CMUX_EA;
+    if ((type & CMUX_CR) == 0)
+    {
+        /* the response of the message sent by us */
+        if (type == CMUX_MSG_CLD)
+        {
+            rt_event_send(cmux->event, CMUX_EVENT_CLD);
+        }
+        return;
+    }
+
+    switch (type & ~CMUX_CR)
+    {
+    case CMUX_MSG_MSC:
+        info[0] &= ~CMUX_CR;
+        cmux_frame_send(cmux, 0, CMUX_UIH, info, len);
+        break;
+
+    case CMUX_MSG_CLD:
+        LOG_W("%s device CMUX is closed by module.", cmux->device->name);
+        info[0] &= ~CMUX_CR;
+        cmux_frame_send(cmux, 0, CMUX_UIH, info, len);
+        break;
+
+    default:
+    {
+        /* not supported command */
+        rt_uint8_t nsc = info[0];
+        cmux_msg_send(cmux, CMUX_MSG_NSC, &nsc, 1);
+        break;
+    }
+    }
+}
+
+static void cmux_frame_handle(struct at_device_cmux *cmux)
+{
+    rt_base_t level;
+    rt_size_t put_len = 0;
+    rt_uint8_t dlci = cmux->frame[0] >> 2;
+    rt_uint8_t control = cmux->frame[1] & ~CMUX_PF;
+    rt_uint8_t *info = cmux->frame + cmux->header_len;
+    struct at_device_cmux_channel *channel = RT_NULL;
+
+    switch (control)
+    {
+    case CMUX_UA:
+        rt_event_send(cmux->event, CMUX_EVENT_UA(dlci));
+        break;
+
+    case CMUX_DM:
+        rt_event_send(cmux->event, CMUX_EVENT_DM(dlci));
+        break;
+
+    case CMUX_DISC:
+        LOG_W("%s device CMUX DLCI(%d) is disconnected by module.", cmux->device->name, dlci);
+        cmux_frame_send(cmux, dlci, CMUX_UA | CMUX_PF, RT_NULL, 0);
+        break;
+
+    case CMUX_UIH:
+    case CMUX_UI:
+        if (dlci == 0)
+        {
+            cmux_control_handle(cmux, info, cmux->info_len);
+            break;
+        }
+
+        channel = cmux_channel_get(cmux, dlci);
+        if (channel == RT_NULL || cmux->info_len == 0)
+        {
+            break;
+        }
+
+        level = rt_hw_interrupt_disable();
+        put_len = rt_ringbuffer_put(channel->rx_rb, info, cmux->info_len);
+        rt_hw_interrupt_enable(level);
+        if (put_len < cmux->info_len)
+        {
+            LOG_W("%s device CMUX DLCI(%d) receive buffer is full, %d bytes are dropped.",
+                  cmux->device->name, dlci, cmux->info_len - put_len);
+        }
+
+        if (put_len > 0 && channel->parent.rx_indicate)
+        {
+            channel->parent.rx_indicate(&(channel->parent), put_len);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+/* feed one received byte to the frame parser */
+static void cmux_parse_byte(struct at_device_cmux *cmux, rt_uint8_t ch)
+{
+    switch (cmux->state)
+    {
+    case CMUX_STATE_FLAG:
+        if (ch == CMUX_FLAG)
+        {
+            cmux->state = CMUX_STATE_ADDR;
+        }
+        break;
+
+    case CMUX_STATE_ADDR:
+        /* the closing flag may be followed by the opening flag of next frame */
+        if (ch == CMUX_FLAG)
+        {
+            break;
+        }
+        cmux->frame[0] = ch;
+        cmux->state = (ch & CMUX_EA) ? CMUX_STATE_CTRL : CMUX_STATE_FLAG;
+        break;
+
+    case CMUX_STATE_CTRL:
+        cmux->frame[1] = ch;
+        cmux->state = CMUX_STATE_LEN;
+        break;
+
+    case CMUX_STATE_LEN:
+        cmux->frame[2] = ch;
+        cmux->header_len = 3;
+        cmux->info_len = ch >> 1;
+        cmux->recv_len = 0;
+        if ((ch & CMUX_EA) == 0)
+        {
+            cmux->state = CMUX_STATE_LEN2;
+        }
+        else if (cmux->info_len > cmux->frame_size)
+        {
+            LOG_W("%s device CMUX frame length(%d) is too long, drop it.", cmux->device->name, cmux->info_len);
+            cmux->state = CMUX_STATE_FLAG;
+        }
+        else
+        {
+            cmux->state = cmux->info_len > 0 ? CMUX_STATE_INFO : CMUX_STATE_FCS;
+        }
+        break;
+
+    case CMUX_STATE_LEN2:
+        cmux->frame[3] = ch;
+        cmux->header_len = 4;
+        cmux->info_len |= (rt_size_t) ch << 7;
+        if (cmux->info_len > cmux->frame_size)
+        {
+            LOG_W("%s device CMUX frame length(%d) is too long, drop it.", cmux->device->name, cmux->info_len);
+            cmux->state = CMUX_STATE_FLAG;
+            break;
+        }
+        cmux->state = cmux->info_len > 0 ? CMUX_STATE_INFO : CMUX_STATE_FCS;
+        break;
+
+    case CMUX_STATE_INFO:
+        cmux->frame[cmux->header_len + cmux->recv_len++] = ch;
+        if (cmux->recv_len >= cmux->info_len)
+        {
+            cmux->state = CMUX_STATE_FCS;
+        }
+        break;
+
+    case CMUX_STATE_FCS:
+        /* the frame check sequence covers the address, control and length fields */
+        if (ch != cmux_fcs(cmux->frame, cmux->header_len))
+        {
+            LOG_W("%s device CMUX frame check sequence error, drop it.", cmux->device->name);
+            cmux->state = CMUX_STATE_FLAG;
+            break;
+        }
+        cmux->state = CMUX_STATE_END;
+        break;
+
+    case CMUX_STATE_END:
+        if (ch == CMUX_FLAG)
+        {
+            cmux_frame_handle(cmux);
+            cmux->state = CMUX_STATE_ADDR;
+        }
+        else
+        {
+            cmux->state = CMUX_STATE_FLAG;
+        }
+        break;
+
+    default:
+        cmux->state = CMUX_STATE_FLAG;
+        break;
+    }
+}
+
+static void cmux_parser(void *parameter)
+{
+    rt_size_t i, len;
+    rt_uint8_t buf[32];
+    struct at_device_cmux *cmux = (struct at_device_cmux *) parameter;
+
+    while (1)
+    {
+        /* the physical AT client reads the serial after CMUX stopped */
+        len = cmux->is_running ? rt_device_read(cmux->serial, 0, buf, sizeof(buf)) : 0;
+        if (len == 0)
+        {
+            rt_sem_take(cmux->rx_notice, RT_WAITING_FOREVER);
+            continue;
+        }
+
+        for (i = 0; i < len; i++)
+        {
+            cmux_parse_byte(cmux, buf[i]);
+        }
+    }
+}
+
+static rt_err_t cmux_serial_rx_ind(rt_device_t dev, rt_size_t size)
+{
+    rt_slist_t *node = RT_NULL;
+    struct at_device_cmux *cmux = RT_NULL;
+
+    rt_slist_for_each(node, &cmux_list)
+    {
+        cmux = rt_slist_entry(node, struct at_device_cmux, list);
+        if (cmux->serial == dev)
+        {
+            rt_sem_release(cmux->rx_notice);
+            break;
+        }
+    }
+
+    return RT_EOK;
+}
+
+static rt_err_t cmux_channel_open(rt_device_t dev, rt_uint16_t oflag)
+{
+    return RT_EOK;
+}
+
+static rt_err_t cmux_channel_close(rt_device_t dev)
+{
+    return RT_EOK;
+}
+
+static rt_size_t cmux_channel_read(rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t size)
+{
+    rt_base_t level;
+    rt_size_t len = 0;
+    struct at_device_cmux_channel *channel = (struct at_device_cmux_channel *) dev;
+
+    level = rt_hw_interrupt_disable();
+    len = rt_ringbuffer_get(channel->rx_rb, (rt_uint8_t *) buffer, size);
+    rt_hw_interrupt_enable(level);
+
+    return len;
+}
+
+static rt_size_t cmux_channel_write(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size)
+{
+    rt_size_t sent = 0, len = 0;
+    struct at_device_cmux_channel *channel = (struct at_device_cmux_channel *) dev;
+    struct at_device_cmux *cmux = channel->cmux;
+
+    /* split the data by the maximum frame size */
+    while (sent < size)
+    {
+        len = size - sent > cmux->frame_size ? cmux->frame_size : size - sent;
+        if (cmux_frame_send(cmux, channel->dlci, CMUX_UIH, (const rt_uint8_t *) buffer + sent, len) < 0)
+        {
+            break;
+        }
+        sent += len;
+    }
+
+    return sent;
+}
+
+static rt_err_t cmux_channel_control(rt_device_t dev, int cmd, void *args)
+{
+    /* the serial configuration belongs to the physical serial */
+    return RT_EOK;
+}
+
+#ifdef RT_USING_DEVICE_OPS
+const static struct rt_device_ops cmux_channel_ops =
+{
+    RT_NULL,
+    cmux_channel_open,
+    cmux_channel_close,
+    cmux_channel_read,
+    cmux_channel_write,
+    cmux_channel_control,
+};
+#endif
+
+static int cmux_channel_register(struct at_device_cmux *cmux, int index, rt_uint8_t dlci, rt_size_t bufsz)
+{
+    char name[RT_NAME_MAX] = {0};
+    struct at_device_cmux_channel *channel = &(cmux->channels[index]);
+    struct rt_device *dev = &(channel->parent);
+
+    channel->cmux = cmux;
+    channel->dlci = dlci;
+    channel->rx_rb = rt_ringbuffer_create(bufsz);
+    if (channel->rx_rb == RT_NULL)
+    {
+        LOG_E("no memory for CMUX channel receive buffer create.");
+        return -RT_ENOMEM;
+    }
+
+    dev->type = RT_Device_Class_Char;
+#ifdef RT_USING_DEVICE_OPS
+    dev->ops = &cmux_channel_ops;
+#else
+    dev->init = RT_NULL;
+    dev->open = cmux_channel_open;
+    dev->close = cmux_channel_close;
+    dev->read = cmux_channel_read;
+    dev->write = cmux_channel_write;
+    dev->control = cmux_channel_control;
+#endif
+
+    rt_snprintf(name, RT_NAME_MAX, "%s_%d", cmux->device->name, dlci);
+
+    return rt_device_register(dev, name, RT_DEVICE_FLAG_RDWR | RT_DEVICE_FLAG_INT_RX | RT_DEVICE_FLAG_STREAM);
+}
+
+/* the channel AT client is created once, the initialize command is sent on every start */
+static struct at_client *cmux_client_setup(struct at_device_cmux *cmux, int index,
+                                           rt_size_t recv_bufsz, const char *init_cmd)
+{
+    const char *name = cmux->channels[index].parent.parent.name;
+    struct at_client *client = cmux->clients[index];
+    at_response_t resp = RT_NULL;
+
+    if (client == RT_NULL)
+    {
+        if (at_client_init(name, recv_bufsz) < 0 || (client = at_client_get(name)) == RT_NULL)
+        {
+            LOG_E("%s device CMUX channel(%s) AT client initialize failed.", cmux->device->name, name);
+            return RT_NULL;
+        }
+        cmux->clients[index] = client;
+    }
+
+    if (init_cmd)
+    {
+        resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+        if (resp == RT_NULL)
+        {
+            LOG_E("no memory for resp create.");
+            return RT_NULL;
+        }
+
+        /* the channel echo is not received by the physical client, it may be enabled */
+        if (at_obj_exec_cmd(client, resp, init_cmd) != RT_EOK)
+        {
+            LOG_W("%s device CMUX channel(%s) execute %s failed.", cmux->device->name, name, init_cmd);
+        }
+        at_delete_resp(resp);
+    }
+
+    return client;
+}
+
+static void cmux_delete(struct at_device_cmux *cmux)
+{
+    int i;
+    rt_base_t level;
+
+    if (cmux->parser)
+    {
+        rt_thread_delete(cmux->parser);
+    }
+
+    level = rt_hw_interrupt_disable();
+    rt_slist_remove(&cmux_list, &(cmux->list));
+    rt_hw_interrupt_enable(level);
+
+    if (cmux->tx_lock)
+    {
+        rt_mutex_delete(cmux->tx_lock);
+    }
+    if (cmux->rx_notice)
+    {
+        rt_sem_delete(cmux->rx_notice);
+    }
+    if (cmux->event)
+    {
+        rt_event_delete(cmux->event);
+    }
+    if (cmux->frame)
+    {
+        rt_free(cmux->frame);
+    }
+    for (i = 0; i < AT_DEVICE_CMUX_CHANNEL_NUM; i++)
+    {
+        if (cmux->channels[i].parent.parent.name[0])
+        {
+            rt_device_unregister(&(cmux->channels[i].parent));
+        }
+        if (cmux->channels[i].rx_rb)
+        {
+            rt_ringbuffer_destroy(cmux->channels[i].rx_rb);
+        }
+    }
+    rt_free(cmux);
+}
+
+static struct at_device_cmux *cmux_create(struct at_device *device, const struct at_device_cmux_cfg *cfg)
+{
+    int i;
+    rt_base_t level;
+    char name[RT_NAME_MAX] = {0};
+    struct at_device_cmux *cmux = RT_NULL;
+
+    cmux = (struct at_device_cmux *) rt_calloc(1, sizeof(struct at_device_cmux));
+    if (cmux == RT_NULL)
+    {
+        LOG_E("no memory for CMUX create.");
+        return RT_NULL;
+    }
+
+    cmux->device = device;
+    cmux->serial = device->client->device;
+    cmux->frame_size = cfg->frame_size;
+    cmux->state = CMUX_STATE_FLAG;
+    rt_slist_init(&(cmux->list));
+
+    rt_snprintf(name, RT_NAME_MAX, "cmx_%s", device->name);
+    cmux->tx_lock = rt_mutex_create(name, RT_IPC_FLAG_PRIO);
+    cmux->rx_notice = rt_sem_create(name, 0, RT_IPC_FLAG_FIFO);
+    cmux->event = rt_event_create(name, RT_IPC_FLAG_FIFO);
+    cmux->frame = (rt_uint8_t *) rt_calloc(1, cfg->frame_size + CMUX_HEADER_MAX);
+    if (cmux->tx_lock == RT_NULL || cmux->rx_notice == RT_NULL || cmux->event == RT_NULL || cmux->frame == RT_NULL)
+    {
+        LOG_E("no memory for CMUX create.");
+        goto __exit;
+    }
+
+    for (i = 0; i < AT_DEVICE_CMUX_CHANNEL_NUM; i++)
+    {
+        if (cmux_channel_register(cmux, i, (rt_uint8_t) (AT_DEVICE_CMUX_DLCI_DATA + i), cfg->channel_bufsz) < 0)
+        {
+            LOG_E("%s device CMUX channel register failed.", device->name);
+            goto __exit;
+        }
+    }
+
+    /* the frame parser sleeps until the serial is switched to it */
+    cmux->parser = rt_thread_create(name, cmux_parser, cmux, AT_DEVICE_CMUX_THREAD_STACK_SIZE,
+                                    AT_DEVICE_CMUX_THREAD_PRIORITY, 5);
+    if (cmux->parser == RT_NULL)
+    {
+        LOG_E("no memory for CMUX parser thread create.");
+        goto __exit;
+    }
+    rt_thread_startup(cmux->parser);
+
+    level = rt_hw_interrupt_disable();
+    rt_slist_append(&cmux_list, &(cmux->list));
+    rt_hw_interrupt_enable(level);
+
+    return cmux;
+
+__exit:
+    cmux_delete(cmux);
+
+    return RT_NULL;
+}
+
+static struct at_device_cmux *cmux_get_by_device(struct at_device *device)
+{
+    rt_slist_t *node = RT_NULL;
+    struct at_device_cmux *cmux = RT_NULL;
+
+    rt_slist_for_each(node, &cmux_list)
+    {
+        cmux = rt_slist_entry(node, struct at_device_cmux, list);
+        if (cmux->device == device)
+        {
+            return cmux;
+        }
+    }
+
+    return RT_NULL;
+}
+
+/* the frame parser takes over the serial, the physical AT client never receives data after it */
+static void cmux_attach(struct at_device_cmux *cmux)
+{
+    cmux->state = CMUX_STATE_FLAG;
+    cmux->serial_rx_ind = cmux->serial->rx_indicate;
+    rt_device_set_rx_indicate(cmux->serial, cmux_serial_rx_ind);
+    cmux->is_running = RT_TRUE;
+    rt_sem_release(cmux->rx_notice);
+}
+
+/* close down the multiplexer and give the serial back to the physical AT client */
+static void cmux_detach(struct at_device_cmux *cmux)
+{
+    rt_event_recv(cmux->event, CMUX_EVENT_CLD, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR, 0, RT_NULL);
+
+    /* the module returns to AT command mode after it responded, it may be powered off already */
+    if (cmux_msg_send(cmux, CMUX_MSG_CLD | CMUX_CR, RT_NULL, 0) < 0 ||
+            rt_event_recv(cmux->event, CMUX_EVENT_CLD, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                          rt_tick_from_millisecond(CMUX_CLOSE_TIMEOUT), RT_NULL) != RT_EOK)
+    {
+        LOG_W("%s device CMUX close down no response.", cmux->device->name);
+    }
+
+    cmux->is_running = RT_FALSE;
+    rt_device_set_rx_indicate(cmux->serial, cmux->serial_rx_ind);
+}
+
+/**
+ * This function will switch the AT device serial to 3GPP 27.010 CMUX basic option
+ * mode and open two virtual channels. The device AT client is changed to the data
+ * channel client for socket data and URC, the device control AT client is the control
+ * channel client for the network status and other background commands. The AT client
+ * numbers configuration must be enough for the two channel clients, they are created
+ * by the first start and reused after CMUX stopped.
+ *
+ * @param device the AT device, the module has responded to AT command
+ * @param cfg the CMUX configuration
+ *
+ * @return  0: start success
+ *         -1: module enter CMUX mode or channel open failed, the device keeps the physical AT client
+ *         -5: no memory
+ */
+int at_device_cmux_start(struct at_device *device, const struct at_device_cmux_cfg *cfg)
+{
+    int i, result = RT_EOK;
+    at_response_t resp = RT_NULL;
+    struct at_client *clients[AT_DEVICE_CMUX_CHANNEL_NUM] = {0};
+    struct at_device_cmux *cmux = RT_NULL;
+
+    RT_ASSERT(device);
+    RT_ASSERT(cfg && cfg->start_cmd);
+
+    if (device->cmux)
+    {
+        return RT_EOK;
+    }
+
+    cmux = cmux_get_by_device(device);
+    if (cmux == RT_NULL && (cmux = cmux_create(device, cfg)) == RT_NULL)
+    {
+        return -RT_ENOMEM;
+    }
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(1000));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    if (at_obj_exec_cmd(device->client, resp, cfg->start_cmd) != RT_EOK)
+    {
+        LOG_E("%s device enter CMUX mode failed.", device->name);
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    cmux_attach(cmux);
+
+    for (i = 0; i < CMUX_DLCI_MAX; i++)
+    {
+        result = cmux_dlci_open(cmux, (rt_uint8_t) i);
+        if (result < 0)
+        {
+            goto __exit;
+        }
+    }
+
+    for (i = 0; i < AT_DEVICE_CMUX_CHANNEL_NUM; i++)
+    {
+        rt_uint8_t msc[2];
+
+        msc[0] = (rt_uint8_t) ((cmux->channels[i].dlci << 2) | CMUX_CR | CMUX_EA);
+        msc[1] = CMUX_MSC_V24_SIGNAL | CMUX_EA;
+        cmux_msg_send(cmux, CMUX_MSG_MSC | CMUX_CR, msc, sizeof(msc));
+    }
+
+    for (i = 0; i < AT_DEVICE_CMUX_CHANNEL_NUM; i++)
+    {
+        clients[i] = cmux_client_setup(cmux, i, device->client->recv_bufsz, cfg->channel_init_cmd);
+        if (clients[i] == RT_NULL)
+        {
+            result = -RT_ERROR;
+            goto __exit;
+        }
+    }
+
+    cmux->phy_client = device->client;
+    cmux->phy_ctrl_client = device->ctrl_client;
+    device->cmux = cmux;
+    device->client = clients[AT_DEVICE_CMUX_DLCI_DATA - 1];
+    device->ctrl_client = clients[AT_DEVICE_CMUX_DLCI_CTRL - 1];
+
+    LOG_I("%s device enter CMUX mode, frame size %d.", device->name, cmux->frame_size);
+
+__exit:
+    if (resp)
+    {
+        at_delete_resp(resp);
+    }
+
+    if (result < 0 && cmux->is_running)
+    {
+        /* undo the switch, the module is reset by the caller when it does not leave CMUX mode */
+        cmux_detach(cmux);
+    }
+
+    return result;
+}
+
+/**
+ * This function will leave CMUX mode before the module is powered off or reset, the
+ * module returns to AT command mode and the device uses the physical AT client again.
+ * The PPP data call on the data channel is terminated first.
+ *
+ * @param device the AT device
+ *
+ * @return  0: stop success
+ *         -1: the device is not in CMUX mode
+ */
+int at_device_cmux_stop(struct at_device *device)
+{
+    struct at_device_cmux *cmux = RT_NULL;
+
+    RT_ASSERT(device);
+
+    cmux = device->cmux;
+    if (cmux == RT_NULL)
+    {
+        return -RT_ERROR;
+    }
+
+#if defined(RT_USING_LWIP) && defined(RT_LWIP_PPP)
+    at_device_ppp_stop(device);
+#endif
+
+    cmux_detach(cmux);
+
+    device->client = cmux->phy_client;
+    device->ctrl_client = cmux->phy_ctrl_client;
+    device->cmux = RT_NULL;
+
+    LOG_I("%s device leave CMUX mode.", device->name);
+
+    return RT_EOK;
+}
@@ -0,0 +1,361 @@
+/*
+ * File      : at_device_coap.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#include <string.h>
+
+#include <at_device_coap.h>
+#include <at_device_urc.h>
+#include <at_device_parser.h>
+#include <at_device_sched.h>
+
+#define LOG_TAG                        "at.dev.coap"
+#include <at_log.h>
+
+#ifdef AT_DEVICE_USING_COAP
+
+struct at_device_coap
+{
+    const struct at_device_coap_ops *ops;
+    struct at_client *client;                    /* the client with the URCs registered */
+    struct rt_mutex lock;                        /* the commands and the result wait in order */
+    struct rt_event event;
+    int state;
+    int result;                                  /* the result of the last module URC, 0: success */
+
+    at_device_coap_recv_cb_t recv_cb;
+    void *user_data;
+    char hex_buf[AT_DEVICE_COAP_SEND_MAX_SIZE * 2 + 1];
+    char recv_buf[AT_DEVICE_COAP_RECV_BUFSZ];
+};
+
+static const char hex_table[] = "0123456789ABCDEF";
+
+/**
+ * This function will get the AT device of the client in the class URCs.
+ *
+ * @param client the AT client which received the URC
+ *
+ * @return the AT device, RT_NULL: the device or the CoAP session is not found
+ */
+struct at_device *at_device_coap_get_device(struct at_client *client)
+{
+    struct at_device *device = RT_NULL;
+    char *client_name = client->device->parent.name;
+
+    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    if (device == RT_NULL || device->coap == RT_NULL)
+    {
+        LOG_E("get device(%s) failed.", client_name);
+        return RT_NULL;
+    }
+
+    return device;
+}
+
+/* wait for the module result URC, the device is not taken during waiting */
+static int at_device_coap_wait(struct at_device *device, rt_uint32_t event, rt_int32_t timeout)
+{
+    if (rt_event_recv(&(device->coap->event), event, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                      timeout * RT_TICK_PER_SECOND, RT_NULL) != RT_EOK)
+    {
+        LOG_E("%s device wait CoAP result timeout.", device->name);
+        return -RT_ETIMEOUT;
+    }
+
+    return (device->coap->result == 0) ? RT_EOK : -RT_ERROR;
+}
+
+/* start the deregistration and wait for it, it is also used to clean up the failed open */
+static void at_device_coap_stop(struct at_device *device)
+{
+    int result = RT_EOK;
+    struct at_device_coap *coap = device->coap;
+
+    at_device_sched_take(device, AT_DEVICE_CMD_CONTROL, RT_WAITING_FOREVER);
+    rt_event_recv(&(coap->event), AT_DEVICE_COAP_EVENT_CLOSE, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR, 0, RT_NULL);
+    result = coap->ops->close(device);
+    at_device_sched_release(device);
+    if (result == RT_EOK)
+    {
+        at_device_coap_wait(device, AT_DEVICE_COAP_EVENT_CLOSE, AT_DEVICE_COAP_TIMEOUT);
+    }
+
+    coap->state = AT_DEVICE_COAP_STATE_CLOSED;
+}
+
+/**
+ * This function will register the module to the platform, the registration
+ * update and the confirmable retransmission are handled by module.
+ *
+ * @param device the AT device
+ * @param cfg the session configuration
+ *
+ * @return  0: open success or already opened
+ *         -1: send AT commands error or the registration failed
+ *         -2: wait registration timeout
+ */
+int at_device_coap_open(struct at_device *device, const struct at_device_coap_cfg *cfg)
+{
+    int result = RT_EOK;
+    struct at_device_coap *coap = device->coap;
+
+    RT_ASSERT(cfg && cfg->host);
+
+    if (coap == RT_NULL)
+    {
+        LOG_E("%s device CoAP session is not initialized.", device->name);
+        return -RT_ERROR;
+    }
+
+    rt_mutex_take(&(coap->lock), RT_WAITING_FOREVER);
+    if (coap->state == AT_DEVICE_COAP_STATE_OPENED)
+    {
+        goto __exit;
+    }
+
+    at_device_sched_take(device, AT_DEVICE_CMD_CONTROL, RT_WAITING_FOREVER);
+    rt_event_recv(&(coap->event), AT_DEVICE_COAP_EVENT_ALL, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR, 0, RT_NULL);
+    result = coap->ops->open(device, cfg);
+    at_device_sched_release(device);
+    if (result < 0)
+    {
+        LOG_E("%s device CoAP open %s failed.", device->name, cfg->host);
+        goto __exit;
+    }
+
+    result = at_device_coap_wait(device, AT_DEVICE_COAP_EVENT_OPEN, AT_DEVICE_COAP_OPEN_TIMEOUT);
+    if (result < 0)
+    {
+        LOG_E("%s device CoAP register to %s failed(%d).", device->name, cfg->host, coap->result);
+        at_device_coap_stop(device);
+        goto __exit;
+    }
+    coap->state = AT_DEVICE_COAP_STATE_OPENED;
+
+__exit:
+    rt_mutex_release(&(coap->lock));
+
+    return result;
+}
+
+/**
+ * This function will deregister the module from the platform.
+ *
+ * @param device the AT device
+ *
+ * @return  0: close success
+ */
+int at_device_coap_close(struct at_device *device)
+{
+    struct at_device_coap *coap = device->coap;
+
+    RT_ASSERT(coap);
+
+    rt_mutex_take(&(coap->lock), RT_WAITING_FOREVER);
+    if (coap->state != AT_DEVICE_COAP_STATE_CLOSED)
+    {
+        at_device_coap_stop(device);
+    }
+    rt_mutex_release(&(coap->lock));
+
+    return RT_EOK;
+}
+
+/**
+ * This function will send the message by the module, the payload is carried
+ * in the command as hex string. The confirmable message returns after the
+ * platform ACK, the module retransmits it until then.
+ *
+ * @param device the AT device
+ * @param data the payload
+ * @param len the payload length, it must be not more than AT_DEVICE_COAP_SEND_MAX_SIZE
+ * @param type the message type, AT_DEVICE_COAP_CON or AT_DEVICE_COAP_NON
+ *
+ * @return  0: send success
+ *         -1: send AT commands error, the session is closed or the message is not acknowledged
+ *         -2: wait ACK timeout
+ */
+int at_device_coap_send(struct at_device *device, const char *data, rt_size_t len, int type)
+{
+    int result = RT_EOK;
+    rt_size_t i = 0;
+    struct at_device_coap *coap = device->coap;
+
+    RT_ASSERT(coap);
+    RT_ASSERT(data && len > 0);
+
+    if (len > AT_DEVICE_COAP_SEND_MAX_SIZE)
+    {
+        LOG_E("%s device CoAP message(%d) is longer than %d bytes, the hex string exceeds AT_CMD_MAX_LEN.",
+              device->name, len, AT_DEVICE_COAP_SEND_MAX_SIZE);
+        return -RT_ERROR;
+    }
+
+    rt_mutex_take(&(coap->lock), RT_WAITING_FOREVER);
+    if (coap->state != AT_DEVICE_COAP_STATE_OPENED)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    for (i = 0; i < len; i++)
+    {
+        coap->hex_buf[i * 2] = hex_table[((rt_uint8_t) data[i]) >> 4];
+        coap->hex_buf[i * 2 + 1] = hex_table[((rt_uint8_t) data[i]) & 0x0F];
+    }
+    coap->hex_buf[len * 2] = '\0';
+
+    at_device_sched_take(device, AT_DEVICE_CMD_DATA, RT_WAITING_FOREVER);
+    rt_event_recv(&(coap->event), AT_DEVICE_COAP_EVENT_SEND, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR, 0, RT_NULL);
+    result = coap->ops->send(device, coap->hex_buf, len, type);
+    at_device_sched_release(device);
+    if (result < 0 || type == AT_DEVICE_COAP_NON)
+    {
+        goto __exit;
+    }
+
+    if ((result = at_device_coap_wait(device, AT_DEVICE_COAP_EVENT_SEND, AT_DEVICE_COAP_TIMEOUT)) < 0)
+    {
+        LOG_E("%s device CoAP message is not acknowledged(%d).", device->name, coap->result);
+    }
+
+__exit:
+    rt_mutex_release(&(coap->lock));
+
+    return result;
+}
+
+int at_device_coap_state(struct at_device *device)
+{
+    return device->coap ? device->coap->state : AT_DEVICE_COAP_STATE_CLOSED;
+}
+
+void at_device_coap_set_recv_cb(struct at_device *device, at_device_coap_recv_cb_t cb, void *user_data)
+{
+    RT_ASSERT(device->coap);
+
+    device->coap->user_data = user_data;
+    device->coap->recv_cb = cb;
+}
+
+/**
+ * This function will notice the module result to the waiting command, it is
+ * called by the class URCs. The close event is also noticed when the module
+ * lost the registration by itself.
+ *
+ * @param device the AT device
+ * @param event the result event
+ * @param result the module result, 0: success
+ */
+void at_device_coap_notify(struct at_device *device, rt_uint32_t event, int result)
+{
+    struct at_device_coap *coap = device->coap;
+
+    if (event == AT_DEVICE_COAP_EVENT_CLOSE)
+    {
+        coap->state = AT_DEVICE_COAP_STATE_CLOSED;
+    }
+
+    coap->result = result;
+    rt_event_send(&(coap->event), event);
+}
+
+/**
+ * This function will decode the downlink hex string payload carried in the
+ * class URC, and notice it to the receive callback.
+ *
+ * @param device the AT device
+ * @param hex the hex string payload
+ * @param hex_len the hex string length, it must be not less than len * 2
+ * @param len the size of decoded payload
+ */
+void at_device_coap_recv_hex(struct at_device *device, const char *hex, rt_size_t hex_len, rt_size_t len)
+{
+    struct at_device_parser parser;
+    struct at_device_coap *coap = device->coap;
+
+    if (len > sizeof(coap->recv_buf))
+    {
+        LOG_W("%s device CoAP message(%d) is truncated to %d bytes.", device->name, len, sizeof(coap->recv_buf));
+        len = sizeof(coap->recv_buf);
+    }
+
+    at_device_parser_init(&parser, hex, hex_len);
+    if (at_device_parser_hex(&parser, coap->recv_buf, len) < 0)
+    {
+        LOG_E("%s device CoAP receive invalid hex data.", device->name);
+        return;
+    }
+
+    if (coap->recv_cb)
+    {
+        coap->recv_cb(device, coap->recv_buf, len, coap->user_data);
+    }
+}
+
+/**
+ * This function will prepare the CoAP session of the device, it is called by
+ * the device class after the AT client is ready, and again when the control
+ * client changed.
+ *
+ * @param device the AT device
+ * @param ops the module CoAP operations
+ *
+ * @return  0: initialize success
+ *         -5: no memory
+ */
+int at_device_coap_init(struct at_device *device, const struct at_device_coap_ops *ops)
+{
+    struct at_device_coap *coap = device->coap;
+
+    RT_ASSERT(device);
+    RT_ASSERT(ops && ops->open && ops->close && ops->send);
+
+    if (coap == RT_NULL)
+    {
+        coap = (struct at_device_coap *) rt_calloc(1, sizeof(struct at_device_coap));
+        if (coap == RT_NULL)
+        {
+            LOG_E("no memory for %s device CoAP session create.", device->name);
+            return -RT_ENOMEM;
+        }
+        rt_mutex_init(&(coap->lock), "at_coap", RT_IPC_FLAG_PRIO);
+        rt_event_init(&(coap->event), "at_coap", RT_IPC_FLAG_PRIO);
+        coap->ops = ops;
+        device->coap = coap;
+    }
+
+    /* the module is re-initialized, the registration is lost */
+    coap->state = AT_DEVICE_COAP_STATE_CLOSED;
+
+    if (coap->client != AT_DEVICE_CTRL_CLIENT(device))
+    {
+        coap->client = AT_DEVICE_CTRL_CLIENT(device);
+        return at_device_urc_set_table(coap->client, ops->urc_table, ops->urc_num);
+    }
+
+    return RT_EOK;
+}
+
+#endif /* AT_DEVICE_USING_COAP */
@@ -0,0 +1,531 @@
+/*
+ * File      : at_device_failover.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#include <string.h>
+
+#include <at_device_failover.h>
+
+#define LOG_TAG                        "at.dev.fover"
+#include <at_log.h>
+
+#if defined(AT_DEVICE_USING_FAILOVER) && defined(AT_USING_SOCKET) && defined(RT_USING_SAL)
+
+#include <at_device_socket.h>
+#include <sys/socket.h>
+#include <netdb.h>
+
+/* the failover thread events, the link down devices are marked in the links */
+#define AT_DEVICE_FAILOVER_EVENT_DOWN  (1L << 0)
+#define AT_DEVICE_FAILOVER_EVENT_UP    (1L << 1)
+
+/* the watched device link, the previous status callback of the netdev is kept */
+struct at_device_failover_link
+{
+    struct at_device *device;
+    netdev_callback_fn status_callback;
+    rt_tick_t down_tick;
+    rt_bool_t down_pending;                      /* the link down is not handled by the failover thread */
+};
+
+static struct at_device_failover_link failover_links[AT_DEVICE_FAILOVER_DEVICE_NUM];
+static rt_slist_t failover_conns = RT_SLIST_OBJECT_INIT(failover_conns);
+static struct at_device_failover_stats failover_stats;
+static rt_bool_t failover_started = RT_FALSE;
+static struct rt_event failover_event;
+/* the connection list lock, it is not held during the resolve and connect */
+static struct rt_mutex failover_lock;
+/* the reopen lock, a connection is not closed while it is reopening */
+static struct rt_mutex failover_reopen_lock;
+
+static struct at_device_failover_link *at_device_failover_link_get(struct netdev *netdev)
+{
+    int i = 0;
+
+    for (i = 0; i < AT_DEVICE_FAILOVER_DEVICE_NUM; i++)
+    {
+        if (failover_links[i].device && failover_links[i].device->netdev == netdev)
+        {
+            return &failover_links[i];
+        }
+    }
+
+    return RT_NULL;
+}
+
+/* the link status is changed by the class, the in-flight operations fail at once */
+static void at_device_failover_status_callback(struct netdev *netdev, enum netdev_cb_type type)
+{
+    struct at_device_failover_link *link = RT_NULL;
+
+    link = at_device_failover_link_get(netdev);
+    if (link == RT_NULL)
+    {
+        return;
+    }
+
+    if (link->status_callback)
+    {
+        link->status_callback(netdev, type);
+    }
+
+    if (type == NETDEV_CB_STATUS_LINK_UP)
+    {
+        link->device->link_down = RT_FALSE;
+        /* the pending connections are retried on the device back */
+        rt_event_send(&failover_event, AT_DEVICE_FAILOVER_EVENT_UP);
+    }
+    else if (type == NETDEV_CB_STATUS_LINK_DOWN && link->device->link_down == RT_FALSE)
+    {
+        LOG_W("%s device link is down, the connections fail over.", link->device->name);
+        link->down_tick = rt_tick_get();
+        link->device->link_down = RT_TRUE;
+        at_device_socket_link_down(link->device);
+        /* the events are merged, the link down is kept in the link until handled */
+        link->down_pending = RT_TRUE;
+        rt_event_send(&failover_event, AT_DEVICE_FAILOVER_EVENT_DOWN);
+    }
+}
+
+/* resolve the host again and connect through the device selected, it returns the socket */
+static int at_device_failover_connect(struct at_device_failover_conn *conn, struct at_device **device)
+{
+    int sock = -1;
+    struct hostent *host = RT_NULL;
+    struct sockaddr_in addr;
+
+    *device = at_device_select();
+    if (*device == RT_NULL)
+    {
+        LOG_E("no AT device is ready for the connection(%s:%d).", conn->host, conn->port);
+        return -RT_ERROR;
+    }
+
+    host = gethostbyname(conn->host);
+    if (host == RT_NULL)
+    {
+        LOG_E("resolve the host(%s) failed.", conn->host);
+        return -RT_ERROR;
+    }
+
+    rt_memset(&addr, 0x00, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(conn->port);
+    rt_memcpy(&(addr.sin_addr), host->h_addr, sizeof(addr.sin_addr));
+
+    sock = socket(AF_INET, conn->type, 0);
+    if (sock < 0)
+    {
+        LOG_E("create the socket for the connection(%s:%d) failed.", conn->host, conn->port);
+        return -RT_ERROR;
+    }
+
+    if (at_device_bind(sock, *device) < 0 ||
+            connect(sock, (struct sockaddr *) &addr, sizeof(addr)) < 0)
+    {
+        LOG_E("%s device connect to %s:%d failed.", (*device)->name, conn->host, conn->port);
+        closesocket(sock);
+        return -RT_ERROR;
+    }
+
+    return sock;
+}
+
+/* reopen the connection, it is pending with no socket if no device is ready,
+   the reopen lock is held and the connection list lock is not */
+static rt_bool_t at_device_failover_reopen(struct at_device_failover_conn *conn)
+{
+    int sock = -1, old_socket = -1;
+    struct at_device *device = RT_NULL, *old_device = conn->device;
+
+    sock = at_device_failover_connect(conn, &device);
+
+    rt_mutex_take(&failover_lock, RT_WAITING_FOREVER);
+    old_socket = conn->socket;
+    conn->socket = sock;
+    conn->device = (sock >= 0) ? device : RT_NULL;
+    rt_mutex_release(&failover_lock);
+
+    if (sock < 0)
+    {
+        failover_stats.failed++;
+        if (old_socket >= 0)
+        {
+            closesocket(old_socket);
+        }
+        return RT_FALSE;
+    }
+
+    if (conn->reopen_cb)
+    {
+        conn->reopen_cb(conn, old_socket);
+    }
+    if (old_socket >= 0)
+    {
+        closesocket(old_socket);
+    }
+
+    failover_stats.reopened++;
+    LOG_I("connection(%s:%d) fails over from %s to %s device.", conn->host, conn->port,
+          old_device ? old_device->name : "none", device->name);
+
+    return RT_TRUE;
+}
+
+/* the connection is on the device, or it is pending when the device is RT_NULL */
+static rt_bool_t at_device_failover_conn_match(struct at_device_failover_conn *conn, struct at_device *device)
+{
+    return device ? (conn->device == device) : (conn->socket < 0);
+}
+
+/* the connection is not closed, the connection list lock is held */
+static rt_bool_t at_device_failover_conn_exist(struct at_device_failover_conn *conn)
+{
+    rt_slist_t *node = RT_NULL;
+
+    rt_slist_for_each(node, &failover_conns)
+    {
+        if (node == &(conn->list))
+        {
+            return RT_TRUE;
+        }
+    }
+
+    return RT_FALSE;
+}
+
+/* reopen the connections on the device, or the pending ones when the device is RT_NULL,
+   it returns the number of connections still pending */
+static int at_device_failover_reopen_all(struct at_device *device)
+{
+    int pending = 0;
+    rt_size_t i = 0, num = 0;
+    rt_bool_t reopen = RT_FALSE;
+    rt_slist_t *node = RT_NULL;
+    struct at_device_failover_conn *conn = RT_NULL, **conns = RT_NULL;
+
+    /* snapshot the connections, the resolve and connect are out of the list lock */
+    rt_mutex_take(&failover_lock, RT_WAITING_FOREVER);
+    if (rt_slist_len(&failover_conns) > 0)
+    {
+        conns = (struct at_device_failover_conn **) rt_calloc(rt_slist_len(&failover_conns),
+                                                              sizeof(struct at_device_failover_conn *));
+        if (conns == RT_NULL)
+        {
+            rt_mutex_release(&failover_lock);
+            LOG_E("no memory for failover connections snapshot.");
+            /* retried on the next interval */
+            return 1;
+        }
+
+        rt_slist_for_each(node, &failover_conns)
+        {
+            conn = rt_slist_entry(node, struct at_device_failover_conn, list);
+            if (at_device_failover_conn_match(conn, device))
+            {
+                conns[num++] = conn;
+            }
+        }
+    }
+    rt_mutex_release(&failover_lock);
+
+    for (i = 0; i < num; i++)
+    {
+        /* the connection may be closed or reopened by the application after the snapshot */
+        rt_mutex_take(&failover_reopen_lock, RT_WAITING_FOREVER);
+        rt_mutex_take(&failover_lock, RT_WAITING_FOREVER);
+        reopen = at_device_failover_conn_exist(conns[i]) && at_device_failover_conn_match(conns[i], device);
+        rt_mutex_release(&failover_lock);
+
+        if (reopen)
+        {
+            at_device_failover_reopen(conns[i]);
+        }
+        rt_mutex_release(&failover_reopen_lock);
+    }
+
+    if (conns)
+    {
+        rt_free(conns);
+    }
+
+    rt_mutex_take(&failover_lock, RT_WAITING_FOREVER);
+    rt_slist_for_each(node, &failover_conns)
+    {
+        conn = rt_slist_entry(node, struct at_device_failover_conn, list);
+        if (conn->socket < 0)
+        {
+            pending++;
+        }
+    }
+    rt_mutex_release(&failover_lock);
+
+    return pending;
+}
+
+/* reopen the connections of the device on the healthy devices, it returns the number pending */
+static int at_device_failover_run(struct at_device_failover_link *link)
+{
+    int pending = 0;
+    rt_uint32_t latency = 0;
+    struct at_device *device = RT_NULL;
+
+    failover_stats.link_down++;
+
+    /* the host is resolved by the default netdev */
+    if (netdev_default == link->device->netdev && (device = at_device_select()) != RT_NULL)
+    {
+        netdev_set_default(device->netdev);
+    }
+
+    pending = at_device_failover_reopen_all(link->device);
+
+    latency = (rt_tick_get() - link->down_tick) * 1000 / RT_TICK_PER_SECOND;
+    failover_stats.last_latency = latency;
+    if (latency > failover_stats.max_latency)
+    {
+        failover_stats.max_latency = latency;
+    }
+
+    return pending;
+}
+
+static void at_device_failover_entry(void *parameter)
+{
+    int i = 0, pending = 0;
+    rt_base_t level;
+    rt_bool_t down = RT_FALSE;
+    rt_uint32_t event = 0;
+
+    while (1)
+    {
+        /* the pending connections are retried on a link up or the retry interval */
+        event = 0;
+        rt_event_recv(&failover_event, AT_DEVICE_FAILOVER_EVENT_DOWN | AT_DEVICE_FAILOVER_EVENT_UP,
+                      RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR, pending ?
+                      rt_tick_from_millisecond(AT_DEVICE_FAILOVER_RETRY_INTERVAL) : RT_WAITING_FOREVER, &event);
+
+        for (i = 0; i < AT_DEVICE_FAILOVER_DEVICE_NUM; i++)
+        {
+            level = rt_hw_interrupt_disable();
+            down = failover_links[i].down_pending;
+            failover_links[i].down_pending = RT_FALSE;
+            rt_hw_interrupt_enable(level);
+
+            if (down)
+            {
+                pending = at_device_failover_run(&failover_links[i]);
+            }
+        }
+
+        if (pending && (event == 0 || (event & AT_DEVICE_FAILOVER_EVENT_UP)))
+        {
+            pending = at_device_failover_reopen_all(RT_NULL);
+        }
+    }
+}
+
+/**
+ * This function will watch the link of the device, it is called for the device
+ * registered after the failover manager started.
+ *
+ * @param device the AT device
+ *
+ * @return  0: attach success or already attached
+ *         -1: the device has no netdev or the watched devices are full
+ */
+int at_device_failover_attach(struct at_device *device)
+{
+    int i = 0;
+    rt_base_t level;
+
+    RT_ASSERT(device);
+
+    if (device->netdev == RT_NULL)
+    {
+        LOG_E("%s device has no netdev to watch.", device->name);
+        return -RT_ERROR;
+    }
+
+    level = rt_hw_interrupt_disable();
+
+    if (at_device_failover_link_get(device->netdev))
+    {
+        rt_hw_interrupt_enable(level);
+        return RT_EOK;
+    }
+
+    for (i = 0; i < AT_DEVICE_FAILOVER_DEVICE_NUM; i++)
+    {
+        if (failover_links[i].device == RT_NULL)
+        {
+            failover_links[i].device = device;
+            failover_links[i].status_callback = device->netdev->status_callback;
+            netdev_set_status_callback(device->netdev, at_device_failover_status_callback);
+            break;
+        }
+    }
+
+    rt_hw_interrupt_enable(level);
+
+    if (i == AT_DEVICE_FAILOVER_DEVICE_NUM)
+    {
+        LOG_E("no room for %s device failover watch.", device->name);
+        return -RT_ERROR;
+    }
+
+    return RT_EOK;
+}
+
+/**
+ * This function will start the failover manager and watch the link of the
+ * registered devices.
+ *
+ * @return  0: start success or already started
+ *         -5: no memory
+ */
+int at_device_failover_init(void)
+{
+    rt_thread_t tid;
+    rt_slist_t *node = RT_NULL;
+    struct netdev *netdev = RT_NULL;
+    struct at_device *device = RT_NULL;
+
+    if (failover_started)
+    {
+        return RT_EOK;
+    }
+
+    rt_event_init(&failover_event, "at_fover", RT_IPC_FLAG_FIFO);
+    rt_mutex_init(&failover_lock, "at_fover", RT_IPC_FLAG_PRIO);
+    rt_mutex_init(&failover_reopen_lock, "at_frop", RT_IPC_FLAG_PRIO);
+
+    tid = rt_thread_create("at_fover", at_device_failover_entry, RT_NULL,
+                           AT_DEVICE_FAILOVER_STACK_SIZE, AT_DEVICE_FAILOVER_PRIORITY, 20);
+    if (tid == RT_NULL)
+    {
+        LOG_E("no memory for failover thread create.");
+        rt_mutex_detach(&failover_reopen_lock);
+        rt_mutex_detach(&failover_lock);
+        rt_event_detach(&failover_event);
+        return -RT_ENOMEM;
+    }
+    rt_thread_startup(tid);
+    failover_started = RT_TRUE;
+
+    for (node = netdev_list ? &(netdev_list->list) : RT_NULL; node; node = rt_slist_next(node))
+    {
+        netdev = rt_slist_entry(node, struct netdev, list);
+        device = at_device_get_by_name(AT_DEVICE_NAMETYPE_NETDEV, netdev->name);
+        if (device && device->netdev == netdev)
+        {
+            at_device_failover_attach(device);
+        }
+    }
+
+    return RT_EOK;
+}
+
+/**
+ * This function will connect the managed connection on the device selected by
+ * the connection scheduler, it is reopened on another device when the link of
+ * the device is down.
+ *
+ * @param conn the connection, the host, port and type are set
+ *
+ * @return  0: connect success
+ *         -1: no device is ready, resolve or connect failed
+ */
+int at_device_failover_open(struct at_device_failover_conn *conn)
+{
+    int sock = -1;
+    struct at_device *device = RT_NULL;
+
+    RT_ASSERT(conn && conn->host);
+    RT_ASSERT(failover_started);
+
+    /* the connection is not in the list yet, the list lock is not held during the connect */
+    sock = at_device_failover_connect(conn, &device);
+    if (sock < 0)
+    {
+        conn->socket = -1;
+        conn->device = RT_NULL;
+        return -RT_ERROR;
+    }
+
+    rt_mutex_take(&failover_lock, RT_WAITING_FOREVER);
+    conn->socket = sock;
+    conn->device = device;
+    rt_slist_init(&(conn->list));
+    rt_slist_append(&failover_conns, &(conn->list));
+    rt_mutex_release(&failover_lock);
+
+    return RT_EOK;
+}
+
+/**
+ * This function will close the managed connection.
+ *
+ * @param conn the connection opened
+ *
+ * @return  0: close success
+ */
+int at_device_failover_close(struct at_device_failover_conn *conn)
+{
+    int sock = -1;
+
+    RT_ASSERT(conn);
+    RT_ASSERT(failover_started);
+
+    /* wait for the reopen in progress, the connection is not reopened after removed */
+    rt_mutex_take(&failover_reopen_lock, RT_WAITING_FOREVER);
+    rt_mutex_take(&failover_lock, RT_WAITING_FOREVER);
+
+    rt_slist_remove(&failover_conns, &(conn->list));
+    sock = conn->socket;
+    conn->socket = -1;
+    conn->device = RT_NULL;
+
+    rt_mutex_release(&failover_lock);
+    rt_mutex_release(&failover_reopen_lock);
+
+    if (sock >= 0)
+    {
+        closesocket(sock);
+    }
+
+    return RT_EOK;
+}
+
+void at_device_failover_stats_get(struct at_device_failover_stats *stats)
+{
+    rt_base_t level;
+
+    RT_ASSERT(stats);
+
+    level = rt_hw_interrupt_disable();
+    rt_memcpy(stats, &failover_stats, sizeof(struct at_device_failover_stats));
+    rt_hw_interrupt_enable(level);
+}
+
+#endif /* AT_DEVICE_USING_FAILOVER && AT_USING_SOCKET && RT_USING_SAL */
@@ -0,0 +1,299 @@
+/*
+ * File      : at_device_init.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#include <at_device_init.h>
+
+#define LOG_TAG                        "at.dev.init"
+#include <at_log.h>
+
+#ifdef AT_DEVICE_USING_INIT_SCHED
+
+/* the worker takes the initialization result of the class, it must not run in another thread */
+#if defined(AT_DEVICE_A9G_INIT_ASYN) || defined(AT_DEVICE_AIR720_INIT_ASYN) || defined(AT_DEVICE_BC26_INIT_ASYN) || \
+    defined(AT_DEVICE_BC28_INIT_ASYN) || defined(AT_DEVICE_EC200X_INIT_ASYN) || defined(AT_DEVICE_EC20_INIT_ASYN) || \
+    defined(AT_DEVICE_ESP32_INIT_ASYN) || defined(AT_DEVICE_ESP8266_INIT_ASYN) || defined(AT_DEVICE_L610_INIT_ASYN) || \
+    defined(AT_DEVICE_M26_INIT_ASYN) || defined(AT_DEVICE_M5311_INIT_ASYN) || defined(AT_DEVICE_M6315_INIT_ASYN) || \
+    defined(AT_DEVICE_ME3616_INIT_ASYN) || defined(AT_DEVICE_MW31_INIT_ASYN) || defined(AT_DEVICE_N21_INIT_ASYN) || \
+    defined(AT_DEVICE_N58_INIT_ASYN) || defined(AT_DEVICE_N720_INIT_ASYN) || defined(AT_DEVICE_RW007_INIT_ASYN) || \
+    defined(AT_DEVICE_SIM76XX_INIT_ASYN) || defined(AT_DEVICE_SIM800C_INIT_ASYN) || defined(AT_DEVICE_W60X_INIT_ASYN)
+#error "The AT device init scheduler needs the device initialization synchronously, please undefine the *_INIT_ASYN options."
+#endif
+
+/* the device initialization state */
+#define AT_DEVICE_INIT_PENDING         0x00
+#define AT_DEVICE_INIT_RUNNING         0x01
+#define AT_DEVICE_INIT_DONE            0x02
+
+/* the event of any device finished initialization */
+#define AT_DEVICE_INIT_EVENT_DONE      (1L << 0)
+
+/* the waiting slice, the waiter checks the devices state again after it */
+#define AT_DEVICE_INIT_WAIT_SLICE      (RT_TICK_PER_SECOND / 10)
+
+struct at_device_init_node
+{
+    struct at_device *device;
+    int result;
+    rt_uint8_t state;
+    rt_slist_t list;
+};
+
+struct at_device_init_sched
+{
+    rt_bool_t is_init;
+    struct rt_mutex lock;
+    struct rt_event event;
+    rt_slist_t node_list;                        /* the registered devices in register order */
+    rt_uint8_t workers;                          /* the number of running workers */
+    at_device_init_cb_t cb;
+};
+
+static struct at_device_init_sched init_sched = {0};
+
+static void at_device_init_sched_setup(void)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (init_sched.is_init == RT_FALSE)
+    {
+        rt_mutex_init(&(init_sched.lock), "at_init", RT_IPC_FLAG_PRIO);
+        rt_event_init(&(init_sched.event), "at_init", RT_IPC_FLAG_PRIO);
+        rt_slist_init(&(init_sched.node_list));
+        init_sched.is_init = RT_TRUE;
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+/* take the next pending device, the worker exits when no device is pending */
+static struct at_device_init_node *at_device_init_next(void)
+{
+    rt_slist_t *list = RT_NULL;
+    struct at_device_init_node *node = RT_NULL;
+
+    rt_mutex_take(&(init_sched.lock), RT_WAITING_FOREVER);
+    rt_slist_for_each(list, &(init_sched.node_list))
+    {
+        node = rt_slist_entry(list, struct at_device_init_node, list);
+        if (node->state == AT_DEVICE_INIT_PENDING)
+        {
+            node->state = AT_DEVICE_INIT_RUNNING;
+            rt_mutex_release(&(init_sched.lock));
+            return node;
+        }
+    }
+
+    /* decrease in the same lock with the pending check, so no device is left without worker */
+    init_sched.workers--;
+    rt_mutex_release(&(init_sched.lock));
+
+    return RT_NULL;
+}
+
+static void at_device_init_entry(void *parameter)
+{
+    int result = RT_EOK;
+    struct at_device *device = RT_NULL;
+    struct at_device_init_node *node = RT_NULL;
+
+    while ((node = at_device_init_next()) != RT_NULL)
+    {
+        device = node->device;
+
+        LOG_D("%s device initialize start.", device->name);
+        result = device->class->device_ops->init(device);
+        device->is_init = (result < 0) ? RT_FALSE : RT_TRUE;
+        if (result < 0)
+        {
+            LOG_E("%s device initialize failed(%d).", device->name, result);
+        }
+
+        rt_mutex_take(&(init_sched.lock), RT_WAITING_FOREVER);
+        node->result = result;
+        node->state = AT_DEVICE_INIT_DONE;
+        rt_mutex_release(&(init_sched.lock));
+
+        /* wake up all the waiters */
+        rt_event_send(&(init_sched.event), AT_DEVICE_INIT_EVENT_DONE);
+
+        if (init_sched.cb)
+        {
+            init_sched.cb(device, result);
+        }
+    }
+}
+
+/**
+ * This function will initialize the device in the init scheduler workers, the
+ * devices registered one by one initialize at the same time, and the number of
+ * devices initialize at the same time is not more than AT_DEVICE_INIT_SCHED_WORKERS.
+ *
+ * @param device the AT device
+ *
+ * @return  0: submit success
+ *         -5: no memory
+ */
+int at_device_init_submit(struct at_device *device)
+{
+    rt_thread_t tid = RT_NULL;
+    rt_bool_t new_worker = RT_FALSE;
+    char name[RT_NAME_MAX] = {0};
+    struct at_device_init_node *node = RT_NULL;
+
+    RT_ASSERT(device);
+
+    at_device_init_sched_setup();
+
+    node = (struct at_device_init_node *) rt_calloc(1, sizeof(struct at_device_init_node));
+    if (node == RT_NULL)
+    {
+        LOG_E("no memory for %s device init node create.", device->name);
+        return -RT_ENOMEM;
+    }
+    node->device = device;
+    node->state = AT_DEVICE_INIT_PENDING;
+    rt_slist_init(&(node->list));
+
+    rt_mutex_take(&(init_sched.lock), RT_WAITING_FOREVER);
+    rt_slist_append(&(init_sched.node_list), &(node->list));
+    if (init_sched.workers < AT_DEVICE_INIT_SCHED_WORKERS)
+    {
+        rt_snprintf(name, RT_NAME_MAX, "at_in%d", init_sched.workers);
+        init_sched.workers++;
+        new_worker = RT_TRUE;
+    }
+    rt_mutex_release(&(init_sched.lock));
+
+    if (new_worker == RT_FALSE)
+    {
+        /* the running worker will take it */
+        return RT_EOK;
+    }
+
+    tid = rt_thread_create(name, at_device_init_entry, RT_NULL,
+                           AT_DEVICE_INIT_SCHED_STACK_SIZE, AT_DEVICE_INIT_SCHED_PRIORITY, 20);
+    if (tid)
+    {
+        rt_thread_startup(tid);
+    }
+    else
+    {
+        /* initialize in the caller thread, the same as no init scheduler */
+        LOG_W("create init worker failed, %s device initialize synchronously.", device->name);
+        at_device_init_entry(RT_NULL);
+    }
+
+    return RT_EOK;
+}
+
+/**
+ * This function will set the notice callback, it is called in the worker
+ * thread when a device finished initialization.
+ *
+ * @param cb the notice callback
+ */
+void at_device_init_set_cb(at_device_init_cb_t cb)
+{
+    init_sched.cb = cb;
+}
+
+/**
+ * This function will wait for the registered devices finished initialization.
+ *
+ * @param option AT_DEVICE_INIT_WAIT_ANY: any device initialized successfully
+ *               AT_DEVICE_INIT_WAIT_ALL: all devices finished initialization
+ * @param timeout the waiting time in millisecond, RT_WAITING_FOREVER: wait forever
+ * @param device the device initialized successfully, it can be RT_NULL
+ *
+ * @return  0: wait success
+ *         -1: all devices finished, but none initialized successfully with WAIT_ANY option
+ *         -2: wait timeout
+ */
+int at_device_init_wait(rt_uint8_t option, rt_int32_t timeout, struct at_device **device)
+{
+    rt_slist_t *list = RT_NULL;
+    rt_tick_t start = rt_tick_get();
+    rt_int32_t wait_tick = 0, timeout_tick = 0;
+    rt_size_t unfinished = 0;
+    struct at_device *ready = RT_NULL;
+    struct at_device_init_node *node = RT_NULL;
+
+    RT_ASSERT(option == AT_DEVICE_INIT_WAIT_ANY || option == AT_DEVICE_INIT_WAIT_ALL);
+
+    at_device_init_sched_setup();
+    timeout_tick = (timeout == RT_WAITING_FOREVER) ? RT_WAITING_FOREVER : rt_tick_from_millisecond(timeout);
+
+    while (1)
+    {
+        unfinished = 0;
+        ready = RT_NULL;
+
+        rt_mutex_take(&(init_sched.lock), RT_WAITING_FOREVER);
+        rt_slist_for_each(list, &(init_sched.node_list))
+        {
+            node = rt_slist_entry(list, struct at_device_init_node, list);
+            if (node->state != AT_DEVICE_INIT_DONE)
+            {
+                unfinished++;
+            }
+            else if (ready == RT_NULL && node->result >= 0)
+            {
+                ready = node->device;
+            }
+        }
+        rt_mutex_release(&(init_sched.lock));
+
+        if ((option == AT_DEVICE_INIT_WAIT_ANY && ready) || unfinished == 0)
+        {
+            break;
+        }
+
+        wait_tick = AT_DEVICE_INIT_WAIT_SLICE;
+        if (timeout_tick != RT_WAITING_FOREVER)
+        {
+            if ((rt_int32_t) (rt_tick_get() - start) >= timeout_tick)
+            {
+                return -RT_ETIMEOUT;
+            }
+
+            if (timeout_tick - (rt_int32_t) (rt_tick_get() - start) < wait_tick)
+            {
+                wait_tick = timeout_tick - (rt_int32_t) (rt_tick_get() - start);
+            }
+        }
+
+        /* all the waiters are woken up by the event, the slice covers the missed one */
+        rt_event_recv(&(init_sched.event), AT_DEVICE_INIT_EVENT_DONE,
+                      RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR, wait_tick, RT_NULL);
+    }
+
+    if (device)
+    {
+        *device = ready;
+    }
+
+    return (option == AT_DEVICE_INIT_WAIT_ANY && ready == RT_NULL) ? -RT_ERROR : RT_EOK;
+}
+
+#endif /* AT_DEVICE_USING_INIT_SCHED */
@@ -0,0 +1,807 @@
+/*
+ * File      : at_device_mqtt.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#include <string.h>
+
+#include <at_device_mqtt.h>
+#include <at_device_urc.h>
+#include <at_device_parser.h>
+#include <at_device_sched.h>
+
+#define LOG_TAG                        "at.dev.mqtt"
+#include <at_log.h>
+
+#ifdef AT_DEVICE_USING_MQTT
+
+/* the module client index, one MQTT client for each device */
+#define AT_DEVICE_MQTT_CLIENT_IDX      0
+
+/* the module result URC events */
+#define AT_DEVICE_MQTT_EVENT_OPEN      (1L << 0)
+#define AT_DEVICE_MQTT_EVENT_CLOSE     (1L << 1)
+#define AT_DEVICE_MQTT_EVENT_CONN      (1L << 2)
+#define AT_DEVICE_MQTT_EVENT_DISC      (1L << 3)
+#define AT_DEVICE_MQTT_EVENT_SUB       (1L << 4)
+#define AT_DEVICE_MQTT_EVENT_UNS       (1L << 5)
+#define AT_DEVICE_MQTT_EVENT_PUB       (1L << 6)
+#define AT_DEVICE_MQTT_EVENT_ALL       0x7F
+
+/* the network open takes the DNS and TCP connect */
+#define AT_DEVICE_MQTT_OPEN_TIMEOUT    75
+
+struct at_device_mqtt
+{
+    const struct at_device_mqtt_dialect *dialect;
+    struct at_client *client;                    /* the client with the URCs registered */
+    struct rt_mutex lock;                        /* the commands and the result wait in order */
+    struct rt_event event;
+    int state;
+    rt_uint16_t msgid;
+    int result[4];                               /* the fields of the last result URC */
+
+    /* the publishes sent and waiting for the result URC, matched by the message identifier */
+    rt_uint16_t pub_msgid[AT_DEVICE_MQTT_PUB_WINDOW];
+    rt_int8_t pub_result[AT_DEVICE_MQTT_PUB_WINDOW];     /* -1: waiting */
+    rt_size_t pub_num;
+
+    at_device_mqtt_recv_cb_t recv_cb;
+    void *user_data;
+    char topic[AT_DEVICE_MQTT_TOPIC_SIZE];
+    char payload[AT_DEVICE_MQTT_RECV_BUFSZ];
+};
+
+/* the result URC prefix and the event */
+static const struct
+{
+    const char *prefix;
+    rt_uint32_t event;
+} mqtt_result_map[] =
+{
+    {"+QMTOPEN:",   AT_DEVICE_MQTT_EVENT_OPEN},
+    {"+QMTCLOSE:",  AT_DEVICE_MQTT_EVENT_CLOSE},
+    {"+QMTCONN:",   AT_DEVICE_MQTT_EVENT_CONN},
+    {"+QMTDISC:",   AT_DEVICE_MQTT_EVENT_DISC},
+    {"+QMTSUB:",    AT_DEVICE_MQTT_EVENT_SUB},
+    {"+QMTUNS:",    AT_DEVICE_MQTT_EVENT_UNS},
+    {"+QMTPUB:",    AT_DEVICE_MQTT_EVENT_PUB},
+    {"+QMTPUBEX:",  AT_DEVICE_MQTT_EVENT_PUB},
+};
+
+static struct at_device *at_device_mqtt_get_device(struct at_client *client)
+{
+    struct at_device *device = RT_NULL;
+    char *client_name = client->device->parent.name;
+
+    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    if (device == RT_NULL || device->mqtt == RT_NULL)
+    {
+        LOG_E("get device(%s) failed.", client_name);
+        return RT_NULL;
+    }
+
+    return device;
+}
+
+/* wait for the result URC of the command sent, the device is not taken during waiting */
+static int at_device_mqtt_wait(struct at_device *device, rt_uint32_t event, rt_int32_t timeout)
+{
+    if (rt_event_recv(&(device->mqtt->event), event, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                      timeout * RT_TICK_PER_SECOND, RT_NULL) != RT_EOK)
+    {
+        LOG_E("%s device wait MQTT result timeout.", device->name);
+        return -RT_ETIMEOUT;
+    }
+
+    return RT_EOK;
+}
+
+/* close the network, it is also used to clean up the failed connect */
+static void at_device_mqtt_close(struct at_device *device, at_response_t resp)
+{
+    struct at_device_mqtt *mqtt = device->mqtt;
+
+    at_device_sched_take(device, AT_DEVICE_CMD_CONTROL, RT_WAITING_FOREVER);
+    rt_event_recv(&(mqtt->event), AT_DEVICE_MQTT_EVENT_CLOSE, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR, 0, RT_NULL);
+    if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QMTCLOSE=%d", AT_DEVICE_MQTT_CLIENT_IDX) == RT_EOK)
+    {
+        at_device_sched_release(device);
+        at_device_mqtt_wait(device, AT_DEVICE_MQTT_EVENT_CLOSE, AT_DEVICE_MQTT_TIMEOUT);
+    }
+    else
+    {
+        at_device_sched_release(device);
+    }
+
+    mqtt->state = AT_DEVICE_MQTT_STATE_CLOSED;
+}
+
+/**
+ * This function will open the network and connect the MQTT session, the
+ * keepalive is handled by module.
+ *
+ * @param device the AT device
+ * @param cfg the connection configuration
+ *
+ * @return  0: connect success
+ *         -1: send AT commands error or connect failed
+ *         -2: wait result timeout
+ *         -5: no memory
+ */
+int at_device_mqtt_connect(struct at_device *device, const struct at_device_mqtt_cfg *cfg)
+{
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+    struct at_device_mqtt *mqtt = device->mqtt;
+
+    RT_ASSERT(cfg && cfg->host && cfg->client_id);
+
+    if (mqtt == RT_NULL)
+    {
+        LOG_E("%s device MQTT client is not initialized.", device->name);
+        return -RT_ERROR;
+    }
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    rt_mutex_take(&(mqtt->lock), RT_WAITING_FOREVER);
+    at_device_sched_take(device, AT_DEVICE_CMD_CONTROL, RT_WAITING_FOREVER);
+
+    /* MQTT v3.1.1 */
+    if (at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QMTCFG=\"version\",%d,4",
+                        AT_DEVICE_MQTT_CLIENT_IDX) < 0 ||
+            at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QMTCFG=\"keepalive\",%d,%d",
+                            AT_DEVICE_MQTT_CLIENT_IDX, cfg->keepalive ? cfg->keepalive : 120) < 0 ||
+            at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QMTCFG=\"session\",%d,%d",
+                            AT_DEVICE_MQTT_CLIENT_IDX, cfg->clean_session ? 1 : 0) < 0)
+    {
+        at_device_sched_release(device);
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    /* report the payload length in "+QMTRECV", the old firmware reports the payload only */
+    at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QMTCFG=\"recv/mode\",%d,0,1", AT_DEVICE_MQTT_CLIENT_IDX);
+
+    /* +QMTOPEN: <client_idx>,<result> */
+    rt_event_recv(&(mqtt->event), AT_DEVICE_MQTT_EVENT_ALL, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR, 0, RT_NULL);
+    result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QMTOPEN=%d,\"%s\",%d",
+                             AT_DEVICE_MQTT_CLIENT_IDX, cfg->host, cfg->port > 0 ? cfg->port : 1883);
+    at_device_sched_release(device);
+    if (result < 0 || (result = at_device_mqtt_wait(device, AT_DEVICE_MQTT_EVENT_OPEN, AT_DEVICE_MQTT_OPEN_TIMEOUT)) < 0)
+    {
+        goto __exit;
+    }
+
+    if (mqtt->result[1] != 0)
+    {
+        LOG_E("%s device MQTT open %s:%d failed(%d).", device->name, cfg->host, cfg->port, mqtt->result[1]);
+        result = -RT_ERROR;
+        goto __exit;
+    }
+    mqtt->state = AT_DEVICE_MQTT_STATE_OPENED;
+
+    /* +QMTCONN: <client_idx>,<result>[,<ret_code>] */
+    at_device_sched_take(device, AT_DEVICE_CMD_CONTROL, RT_WAITING_FOREVER);
+    if (cfg->user)
+    {
+        result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QMTCONN=%d,\"%s\",\"%s\",\"%s\"",
+                                 AT_DEVICE_MQTT_CLIENT_IDX, cfg->client_id, cfg->user, cfg->password ? cfg->password : "");
+    }
+    else
+    {
+        result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QMTCONN=%d,\"%s\"",
+                                 AT_DEVICE_MQTT_CLIENT_IDX, cfg->client_id);
+    }
+    at_device_sched_release(device);
+    if (result < 0 || (result = at_device_mqtt_wait(device, AT_DEVICE_MQTT_EVENT_CONN, AT_DEVICE_MQTT_TIMEOUT)) < 0)
+    {
+        at_device_mqtt_close(device, resp);
+        goto __exit;
+    }
+
+    if (mqtt->result[1] != 0 || mqtt->result[2] != 0)
+    {
+        LOG_E("%s device MQTT connect failed(%d), return code(%d).", device->name, mqtt->result[1], mqtt->result[2]);
+        at_device_mqtt_close(device, resp);
+        result = -RT_ERROR;
+        goto __exit;
+    }
+    mqtt->state = AT_DEVICE_MQTT_STATE_CONNECTED;
+
+__exit:
+    rt_mutex_release(&(mqtt->lock));
+
+    at_delete_resp(resp);
+
+    return result;
+}
+
+/**
+ * This function will disconnect the MQTT session and close the network.
+ *
+ * @param device the AT device
+ *
+ * @return  0: disconnect success
+ *         -5: no memory
+ */
+int at_device_mqtt_disconnect(struct at_device *device)
+{
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+    struct at_device_mqtt *mqtt = device->mqtt;
+
+    RT_ASSERT(mqtt);
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    rt_mutex_take(&(mqtt->lock), RT_WAITING_FOREVER);
+
+    /* the module closes the network after the disconnect */
+    if (mqtt->state == AT_DEVICE_MQTT_STATE_CONNECTED)
+    {
+        at_device_sched_take(device, AT_DEVICE_CMD_CONTROL, RT_WAITING_FOREVER);
+        rt_event_recv(&(mqtt->event), AT_DEVICE_MQTT_EVENT_DISC, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR, 0, RT_NULL);
+        result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QMTDISC=%d", AT_DEVICE_MQTT_CLIENT_IDX);
+        at_device_sched_release(device);
+        if (result == RT_EOK && at_device_mqtt_wait(device, AT_DEVICE_MQTT_EVENT_DISC, AT_DEVICE_MQTT_TIMEOUT) == RT_EOK)
+        {
+            mqtt->state = AT_DEVICE_MQTT_STATE_CLOSED;
+        }
+    }
+
+    if (mqtt->state != AT_DEVICE_MQTT_STATE_CLOSED)
+    {
+        at_device_mqtt_close(device, resp);
+    }
+
+    rt_mutex_release(&(mqtt->lock));
+
+    at_delete_resp(resp);
+
+    return RT_EOK;
+}
+
+/* subscribe or unsubscribe the topic, the result is "+QMTSUB/+QMTUNS: <client_idx>,<msgid>,<result>" */
+static int at_device_mqtt_sub(struct at_device *device, const char *topic, int qos)
+{
+    int result = RT_EOK;
+    rt_uint16_t msgid = 0;
+    rt_uint32_t event = (qos < 0) ? AT_DEVICE_MQTT_EVENT_UNS : AT_DEVICE_MQTT_EVENT_SUB;
+    at_response_t resp = RT_NULL;
+    struct at_device_mqtt *mqtt = device->mqtt;
+
+    RT_ASSERT(mqtt);
+    RT_ASSERT(topic);
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    rt_mutex_take(&(mqtt->lock), RT_WAITING_FOREVER);
+    if (mqtt->state != AT_DEVICE_MQTT_STATE_CONNECTED)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    /* the SUBSCRIBE and UNSUBSCRIBE message identifier is not 0 */
+    msgid = (++mqtt->msgid) ? mqtt->msgid : ++mqtt->msgid;
+
+    at_device_sched_take(device, AT_DEVICE_CMD_CONTROL, RT_WAITING_FOREVER);
+    rt_event_recv(&(mqtt->event), event, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR, 0, RT_NULL);
+    if (qos < 0)
+    {
+        result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QMTUNS=%d,%d,\"%s\"",
+                                 AT_DEVICE_MQTT_CLIENT_IDX, msgid, topic);
+    }
+    else
+    {
+        result = at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, "AT+QMTSUB=%d,%d,\"%s\",%d",
+                                 AT_DEVICE_MQTT_CLIENT_IDX, msgid, topic, qos);
+    }
+    at_device_sched_release(device);
+    if (result < 0 || (result = at_device_mqtt_wait(device, event, AT_DEVICE_MQTT_TIMEOUT)) < 0)
+    {
+        goto __exit;
+    }
+
+    if (mqtt->result[1] != msgid || mqtt->result[2] != 0)
+    {
+        LOG_E("%s device MQTT %s topic(%s) failed(%d).", device->name, (qos < 0) ? "unsubscribe" : "subscribe",
+              topic, mqtt->result[2]);
+        result = -RT_ERROR;
+    }
+
+__exit:
+    rt_mutex_release(&(mqtt->lock));
+
+    at_delete_resp(resp);
+
+    return result;
+}
+
+int at_device_mqtt_subscribe(struct at_device *device, const char *topic, rt_uint8_t qos)
+{
+    RT_ASSERT(qos <= 2);
+
+    return at_device_mqtt_sub(device, topic, qos);
+}
+
+int at_device_mqtt_unsubscribe(struct at_device *device, const char *topic)
+{
+    return at_device_mqtt_sub(device, topic, -1);
+}
+
+/* send the publishes in one data command take, the broker results are not waited */
+static rt_size_t at_device_mqtt_pub_send(struct at_device *device, const struct at_device_mqtt_msg *msgs,
+                                         rt_size_t num, at_response_t resp, at_response_t ok_resp)
+{
+    rt_size_t i = 0;
+    rt_uint16_t msgid = 0;
+    struct at_device_mqtt *mqtt = device->mqtt;
+    struct at_client *client = AT_DEVICE_CTRL_CLIENT(device);
+
+    at_device_sched_take(device, AT_DEVICE_CMD_DATA, RT_WAITING_FOREVER);
+    at_obj_set_end_sign(client, '>');
+
+    for (i = 0; i < num; i++)
+    {
+        RT_ASSERT(msgs[i].topic && msgs[i].qos <= 2);
+
+        /* the QoS 0 message identifier is 0 */
+        msgid = 0;
+        if (msgs[i].qos > 0)
+        {
+            msgid = (++mqtt->msgid) ? mqtt->msgid : ++mqtt->msgid;
+        }
+
+        mqtt->pub_msgid[i] = msgid;
+        mqtt->pub_result[i] = -1;
+        mqtt->pub_num = i + 1;
+
+        if (at_obj_exec_cmd(client, resp, mqtt->dialect->pub, AT_DEVICE_MQTT_CLIENT_IDX, msgid,
+                            msgs[i].qos, msgs[i].retain ? 1 : 0, msgs[i].topic, (int) msgs[i].len) < 0)
+        {
+            break;
+        }
+
+        /* the "OK" follows the payload, send the last byte with waiting it, so it is not taken
+           as the response of the next publish, the line end after it is ignored by module */
+        if (msgs[i].len > 1 && at_client_obj_send(client, msgs[i].payload, msgs[i].len - 1) != msgs[i].len - 1)
+        {
+            break;
+        }
+        if (msgs[i].len > 0 && at_obj_exec_cmd(client, ok_resp, "%c", msgs[i].payload[msgs[i].len - 1]) < 0)
+        {
+            break;
+        }
+    }
+
+    at_obj_set_end_sign(client, 0);
+    at_device_sched_release(device);
+
+    if (i < num)
+    {
+        LOG_E("%s device MQTT publish topic(%s) send failed.", device->name, msgs[i].topic);
+        mqtt->pub_num = i;
+    }
+
+    return i;
+}
+
+/* wait for the result URCs of the publishes sent, out of the device take */
+static int at_device_mqtt_pub_wait(struct at_device *device)
+{
+    rt_size_t i = 0;
+    rt_tick_t start = rt_tick_get(), elapsed = 0;
+    rt_tick_t timeout = rt_tick_from_millisecond(AT_DEVICE_MQTT_TIMEOUT * 1000);
+    struct at_device_mqtt *mqtt = device->mqtt;
+
+    while (1)
+    {
+        for (i = 0; i < mqtt->pub_num && mqtt->pub_result[i] >= 0; i++);
+        if (i == mqtt->pub_num)
+        {
+            return RT_EOK;
+        }
+
+        elapsed = rt_tick_get() - start;
+        if (elapsed >= timeout || rt_event_recv(&(mqtt->event), AT_DEVICE_MQTT_EVENT_PUB,
+                RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR, timeout - elapsed, RT_NULL) != RT_EOK)
+        {
+            LOG_E("%s device wait MQTT publish result timeout.", device->name);
+            return -RT_ETIMEOUT;
+        }
+    }
+}
+
+/**
+ * This function will publish the messages. Up to AT_DEVICE_MQTT_PUB_WINDOW
+ * messages are sent in one device take, then the broker results are waited
+ * out of the take, so the result round trips are not serialized and the other
+ * commands are not blocked. The messages after the first failed one are not
+ * counted as published.
+ *
+ * @param device the AT device
+ * @param msgs the messages
+ * @param num the number of messages
+ *
+ * @return >0: the number of messages published
+ *         -1: send AT commands error or the first message publish failed
+ *         -2: wait result timeout
+ *         -5: no memory
+ */
+int at_device_mqtt_publish_batch(struct at_device *device, const struct at_device_mqtt_msg *msgs, rt_size_t num)
+{
+    int result = RT_EOK;
+    rt_size_t i = 0, sent = 0, count = 0, published = 0;
+    at_response_t resp = RT_NULL, ok_resp = RT_NULL;
+    struct at_device_mqtt *mqtt = device->mqtt;
+
+    RT_ASSERT(mqtt);
+    RT_ASSERT(msgs && num > 0);
+
+    /* receive the '>' response on the first line, and the "OK" after the payload */
+    resp = at_create_resp(64, 2, rt_tick_from_millisecond(5000));
+    ok_resp = at_create_resp(64, 0, rt_tick_from_millisecond(5000));
+    if (resp == RT_NULL || ok_resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        result = -RT_ENOMEM;
+        goto __free;
+    }
+
+    rt_mutex_take(&(mqtt->lock), RT_WAITING_FOREVER);
+    if (mqtt->state != AT_DEVICE_MQTT_STATE_CONNECTED)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    while (published < num)
+    {
+        count = (num - published > AT_DEVICE_MQTT_PUB_WINDOW) ? AT_DEVICE_MQTT_PUB_WINDOW : num - published;
+
+        mqtt->pub_num = 0;
+        rt_event_recv(&(mqtt->event), AT_DEVICE_MQTT_EVENT_PUB, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR, 0, RT_NULL);
+
+        sent = at_device_mqtt_pub_send(device, msgs + published, count, resp, ok_resp);
+        if (sent < count)
+        {
+            result = -RT_ERROR;
+        }
+
+        /* +QMTPUB: <client_idx>,<msgid>,<result>[,<value>] */
+        if (sent > 0 && at_device_mqtt_pub_wait(device) < 0)
+        {
+            result = -RT_ETIMEOUT;
+        }
+
+        /* the messages are published in order until the first failed one */
+        for (i = 0; i < sent && mqtt->pub_result[i] >= 0 && mqtt->pub_result[i] != 2; i++);
+        if (i < sent && mqtt->pub_result[i] == 2)
+        {
+            LOG_E("%s device MQTT publish topic(%s) failed.", device->name, msgs[published + i].topic);
+            result = -RT_ERROR;
+        }
+        published += i;
+        mqtt->pub_num = 0;
+
+        if (i < count)
+        {
+            break;
+        }
+    }
+
+__exit:
+    rt_mutex_release(&(mqtt->lock));
+
+__free:
+    if (resp)
+    {
+        at_delete_resp(resp);
+    }
+    if (ok_resp)
+    {
+        at_delete_resp(ok_resp);
+    }
+
+    return (published > 0) ? (int) published : result;
+}
+
+int at_device_mqtt_publish(struct at_device *device, const struct at_device_mqtt_msg *msg)
+{
+    int result = at_device_mqtt_publish_batch(device, msg, 1);
+
+    return (result > 0) ? RT_EOK : result;
+}
+
+int at_device_mqtt_state(struct at_device *device)
+{
+    return device->mqtt ? device->mqtt->state : AT_DEVICE_MQTT_STATE_CLOSED;
+}
+
+void at_device_mqtt_set_recv_cb(struct at_device *device, at_device_mqtt_recv_cb_t cb, void *user_data)
+{
+    RT_ASSERT(device->mqtt);
+
+    device->mqtt->user_data = user_data;
+    device->mqtt->recv_cb = cb;
+}
+
+/* save the publish result to the first waiting publish with the message identifier */
+static void urc_pub_result(struct at_device_mqtt *mqtt)
+{
+    rt_size_t i = 0;
+
+    for (i = 0; i < mqtt->pub_num; i++)
+    {
+        if (mqtt->pub_result[i] < 0 && mqtt->pub_msgid[i] == (rt_uint16_t) mqtt->result[1])
+        {
+            mqtt->pub_result[i] = (rt_int8_t) mqtt->result[2];
+            break;
+        }
+    }
+}
+
+static void urc_result_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    rt_size_t i = 0;
+    int value = 0;
+    struct at_device_parser parser;
+    struct at_device *device = RT_NULL;
+    struct at_device_mqtt *mqtt = RT_NULL;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_mqtt_get_device(client);
+    if (device == RT_NULL)
+    {
+        return;
+    }
+    mqtt = device->mqtt;
+
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_skip_to(&parser, ':') < 0)
+    {
+        return;
+    }
+
+    rt_memset(mqtt->result, 0x00, sizeof(mqtt->result));
+    for (i = 0; i < sizeof(mqtt->result) / sizeof(mqtt->result[0]); i++)
+    {
+        if (at_device_parser_int(&parser, &value) < 0)
+        {
+            break;
+        }
+        mqtt->result[i] = value;
+    }
+
+    for (i = 0; i < sizeof(mqtt_result_map) / sizeof(mqtt_result_map[0]); i++)
+    {
+        if (strncmp(data, mqtt_result_map[i].prefix, rt_strlen(mqtt_result_map[i].prefix)) == 0)
+        {
+            if (mqtt_result_map[i].event == AT_DEVICE_MQTT_EVENT_PUB)
+            {
+                urc_pub_result(mqtt);
+            }
+            rt_event_send(&(mqtt->event), mqtt_result_map[i].event);
+            break;
+        }
+    }
+}
+
+/* +QMTSTAT: <client_idx>,<err_code>, the module closed the network */
+static void urc_stat_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    int idx = 0, err = 0;
+    struct at_device_parser parser;
+    struct at_device *device = RT_NULL;
+    struct at_device_mqtt *mqtt = RT_NULL;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_mqtt_get_device(client);
+    if (device == RT_NULL)
+    {
+        return;
+    }
+    mqtt = device->mqtt;
+
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+QMTSTAT:") < 0 ||
+            at_device_parser_int(&parser, &idx) < 0 || at_device_parser_int(&parser, &err) < 0)
+    {
+        return;
+    }
+
+    LOG_W("%s device MQTT client(%d) link state changed(%d), reconnect is required.", device->name, idx, err);
+    mqtt->state = AT_DEVICE_MQTT_STATE_CLOSED;
+}
+
+/* +QMTRECV: <client_idx>,<msgid>,"<topic>"[,<payload_len>],"<payload>" */
+static void urc_recv_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    int idx = 0, msgid = 0, len = -1;
+    rt_int32_t timeout;
+    rt_size_t avail = 0, copy = 0, pos = 0, drain = 0;
+    const char *payload = RT_NULL;
+    char temp[8] = {0};
+    struct at_device_parser parser;
+    struct at_device *device = RT_NULL;
+    struct at_device_mqtt *mqtt = RT_NULL;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_mqtt_get_device(client);
+    if (device == RT_NULL)
+    {
+        return;
+    }
+    mqtt = device->mqtt;
+
+    at_device_parser_init(&parser, data, size);
+    if (at_device_parser_expect(&parser, "+QMTRECV:") < 0 ||
+            at_device_parser_int(&parser, &idx) < 0 || at_device_parser_int(&parser, &msgid) < 0 ||
+            at_device_parser_str(&parser, mqtt->topic, sizeof(mqtt->topic)) < 0)
+    {
+        LOG_E("MQTT message topic parse failed or too long.");
+        return;
+    }
+
+    if (at_device_parser_int(&parser, &len) < 0)
+    {
+        len = -1;
+    }
+
+    if (at_device_parser_expect(&parser, "\"") < 0)
+    {
+        return;
+    }
+    payload = data + parser.pos;
+    avail = size - parser.pos;
+
+    if (len < 0)
+    {
+        /* no length reported, the payload ends at the last quote */
+        payload = at_device_parser_rest(&parser, &avail);
+        len = (avail > 0 && payload[avail - 1] == '"') ? (int) avail - 1 : (int) avail;
+        avail = len + 3;
+    }
+
+    copy = ((rt_size_t) len < sizeof(mqtt->payload)) ? (rt_size_t) len : sizeof(mqtt->payload) - 1;
+    if (copy < (rt_size_t) len)
+    {
+        LOG_W("MQTT message(%d) is truncated to %d bytes.", len, copy);
+    }
+
+    /* the line has the payload, the closing quote and the line end */
+    if (avail >= (rt_size_t) len + 3)
+    {
+        rt_memcpy(mqtt->payload, payload, copy);
+    }
+    else
+    {
+        /* the line end in the payload ended the URC line, read the rest of the payload */
+        timeout = len > 10 ? len : 10;
+        if (avail < copy)
+        {
+            rt_memcpy(mqtt->payload, payload, avail);
+            at_client_obj_recv(client, mqtt->payload + avail, copy - avail, timeout);
+            pos = copy;
+        }
+        else
+        {
+            rt_memcpy(mqtt->payload, payload, copy);
+            pos = avail;
+        }
+
+        /* read and clean the truncated payload, the closing quote and the line end */
+        while (pos < (rt_size_t) len + 3)
+        {
+            drain = ((rt_size_t) len + 3 - pos > sizeof(temp)) ? sizeof(temp) : (rt_size_t) len + 3 - pos;
+            at_client_obj_recv(client, temp, drain, timeout);
+            pos += drain;
+        }
+    }
+    mqtt->payload[copy] = '\0';
+
+    if (mqtt->recv_cb)
+    {
+        mqtt->recv_cb(device, mqtt->topic, mqtt->payload, copy, mqtt->user_data);
+    }
+}
+
+static const struct at_urc mqtt_urc_table[] =
+{
+    {"+QMTOPEN:",   "\r\n",                 urc_result_func},
+    {"+QMTCLOSE:",  "\r\n",                 urc_result_func},
+    {"+QMTCONN:",   "\r\n",                 urc_result_func},
+    {"+QMTDISC:",   "\r\n",                 urc_result_func},
+    {"+QMTSUB:",    "\r\n",                 urc_result_func},
+    {"+QMTUNS:",    "\r\n",                 urc_result_func},
+    {"+QMTPUB:",    "\r\n",                 urc_result_func},
+    {"+QMTPUBEX:",  "\r\n",                 urc_result_func},
+    {"+QMTSTAT:",   "\r\n",                 urc_stat_func},
+    {"+QMTRECV:",   "\r\n",                 urc_recv_func},
+};
+
+/**
+ * This function will prepare the MQTT client of the device, it is called by
+ * the device class after the control client is ready, and again when the
+ * control client changed.
+ *
+ * @param device the AT device
+ * @param dialect the module MQTT commands dialect
+ *
+ * @return  0: initialize success
+ *         -5: no memory
+ */
+int at_device_mqtt_init(struct at_device *device, const struct at_device_mqtt_dialect *dialect)
+{
+    struct at_device_mqtt *mqtt = device->mqtt;
+
+    RT_ASSERT(device);
+    RT_ASSERT(dialect && dialect->pub);
+
+    if (mqtt == RT_NULL)
+    {
+        mqtt = (struct at_device_mqtt *) rt_calloc(1, sizeof(struct at_device_mqtt));
+        if (mqtt == RT_NULL)
+        {
+            LOG_E("no memory for %s device MQTT client create.", device->name);
+            return -RT_ENOMEM;
+        }
+        rt_mutex_init(&(mqtt->lock), "at_mqtt", RT_IPC_FLAG_PRIO);
+        rt_event_init(&(mqtt->event), "at_mqtt", RT_IPC_FLAG_PRIO);
+        mqtt->dialect = dialect;
+        device->mqtt = mqtt;
+    }
+
+    /* the module is re-initialized, the session is lost */
+    mqtt->state = AT_DEVICE_MQTT_STATE_CLOSED;
+
+    if (mqtt->client != AT_DEVICE_CTRL_CLIENT(device))
+    {
+        mqtt->client = AT_DEVICE_CTRL_CLIENT(device);
+        return at_device_urc_set_table(mqtt->client, mqtt_urc_table, sizeof(mqtt_urc_table) / sizeof(mqtt_urc_table[0]));
+    }
+
+    return RT_EOK;
+}
+
+#endif /* AT_DEVICE_USING_MQTT */
@@ -0,0 +1,454 @@
+/*
+ * File      : at_device_parser.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#include <at_device_parser.h>
+
+#define PARSER_CUR(parser)             ((parser)->buf[(parser)->pos])
+#define PARSER_END(parser)             ((parser)->pos >= (parser)->size)
+
+static int hex_value(char ch)
+{
+    if (ch >= '0' && ch <= '9')
+    {
+        return ch - '0';
+    }
+    else if (ch >= 'A' && ch <= 'F')
+    {
+        return ch - 'A' + 10;
+    }
+    else if (ch >= 'a' && ch <= 'f')
+    {
+        return ch - 'a' + 10;
+    }
+
+    return -1;
+}
+
+static rt_bool_t is_line_end(char ch)
+{
+    return (ch == '\r' || ch == '\n' || ch == '\0');
+}
+
+static void parser_skip_space(struct at_device_parser *parser)
+{
+    while (!PARSER_END(parser) && PARSER_CUR(parser) == ' ')
+    {
+        parser->pos++;
+    }
+}
+
+/* finish one field, skip the tailing spaces and field separator */
+static void parser_field_end(struct at_device_parser *parser)
+{
+    parser_skip_space(parser);
+    if (!PARSER_END(parser) && PARSER_CUR(parser) == ',')
+    {
+        parser->pos++;
+    }
+}
+
+/**
+ * This function will initialize the parser.
+ *
+ * @param parser the parser object
+ * @param buf the line buffer
+ * @param size the line buffer size
+ */
+void at_device_parser_init(struct at_device_parser *parser, const char *buf, rt_size_t size)
+{
+    RT_ASSERT(parser);
+    RT_ASSERT(buf);
+
+    parser->buf = buf;
+    parser->size = size;
+    parser->pos = 0;
+}
+
+/**
+ * This function will skip the literal string, the spaces before it are skipped,
+ * a space in the string matches zero or more spaces, the same as scanf.
+ *
+ * @param parser the parser object
+ * @param str the literal string
+ *
+ * @return  0: skip success
+ *         -1: the string is not matched, the position is not changed
+ */
+int at_device_parser_expect(struct at_device_parser *parser, const char *str)
+{
+    rt_size_t pos = parser->pos;
+
+    parser_skip_space(parser);
+    for (; *str; str++)
+    {
+        if (*str == ' ')
+        {
+            parser_skip_space(parser);
+            continue;
+        }
+
+        if (PARSER_END(parser) || PARSER_CUR(parser) != *str)
+        {
+            parser->pos = pos;
+            return -RT_ERROR;
+        }
+        parser->pos++;
+    }
+
+    return RT_EOK;
+}
+
+/**
+ * This function will skip over the next specified character.
+ *
+ * @param parser the parser object
+ * @param ch the character
+ *
+ * @return  0: skip success
+ *         -1: the character is not found, the position is not changed
+ */
+int at_device_parser_skip_to(struct at_device_parser *parser, char ch)
+{
+    rt_size_t pos = parser->pos;
+
+    for (; pos < parser->size; pos++)
+    {
+        if (parser->buf[pos] == ch)
+        {
+            parser->pos = pos + 1;
+            return RT_EOK;
+        }
+    }
+
+    return -RT_ERROR;
+}
+
+/**
+ * This function will parse a decimal integer field.
+ *
+ * @param parser the parser object
+ * @param value the parsed value
+ *
+ * @return  0: parse success
+ *         -1: no digit or overflow, the position is not changed
+ */
+int at_device_parser_int(struct at_device_parser *parser, int *value)
+{
+    rt_bool_t negative = RT_FALSE;
+    rt_size_t pos = parser->pos, digits = 0;
+    unsigned int result = 0, limit = 0x7FFFFFFFU;
+
+    RT_ASSERT(value);
+
+    parser_skip_space(parser);
+    if (!PARSER_END(parser) && (PARSER_CUR(parser) == '-' || PARSER_CUR(parser) == '+'))
+    {
+        negative = (PARSER_CUR(parser) == '-');
+        parser->pos++;
+    }
+
+    if (negative)
+    {
+        limit++;
+    }
+
+    for (; !PARSER_END(parser) && PARSER_CUR(parser) >= '0' && PARSER_CUR(parser) <= '9'; parser->pos++, digits++)
+    {
+        unsigned int digit = (unsigned int) (PARSER_CUR(parser) - '0');
+
+        if (result > (limit - digit) / 10)
+        {
+            parser->pos = pos;
+            return -RT_ERROR;
+        }
+        result = result * 10 + digit;
+    }
+
+    if (digits == 0)
+    {
+        parser->pos = pos;
+        return -RT_ERROR;
+    }
+
+    *value = negative ? (int) (0U - result) : (int) result;
+    parser_field_end(parser);
+
+    return RT_EOK;
+}
+
+/**
+ * This function will parse a non-negative decimal size field.
+ *
+ * @param parser the parser object
+ * @param value the parsed value
+ *
+ * @return  0: parse success
+ *         -1: no digit, negative or overflow, the position is not changed
+ */
+int at_device_parser_size(struct at_device_parser *parser, rt_size_t *value)
+{
+    int result = 0;
+    rt_size_t pos = parser->pos;
+
+    RT_ASSERT(value);
+
+    if (at_device_parser_int(parser, &result) < 0 || result < 0)
+    {
+        parser->pos = pos;
+        return -RT_ERROR;
+    }
+
+    *value = (rt_size_t) result;
+
+    return RT_EOK;
+}
+
+/**
+ * This function will parse a string field, the quoted string ends at the closing
+ * quote and the unquoted string ends at ',' or line end.
+ *
+ * @param parser the parser object
+ * @param str the string buffer, it is always '\0' terminated when success
+ * @param size the string buffer size
+ *
+ * @return >=0: the string length
+ *          -1: the string is not closed, too long or has '\0', the position is not changed
+ */
+int at_device_parser_str(struct at_device_parser *parser, char *str, rt_size_t size)
+{
+    rt_size_t pos = parser->pos, len = 0;
+    rt_bool_t quoted = RT_FALSE;
+
+    RT_ASSERT(str && size > 0);
+
+    parser_skip_space(parser);
+    if (!PARSER_END(parser) && PARSER_CUR(parser) == '"')
+    {
+        quoted = RT_TRUE;
+        parser->pos++;
+    }
+
+    for (; !PARSER_END(parser); parser->pos++)
+    {
+        char ch = PARSER_CUR(parser);
+
+        if ((quoted && ch == '"') || (!quoted && (ch == ',' || is_line_end(ch))))
+        {
+            break;
+        }
+
+        /* the '\0' in the quoted string can not be returned in the C string */
+        if (ch == '\0')
+        {
+            parser->pos = pos;
+            return -RT_ERROR;
+        }
+
+        if (len + 1 >= size)
+        {
+            parser->pos = pos;
+            return -RT_ERROR;
+        }
+        str[len++] = ch;
+    }
+
+    if (quoted)
+    {
+        if (PARSER_END(parser))
+        {
+            parser->pos = pos;
+            return -RT_ERROR;
+        }
+        /* skip the closing quote */
+        parser->pos++;
+    }
+    else
+    {
+        /* remove the tailing spaces */
+        while (len > 0 && str[len - 1] == ' ')
+        {
+            len--;
+        }
+    }
+
+    str[len] = '\0';
+    parser_field_end(parser);
+
+    return (int) len;
+}
+
+/**
+ * This function will parse an IPv4 address field, quoted or unquoted.
+ *
+ * @param parser the parser object
+ * @param ip the IPv4 address string
+ *
+ * @return  0: parse success
+ *         -1: not a valid IPv4 address, the position is not changed
+ */
+int at_device_parser_ipv4(struct at_device_parser *parser, char ip[16])
+{
+    int i = 0, dots = 0, value = -1;
+    rt_size_t pos = parser->pos;
+
+    if (at_device_parser_str(parser, ip, 16) < 0)
+    {
+        return -RT_ERROR;
+    }
+
+    for (i = 0; ; i++)
+    {
+        if (ip[i] >= '0' && ip[i] <= '9')
+        {
+            value = (value < 0 ? 0 : value * 10) + (ip[i] - '0');
+            if (value > 255)
+            {
+                break;
+            }
+        }
+        else if ((ip[i] == '.' || ip[i] == '\0') && value >= 0)
+        {
+            value = -1;
+            if (ip[i] == '\0')
+            {
+                if (dots == 3)
+                {
+                    return RT_EOK;
+                }
+                break;
+            }
+            dots++;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    ip[0] = '\0';
+    parser->pos = pos;
+
+    return -RT_ERROR;
+}
+
+/**
+ * This function will skip one field, quoted or unquoted.
+ *
+ * @param parser the parser object
+ *
+ * @return  0: skip success
+ *         -1: the quoted field is not closed, the position is not changed
+ */
+int at_device_parser_skip(struct at_device_parser *parser)
+{
+    rt_size_t pos = parser->pos;
+    rt_bool_t quoted = RT_FALSE;
+
+    parser_skip_space(parser);
+    if (!PARSER_END(parser) && PARSER_CUR(parser) == '"')
+    {
+        quoted = RT_TRUE;
+        parser->pos++;
+        if (at_device_parser_skip_to(parser, '"') < 0)
+        {
+            parser->pos = pos;
+            return -RT_ERROR;
+        }
+    }
+
+    while (!quoted && !PARSER_END(parser) && PARSER_CUR(parser) != ',' && !is_line_end(PARSER_CUR(parser)))
+    {
+        parser->pos++;
+    }
+    parser_field_end(parser);
+
+    return RT_EOK;
+}
+
+/**
+ * This function will decode the hex string field to binary data.
+ *
+ * @param parser the parser object
+ * @param data the binary data buffer
+ * @param size the binary data size, the hex string length must be not less than size * 2
+ *
+ * @return  0: decode success
+ *         -1: the hex string is too short or invalid, the position is not changed
+ */
+int at_device_parser_hex(struct at_device_parser *parser, char *data, rt_size_t size)
+{
+    int high, low;
+    rt_size_t i, pos = parser->pos;
+
+    RT_ASSERT(data || size == 0);
+
+    parser_skip_space(parser);
+    if (parser->size - parser->pos < size * 2)
+    {
+        parser->pos = pos;
+        return -RT_ERROR;
+    }
+
+    for (i = 0; i < size; i++)
+    {
+        high = hex_value(parser->buf[parser->pos + i * 2]);
+        low = hex_value(parser->buf[parser->pos + i * 2 + 1]);
+        if (high < 0 || low < 0)
+        {
+            parser->pos = pos;
+            return -RT_ERROR;
+        }
+        data[i] = (char) ((high << 4) | low);
+    }
+
+    parser->pos += size * 2;
+    parser_field_end(parser);
+
+    return RT_EOK;
+}
+
+/**
+ * This function will get the rest of line, the tailing CR/LF is not included.
+ *
+ * @param parser the parser object
+ * @param size the rest size
+ *
+ * @return the rest of line
+ */
+const char *at_device_parser_rest(struct at_device_parser *parser, rt_size_t *size)
+{
+    rt_size_t end = parser->size;
+
+    while (end > parser->pos && is_line_end(parser->buf[end - 1]))
+    {
+        end--;
+    }
+
+    if (size)
+    {
+        *size = end - parser->pos;
+    }
+
+    return parser->buf + parser->pos;
+}
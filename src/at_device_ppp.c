@@ -0,0 +1,431 @@
+/*
+ * File      : at_device_ppp.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#include <at_device_ppp.h>
+
+#if defined(RT_USING_LWIP) && defined(RT_LWIP_PPP)
+
+#include <lwip/init.h>
+#include <lwip/dns.h>
+#include <netif/ppp/pppapi.h>
+#include <netif/ppp/pppos.h>
+
+#define LOG_TAG                        "at.dev.ppp"
+#include <at_log.h>
+
+#define PPP_DIAL_TIMEOUT               (30 * 1000)
+#define PPP_RELEASE_TIMEOUT            (40 * 1000)
+#define PPP_LINK_TIMEOUT               (30 * 1000)
+
+#define PPP_EVENT_UP                   (1 << 0)
+#define PPP_EVENT_DOWN                 (1 << 1)
+
+struct at_device_ppp
+{
+    struct at_device *device;
+    const struct at_device_ppp_cfg *cfg;
+    rt_device_t serial;                          /* data channel device */
+    rt_err_t (*serial_rx_ind)(rt_device_t dev, rt_size_t size); /* data channel AT client receive indicate */
+    rt_sem_t rx_notice;
+    rt_event_t event;
+    rt_thread_t input;
+    ppp_pcb *pcb;
+    struct netif netif;
+    struct netdev netdev;                        /* lwIP network interface device of data call */
+    rt_slist_t list;
+};
+
+/* PPP list, the data channel receive indicate looks up the PPP by it */
+static rt_slist_t ppp_list = RT_SLIST_OBJECT_INIT(ppp_list);
+
+static rt_err_t ppp_serial_rx_ind(rt_device_t dev, rt_size_t size)
+{
+    rt_slist_t *node = RT_NULL;
+    struct at_device_ppp *ppp = RT_NULL;
+
+    rt_slist_for_each(node, &ppp_list)
+    {
+        ppp = rt_slist_entry(node, struct at_device_ppp, list);
+        if (ppp->serial == dev)
+        {
+            rt_sem_release(ppp->rx_notice);
+            break;
+        }
+    }
+
+    return RT_EOK;
+}
+
+static void ppp_input(void *parameter)
+{
+    rt_size_t len;
+    rt_uint8_t buf[64];
+    struct at_device_ppp *ppp = (struct at_device_ppp *) parameter;
+
+    while (1)
+    {
+        len = rt_device_read(ppp->serial, 0, buf, sizeof(buf));
+        if (len == 0)
+        {
+            rt_sem_take(ppp->rx_notice, RT_WAITING_FOREVER);
+            continue;
+        }
+
+        pppos_input_tcpip(ppp->pcb, buf, (int) len);
+    }
+}
+
+#if LWIP_VERSION >= 0x02010000
+static u32_t ppp_output(ppp_pcb *pcb, const void *data, u32_t len, void *ctx)
+#else
+static u32_t ppp_output(ppp_pcb *pcb, u8_t *data, u32_t len, void *ctx)
+#endif
+{
+    struct at_device_ppp *ppp = (struct at_device_ppp *) ctx;
+
+    return (u32_t) rt_device_write(ppp->serial, 0, data, len);
+}
+
+/* it runs in the lwIP TCP/IP thread */
+static void ppp_link_status(ppp_pcb *pcb, int err_code, void *ctx)
+{
+    struct at_device_ppp *ppp = (struct at_device_ppp *) ctx;
+    struct netdev *netdev = &(ppp->netdev);
+
+    if (err_code == PPPERR_NONE)
+    {
+        netdev_low_level_set_ipaddr(netdev, &(ppp->netif.ip_addr));
+        netdev_low_level_set_netmask(netdev, &(ppp->netif.netmask));
+        netdev_low_level_set_gw(netdev, &(ppp->netif.gw));
+        netdev_low_level_set_dns_server(netdev, 0, dns_getserver(0));
+        netdev_low_level_set_dns_server(netdev, 1, dns_getserver(1));
+        netdev_low_level_set_status(netdev, RT_TRUE);
+        netdev_low_level_set_link_status(netdev, RT_TRUE);
+
+        /* the sockets use the data call network interface from now on */
+        netif_set_default(&(ppp->netif));
+        netdev_set_default(netdev);
+
+        LOG_I("%s device PPP data call is up.", ppp->device->name);
+        rt_event_send(ppp->event, PPP_EVENT_UP);
+    }
+    else
+    {
+        netdev_low_level_set_link_status(netdev, RT_FALSE);
+        netdev_low_level_set_status(netdev, RT_FALSE);
+        if (ppp->device->netdev)
+        {
+            netdev_set_default(ppp->device->netdev);
+        }
+
+        if (err_code != PPPERR_USER)
+        {
+            LOG_W("%s device PPP data call is down(%d).", ppp->device->name, err_code);
+        }
+        rt_event_send(ppp->event, PPP_EVENT_DOWN);
+    }
+}
+
+static int ppp_netdev_set_up(struct netdev *netdev)
+{
+    struct at_device_ppp *ppp = rt_container_of(netdev, struct at_device_ppp, netdev);
+
+    return at_device_ppp_start(ppp->device, ppp->cfg);
+}
+
+static int ppp_netdev_set_down(struct netdev *netdev)
+{
+    struct at_device_ppp *ppp = rt_container_of(netdev, struct at_device_ppp, netdev);
+
+    return at_device_ppp_stop(ppp->device);
+}
+
+static const struct netdev_ops ppp_netdev_ops =
+{
+    ppp_netdev_set_up,
+    ppp_netdev_set_down,
+
+    RT_NULL,
+    RT_NULL,
+    RT_NULL,
+#ifdef NETDEV_USING_PING
+    RT_NULL,
+#endif
+    RT_NULL,
+};
+
+static struct at_device_ppp *ppp_create(struct at_device *device)
+{
+    char name[RT_NAME_MAX] = {0};
+    struct at_device_ppp *ppp = RT_NULL;
+
+    ppp = (struct at_device_ppp *) rt_calloc(1, sizeof(struct at_device_ppp));
+    if (ppp == RT_NULL)
+    {
+        LOG_E("no memory for PPP create.");
+        return RT_NULL;
+    }
+
+    rt_snprintf(name, RT_NAME_MAX, "ppp_%s", device->name);
+    ppp->device = device;
+    ppp->rx_notice = rt_sem_create(name, 0, RT_IPC_FLAG_FIFO);
+    ppp->event = rt_event_create(name, RT_IPC_FLAG_FIFO);
+    if (ppp->rx_notice == RT_NULL || ppp->event == RT_NULL)
+    {
+        LOG_E("no memory for PPP create.");
+        if (ppp->rx_notice)
+        {
+            rt_sem_delete(ppp->rx_notice);
+        }
+        if (ppp->event)
+        {
+            rt_event_delete(ppp->event);
+        }
+        rt_free(ppp);
+        return RT_NULL;
+    }
+    rt_slist_init(&(ppp->list));
+
+    ppp->netdev.mtu = 1500;
+    ppp->netdev.ops = &ppp_netdev_ops;
+#ifdef SAL_USING_LWIP
+    extern int sal_lwip_netdev_set_pf_info(struct netdev *netdev);
+    /* set the network interface socket/netdb operations */
+    sal_lwip_netdev_set_pf_info(&(ppp->netdev));
+#endif
+    netdev_register(&(ppp->netdev), name, &(ppp->netif));
+
+    return ppp;
+}
+
+/* give the data channel back to the AT client */
+static void ppp_channel_release(struct at_device_ppp *ppp)
+{
+    rt_base_t level;
+
+    if (ppp->input)
+    {
+        rt_thread_delete(ppp->input);
+        ppp->input = RT_NULL;
+    }
+
+    if (ppp->serial)
+    {
+        rt_device_set_rx_indicate(ppp->serial, ppp->serial_rx_ind);
+
+        level = rt_hw_interrupt_disable();
+        rt_slist_remove(&ppp_list, &(ppp->list));
+        rt_hw_interrupt_enable(level);
+
+        ppp->serial = RT_NULL;
+    }
+}
+
+/**
+ * This function will dial the PPP data call on the CMUX data channel and register
+ * the lwIP PPPoS network interface as the default network interface device. The
+ * AT commands keep working on the CMUX control channel, the AT sockets are not
+ * available until the data call stopped.
+ *
+ * @param device the AT device, CMUX mode is started
+ * @param cfg the PPP configuration
+ *
+ * @return  0: the data call is up
+ *         -1: dial or link negotiation failed
+ *         -2: link negotiation timeout
+ *         -5: no memory
+ */
+int at_device_ppp_start(struct at_device *device, const struct at_device_ppp_cfg *cfg)
+{
+    int result = RT_EOK;
+    rt_base_t level;
+    rt_uint32_t event = 0;
+    char name[RT_NAME_MAX] = {0};
+    at_response_t resp = RT_NULL;
+    struct at_device_ppp *ppp = RT_NULL;
+
+    RT_ASSERT(device);
+    RT_ASSERT(cfg && cfg->dial_cmd);
+
+    if (device->cmux == RT_NULL)
+    {
+        LOG_E("%s device PPP data call needs CMUX control channel.", device->name);
+        return -RT_ERROR;
+    }
+
+    if (device->ppp == RT_NULL)
+    {
+        device->ppp = ppp_create(device);
+        if (device->ppp == RT_NULL)
+        {
+            return -RT_ENOMEM;
+        }
+    }
+
+    ppp = device->ppp;
+    if (ppp->serial)
+    {
+        if (netdev_is_up(&(ppp->netdev)))
+        {
+            return RT_EOK;
+        }
+
+        /* the data call is terminated by network, hang up it and dial again */
+        at_device_ppp_stop(device);
+    }
+    ppp->cfg = cfg;
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(PPP_RELEASE_TIMEOUT));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    if (cfg->release_cmd)
+    {
+        at_obj_exec_cmd(AT_DEVICE_CTRL_CLIENT(device), resp, cfg->release_cmd);
+    }
+
+    /* the data call response is "CONNECT" line after an empty line */
+    at_resp_set_info(resp, 64, 2, rt_tick_from_millisecond(PPP_DIAL_TIMEOUT));
+    if (at_obj_exec_cmd(device->client, resp, cfg->dial_cmd) != RT_EOK ||
+            at_resp_get_line_by_kw(resp, "CONNECT") == RT_NULL)
+    {
+        LOG_E("%s device PPP dial failed.", device->name);
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    /* the data channel AT client never receives data after here, the PPP takes over it */
+    ppp->serial = device->client->device;
+    ppp->serial_rx_ind = ppp->serial->rx_indicate;
+    level = rt_hw_interrupt_disable();
+    rt_slist_append(&ppp_list, &(ppp->list));
+    rt_hw_interrupt_enable(level);
+    rt_device_set_rx_indicate(ppp->serial, ppp_serial_rx_ind);
+
+    if (ppp->pcb == RT_NULL)
+    {
+        ppp->pcb = pppapi_pppos_create(&(ppp->netif), ppp_output, ppp_link_status, ppp);
+        if (ppp->pcb == RT_NULL)
+        {
+            LOG_E("no memory for PPP control block create.");
+            result = -RT_ENOMEM;
+            goto __exit;
+        }
+        ppp_set_usepeerdns(ppp->pcb, 1);
+    }
+
+    rt_snprintf(name, RT_NAME_MAX, "ppp_%s", device->name);
+    ppp->input = rt_thread_create(name, ppp_input, ppp, AT_DEVICE_PPP_THREAD_STACK_SIZE,
+                                  AT_DEVICE_PPP_THREAD_PRIORITY, 5);
+    if (ppp->input == RT_NULL)
+    {
+        LOG_E("no memory for PPP input thread create.");
+        result = -RT_ENOMEM;
+        goto __exit;
+    }
+    rt_thread_startup(ppp->input);
+
+    rt_event_recv(ppp->event, PPP_EVENT_UP | PPP_EVENT_DOWN, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR, 0, RT_NULL);
+    pppapi_connect(ppp->pcb, 0);
+
+    if (rt_event_recv(ppp->event, PPP_EVENT_UP | PPP_EVENT_DOWN, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                      rt_tick_from_millisecond(PPP_LINK_TIMEOUT), &event) != RT_EOK)
+    {
+        LOG_E("%s device PPP link negotiation timeout.", device->name);
+        pppapi_close(ppp->pcb, 0);
+        rt_event_recv(ppp->event, PPP_EVENT_DOWN, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                      rt_tick_from_millisecond(PPP_LINK_TIMEOUT), RT_NULL);
+        result = -RT_ETIMEOUT;
+        goto __exit;
+    }
+
+    if (event & PPP_EVENT_DOWN)
+    {
+        LOG_E("%s device PPP link negotiation failed.", device->name);
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+__exit:
+    if (resp)
+    {
+        at_delete_resp(resp);
+    }
+
+    if (result < 0)
+    {
+        ppp_channel_release(ppp);
+    }
+
+    return result;
+}
+
+/**
+ * This function will terminate the PPP data call, the data channel returns to the AT client
+ * and the AT device network interface device becomes the default one again.
+ *
+ * @param device the AT device
+ *
+ * @return  0: stop success
+ *         -1: the data call is not running
+ */
+int at_device_ppp_stop(struct at_device *device)
+{
+    struct at_device_ppp *ppp = RT_NULL;
+
+    RT_ASSERT(device);
+
+    ppp = device->ppp;
+    if (ppp == RT_NULL || ppp->serial == RT_NULL)
+    {
+        return -RT_ERROR;
+    }
+
+    if (netdev_is_up(&(ppp->netdev)))
+    {
+        rt_event_recv(ppp->event, PPP_EVENT_DOWN, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR, 0, RT_NULL);
+        pppapi_close(ppp->pcb, 0);
+        /* the module returns to command mode after the link terminated */
+        rt_event_recv(ppp->event, PPP_EVENT_DOWN, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                      rt_tick_from_millisecond(PPP_LINK_TIMEOUT), RT_NULL);
+    }
+
+    ppp_channel_release(ppp);
+
+    LOG_I("%s device PPP data call is stopped.", device->name);
+
+    return RT_EOK;
+}
+
+rt_bool_t at_device_ppp_is_running(struct at_device *device)
+{
+    RT_ASSERT(device);
+
+    return device->ppp && device->ppp->serial;
+}
+
+#endif /* RT_USING_LWIP && RT_LWIP_PPP */
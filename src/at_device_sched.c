@@ -0,0 +1,299 @@
+/*
+ * File      : at_device_sched.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#include <at_device_sched.h>
+
+#define LOG_TAG                        "at.dev.sched"
+#include <at_log.h>
+
+static const char *sched_class_name[AT_DEVICE_CMD_CLASS_NUM] = {"data", "control", "background"};
+
+/* the command can run when no higher class command is waiting */
+static rt_bool_t sched_higher_waiting(struct at_device_sched *sched, int cmd_class)
+{
+    int i;
+
+    for (i = 0; i < cmd_class; i++)
+    {
+        if (sched->waiting[i] > 0)
+        {
+            return RT_TRUE;
+        }
+    }
+
+    return RT_FALSE;
+}
+
+/**
+ * This function will create the AT device command scheduler.
+ *
+ * @param device the AT device
+ *
+ * @return  0: create success
+ *         -5: no memory
+ */
+int at_device_sched_init(struct at_device *device)
+{
+    int i;
+    static int sched_counts = 0;
+    char name[RT_NAME_MAX] = {0};
+    struct at_device_sched *sched = RT_NULL;
+
+    RT_ASSERT(device);
+
+    sched = (struct at_device_sched *) rt_calloc(1, sizeof(struct at_device_sched));
+    if (sched == RT_NULL)
+    {
+        goto __nomem;
+    }
+
+    rt_snprintf(name, RT_NAME_MAX, "at_sm%d", sched_counts);
+    sched->lock = rt_mutex_create(name, RT_IPC_FLAG_FIFO);
+    if (sched->lock == RT_NULL)
+    {
+        goto __nomem;
+    }
+
+    for (i = 0; i < AT_DEVICE_CMD_CLASS_NUM; i++)
+    {
+        rt_snprintf(name, RT_NAME_MAX, "at_s%d_%d", sched_counts, i);
+        sched->sem[i] = rt_sem_create(name, 0, RT_IPC_FLAG_FIFO);
+        if (sched->sem[i] == RT_NULL)
+        {
+            goto __nomem;
+        }
+    }
+
+    sched_counts++;
+    device->sched = sched;
+
+    return RT_EOK;
+
+__nomem:
+    LOG_E("no memory for %s device command scheduler create.", device->name);
+    if (sched)
+    {
+        for (i = 0; i < AT_DEVICE_CMD_CLASS_NUM; i++)
+        {
+            if (sched->sem[i])
+            {
+                rt_sem_delete(sched->sem[i]);
+            }
+        }
+
+        if (sched->lock)
+        {
+            rt_mutex_delete(sched->lock);
+        }
+
+        rt_free(sched);
+    }
+
+    return -RT_ENOMEM;
+}
+
+/**
+ * This function will get the device for executing commands of the priority class.
+ * The device is given to the highest class waiting command when it is released,
+ * so the commands of a long background job, which takes and releases the device
+ * for each command, are preempted by the data and control commands between them.
+ * The same thread can take the device again before it is released.
+ *
+ * @param device the AT device
+ * @param cmd_class the command priority class
+ * @param timeout the deadline of waiting for the device
+ *
+ * @return  0: get the device success
+ *         -2: wait timeout, the command is dropped
+ */
+int at_device_sched_take(struct at_device *device, int cmd_class, rt_int32_t timeout)
+{
+    rt_tick_t start, wait;
+    rt_int32_t remain = RT_WAITING_FOREVER;
+    rt_thread_t self = rt_thread_self();
+    struct at_device_sched *sched = device->sched;
+
+    RT_ASSERT(cmd_class >= 0 && cmd_class < AT_DEVICE_CMD_CLASS_NUM);
+
+    if (sched == RT_NULL)
+    {
+        return RT_EOK;
+    }
+
+    start = rt_tick_get();
+    rt_mutex_take(sched->lock, RT_WAITING_FOREVER);
+
+    if (sched->owner == self)
+    {
+        sched->nest++;
+        rt_mutex_release(sched->lock);
+        return RT_EOK;
+    }
+
+    /* the background command uses the separate control channel, not need to queue */
+    if (cmd_class == AT_DEVICE_CMD_BACKGROUND && device->ctrl_client)
+    {
+        sched->stat[cmd_class].count++;
+        rt_mutex_release(sched->lock);
+        return RT_EOK;
+    }
+
+    while (sched->owner != RT_NULL || sched_higher_waiting(sched, cmd_class))
+    {
+        if (timeout != RT_WAITING_FOREVER)
+        {
+            remain = timeout - (rt_int32_t) (rt_tick_get() - start);
+            if (remain <= 0)
+            {
+                sched->stat[cmd_class].timeout++;
+                rt_mutex_release(sched->lock);
+                LOG_D("%s device %s command wait timeout.", device->name, sched_class_name[cmd_class]);
+                return -RT_ETIMEOUT;
+            }
+        }
+
+        sched->waiting[cmd_class]++;
+        rt_mutex_release(sched->lock);
+
+        rt_sem_take(sched->sem[cmd_class], remain);
+
+        rt_mutex_take(sched->lock, RT_WAITING_FOREVER);
+        sched->waiting[cmd_class]--;
+    }
+
+    sched->owner = self;
+    sched->nest = 1;
+
+    wait = rt_tick_get() - start;
+    sched->stat[cmd_class].count++;
+    sched->stat[cmd_class].wait_total += wait;
+    if (wait > sched->stat[cmd_class].wait_max)
+    {
+        sched->stat[cmd_class].wait_max = wait;
+    }
+
+    rt_mutex_release(sched->lock);
+
+    return RT_EOK;
+}
+
+/**
+ * This function will put back the device and wake up the highest class waiting command.
+ *
+ * @param device the AT device
+ */
+void at_device_sched_release(struct at_device *device)
+{
+    int i;
+    struct at_device_sched *sched = device->sched;
+
+    if (sched == RT_NULL)
+    {
+        return;
+    }
+
+    rt_mutex_take(sched->lock, RT_WAITING_FOREVER);
+
+    if (sched->owner != rt_thread_self() || --sched->nest > 0)
+    {
+        rt_mutex_release(sched->lock);
+        return;
+    }
+
+    sched->owner = RT_NULL;
+    for (i = 0; i < AT_DEVICE_CMD_CLASS_NUM; i++)
+    {
+        if (sched->waiting[i] > 0)
+        {
+            rt_sem_release(sched->sem[i]);
+            break;
+        }
+    }
+
+    rt_mutex_release(sched->lock);
+}
+
+/**
+ * This function will get the command queueing statistics of the priority class.
+ *
+ * @param device the AT device
+ * @param cmd_class the command priority class
+ * @param stat the statistics
+ *
+ * @return  0: get success
+ *         -1: the scheduler is not created
+ */
+int at_device_sched_stat_get(struct at_device *device, int cmd_class, struct at_device_sched_stat *stat)
+{
+    struct at_device_sched *sched = device->sched;
+
+    RT_ASSERT(cmd_class >= 0 && cmd_class < AT_DEVICE_CMD_CLASS_NUM);
+    RT_ASSERT(stat);
+
+    if (sched == RT_NULL)
+    {
+        return -RT_ERROR;
+    }
+
+    rt_mutex_take(sched->lock, RT_WAITING_FOREVER);
+    rt_memcpy(stat, &(sched->stat[cmd_class]), sizeof(struct at_device_sched_stat));
+    rt_mutex_release(sched->lock);
+
+    return RT_EOK;
+}
+
+#ifdef FINSH_USING_MSH
+#include <finsh.h>
+
+static int at_device_sched_dump(int argc, char **argv)
+{
+    int i;
+    struct at_device *device = RT_NULL;
+    struct at_device_sched_stat stat;
+
+    if (argc != 2)
+    {
+        rt_kprintf("Usage: at_sched <device name>\n");
+        return -RT_ERROR;
+    }
+
+    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_DEVICE, argv[1]);
+    if (device == RT_NULL || device->sched == RT_NULL)
+    {
+        rt_kprintf("AT device(%s) is not found.\n", argv[1]);
+        return -RT_ERROR;
+    }
+
+    rt_kprintf("class       count      timeout    wait avg   wait max (tick)\n");
+    for (i = 0; i < AT_DEVICE_CMD_CLASS_NUM; i++)
+    {
+        at_device_sched_stat_get(device, i, &stat);
+        rt_kprintf("%-10s  %-9d  %-9d  %-9d  %d\n", sched_class_name[i], stat.count, stat.timeout,
+                   stat.count ? stat.wait_total / stat.count : 0, stat.wait_max);
+    }
+
+    return RT_EOK;
+}
+MSH_CMD_EXPORT_ALIAS(at_device_sched_dump, at_sched, dump AT device command queueing delay);
+#endif /* FINSH_USING_MSH */
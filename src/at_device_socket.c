@@ -0,0 +1,1394 @@
+/*
+ * File      : at_device_socket.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <at_device_socket.h>
+#include <at_device_urc.h>
+#include <at_device_parser.h>
+#include <at_device_sched.h>
+#include <at_device_ppp.h>
+
+#define LOG_TAG                        "at.skt"
+#include <at_log.h>
+
+#ifdef AT_USING_SOCKET
+
+static at_evt_cb_t at_evt_cb_set[] = {
+        [AT_SOCKET_EVT_RECV] = NULL,
+        [AT_SOCKET_EVT_CLOSED] = NULL,
+#ifdef AT_USING_SOCKET_SERVER
+        [AT_SOCKET_EVT_CONNECTED] = NULL,
+#endif
+};
+
+static const char hex_table[] = "0123456789ABCDEF";
+
+static const struct at_device_socket_dialect *at_device_socket_dialect_get(struct at_device *device)
+{
+    RT_ASSERT(device->class->socket_dialect);
+
+    return device->class->socket_dialect;
+}
+
+int at_device_socket_event_send(struct at_device *device, uint32_t event)
+{
+    return (int) rt_event_send(device->socket_event, event);
+}
+
+int at_device_socket_event_recv(struct at_device *device, uint32_t event, uint32_t timeout, rt_uint8_t option)
+{
+    int result = RT_EOK;
+    rt_uint32_t recved;
+
+    result = rt_event_recv(device->socket_event, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
+    if (result != RT_EOK)
+    {
+        return -RT_ETIMEOUT;
+    }
+
+    return recved;
+}
+
+/* finish the non-blocking connect with the result and wake up all the result waiters */
+static void at_device_socket_connect_done(struct at_device *device, int device_socket, int result)
+{
+    struct at_device_socket_info *info = &(device->socket_info[device_socket]);
+
+    info->conn_result = result;
+    info->is_connecting = RT_FALSE;
+    rt_event_send(device->conn_event, AT_DEVICE_SOCKET_CONN_DONE(device_socket));
+}
+
+/**
+ * close socket by AT commands.
+ *
+ * @param current socket
+ *
+ * @return  0: close socket success
+ *         -1: send AT commands error
+ *         -2: wait socket event timeout
+ *         -5: no memory
+ */
+int at_device_socket_close(struct at_socket *socket)
+{
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+    int device_socket = (int) socket->user_data;
+    struct at_device *device = (struct at_device *) socket->device;
+    const struct at_device_socket_dialect *dialect = at_device_socket_dialect_get(device);
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(dialect->close_timeout));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    at_device_sched_take(device, AT_DEVICE_CMD_CONTROL, RT_WAITING_FOREVER);
+    if (device->socket_info[device_socket].is_listen && dialect->close_listen)
+    {
+        result = at_obj_exec_cmd(device->client, resp, dialect->close_listen);
+    }
+    else if (device->socket_info[device_socket].tls && dialect->close_tls)
+    {
+        result = at_obj_exec_cmd(device->client, resp, dialect->close_tls, device_socket);
+    }
+    else
+    {
+        result = at_obj_exec_cmd(device->client, resp, dialect->close, device_socket);
+    }
+    at_device_sched_release(device);
+    device->socket_info[device_socket].is_listen = RT_FALSE;
+    device->socket_info[device_socket].is_opened = RT_FALSE;
+    device->socket_info[device_socket].from_ip[0] = '\0';
+    device->socket_info[device_socket].is_nonblock = RT_FALSE;
+    if (device->socket_info[device_socket].is_connecting)
+    {
+        at_device_socket_connect_done(device, device_socket, RT_EOK);
+    }
+    device->socket_info[device_socket].conn_result = RT_EOK;
+    device->socket_info[device_socket].tls = RT_NULL;
+    device->socket_info[device_socket].context = 0;
+    device->socket_info[device_socket].conn_tick = 0;
+    if (result < 0)
+    {
+        LOG_D("%s device close socket(%d) failed [%d].", device->name, device_socket, result);
+    }
+
+    at_delete_resp(resp);
+
+    return result;
+}
+
+/**
+ * This function will wait the connect or listen result reported by URC.
+ *
+ * @param device the AT device
+ * @param device_socket the device socket descriptor
+ *
+ * @return  0: connect success
+ *         -1: connect failed
+ *         -2: wait connect result timeout
+ */
+int at_device_socket_connect_wait(struct at_device *device, int device_socket)
+{
+    int event_result = 0;
+    const struct at_device_socket_dialect *dialect = at_device_socket_dialect_get(device);
+
+    if (at_device_socket_event_recv(device, AT_DEVICE_SOCKET_EVENT(device_socket, 0),
+                                    rt_tick_from_millisecond(dialect->connect_timeout), RT_EVENT_FLAG_OR) < 0)
+    {
+        if (dialect->flags & AT_DEVICE_SOCKET_FLAG_CONN_TIMEO_OK)
+        {
+            /* No news is good news */
+            return RT_EOK;
+        }
+
+        LOG_E("%s device socket(%d) wait connect result timeout.", device->name, device_socket);
+        return -RT_ETIMEOUT;
+    }
+
+    /* waiting OK or failed result */
+    event_result = at_device_socket_event_recv(device, AT_DEVICE_SOCKET_EVENT_CONN_OK | AT_DEVICE_SOCKET_EVENT_CONN_FAIL,
+                                               1 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
+    if (event_result < 0)
+    {
+        LOG_E("%s device socket(%d) wait connect OK|FAIL timeout.", device->name, device_socket);
+        return -RT_ETIMEOUT;
+    }
+
+    if (event_result & AT_DEVICE_SOCKET_EVENT_CONN_FAIL)
+    {
+        return -RT_ERROR;
+    }
+
+    return RT_EOK;
+}
+
+/* wait the non-blocking connect result, the connect fails when no URC in connect timeout */
+static int at_device_socket_connect_pending(struct at_device *device, int device_socket, rt_int32_t timeout)
+{
+    rt_tick_t start = rt_tick_get(), elapsed = 0, wait = 0;
+    struct at_device_socket_info *info = &(device->socket_info[device_socket]);
+    const struct at_device_socket_dialect *dialect = at_device_socket_dialect_get(device);
+    rt_tick_t conn_timeout = rt_tick_from_millisecond(dialect->connect_timeout);
+
+    while (info->is_connecting)
+    {
+        elapsed = rt_tick_get() - info->conn_tick;
+        if (elapsed >= conn_timeout)
+        {
+            /* No news is good news */
+            info->conn_tick = 0;
+            at_device_socket_connect_done(device, device_socket,
+                    (dialect->flags & AT_DEVICE_SOCKET_FLAG_CONN_TIMEO_OK) ? RT_EOK : -RT_ETIMEOUT);
+            break;
+        }
+        wait = conn_timeout - elapsed;
+
+        elapsed = rt_tick_get() - start;
+        if (elapsed >= rt_tick_from_millisecond(timeout))
+        {
+            return -RT_EBUSY;
+        }
+        if (rt_tick_from_millisecond(timeout) - elapsed < wait)
+        {
+            wait = rt_tick_from_millisecond(timeout) - elapsed;
+        }
+
+        /* the done bit is not cleared here, so all the waiters of the socket wake up */
+        rt_event_recv(device->conn_event, AT_DEVICE_SOCKET_CONN_DONE(device_socket), RT_EVENT_FLAG_OR,
+                      (rt_int32_t) wait, RT_NULL);
+    }
+
+    return info->conn_result;
+}
+
+/**
+ * This function will set the socket connect mode, the non-blocking connect
+ * returns after the connect command accepted, and the result is reported by
+ * the connect URC later, so several sockets connect at the same time.
+ *
+ * @param socket the AT socket object
+ * @param nonblock RT_TRUE: non-blocking connect, RT_FALSE: blocking connect
+ *
+ * @return  0: set success
+ *         -1: the connect result is not reported by URC, non-blocking connect is not supported
+ */
+int at_device_socket_set_nonblock(struct at_socket *socket, rt_bool_t nonblock)
+{
+    struct at_device *device = RT_NULL;
+
+    RT_ASSERT(socket);
+
+    device = (struct at_device *) socket->device;
+    if (nonblock && at_device_socket_dialect_get(device)->connect_style != AT_DEVICE_SOCKET_CONN_URC)
+    {
+        LOG_E("%s device not support non-blocking connect.", device->name);
+        return -RT_ERROR;
+    }
+
+    device->socket_info[(int) socket->user_data].is_nonblock = nonblock;
+
+    return RT_EOK;
+}
+
+/**
+ * This function will get the non-blocking connect result, the socket data send
+ * waits for the result too.
+ *
+ * @param socket the AT socket object
+ * @param timeout the waiting time in millisecond, 0: not wait
+ *
+ * @return  0: connect success
+ *         -1: connect failed
+ *         -2: no connect result in the device connect timeout
+ *         -7: the connect is in progress
+ */
+int at_device_socket_connect_result(struct at_socket *socket, rt_int32_t timeout)
+{
+    RT_ASSERT(socket);
+
+    return at_device_socket_connect_pending((struct at_device *) socket->device, (int) socket->user_data, timeout);
+}
+
+/**
+ * This function will set the socket connects with TLS terminated by the module,
+ * the data send and receive are the same as the plain TCP socket. It should be
+ * called before connect, and the setting is cleared when the socket closed.
+ *
+ * @param socket the AT socket object
+ * @param cfg the TLS configuration, it must be valid until the socket closed, RT_NULL: plain TCP
+ *
+ * @return  0: set success
+ *         -1: the device not support TLS offload
+ */
+int at_device_socket_set_tls(struct at_socket *socket, const struct at_device_tls_cfg *cfg)
+{
+    struct at_device *device = RT_NULL;
+
+    RT_ASSERT(socket);
+
+    device = (struct at_device *) socket->device;
+    if (cfg && (device->class->socket_tls == RT_NULL ||
+            (device->class->socket_dialect && device->class->socket_dialect->connect_tls == RT_NULL)))
+    {
+        LOG_E("%s device not support TLS offload.", device->name);
+        return -RT_ERROR;
+    }
+
+    device->socket_info[(int) socket->user_data].tls = cfg;
+
+    return RT_EOK;
+}
+
+/**
+ * This function will write the certificate or key file to the module file
+ * system, the file with the same name is replaced.
+ *
+ * @param device the AT device
+ * @param name the file name used in the TLS configuration
+ * @param data the file data
+ * @param size the file size
+ *
+ * @return  0: upload success
+ *         -1: the device not support file upload or upload failed
+ *         -2: wait upload result timeout
+ *         -5: no memory
+ */
+int at_device_socket_tls_upload(struct at_device *device, const char *name, const char *data, size_t size)
+{
+    RT_ASSERT(device);
+    RT_ASSERT(name);
+    RT_ASSERT(data);
+
+    if (device->class->socket_tls == RT_NULL || device->class->socket_tls->file_upload == RT_NULL)
+    {
+        LOG_E("%s device not support file upload, use the provisioned files.", device->name);
+        return -RT_ERROR;
+    }
+
+    return device->class->socket_tls->file_upload(device, name, data, size);
+}
+
+/* open the connectionless UDP socket on the local port by the class dialect */
+static int at_device_socket_open_udp(struct at_socket *socket, const char *ip, int32_t port, int32_t local_port)
+{
+    int result = RT_EOK;
+    int device_socket = (int) socket->user_data;
+    struct at_device *device = (struct at_device *) socket->device;
+    const struct at_device_socket_dialect *dialect = at_device_socket_dialect_get(device);
+
+    result = dialect->open_udp(socket, ip, port, local_port);
+    if (result < 0)
+    {
+        LOG_E("%s device socket(%d) open UDP on port(%d) failed.", device->name, device_socket, local_port);
+        return result;
+    }
+
+    device->socket_info[device_socket].is_opened = RT_TRUE;
+
+    return RT_EOK;
+}
+
+/**
+ * create TCP/UDP client or server connect by AT commands.
+ *
+ * @param socket current socket
+ * @param ip server or client IP address
+ * @param port server or client port
+ * @param type connect socket type(tcp, udp)
+ * @param is_client connection is client
+ *
+ * @return   0: connect success
+ *          -1: connect failed, send commands error or type error
+ *          -2: wait socket event timeout
+ *          -5: no memory
+ *          -8: the device link is down
+ */
+int at_device_socket_connect(struct at_socket *socket, char *ip, int32_t port,
+                             enum at_socket_type type, rt_bool_t is_client)
+{
+    int retry = 0;
+    uint32_t event = 0;
+    int result = RT_EOK;
+    rt_uint8_t context = 0;
+    rt_bool_t nonblock = RT_FALSE;
+    const char *cmd_expr = RT_NULL;
+    const struct at_device_tls_cfg *tls = RT_NULL;
+    at_response_t resp = RT_NULL;
+    int device_socket = (int) socket->user_data;
+    struct at_device *device = (struct at_device *) socket->device;
+    struct at_device_socket_info *info = &(device->socket_info[device_socket]);
+    const struct at_device_socket_dialect *dialect = at_device_socket_dialect_get(device);
+
+    RT_ASSERT(ip);
+    RT_ASSERT(port >= 0);
+
+    if (at_device_ppp_is_running(device))
+    {
+        LOG_E("%s device socket(%d) connect failed, the data channel is used by PPP.", device->name, device_socket);
+        return -RT_ERROR;
+    }
+
+    if (is_client == RT_FALSE)
+    {
+        if (info->tls)
+        {
+            LOG_E("%s device socket(%d) not support TLS server mode.", device->name, device_socket);
+            return -RT_ERROR;
+        }
+
+        if (type == AT_SOCKET_UDP && dialect->open_udp)
+        {
+            /* the UDP server receives the datagrams from any peer on the local port */
+            return at_device_socket_open_udp(socket, ip, 0, port);
+        }
+
+        if (type != AT_SOCKET_TCP || dialect->listen == RT_NULL)
+        {
+            LOG_E("%s device socket(%d) not support server mode.", device->name, device_socket);
+            return -RT_ERROR;
+        }
+
+        result = dialect->listen(socket, port);
+        if (result < 0)
+        {
+            LOG_E("%s device socket(%d) listen on port(%d) failed.", device->name, device_socket, port);
+            return result;
+        }
+
+        device->socket_info[device_socket].is_listen = RT_TRUE;
+        return RT_EOK;
+    }
+
+    switch (type)
+    {
+    case AT_SOCKET_TCP:
+        cmd_expr = dialect->connect_tcp;
+        break;
+
+    case AT_SOCKET_UDP:
+        if (info->tls)
+        {
+            LOG_E("%s device socket(%d) not support TLS over UDP.", device->name, device_socket);
+            return -RT_ERROR;
+        }
+
+        cmd_expr = dialect->connect_udp;
+        if (cmd_expr == RT_NULL || dialect->open_udp)
+        {
+            /* connectionless UDP, only record the remote address for sending */
+            rt_strncpy(device->socket_info[device_socket].remote_ip, ip,
+                       sizeof(device->socket_info[device_socket].remote_ip) - 1);
+            device->socket_info[device_socket].remote_port = port;
+
+            /* the SAL connects on every sendto, the socket is opened by the first one */
+            if (dialect->open_udp && device->socket_info[device_socket].is_opened == RT_FALSE)
+            {
+                return at_device_socket_open_udp(socket, ip, port, AT_DEVICE_SOCKET_UDP_LOCAL_PORT(device_socket));
+            }
+            return RT_EOK;
+        }
+        break;
+
+    default:
+        LOG_E("not supported connect type : %d.", type);
+        return -RT_ERROR;
+    }
+
+    resp = at_create_resp(128, 0, rt_tick_from_millisecond(dialect->cmd_timeout));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    if (info->tls)
+    {
+        /* the module TLS context is configured once, the connect retry uses it too */
+        at_device_sched_take(device, AT_DEVICE_CMD_CONTROL, RT_WAITING_FOREVER);
+        result = device->class->socket_tls->config(socket, info->tls);
+        at_device_sched_release(device);
+        if (result < 0)
+        {
+            LOG_E("%s device socket(%d) TLS config failed.", device->name, device_socket);
+            goto __exit;
+        }
+    }
+
+    for (retry = 0; retry <= dialect->connect_retry; retry++)
+    {
+        if (device->link_down)
+        {
+            result = -AT_DEVICE_SOCKET_ELINKDOWN;
+            break;
+        }
+
+        if (retry > 0 && (dialect->flags & AT_DEVICE_SOCKET_FLAG_CLOSE_RETRY))
+        {
+            LOG_D("%s device socket(%d) connect failed, the socket was not be closed and now will connect retry.",
+                    device->name, device_socket);
+            tls = info->tls;
+            context = info->context;
+            nonblock = info->is_nonblock;
+            if (at_device_socket_close(socket) < 0)
+            {
+                break;
+            }
+            /* the retry connects with the same TLS configuration, context and blocking mode */
+            info->tls = tls;
+            info->context = context;
+            info->is_nonblock = nonblock;
+        }
+
+        /* clear socket connect event */
+        event = AT_DEVICE_SOCKET_EVENT(device_socket, AT_DEVICE_SOCKET_EVENT_CONN_OK | AT_DEVICE_SOCKET_EVENT_CONN_FAIL);
+        at_device_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
+
+        at_device_sched_take(device, AT_DEVICE_CMD_CONTROL, RT_WAITING_FOREVER);
+        /* the connect time is the round trip time metrics of the device, it starts after the
+         * device is taken, so the time queued in the scheduler behind other commands is not counted */
+        info->conn_tick = rt_tick_get();
+        if (info->is_nonblock)
+        {
+            /* mark it before the command, the connect URC may come before the command returns */
+            rt_event_recv(device->conn_event, AT_DEVICE_SOCKET_CONN_DONE(device_socket),
+                          RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR, 0, RT_NULL);
+            info->conn_result = -RT_EBUSY;
+            info->is_connecting = RT_TRUE;
+        }
+        if (info->tls)
+        {
+            result = dialect->connect_tls(socket, resp, ip, port, info->tls);
+        }
+        else if (dialect->connect_cmd)
+        {
+            result = dialect->connect_cmd(socket, resp, ip, port, type);
+        }
+        else
+        {
+            result = at_obj_exec_cmd(device->client, resp, cmd_expr, device_socket, ip, port);
+        }
+        at_device_sched_release(device);
+        if (result < 0)
+        {
+            if (info->is_connecting)
+            {
+                at_device_socket_connect_done(device, device_socket, -RT_ERROR);
+            }
+            result = -RT_ERROR;
+            continue;
+        }
+        LOG_D("%s device socket(%d) try connect to %s:%d.", device->name, device_socket, ip, port);
+
+        if (info->is_nonblock)
+        {
+            /* the result is reported by the connect URC, it is not retried */
+            result = RT_EOK;
+            break;
+        }
+        else if (dialect->connect_style == AT_DEVICE_SOCKET_CONN_URC)
+        {
+            result = at_device_socket_connect_wait(device, device_socket);
+            if (result == -RT_ETIMEOUT)
+            {
+                break;
+            }
+        }
+        else
+        {
+            /* the command returns after the connection is established */
+            if (info->tls == RT_NULL)
+            {
+                at_device_metrics_update_rtt(device, (rt_tick_get() - info->conn_tick) * 1000 / RT_TICK_PER_SECOND);
+            }
+            info->conn_tick = 0;
+            result = RT_EOK;
+        }
+
+        if (result == RT_EOK)
+        {
+            break;
+        }
+    }
+
+__exit:
+    if (result != RT_EOK)
+    {
+        if (device->link_down)
+        {
+            result = -AT_DEVICE_SOCKET_ELINKDOWN;
+        }
+        LOG_E("%s device socket(%d) connect failed.", device->name, device_socket);
+    }
+    /* the late connect URC of a timed out connect is not a round trip time sample */
+    if (info->is_connecting == RT_FALSE)
+    {
+        info->conn_tick = 0;
+    }
+
+    at_delete_resp(resp);
+
+    return result;
+}
+
+/* the send position in the scatter-gather segments */
+struct at_device_socket_iov_pos
+{
+    const struct at_device_iovec *iov;
+    int index;
+    size_t offset;
+};
+
+/* get the contiguous data at the position not more than size, and move the position over it */
+static const char *at_device_socket_iov_next(struct at_device_socket_iov_pos *pos, size_t *size)
+{
+    const char *data = RT_NULL;
+
+    /* skip the empty and finished segments */
+    while (pos->offset >= pos->iov[pos->index].iov_len)
+    {
+        pos->index++;
+        pos->offset = 0;
+    }
+
+    data = (const char *) pos->iov[pos->index].iov_base + pos->offset;
+    if (*size > pos->iov[pos->index].iov_len - pos->offset)
+    {
+        *size = pos->iov[pos->index].iov_len - pos->offset;
+    }
+    pos->offset += *size;
+
+    return data;
+}
+
+/* send one packet with the prompt style, the '>' end sign has been set */
+static int at_device_socket_send_prompt(struct at_socket *socket, at_response_t resp,
+                                        struct at_device_socket_iov_pos *pos, size_t size,
+                                        enum at_socket_type type)
+{
+    size_t seg_size = 0;
+    const char *seg = RT_NULL;
+    int result = RT_EOK;
+    int device_socket = (int) socket->user_data;
+    struct at_device *device = (struct at_device *) socket->device;
+    struct at_device_socket_info *info = &(device->socket_info[device_socket]);
+    const struct at_device_socket_dialect *dialect = at_device_socket_dialect_get(device);
+
+    /* send the send commands to AT server than receive the '>' response on the first line */
+    if (type == AT_SOCKET_UDP && dialect->send_udp)
+    {
+        result = at_obj_exec_cmd(device->client, resp, dialect->send_udp, device_socket, (int) size,
+                                 info->remote_ip, info->remote_port);
+    }
+    else if (info->tls && dialect->send_tls)
+    {
+        result = at_obj_exec_cmd(device->client, resp, dialect->send_tls, device_socket, (int) size);
+    }
+    else
+    {
+        result = at_obj_exec_cmd(device->client, resp, dialect->send, device_socket, (int) size);
+    }
+    if (result < 0)
+    {
+        return -RT_ERROR;
+    }
+
+    /* send the real data to server or client, the packet may cross the segments */
+    for (; size > 0; size -= seg_size)
+    {
+        seg_size = size;
+        seg = at_device_socket_iov_next(pos, &seg_size);
+        if (at_client_obj_send(device->client, seg, seg_size) == 0)
+        {
+            return -RT_ERROR;
+        }
+    }
+
+    return RT_EOK;
+}
+
+/* send one packet with the hex style, the data is carried in the command */
+static int at_device_socket_send_hex(struct at_socket *socket, at_response_t resp, char *hex_buf,
+                                     struct at_device_socket_iov_pos *pos, size_t size, enum at_socket_type type)
+{
+    size_t i = 0, hex_len = 0, seg_size = 0;
+    const char *seg = RT_NULL;
+    int device_socket = (int) socket->user_data;
+    struct at_device *device = (struct at_device *) socket->device;
+    struct at_device_socket_info *info = &(device->socket_info[device_socket]);
+    const struct at_device_socket_dialect *dialect = at_device_socket_dialect_get(device);
+
+    /* encode the packet across the segments */
+    while (hex_len < size * 2)
+    {
+        seg_size = size - hex_len / 2;
+        seg = at_device_socket_iov_next(pos, &seg_size);
+        for (i = 0; i < seg_size; i++)
+        {
+            hex_buf[hex_len++] = hex_table[((rt_uint8_t) seg[i]) >> 4];
+            hex_buf[hex_len++] = hex_table[((rt_uint8_t) seg[i]) & 0x0F];
+        }
+    }
+    hex_buf[hex_len] = '\0';
+
+    if (type == AT_SOCKET_UDP && dialect->send_udp)
+    {
+        if (at_obj_exec_cmd(device->client, resp, dialect->send_udp, device_socket,
+                            info->remote_ip, info->remote_port, (int) size, hex_buf) < 0)
+        {
+            return -RT_ERROR;
+        }
+    }
+    else
+    {
+        if (at_obj_exec_cmd(device->client, resp, dialect->send, device_socket, (int) size, hex_buf) < 0)
+        {
+            return -RT_ERROR;
+        }
+    }
+
+    if (dialect->send_check && dialect->send_check(socket, resp, size) < 0)
+    {
+        LOG_E("%s device socket(%d) send data failed.", device->name, device_socket);
+        return -RT_ERROR;
+    }
+
+    return RT_EOK;
+}
+
+/**
+ * send the scatter-gather data to server or client by AT commands, the module
+ * packets are composed across the segments without coalescing copy.
+ *
+ * @param socket current socket
+ * @param iov the send segments
+ * @param iovcnt the number of send segments
+ * @param type connect socket type(tcp, udp)
+ *
+ * @return >=0: the size of send success
+ *          -1: send AT commands error or send data error
+ *          -2: waited socket event timeout
+ *          -5: no memory
+ *          -8: the device link is down
+ */
+int at_device_socket_sendv(struct at_socket *socket, const struct at_device_iovec *iov, int iovcnt,
+                           enum at_socket_type type)
+{
+    int i = 0;
+    uint32_t event = 0;
+    int result = RT_EOK, event_result = 0;
+    size_t bfsz = 0, cur_pkt_size = 0, sent_size = 0;
+    char *hex_buf = RT_NULL;
+    at_response_t resp = RT_NULL;
+    int device_socket = (int) socket->user_data;
+    struct at_device *device = (struct at_device *) socket->device;
+    const struct at_device_socket_dialect *dialect = at_device_socket_dialect_get(device);
+    rt_mutex_t lock = device->client->lock;
+    struct at_device_socket_iov_pos pos = {iov, 0, 0};
+
+    RT_ASSERT(iov || iovcnt == 0);
+
+    for (i = 0; i < iovcnt; i++)
+    {
+        RT_ASSERT(iov[i].iov_base || iov[i].iov_len == 0);
+        bfsz += iov[i].iov_len;
+    }
+
+    if (device->link_down)
+    {
+        LOG_E("%s device socket(%d) send failed, the link is down.", device->name, device_socket);
+        return -AT_DEVICE_SOCKET_ELINKDOWN;
+    }
+
+    if (at_device_ppp_is_running(device))
+    {
+        LOG_E("%s device socket(%d) send failed, the data channel is used by PPP.", device->name, device_socket);
+        return -RT_ERROR;
+    }
+
+    if (device->socket_info[device_socket].is_connecting)
+    {
+        /* the data is sent after the non-blocking connect finished */
+        result = at_device_socket_connect_pending(device, device_socket, dialect->connect_timeout);
+        if (result < 0)
+        {
+            LOG_E("%s device socket(%d) is not connected.", device->name, device_socket);
+            return result;
+        }
+    }
+
+    if (dialect->send_style == AT_DEVICE_SOCKET_SEND_HEX)
+    {
+        resp = at_create_resp(128, 0, rt_tick_from_millisecond(dialect->cmd_timeout));
+        hex_buf = (char *) rt_malloc(dialect->send_max_size * 2 + 1);
+        if (hex_buf == RT_NULL)
+        {
+            LOG_E("no memory for send hex buffer(%d) create.", dialect->send_max_size * 2 + 1);
+            result = -RT_ENOMEM;
+            goto __exit_free;
+        }
+    }
+    else
+    {
+        resp = at_create_resp(128, 2, rt_tick_from_millisecond(dialect->cmd_timeout));
+    }
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        result = -RT_ENOMEM;
+        goto __exit_free;
+    }
+
+    /* the data send goes before the waiting control and background commands */
+    at_device_sched_take(device, AT_DEVICE_CMD_DATA, RT_WAITING_FOREVER);
+    rt_mutex_take(lock, RT_WAITING_FOREVER);
+
+    /* set current socket for send URC event */
+    device->send_socket = device_socket;
+
+    /* clear socket send event */
+    event = AT_DEVICE_SOCKET_EVENT(device_socket, AT_DEVICE_SOCKET_EVENT_SEND_OK | AT_DEVICE_SOCKET_EVENT_SEND_FAIL);
+    at_device_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
+
+    if (dialect->send_style == AT_DEVICE_SOCKET_SEND_PROMPT)
+    {
+        /* set AT client end sign to deal with '>' sign */
+        at_obj_set_end_sign(device->client, '>');
+    }
+
+    while (sent_size < bfsz)
+    {
+        if (bfsz - sent_size < dialect->send_max_size)
+        {
+            cur_pkt_size = bfsz - sent_size;
+        }
+        else
+        {
+            cur_pkt_size = dialect->send_max_size;
+        }
+
+        if (dialect->send_style == AT_DEVICE_SOCKET_SEND_HEX)
+        {
+            result = at_device_socket_send_hex(socket, resp, hex_buf, &pos, cur_pkt_size, type);
+        }
+        else
+        {
+            result = at_device_socket_send_prompt(socket, resp, &pos, cur_pkt_size, type);
+        }
+        if (result < 0)
+        {
+            goto __exit;
+        }
+
+        /* waiting result event from AT URC */
+        if (at_device_socket_event_recv(device, AT_DEVICE_SOCKET_EVENT(device_socket, 0),
+                                        rt_tick_from_millisecond(dialect->send_timeout), RT_EVENT_FLAG_OR) < 0)
+        {
+            LOG_E("%s device socket(%d) wait send result timeout.", device->name, device_socket);
+            result = -RT_ETIMEOUT;
+            goto __exit;
+        }
+        /* waiting OK or failed result */
+        event_result = at_device_socket_event_recv(device, AT_DEVICE_SOCKET_EVENT_SEND_OK | AT_DEVICE_SOCKET_EVENT_SEND_FAIL,
+                                                   1 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
+        if (event_result < 0)
+        {
+            LOG_E("%s device socket(%d) wait send OK|FAIL timeout.", device->name, device_socket);
+            result = -RT_ETIMEOUT;
+            goto __exit;
+        }
+        /* check result */
+        if (event_result & AT_DEVICE_SOCKET_EVENT_SEND_FAIL)
+        {
+            LOG_E("%s device socket(%d) send failed.", device->name, device_socket);
+            result = -RT_ERROR;
+            goto __exit;
+        }
+
+        if (type == AT_SOCKET_TCP && (dialect->flags & AT_DEVICE_SOCKET_FLAG_TCP_SEND_DELAY))
+        {
+            rt_thread_mdelay(10);
+        }
+
+        sent_size += cur_pkt_size;
+    }
+
+__exit:
+    if (dialect->send_style == AT_DEVICE_SOCKET_SEND_PROMPT)
+    {
+        /* reset the end sign for data */
+        at_obj_set_end_sign(device->client, 0);
+    }
+
+    if (result < 0 && device->link_down)
+    {
+        result = -AT_DEVICE_SOCKET_ELINKDOWN;
+    }
+
+    rt_mutex_release(lock);
+    at_device_sched_release(device);
+
+__exit_free:
+    if (resp)
+    {
+        at_delete_resp(resp);
+    }
+
+    if (hex_buf)
+    {
+        rt_free(hex_buf);
+    }
+
+    return result < 0 ? result : (int) sent_size;
+}
+
+/**
+ * send data to server or client by AT commands.
+ *
+ * @param socket current socket
+ * @param buff send buffer
+ * @param bfsz send buffer size
+ * @param type connect socket type(tcp, udp)
+ *
+ * @return >=0: the size of send success
+ *          -1: send AT commands error or send data error
+ *          -2: waited socket event timeout
+ *          -5: no memory
+ *          -8: the device link is down
+ */
+int at_device_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
+{
+    struct at_device_iovec iov;
+
+    RT_ASSERT(buff);
+
+    iov.iov_base = (void *) buff;
+    iov.iov_len = bfsz;
+
+    return at_device_socket_sendv(socket, &iov, 1, type);
+}
+
+/**
+ * set AT socket event notice callback
+ *
+ * @param event notice event
+ * @param cb notice callback
+ */
+void at_device_socket_set_event_cb(at_socket_evt_t event, at_evt_cb_t cb)
+{
+    if (event < sizeof(at_evt_cb_set) / sizeof(at_evt_cb_set[1]))
+    {
+        at_evt_cb_set[event] = cb;
+    }
+}
+
+/**
+ * This function will get the AT device which the URC belongs to.
+ *
+ * @param client the AT client which receives the URC
+ *
+ * @return the AT device structure pointer, RT_NULL: get failed
+ */
+struct at_device *at_device_socket_get_device(struct at_client *client)
+{
+    struct at_device *device = RT_NULL;
+    char *client_name = client->device->parent.name;
+
+    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    if (device == RT_NULL)
+    {
+        LOG_E("get device(%s) failed.", client_name);
+    }
+
+    return device;
+}
+
+/* find the SAL socket object bound to the device socket descriptor */
+static struct at_socket *at_device_socket_find(struct at_device *device, int device_socket)
+{
+    int i;
+
+    /* the socket allocated by SAL uses the same index as the device socket descriptor */
+    if (device->sockets[device_socket].magic && (int) device->sockets[device_socket].user_data == device_socket)
+    {
+        return &(device->sockets[device_socket]);
+    }
+
+    /* the accepted socket is bound to the descriptor assigned by module */
+    for (i = 0; i < (int) device->class->socket_num; i++)
+    {
+        if (device->sockets[i].magic && (int) device->sockets[i].user_data == device_socket)
+        {
+            return &(device->sockets[i]);
+        }
+    }
+
+    return RT_NULL;
+}
+
+/**
+ * This function will get the SAL socket object by device socket descriptor,
+ * the accepted socket bound to the descriptor is found too.
+ *
+ * @param device the AT device
+ * @param device_socket the device socket descriptor
+ *
+ * @return the SAL socket object, RT_NULL: the descriptor is out of range
+ */
+struct at_socket *at_device_socket_get(struct at_device *device, int device_socket)
+{
+    struct at_socket *socket = RT_NULL;
+
+    if (device_socket < 0 || device_socket >= (int) device->class->socket_num)
+    {
+        LOG_E("%s device socket(%d) is out of range.", device->name, device_socket);
+        return RT_NULL;
+    }
+
+    socket = at_device_socket_find(device, device_socket);
+
+    return socket ? socket : &(device->sockets[device_socket]);
+}
+
+/**
+ * This function will read the raw data which follows the receive URC,
+ * and notice it to the socket. It must be called in the URC execution function.
+ *
+ * @param client the AT client which receives the URC
+ * @param device the AT device
+ * @param device_socket the device socket descriptor
+ * @param bfsz the size of raw data
+ */
+void at_device_socket_recv_push(struct at_client *client, struct at_device *device,
+                                int device_socket, rt_size_t bfsz)
+{
+    rt_int32_t timeout;
+    rt_size_t temp_size = 0;
+    char *recv_buf = RT_NULL, temp[8] = {0};
+    struct at_socket *socket = RT_NULL;
+
+    if (bfsz == 0)
+    {
+        return;
+    }
+
+    /* set receive timeout by receive buffer length, not less than 10 ms */
+    timeout = bfsz > 10 ? bfsz : 10;
+
+    socket = at_device_socket_get(device, device_socket);
+    if (socket)
+    {
+        recv_buf = (char *) rt_calloc(1, bfsz);
+        if (recv_buf == RT_NULL)
+        {
+            LOG_E("no memory for URC receive buffer(%d).", bfsz);
+        }
+    }
+
+    if (recv_buf == RT_NULL)
+    {
+        /* read and clean the coming data */
+        while (temp_size < bfsz)
+        {
+            if (bfsz - temp_size > sizeof(temp))
+            {
+                at_client_obj_recv(client, temp, sizeof(temp), timeout);
+            }
+            else
+            {
+                at_client_obj_recv(client, temp, bfsz - temp_size, timeout);
+            }
+            temp_size += sizeof(temp);
+        }
+        return;
+    }
+
+    /* sync receive data */
+    if (at_client_obj_recv(client, recv_buf, bfsz, timeout) != bfsz)
+    {
+        LOG_E("%s device receive size(%d) data failed.", device->name, bfsz);
+        rt_free(recv_buf);
+        return;
+    }
+
+    /* notice the receive buffer and buffer size */
+    if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
+    {
+        at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
+    }
+    else
+    {
+        rt_free(recv_buf);
+    }
+}
+
+/**
+ * This function will decode the hex string data carried in the receive URC,
+ * and notice it to the socket.
+ *
+ * @param device the AT device
+ * @param device_socket the device socket descriptor
+ * @param hex the hex string data
+ * @param hex_len the hex string length, it must be not less than bfsz * 2
+ * @param bfsz the size of decoded data
+ */
+void at_device_socket_recv_hex(struct at_device *device, int device_socket,
+                               const char *hex, rt_size_t hex_len, rt_size_t bfsz)
+{
+    char *recv_buf = RT_NULL;
+    struct at_socket *socket = RT_NULL;
+    struct at_device_parser parser;
+
+    socket = at_device_socket_get(device, device_socket);
+    if (socket == RT_NULL || bfsz == 0)
+    {
+        return;
+    }
+
+    recv_buf = (char *) rt_calloc(1, bfsz);
+    if (recv_buf == RT_NULL)
+    {
+        LOG_E("no memory for URC receive buffer(%d).", bfsz);
+        return;
+    }
+
+    at_device_parser_init(&parser, hex, hex_len);
+    if (at_device_parser_hex(&parser, recv_buf, bfsz) < 0)
+    {
+        LOG_E("%s device socket(%d) receive invalid hex data.", device->name, device_socket);
+        rt_free(recv_buf);
+        return;
+    }
+
+    /* notice the receive buffer and buffer size */
+    if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
+    {
+        at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
+    }
+    else
+    {
+        rt_free(recv_buf);
+    }
+}
+
+/**
+ * This function will notice the socket is disconnect by remote.
+ *
+ * @param device the AT device
+ * @param device_socket the device socket descriptor
+ */
+void at_device_socket_closed_notice(struct at_device *device, int device_socket)
+{
+    struct at_socket *socket = RT_NULL;
+
+    socket = at_device_socket_get(device, device_socket);
+    if (socket == RT_NULL)
+    {
+        return;
+    }
+
+    if (at_evt_cb_set[AT_SOCKET_EVT_CLOSED])
+    {
+        at_evt_cb_set[AT_SOCKET_EVT_CLOSED](socket, AT_SOCKET_EVT_CLOSED, RT_NULL, 0);
+    }
+}
+
+/**
+ * This function will notice a TCP server of the device accepted a connection, the
+ * connection is allocated to a new socket bound to the device socket descriptor.
+ *
+ * @param device the AT device
+ * @param device_socket the device socket descriptor of accepted connection
+ */
+void at_device_socket_accept_notice(struct at_device *device, int device_socket)
+{
+#ifdef AT_USING_SOCKET_SERVER
+    int i;
+    char socket_info[16] = {0};
+#endif
+
+    if (device_socket < 0 || device_socket >= (int) device->class->socket_num)
+    {
+        LOG_E("%s device socket(%d) is out of range.", device->name, device_socket);
+        return;
+    }
+
+    /* the connect result of client socket is the same as the accepted connection on some modules */
+    if (at_device_socket_find(device, device_socket))
+    {
+        return;
+    }
+
+#ifdef AT_USING_SOCKET_SERVER
+
+    for (i = 0; i < (int) device->class->socket_num; i++)
+    {
+        if (device->socket_info[i].is_listen)
+        {
+            break;
+        }
+    }
+    if (i == (int) device->class->socket_num)
+    {
+        LOG_W("%s device socket(%d) is accepted without server.", device->name, device_socket);
+        return;
+    }
+
+    if (at_evt_cb_set[AT_SOCKET_EVT_CONNECTED])
+    {
+        rt_snprintf(socket_info, sizeof(socket_info), "SOCKET:%d", device_socket);
+        at_evt_cb_set[AT_SOCKET_EVT_CONNECTED](RT_NULL, AT_SOCKET_EVT_CONNECTED, socket_info, rt_strlen(socket_info));
+    }
+#else
+    LOG_W("%s device socket(%d) is accepted, but the AT socket server is disabled.", device->name, device_socket);
+#endif /* AT_USING_SOCKET_SERVER */
+}
+
+/**
+ * This function will notice the connect result reported by the connect URC, the
+ * result of non-blocking connect is recorded and the failed socket is closed.
+ *
+ * @param device the AT device
+ * @param device_socket the device socket descriptor
+ * @param success the connect result
+ */
+void at_device_socket_connect_notice(struct at_device *device, int device_socket, rt_bool_t success)
+{
+    struct at_device_socket_info *info = RT_NULL;
+
+    if (device_socket < 0 || device_socket >= (int) device->class->socket_num)
+    {
+        LOG_E("%s device socket(%d) is out of range.", device->name, device_socket);
+        return;
+    }
+
+    info = &(device->socket_info[device_socket]);
+    /* only the connect command is timed, the listen and UDP service opens have no start tick */
+    if (success && info->tls == RT_NULL && info->conn_tick)
+    {
+        at_device_metrics_update_rtt(device, (rt_tick_get() - info->conn_tick) * 1000 / RT_TICK_PER_SECOND);
+    }
+    info->conn_tick = 0;
+
+    if (info->is_connecting)
+    {
+        at_device_socket_connect_done(device, device_socket, success ? RT_EOK : -RT_ERROR);
+        if (success == RT_FALSE)
+        {
+            LOG_E("%s device socket(%d) connect failed.", device->name, device_socket);
+            at_device_socket_closed_notice(device, device_socket);
+        }
+        return;
+    }
+
+    if (success)
+    {
+        at_device_socket_event_send(device, AT_DEVICE_SOCKET_EVENT(device_socket, AT_DEVICE_SOCKET_EVENT_CONN_OK));
+    }
+    else
+    {
+        at_device_socket_event_send(device, AT_DEVICE_SOCKET_EVENT(device_socket, AT_DEVICE_SOCKET_EVENT_CONN_FAIL));
+    }
+}
+
+/**
+ * This function will record the source address of the datagram, it must be called
+ * before the datagram noticed to the socket.
+ *
+ * @param device the AT device
+ * @param device_socket the device socket descriptor
+ * @param ip the source IP address
+ * @param port the source port
+ */
+void at_device_socket_set_from(struct at_device *device, int device_socket, const char *ip, int32_t port)
+{
+    struct at_device_socket_info *info = RT_NULL;
+
+    if (device_socket < 0 || device_socket >= (int) device->class->socket_num)
+    {
+        return;
+    }
+
+    info = &(device->socket_info[device_socket]);
+    rt_strncpy(info->from_ip, ip, sizeof(info->from_ip) - 1);
+    info->from_ip[sizeof(info->from_ip) - 1] = '\0';
+    info->from_port = port;
+}
+
+/**
+ * This function will get the source address of the last datagram received by
+ * the connectionless socket, it is reported by the receive URC without AT command.
+ *
+ * @param socket the AT socket object
+ * @param ip the source IP address
+ * @param port the source port
+ *
+ * @return  0: get success
+ *         -1: no source address is received
+ */
+int at_device_socket_get_from(struct at_socket *socket, char ip[16], int32_t *port)
+{
+    struct at_device *device = RT_NULL;
+    struct at_device_socket_info *info = RT_NULL;
+
+    RT_ASSERT(socket);
+    RT_ASSERT(ip);
+    RT_ASSERT(port);
+
+    device = (struct at_device *) socket->device;
+    info = &(device->socket_info[(int) socket->user_data]);
+    if (info->from_ip[0] == '\0')
+    {
+        return -RT_ERROR;
+    }
+
+    rt_memcpy(ip, info->from_ip, sizeof(info->from_ip));
+    *port = info->from_port;
+
+    return RT_EOK;
+}
+
+/**
+ * The "SEND OK" and "SEND FAIL" URC execution function for modules
+ * which don't report the socket in the send result.
+ */
+void at_device_socket_urc_send(struct at_client *client, const char *data, rt_size_t size)
+{
+    struct at_device *device = RT_NULL;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_socket_get_device(client);
+    if (device == RT_NULL)
+    {
+        return;
+    }
+
+    if (rt_strstr(data, "SEND OK"))
+    {
+        at_device_socket_event_send(device, AT_DEVICE_SOCKET_EVENT(device->send_socket, AT_DEVICE_SOCKET_EVENT_SEND_OK));
+    }
+    else if (rt_strstr(data, "SEND FAIL"))
+    {
+        at_device_socket_event_send(device, AT_DEVICE_SOCKET_EVENT(device->send_socket, AT_DEVICE_SOCKET_EVENT_SEND_FAIL));
+    }
+}
+
+/**
+ * This function will fail the in-flight operations of the device sockets, the
+ * connect and send waiting for the result URC return the link down error, and
+ * the sockets are noticed closed, so the receive returns too.
+ *
+ * @param device the AT device whose link is down
+ */
+void at_device_socket_link_down(struct at_device *device)
+{
+    int device_socket = 0;
+    uint32_t i = 0;
+    struct at_device_socket_info *info = RT_NULL;
+
+    for (i = 0; i < device->class->socket_num; i++)
+    {
+        if (device->sockets[i].magic == 0)
+        {
+            continue;
+        }
+
+        device_socket = (int) device->sockets[i].user_data;
+        info = &(device->socket_info[device_socket]);
+        if (info->is_connecting)
+        {
+            at_device_socket_connect_done(device, device_socket, -AT_DEVICE_SOCKET_ELINKDOWN);
+        }
+
+        at_device_socket_event_send(device, AT_DEVICE_SOCKET_EVENT(device_socket,
+                                    AT_DEVICE_SOCKET_EVENT_CONN_FAIL | AT_DEVICE_SOCKET_EVENT_SEND_FAIL));
+        at_device_socket_closed_notice(device, device_socket);
+    }
+}
+
+/**
+ * This function will register the class dialect URC table to the device AT client.
+ *
+ * @param device the AT device
+ *
+ * @return 0: initialize success
+ */
+int at_device_socket_init(struct at_device *device)
+{
+    const struct at_device_socket_dialect *dialect = RT_NULL;
+
+    RT_ASSERT(device);
+
+    dialect = at_device_socket_dialect_get(device);
+
+    /* register URC data execution function  */
+    return at_device_urc_set_table(device->client, dialect->urc_table, dialect->urc_table_size);
+}
+
+#endif /* AT_USING_SOCKET */
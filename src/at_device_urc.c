@@ -0,0 +1,450 @@
+/*
+ * File      : at_device_urc.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#include <string.h>
+
+#include <at_device_urc.h>
+
+#define LOG_TAG                        "at.dev.urc"
+#include <at_log.h>
+
+/* the URC tables registered to the AT clients */
+static rt_slist_t urc_table_list = RT_SLIST_OBJECT_INIT(urc_table_list);
+static struct rt_mutex urc_lock;
+static rt_bool_t urc_lock_init = RT_FALSE;
+
+/* the AT client line buffer never starts with CR/LF followed URC prefix, skip them */
+static const char *urc_prefix_skip_crlf(const char *prefix)
+{
+    while (*prefix == '\r' || *prefix == '\n')
+    {
+        prefix++;
+    }
+
+    return prefix;
+}
+
+static rt_bool_t urc_is_same(const struct at_urc *urc1, const struct at_urc *urc2)
+{
+    return (rt_strcmp(urc_prefix_skip_crlf(urc1->cmd_prefix), urc_prefix_skip_crlf(urc2->cmd_prefix)) == 0 &&
+            rt_strcmp(urc1->cmd_suffix, urc2->cmd_suffix) == 0 && urc1->func == urc2->func);
+}
+
+/* the URC entry is matched by an entry of the table with the same prefix and suffix */
+static rt_bool_t urc_is_registered(const struct at_urc *urc, const struct at_urc *table, rt_size_t size)
+{
+    rt_size_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        if (rt_strcmp(urc->cmd_prefix, table[i].cmd_prefix) == 0 &&
+                rt_strcmp(urc->cmd_suffix, table[i].cmd_suffix) == 0)
+        {
+            return RT_TRUE;
+        }
+    }
+
+    return RT_FALSE;
+}
+
+/* find the child node by character, create it when the nodes buffer is given */
+static rt_int16_t urc_node_child(struct at_device_urc_dispatcher *dispatcher, rt_int16_t parent,
+                                 char ch, rt_bool_t create)
+{
+    rt_int16_t index = dispatcher->nodes[parent].child;
+    struct at_device_urc_node *node = RT_NULL;
+
+    for (; index >= 0; index = dispatcher->nodes[index].sibling)
+    {
+        if (dispatcher->nodes[index].ch == ch)
+        {
+            return index;
+        }
+    }
+
+    if (create == RT_FALSE)
+    {
+        return -1;
+    }
+
+    index = (rt_int16_t) dispatcher->node_num++;
+    node = &(dispatcher->nodes[index]);
+    node->ch = ch;
+    node->child = -1;
+    node->entry = -1;
+    node->sibling = dispatcher->nodes[parent].child;
+    dispatcher->nodes[parent].child = index;
+
+    return index;
+}
+
+/**
+ * This function will compile the URC table to a prefix trie dispatcher,
+ * the leading CR/LF of prefix is ignored and the duplicate entries are dropped.
+ *
+ * @param urc the URC table, it must be valid until the dispatcher deleted
+ * @param size the URC table size
+ *
+ * @return the dispatcher object, RT_NULL: no memory or table too large
+ */
+struct at_device_urc_dispatcher *at_device_urc_dispatcher_create(const struct at_urc *urc, rt_size_t size)
+{
+    rt_size_t i, j, node_max = 1;
+    const char *prefix = RT_NULL;
+    rt_int16_t node = 0, *entry = RT_NULL;
+    struct at_device_urc_dispatcher *dispatcher = RT_NULL;
+
+    RT_ASSERT(urc);
+
+    for (i = 0; i < size; i++)
+    {
+        node_max += rt_strlen(urc_prefix_skip_crlf(urc[i].cmd_prefix));
+    }
+
+    if (node_max > 0x7FFF || size > 0x7FFF)
+    {
+        LOG_E("URC table is too large to compile.");
+        return RT_NULL;
+    }
+
+    dispatcher = (struct at_device_urc_dispatcher *) rt_calloc(1, sizeof(struct at_device_urc_dispatcher));
+    if (dispatcher == RT_NULL)
+    {
+        goto __nomem;
+    }
+
+    dispatcher->nodes = (struct at_device_urc_node *) rt_calloc(node_max, sizeof(struct at_device_urc_node));
+    dispatcher->next = (rt_int16_t *) rt_calloc(size > 0 ? size : 1, sizeof(rt_int16_t));
+    if (dispatcher->nodes == RT_NULL || dispatcher->next == RT_NULL)
+    {
+        goto __nomem;
+    }
+
+    dispatcher->urc = urc;
+    dispatcher->urc_size = size;
+    dispatcher->node_num = 1;
+    dispatcher->nodes[0].child = -1;
+    dispatcher->nodes[0].sibling = -1;
+    dispatcher->nodes[0].entry = -1;
+
+    for (i = 0; i < size; i++)
+    {
+        dispatcher->next[i] = -1;
+
+        for (j = 0; j < i; j++)
+        {
+            if (urc_is_same(&urc[i], &urc[j]))
+            {
+                break;
+            }
+        }
+        if (j < i)
+        {
+            LOG_D("URC(%s%s) is duplicate, ignore it.", urc[i].cmd_prefix, urc[i].cmd_suffix);
+            continue;
+        }
+
+        node = 0;
+        for (prefix = urc_prefix_skip_crlf(urc[i].cmd_prefix); *prefix; prefix++)
+        {
+            node = urc_node_child(dispatcher, node, *prefix, RT_TRUE);
+        }
+
+        /* append to the tail, keep the entries in table order */
+        for (entry = &(dispatcher->nodes[node].entry); *entry >= 0; entry = &(dispatcher->next[*entry]));
+        *entry = (rt_int16_t) i;
+    }
+
+    return dispatcher;
+
+__nomem:
+    LOG_E("no memory for URC dispatcher create.");
+    at_device_urc_dispatcher_delete(dispatcher);
+
+    return RT_NULL;
+}
+
+/**
+ * This function will delete the URC dispatcher.
+ *
+ * @param dispatcher the dispatcher object
+ */
+void at_device_urc_dispatcher_delete(struct at_device_urc_dispatcher *dispatcher)
+{
+    if (dispatcher == RT_NULL)
+    {
+        return;
+    }
+
+    if (dispatcher->nodes)
+    {
+        rt_free(dispatcher->nodes);
+    }
+
+    if (dispatcher->next)
+    {
+        rt_free(dispatcher->next);
+    }
+
+    rt_free(dispatcher);
+}
+
+/**
+ * This function will match the URC line by the dispatcher, the matching cost is
+ * proportional to the line prefix length, not the URC table size.
+ * The same as the AT client, the first matched entry in table order is returned.
+ *
+ * @param dispatcher the dispatcher object
+ * @param data the URC line
+ * @param size the URC line size
+ *
+ * @return the matched URC entry, RT_NULL: no entry matched
+ */
+const struct at_urc *at_device_urc_match(struct at_device_urc_dispatcher *dispatcher,
+                                         const char *data, rt_size_t size)
+{
+    rt_size_t pos = 0, suffix_len = 0;
+    rt_int16_t node = 0, entry = -1, best = -1;
+    const struct at_urc *urc = RT_NULL;
+
+    RT_ASSERT(dispatcher);
+    RT_ASSERT(data);
+
+    while (pos < size && (data[pos] == '\r' || data[pos] == '\n'))
+    {
+        pos++;
+    }
+
+    while (node >= 0)
+    {
+        /* check the entries end on this node, only the first matched entry is needed */
+        for (entry = dispatcher->nodes[node].entry; entry >= 0 && (best < 0 || entry < best);
+                entry = dispatcher->next[entry])
+        {
+            urc = &(dispatcher->urc[entry]);
+            suffix_len = rt_strlen(urc->cmd_suffix);
+            if (size - pos >= suffix_len &&
+                    rt_strncmp(data + size - suffix_len, urc->cmd_suffix, suffix_len) == 0)
+            {
+                best = entry;
+                break;
+            }
+        }
+
+        if (pos >= size)
+        {
+            break;
+        }
+        node = urc_node_child(dispatcher, node, data[pos++], RT_FALSE);
+    }
+
+    return best >= 0 ? &(dispatcher->urc[best]) : RT_NULL;
+}
+
+/**
+ * This function will match the URC line and execute the entry function.
+ *
+ * @param dispatcher the dispatcher object
+ * @param client the AT client which receives the URC
+ * @param data the URC line
+ * @param size the URC line size
+ *
+ * @return  0: the URC is executed
+ *         -1: no entry matched
+ */
+int at_device_urc_exec(struct at_device_urc_dispatcher *dispatcher, struct at_client *client,
+                       const char *data, rt_size_t size)
+{
+    const struct at_urc *urc = RT_NULL;
+
+    urc = at_device_urc_match(dispatcher, data, size);
+    if (urc == RT_NULL || urc->func == RT_NULL)
+    {
+        return -RT_ERROR;
+    }
+
+    urc->func(client, data, size);
+
+    return RT_EOK;
+}
+
+/**
+ * This function will register the URC table to the AT client. The entries
+ * duplicated with a previous one, also the ones already registered on the client
+ * by another table, and the entries starting with CR LF, which the AT client
+ * finishes as an empty line and never matches, are not registered.
+ * The AT client matches every received character with all registered entries,
+ * so a smaller table makes the receive parser faster.
+ * The AT client appends every registered table and can not remove it, so the
+ * table registered again to the same client is ignored.
+ *
+ * @param client the AT client
+ * @param urc the URC table, it must be valid when the client is running
+ * @param size the URC table size
+ *
+ * @return  0: register success or registered already
+ *         -5: no memory
+ */
+int at_device_urc_set_table(struct at_client *client, const struct at_urc *urc, rt_size_t size)
+{
+    rt_size_t i, j, num = 0;
+    rt_uint8_t *skip = RT_NULL;
+    rt_slist_t *node = RT_NULL;
+    struct at_device_urc_table *reg = RT_NULL;
+    int result = RT_EOK;
+
+    RT_ASSERT(client);
+    RT_ASSERT(urc);
+
+    rt_enter_critical();
+    if (urc_lock_init == RT_FALSE)
+    {
+        rt_mutex_init(&urc_lock, "at_urc", RT_IPC_FLAG_PRIO);
+        urc_lock_init = RT_TRUE;
+    }
+    rt_exit_critical();
+
+    rt_mutex_take(&urc_lock, RT_WAITING_FOREVER);
+
+    rt_slist_for_each(node, &urc_table_list)
+    {
+        reg = rt_slist_entry(node, struct at_device_urc_table, list);
+        if (reg->client == client && reg->urc == urc)
+        {
+            /* registered already, the AT client keeps the previous table */
+            goto __exit;
+        }
+    }
+
+    reg = (struct at_device_urc_table *) rt_calloc(1, sizeof(struct at_device_urc_table));
+    skip = (rt_uint8_t *) rt_calloc(size > 0 ? size : 1, sizeof(rt_uint8_t));
+    if (reg == RT_NULL || skip == RT_NULL)
+    {
+        LOG_E("no memory for URC table check.");
+        result = -RT_ENOMEM;
+        goto __exit;
+    }
+
+    for (i = 0; i < size; i++)
+    {
+        if (rt_strncmp(urc[i].cmd_prefix, "\r\n", 2) == 0)
+        {
+            skip[i] = 1;
+            continue;
+        }
+
+        for (j = 0; j < i; j++)
+        {
+            if (skip[j] == 0 && urc_is_registered(&urc[i], &urc[j], 1))
+            {
+                skip[i] = 1;
+                break;
+            }
+        }
+
+        if (skip[i] == 0)
+        {
+            rt_slist_for_each(node, &urc_table_list)
+            {
+                struct at_device_urc_table *prev = rt_slist_entry(node, struct at_device_urc_table, list);
+
+                if (prev->client == client &&
+                        urc_is_registered(&urc[i], prev->table ? prev->table : prev->urc, prev->num))
+                {
+                    skip[i] = 1;
+                    break;
+                }
+            }
+        }
+
+        if (skip[i] == 0)
+        {
+            num++;
+        }
+    }
+
+    if (num == 0)
+    {
+        /* all entries are registered by other tables, nothing to keep */
+        rt_free(reg);
+        reg = RT_NULL;
+        goto __exit;
+    }
+
+    reg->client = client;
+    reg->urc = urc;
+    reg->num = num;
+
+    if (num < size)
+    {
+        /* the AT client keeps the table pointer, it is kept with the registered record */
+        reg->table = (struct at_urc *) rt_calloc(num, sizeof(struct at_urc));
+        if (reg->table == RT_NULL)
+        {
+            LOG_E("no memory for URC table create.");
+            result = -RT_ENOMEM;
+            goto __exit;
+        }
+
+        for (i = 0, j = 0; i < size; i++)
+        {
+            if (skip[i] == 0)
+            {
+                rt_memcpy(&(reg->table[j++]), &urc[i], sizeof(struct at_urc));
+            }
+            else
+            {
+                LOG_D("URC(%s) is unreachable or duplicate, ignore it.", urc[i].cmd_prefix);
+            }
+        }
+    }
+
+    result = at_obj_set_urc_table(client, reg->table ? reg->table : urc, num);
+    if (result < 0)
+    {
+        goto __exit;
+    }
+
+    rt_slist_append(&urc_table_list, &(reg->list));
+    reg = RT_NULL;
+
+__exit:
+    if (result < 0 && reg)
+    {
+        if (reg->table)
+        {
+            rt_free(reg->table);
+        }
+        rt_free(reg);
+    }
+
+    if (skip)
+    {
+        rt_free(skip);
+    }
+
+    rt_mutex_release(&urc_lock);
+
+    return result;
+}
@@ -0,0 +1,129 @@
+/*
+ * File      : at_device_work.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+#include <rtdevice.h>
+
+#include <at_device_work.h>
+
+#define LOG_TAG                        "at.dev.work"
+#include <at_log.h>
+
+/* AT device deferred work object, the argument data follows it */
+struct at_device_work
+{
+    struct rt_work work;
+    struct at_device *device;
+    at_device_work_func_t func;
+    rt_size_t arg_size;
+};
+
+static void at_device_work_entry(struct rt_work *work, void *work_data)
+{
+    struct at_device_work *device_work = (struct at_device_work *) work_data;
+
+    device_work->func(device_work->device, device_work->arg_size > 0 ? (void *) (device_work + 1) : RT_NULL);
+
+    rt_free(device_work);
+}
+
+/**
+ * This function will create the AT device deferred work queue, the AT client
+ * parser thread can not wait for a command response, so the URC function which
+ * needs to send a command defers it to this queue.
+ *
+ * @param device the AT device
+ *
+ * @return  0: create success or already created
+ *         -5: no memory
+ */
+int at_device_work_init(struct at_device *device)
+{
+    RT_ASSERT(device);
+
+    if (device->workqueue)
+    {
+        return RT_EOK;
+    }
+
+    device->workqueue = rt_workqueue_create(device->name, AT_DEVICE_WORK_STACK_SIZE, AT_DEVICE_WORK_PRIORITY);
+    if (device->workqueue == RT_NULL)
+    {
+        LOG_E("no memory for %s device work queue create.", device->name);
+        return -RT_ENOMEM;
+    }
+
+    return RT_EOK;
+}
+
+/**
+ * This function will run the function in the AT device work queue. The argument
+ * is copied, so the caller can pass the data on its stack.
+ *
+ * @param device the AT device
+ * @param func the work function
+ * @param arg the argument data, it can be RT_NULL
+ * @param arg_size the argument data size
+ *
+ * @return  0: submit success
+ *         -1: the work queue is not created
+ *         -5: no memory
+ */
+int at_device_work_submit(struct at_device *device, at_device_work_func_t func,
+                          const void *arg, rt_size_t arg_size)
+{
+    struct at_device_work *device_work = RT_NULL;
+
+    RT_ASSERT(device);
+    RT_ASSERT(func);
+
+    if (device->workqueue == RT_NULL)
+    {
+        LOG_E("%s device work queue is not created.", device->name);
+        return -RT_ERROR;
+    }
+
+    device_work = (struct at_device_work *) rt_malloc(sizeof(struct at_device_work) + arg_size);
+    if (device_work == RT_NULL)
+    {
+        LOG_E("no memory for %s device work create.", device->name);
+        return -RT_ENOMEM;
+    }
+
+    device_work->device = device;
+    device_work->func = func;
+    device_work->arg_size = arg ? arg_size : 0;
+    if (device_work->arg_size > 0)
+    {
+        rt_memcpy(device_work + 1, arg, arg_size);
+    }
+
+    rt_work_init(&(device_work->work), at_device_work_entry, device_work);
+    if (rt_workqueue_dowork(device->workqueue, &(device_work->work)) != RT_EOK)
+    {
+        rt_free(device_work);
+        return -RT_ERROR;
+    }
+
+    return RT_EOK;
+}
@@ -0,0 +1,63 @@
+/*
+ * File      : at.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+/* the host shim of the AT client types used by the host tests */
+
+#ifndef __AT_H__
+#define __AT_H__
+
+#include <rtthread.h>
+
+#define AT_CMD_MAX_LEN                 128
+
+struct at_client;
+
+struct at_urc
+{
+    const char *cmd_prefix;
+    const char *cmd_suffix;
+    void (*func)(struct at_client *client, const char *data, rt_size_t size);
+};
+
+/* the host test keeps the registered URC tables the same as the AT client */
+struct at_urc_table
+{
+    rt_size_t urc_size;
+    const struct at_urc *urc;
+};
+
+struct at_client
+{
+    rt_device_t device;
+    char *recv_line_buf;
+    rt_size_t recv_line_len;
+    struct at_urc_table *urc_table;
+    rt_size_t urc_table_size;
+};
+typedef struct at_client *at_client_t;
+
+/* implemented by the host test */
+int at_obj_set_urc_table(struct at_client *client, const struct at_urc *table, rt_size_t size);
+
+#endif /* __AT_H__ */
@@ -0,0 +1,219 @@
+/*
+ * File      : parser_bench.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+/*
+ * Host benchmark of the URC field parsing. Every line is parsed with the
+ * sscanf() format the device class used before and with at_device_parser the
+ * same way the device class does now. The benchmark fails when the results
+ * are different.
+ *
+ * build and run on the host:
+ *   gcc -O2 -Itests/host -Iinc -o parser_bench tests/host/parser_bench.c src/at_device_parser.c
+ *   ./parser_bench [rounds]
+ */
+
+#include <time.h>
+
+#include <at_device_parser.h>
+
+#define BENCH_ROUNDS_DEFAULT           200000
+
+/* keep the compiler from hoisting the parsing out of the rounds loop */
+#define BENCH_BARRIER()                __asm__ __volatile__("" ::: "memory")
+
+struct bench_result
+{
+    int socket;
+    int value;
+    int port;
+    int size;
+    char ip[16];
+};
+
+struct bench_case
+{
+    const char *name;
+    const char *line;
+    int (*scan)(const char *line, rt_size_t size, struct bench_result *result);
+    int (*parse)(const char *line, rt_size_t size, struct bench_result *result);
+};
+
+/* class/esp8266/at_socket_esp8266.c urc_recv_func() */
+static int esp8266_ipd_scan(const char *line, rt_size_t size, struct bench_result *result)
+{
+    return sscanf(line, "+IPD,%d,%d:", &result->socket, &result->size) == 2 ? 0 : -1;
+}
+
+static int esp8266_ipd_parse(const char *line, rt_size_t size, struct bench_result *result)
+{
+    struct at_device_parser parser;
+
+    at_device_parser_init(&parser, line, size);
+    if (at_device_parser_expect(&parser, "+IPD,") < 0 ||
+            at_device_parser_int(&parser, &result->socket) < 0 ||
+            at_device_parser_int(&parser, &result->size) < 0)
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+/* class/ec20/at_socket_ec20.c urc_recv_func() */
+static int ec20_recv_scan(const char *line, rt_size_t size, struct bench_result *result)
+{
+    return sscanf(line, "+QIURC: \"recv\",%d,%d", &result->socket, &result->size) == 2 ? 0 : -1;
+}
+
+static int ec20_recv_parse(const char *line, rt_size_t size, struct bench_result *result)
+{
+    struct at_device_parser parser;
+
+    at_device_parser_init(&parser, line, size);
+    if (at_device_parser_expect(&parser, "+QIURC: \"recv\",") < 0 ||
+            at_device_parser_int(&parser, &result->socket) < 0 ||
+            at_device_parser_int(&parser, &result->size) < 0)
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+/* class/ec20/at_socket_ec20.c urc_connect_func() */
+static int ec20_open_scan(const char *line, rt_size_t size, struct bench_result *result)
+{
+    return sscanf(line, "+QIOPEN: %d,%d", &result->socket, &result->value) == 2 ? 0 : -1;
+}
+
+static int ec20_open_parse(const char *line, rt_size_t size, struct bench_result *result)
+{
+    struct at_device_parser parser;
+
+    at_device_parser_init(&parser, line, size);
+    if (at_device_parser_expect(&parser, "+QIOPEN:") < 0 ||
+            at_device_parser_int(&parser, &result->socket) < 0 ||
+            at_device_parser_int(&parser, &result->value) < 0)
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+/* class/bc28/at_socket_bc28.c urc_recv_func() */
+static int bc28_nsonmi_scan(const char *line, rt_size_t size, struct bench_result *result)
+{
+    return sscanf(line, "+NSONMI:%d,%15[0-9.],%d,%d", &result->socket, result->ip,
+                  &result->port, &result->size) == 4 ? 0 : -1;
+}
+
+static int bc28_nsonmi_parse(const char *line, rt_size_t size, struct bench_result *result)
+{
+    struct at_device_parser parser;
+
+    at_device_parser_init(&parser, line, size);
+    if (at_device_parser_expect(&parser, "+NSONMI:") < 0 ||
+            at_device_parser_int(&parser, &result->socket) < 0 ||
+            at_device_parser_ipv4(&parser, result->ip) < 0 ||
+            at_device_parser_int(&parser, &result->port) < 0 ||
+            at_device_parser_int(&parser, &result->size) < 0)
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+static const struct bench_case bench_cases[] =
+{
+    {"esp8266 +IPD",   "+IPD,0,1460:",                                 esp8266_ipd_scan,  esp8266_ipd_parse},
+    {"ec20 recv",      "+QIURC: \"recv\",11,1460\r\n",                 ec20_recv_scan,    ec20_recv_parse},
+    {"ec20 open",      "+QIOPEN: 2,0\r\n",                             ec20_open_scan,    ec20_open_parse},
+    {"bc28 +NSONMI",   "+NSONMI:1,192.168.100.200,5683,512\r\n",       bc28_nsonmi_scan,  bc28_nsonmi_parse},
+};
+
+static double bench_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int bench_run(const struct bench_case *bench, int rounds)
+{
+    struct bench_result scan_result, parse_result;
+    rt_size_t size = strlen(bench->line);
+    double start, scan_ns, parse_ns;
+    int i, fails = 0;
+
+    memset(&scan_result, 0, sizeof(scan_result));
+    memset(&parse_result, 0, sizeof(parse_result));
+    if (bench->scan(bench->line, size, &scan_result) < 0 ||
+            bench->parse(bench->line, size, &parse_result) < 0 ||
+            memcmp(&scan_result, &parse_result, sizeof(scan_result)) != 0)
+    {
+        printf("%-14s sscanf and parser results are different\n", bench->name);
+        return -1;
+    }
+
+    start = bench_now_ns();
+    for (i = 0; i < rounds; i++)
+    {
+        fails += bench->scan(bench->line, size, &scan_result) < 0;
+        BENCH_BARRIER();
+    }
+    scan_ns = (bench_now_ns() - start) / rounds;
+
+    start = bench_now_ns();
+    for (i = 0; i < rounds; i++)
+    {
+        fails += bench->parse(bench->line, size, &parse_result) < 0;
+        BENCH_BARRIER();
+    }
+    parse_ns = (bench_now_ns() - start) / rounds;
+
+    printf("%-14s sscanf %7.1f ns/line, parser %7.1f ns/line\n", bench->name, scan_ns, parse_ns);
+
+    return fails == 0 ? 0 : -1;
+}
+
+int main(int argc, char *argv[])
+{
+    int rounds = BENCH_ROUNDS_DEFAULT, result = 0;
+    rt_size_t i;
+
+    if (argc > 1)
+    {
+        rounds = atoi(argv[1]) > 0 ? atoi(argv[1]) : BENCH_ROUNDS_DEFAULT;
+    }
+
+    for (i = 0; i < sizeof(bench_cases) / sizeof(bench_cases[0]); i++)
+    {
+        result |= bench_run(&bench_cases[i], rounds);
+    }
+
+    return result == 0 ? 0 : 1;
+}
@@ -0,0 +1,279 @@
+/*
+ * File      : parser_fuzz.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+/*
+ * Fuzz target of at_device_parser. The first bytes of the input select the
+ * parser calls, the rest is the received line. The line and every output buffer
+ * are allocated with the exact size and without '\0', so the address sanitizer
+ * reports any read or write out of them. After every call it also checks:
+ *
+ *  - the position never goes past the line size;
+ *  - a failed call leaves the position where it was;
+ *  - a parsed string is '\0' terminated inside its buffer with the returned length;
+ *  - a parsed IPv4 address is four dotted numbers not greater than 255.
+ *
+ * build and run with libFuzzer:
+ *   clang -g -O1 -fsanitize=fuzzer,address,undefined -DPARSER_FUZZ_LIBFUZZER -Itests/host -Iinc \
+ *       -o parser_fuzz tests/host/parser_fuzz.c src/at_device_parser.c
+ *   ./parser_fuzz -max_len=256 [corpus]
+ *
+ * build and run with the standalone driver, it mutates URC shaped lines and
+ * replays the input files when they are given:
+ *   gcc -g -O1 -fsanitize=address,undefined -Itests/host -Iinc \
+ *       -o parser_fuzz tests/host/parser_fuzz.c src/at_device_parser.c
+ *   ./parser_fuzz [iterations | files...]
+ */
+
+#include <at_device_parser.h>
+
+#define FUZZ_OPS_MAX                   8
+#define FUZZ_LINE_MAX                  256
+#define FUZZ_ITERATIONS_DEFAULT        2000000
+
+#define FUZZ_CHECK(EX)                                                          \
+    do                                                                          \
+    {                                                                           \
+        if (!(EX))                                                              \
+        {                                                                       \
+            fprintf(stderr, "check %s failed at %s:%d\n", #EX, __FILE__, __LINE__);\
+            abort();                                                            \
+        }                                                                       \
+    } while (0)
+
+static const char *fuzz_literals[] =
+{
+    "+IPD,", "+QIURC: \"recv\",", "+NSONMI:", "Recv", " ", ",", "\"", ""
+};
+
+static void fuzz_check_ipv4(const char *ip)
+{
+    int a, b, c, d;
+    char tail;
+
+    FUZZ_CHECK(sscanf(ip, "%d.%d.%d.%d%c", &a, &b, &c, &d, &tail) == 4);
+    FUZZ_CHECK(a <= 255 && b <= 255 && c <= 255 && d <= 255);
+}
+
+static void fuzz_one(const rt_uint8_t *data, rt_size_t size)
+{
+    struct at_device_parser parser;
+    rt_size_t ops_num, i, pos, value_size, rest_size, out_size;
+    const rt_uint8_t *ops;
+    const char *rest;
+    char *line, *out, ip[16];
+    int value, result;
+
+    if (size == 0)
+    {
+        return;
+    }
+
+    ops_num = data[0] % FUZZ_OPS_MAX + 1;
+    if (size < 1 + ops_num)
+    {
+        return;
+    }
+    ops = data + 1;
+    data += 1 + ops_num;
+    size -= 1 + ops_num;
+
+    /* no '\0' after the line, the sanitizer catches the reads past it */
+    line = (char *) malloc(size ? size : 1);
+    FUZZ_CHECK(line);
+    memcpy(line, data, size);
+
+    at_device_parser_init(&parser, line, size);
+    for (i = 0; i < ops_num; i++)
+    {
+        pos = parser.pos;
+        out_size = (ops[i] >> 3) % 20 + 1;
+
+        switch (ops[i] % 9)
+        {
+        case 0:
+            result = at_device_parser_expect(&parser, fuzz_literals[(ops[i] >> 4) % (sizeof(fuzz_literals) / sizeof(fuzz_literals[0]))]);
+            break;
+        case 1:
+            result = at_device_parser_skip_to(&parser, (ops[i] & 0x10) ? ',' : ':');
+            break;
+        case 2:
+            result = at_device_parser_int(&parser, &value);
+            break;
+        case 3:
+            result = at_device_parser_size(&parser, &value_size);
+            FUZZ_CHECK(result < 0 || (int) value_size >= 0);
+            break;
+        case 4:
+            out = (char *) malloc(out_size);
+            FUZZ_CHECK(out);
+            result = at_device_parser_str(&parser, out, out_size);
+            if (result >= 0)
+            {
+                FUZZ_CHECK((rt_size_t) result < out_size);
+                FUZZ_CHECK(out[result] == '\0' && strlen(out) == (rt_size_t) result);
+            }
+            free(out);
+            break;
+        case 5:
+            result = at_device_parser_ipv4(&parser, ip);
+            if (result == 0)
+            {
+                fuzz_check_ipv4(ip);
+            }
+            break;
+        case 6:
+            result = at_device_parser_skip(&parser);
+            break;
+        case 7:
+            out = (char *) malloc(out_size);
+            FUZZ_CHECK(out);
+            result = at_device_parser_hex(&parser, out, out_size);
+            free(out);
+            break;
+        default:
+            rest = at_device_parser_rest(&parser, &rest_size);
+            FUZZ_CHECK(rest == line + parser.pos && parser.pos + rest_size <= size);
+            result = 0;
+            break;
+        }
+
+        FUZZ_CHECK(parser.pos <= size);
+        if (result < 0)
+        {
+            FUZZ_CHECK(parser.pos == pos);
+        }
+    }
+
+    free(line);
+}
+
+int LLVMFuzzerTestOneInput(const rt_uint8_t *data, rt_size_t size)
+{
+    fuzz_one(data, size);
+    return 0;
+}
+
+#ifndef PARSER_FUZZ_LIBFUZZER
+
+/* the pieces of the URC lines the device classes parse */
+static const char *fuzz_tokens[] =
+{
+    "+IPD,", "+QIURC: ", "\"recv\"", "\"closed\"", "+NSONMI:", "+QIOPEN: ",
+    "0", "1", "128", "5683", "-1", "+2", "2147483647", "2147483648", "-2147483648", "99999999999",
+    "192.168.1.100", "10.0.0.1", "256.1.1.1", "1.2.3", "1..2.3", "1.2.3.4.5",
+    "AABBCCDD", "0f", "zz", "\"", "\"\"", ",", ",,", " ", "  ", ":", ".", "\r\n", "\r", "\n", "\0",
+};
+
+static rt_uint32_t fuzz_seed = 0x2026;
+
+static rt_uint32_t fuzz_rand(void)
+{
+    fuzz_seed = fuzz_seed * 1103515245 + 12345;
+    return fuzz_seed >> 8;
+}
+
+static rt_size_t fuzz_generate(rt_uint8_t *buf, rt_size_t size)
+{
+    rt_size_t len = 0, i, ops_num = fuzz_rand() % FUZZ_OPS_MAX + 1;
+
+    buf[len++] = (rt_uint8_t) (ops_num - 1);
+    for (i = 0; i < ops_num; i++)
+    {
+        buf[len++] = (rt_uint8_t) fuzz_rand();
+    }
+
+    while (len < size && fuzz_rand() % 16 != 0)
+    {
+        if (fuzz_rand() % 4 == 0)
+        {
+            /* random byte */
+            buf[len++] = (rt_uint8_t) fuzz_rand();
+        }
+        else
+        {
+            const char *token = fuzz_tokens[fuzz_rand() % (sizeof(fuzz_tokens) / sizeof(fuzz_tokens[0]))];
+            rt_size_t token_len = strlen(token) ? strlen(token) : 1;
+
+            for (i = 0; i < token_len && len < size; i++)
+            {
+                buf[len++] = (rt_uint8_t) token[i];
+            }
+        }
+    }
+
+    return len;
+}
+
+static int fuzz_replay(const char *path)
+{
+    rt_uint8_t buf[FUZZ_LINE_MAX];
+    rt_size_t len;
+    FILE *fp = fopen(path, "rb");
+
+    if (fp == RT_NULL)
+    {
+        printf("open %s failed\n", path);
+        return -1;
+    }
+    len = fread(buf, 1, sizeof(buf), fp);
+    fclose(fp);
+
+    fuzz_one(buf, len);
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    rt_uint8_t buf[FUZZ_LINE_MAX];
+    long iterations = FUZZ_ITERATIONS_DEFAULT, i;
+
+    if (argc > 1 && atol(argv[1]) <= 0)
+    {
+        for (i = 1; i < argc; i++)
+        {
+            if (fuzz_replay(argv[i]) < 0)
+            {
+                return 1;
+            }
+        }
+        printf("replayed %d inputs\n", argc - 1);
+        return 0;
+    }
+
+    if (argc > 1)
+    {
+        iterations = atol(argv[1]);
+    }
+
+    for (i = 0; i < iterations; i++)
+    {
+        fuzz_one(buf, fuzz_generate(buf, (rt_size_t) (fuzz_rand() % sizeof(buf)) + 1));
+    }
+    printf("%ld inputs passed\n", iterations);
+
+    return 0;
+}
+
+#endif /* PARSER_FUZZ_LIBFUZZER */
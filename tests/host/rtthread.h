@@ -0,0 +1,129 @@
+/*
+ * File      : rtthread.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+/* the host shim of the RT-Thread kernel API used by the host tests, single thread only */
+
+#ifndef __RTTHREAD_H__
+#define __RTTHREAD_H__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+
+typedef int                 rt_bool_t;
+typedef long                rt_base_t;
+typedef unsigned long       rt_ubase_t;
+typedef long                rt_err_t;
+typedef int8_t              rt_int8_t;
+typedef int16_t             rt_int16_t;
+typedef int32_t             rt_int32_t;
+typedef uint8_t             rt_uint8_t;
+typedef uint16_t            rt_uint16_t;
+typedef uint32_t            rt_uint32_t;
+typedef uint64_t            rt_uint64_t;
+typedef size_t              rt_size_t;
+typedef uint32_t            rt_tick_t;
+
+#define RT_TRUE             1
+#define RT_FALSE            0
+#define RT_NULL             ((void *) 0)
+
+#define RT_EOK              0
+#define RT_ERROR            1
+#define RT_ETIMEOUT         2
+#define RT_EFULL            3
+#define RT_EEMPTY           4
+#define RT_ENOMEM           5
+#define RT_ENOSYS           6
+#define RT_EBUSY            7
+#define RT_EIO              8
+#define RT_EINTR            9
+#define RT_EINVAL           10
+
+#define RT_NAME_MAX         8
+#define RT_WAITING_FOREVER  -1
+#define RT_IPC_FLAG_FIFO    0x00
+#define RT_IPC_FLAG_PRIO    0x01
+
+#define RT_ASSERT(EX)       do { if (!(EX)) { printf("assert %s failed at %s:%d\n", #EX, __FILE__, __LINE__); abort(); } } while (0)
+
+/* single list */
+typedef struct rt_slist_node
+{
+    struct rt_slist_node *next;
+} rt_slist_t;
+
+#define RT_SLIST_OBJECT_INIT(object) { RT_NULL }
+#define rt_container_of(ptr, type, member) \
+    ((type *)((char *)(ptr) - (unsigned long)(&((type *)0)->member)))
+#define rt_slist_entry(node, type, member) rt_container_of(node, type, member)
+#define rt_slist_for_each(pos, head) \
+    for (pos = (head)->next; pos != RT_NULL; pos = pos->next)
+
+static inline void rt_slist_append(rt_slist_t *l, rt_slist_t *n)
+{
+    while (l->next)
+    {
+        l = l->next;
+    }
+    l->next = n;
+    n->next = RT_NULL;
+}
+
+/* kernel objects, the host tests run in one thread */
+struct rt_object
+{
+    char name[RT_NAME_MAX];
+};
+struct rt_mutex
+{
+    struct rt_object parent;
+};
+typedef struct rt_mutex *rt_mutex_t;
+typedef struct rt_device *rt_device_t;
+
+static inline rt_err_t rt_mutex_init(rt_mutex_t mutex, const char *name, rt_uint8_t flag) { return RT_EOK; }
+static inline rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time) { return RT_EOK; }
+static inline rt_err_t rt_mutex_release(rt_mutex_t mutex) { return RT_EOK; }
+static inline void rt_enter_critical(void) {}
+static inline void rt_exit_critical(void) {}
+
+/* memory and string */
+#define rt_malloc           malloc
+#define rt_calloc           calloc
+#define rt_realloc          realloc
+#define rt_free             free
+#define rt_memcpy           memcpy
+#define rt_memset           memset
+#define rt_memcmp           memcmp
+#define rt_strlen           strlen
+#define rt_strcmp           strcmp
+#define rt_strncmp          strncmp
+#define rt_strstr           strstr
+#define rt_snprintf         snprintf
+#define rt_kprintf          printf
+
+#endif /* __RTTHREAD_H__ */
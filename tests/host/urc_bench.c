@@ -0,0 +1,405 @@
+/*
+ * File      : urc_bench.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        first version
+ */
+
+/*
+ * Host benchmark of the URC matching with the full esp8266 and ec20 tables
+ * under a mixed URC and response load. It compares:
+ *
+ *  - raw:    the AT client linear scan on every received character over the
+ *            tables as they are written in the device classes;
+ *  - pruned: the same scan over the entries at_device_urc_set_table() registers;
+ *  - trie:   at_device_urc_match() when a line ends or a ":" suffix received.
+ *
+ * Every line is also checked that the trie returns the entry the AT client
+ * linear scan returns, the benchmark fails when they are different.
+ *
+ * build and run on the host:
+ *   gcc -O2 -Itests/host -Iinc -o urc_bench tests/host/urc_bench.c src/at_device_urc.c
+ *   ./urc_bench [rounds]
+ */
+
+#include <time.h>
+
+#include <at_device_urc.h>
+
+#define BENCH_ROUNDS_DEFAULT           20000
+#define BENCH_TABLE_MAX                16
+
+/* keep the compiler from hoisting the matching out of the rounds loop */
+#define BENCH_BARRIER()                __asm__ __volatile__("" ::: "memory")
+
+static void urc_func(struct at_client *client, const char *data, rt_size_t size) {}
+static void urc_send_func(struct at_client *client, const char *data, rt_size_t size) {}
+static void urc_recv_func(struct at_client *client, const char *data, rt_size_t size) {}
+static void urc_close_func(struct at_client *client, const char *data, rt_size_t size) {}
+static void urc_connect_func(struct at_client *client, const char *data, rt_size_t size) {}
+static void urc_app_func(struct at_client *client, const char *data, rt_size_t size) {}
+static void urc_boot_func(struct at_client *client, const char *data, rt_size_t size) {}
+
+/* class/esp8266/at_device_esp8266.c */
+static const struct at_urc esp8266_device_table[] =
+{
+    {"busy p",           "\r\n",           urc_func},
+    {"busy s",           "\r\n",           urc_func},
+    {"WIFI CONNECTED",   "\r\n",           urc_func},
+    {"WIFI DISCONNECT",  "\r\n",           urc_func},
+};
+
+/* class/esp8266/at_socket_esp8266.c, with AT_USING_SOCKET_SERVER */
+static const struct at_urc esp8266_socket_table[] =
+{
+    {"SEND OK",          "\r\n",           urc_send_func},
+    {"SEND FAIL",        "\r\n",           urc_send_func},
+    {"Recv",             "bytes\r\n",      urc_send_func},
+    {"",                 ",CLOSED\r\n",    urc_close_func},
+    {"",                 ",CONNECT\r\n",   urc_connect_func},
+    {"+IPD",             ":",              urc_recv_func},
+};
+
+/* src/at_device_boot.c, the ec20 boot steps with URC */
+static const struct at_urc ec20_boot_table[] =
+{
+    {"+CPIN:",           "\r\n",           urc_boot_func},
+    {"+CREG:",           "\r\n",           urc_boot_func},
+};
+
+/* class/ec20/at_socket_ec20.c */
+static const struct at_urc ec20_socket_table[] =
+{
+    {"SEND OK",     "\r\n",                 urc_send_func},
+    {"SEND FAIL",   "\r\n",                 urc_send_func},
+    {"+QIOPEN:",    "\r\n",                 urc_connect_func},
+    {"+QIURC:",     "\r\n",                 urc_func},
+    {"+QSSLOPEN:",  "\r\n",                 urc_connect_func},
+    {"+QSSLURC: \"recv\"",   "\r\n",        urc_recv_func},
+    {"+QSSLURC: \"closed\"", "\r\n",        urc_close_func},
+};
+
+/* src/at_device_mqtt.c */
+static const struct at_urc ec20_mqtt_table[] =
+{
+    {"+QMTOPEN:",   "\r\n",                 urc_app_func},
+    {"+QMTCLOSE:",  "\r\n",                 urc_app_func},
+    {"+QMTCONN:",   "\r\n",                 urc_app_func},
+    {"+QMTDISC:",   "\r\n",                 urc_app_func},
+    {"+QMTSUB:",    "\r\n",                 urc_app_func},
+    {"+QMTUNS:",    "\r\n",                 urc_app_func},
+    {"+QMTPUB:",    "\r\n",                 urc_app_func},
+    {"+QMTPUBEX:",  "\r\n",                 urc_app_func},
+    {"+QMTSTAT:",   "\r\n",                 urc_app_func},
+    {"+QMTRECV:",   "\r\n",                 urc_recv_func},
+};
+
+/* class/ec20/at_file_ec20.c, at_http_ec20.c and at_ftp_ec20.c */
+static const struct at_urc ec20_file_table[] =
+{
+    {"CONNECT ",    "\r\n",                 urc_func},
+};
+
+static const struct at_urc ec20_http_table[] =
+{
+    {"+QHTTPGET:",       "\r\n",            urc_app_func},
+    {"+QHTTPPOST:",      "\r\n",            urc_app_func},
+    {"+QHTTPPOSTFILE:",  "\r\n",            urc_app_func},
+    {"+QHTTPREADFILE:",  "\r\n",            urc_app_func},
+};
+
+static const struct at_urc ec20_ftp_table[] =
+{
+    {"+QFTPOPEN:",       "\r\n",            urc_app_func},
+    {"+QFTPCLOSE:",      "\r\n",            urc_app_func},
+    {"+QFTPCWD:",        "\r\n",            urc_app_func},
+    {"+QFTPSIZE:",       "\r\n",            urc_app_func},
+    {"+QFTPGET:",        "\r\n",            urc_app_func},
+    {"+QFTPPUT:",        "\r\n",            urc_app_func},
+    {"+QFTPLEN:",        "\r\n",            urc_app_func},
+};
+
+/* the ec20 socket, MQTT and application tables are registered twice, the same as netdev set up again */
+static const struct at_urc *ec20_register[] =
+{
+    ec20_boot_table, ec20_socket_table, ec20_mqtt_table, ec20_file_table,
+    ec20_http_table, ec20_ftp_table, ec20_socket_table, ec20_mqtt_table,
+};
+static const rt_size_t ec20_register_size[] =
+{
+    2, 7, 10, 1, 4, 7, 7, 10,
+};
+
+static const struct at_urc *esp8266_register[] =
+{
+    esp8266_device_table, esp8266_socket_table, esp8266_socket_table,
+};
+static const rt_size_t esp8266_register_size[] =
+{
+    4, 6, 6,
+};
+
+/* the mixed received lines, responses and URCs */
+static const char *esp8266_lines[] =
+{
+    "OK\r\n", "AT+CIPSEND=0,128\r\n", "SEND OK\r\n", "+IPD,0,5:", "0,CLOSED\r\n", "1,CONNECT\r\n",
+    "busy p...\r\n", "+CIPSTA:ip:\"192.168.1.10\"\r\n", "WIFI CONNECTED\r\n", "ERROR\r\n",
+    "Recv 128 bytes\r\n", "WIFI GOT IP\r\n",
+};
+
+static const char *ec20_lines[] =
+{
+    "OK\r\n", "+CSQ: 20,99\r\n", "+QIURC: \"recv\",0,128\r\n", "+QIOPEN: 0,0\r\n", "SEND OK\r\n",
+    "+QMTRECV: 0,1,\"topic\",\"payload\"\r\n", "+QMTPUB: 0,1,0\r\n", "+CREG: 0,1\r\n", "+QIACT: 1,1,1,\"10.0.0.1\"\r\n",
+    "+QHTTPGET: 0,200,512\r\n", "+QFTPGET: 0,1024\r\n", "+QSSLURC: \"recv\",1,64\r\n", "ERROR\r\n",
+    "CONNECT 128\r\n", "+CGREG: 0,1\r\n", "+QIURC: \"closed\",0\r\n",
+};
+
+/* the AT clients of the esp8266 and ec20 devices */
+static struct at_urc_table esp8266_tables[BENCH_TABLE_MAX];
+static struct at_urc_table ec20_tables[BENCH_TABLE_MAX];
+static struct at_client esp8266_client = { RT_NULL, RT_NULL, 0, esp8266_tables, 0 };
+static struct at_client ec20_client = { RT_NULL, RT_NULL, 0, ec20_tables, 0 };
+
+int at_obj_set_urc_table(struct at_client *client, const struct at_urc *table, rt_size_t size)
+{
+    RT_ASSERT(client->urc_table_size < BENCH_TABLE_MAX);
+
+    client->urc_table[client->urc_table_size].urc = table;
+    client->urc_table[client->urc_table_size].urc_size = size;
+    client->urc_table_size++;
+
+    return RT_EOK;
+}
+
+/* the same as get_urc_obj() of the AT client */
+static const struct at_urc *client_urc_get(struct at_urc_table *tables, rt_size_t table_size,
+                                           const char *buffer, rt_size_t bufsz)
+{
+    rt_size_t i, j, prefix_len, suffix_len;
+    const struct at_urc *urc = RT_NULL;
+
+    for (i = 0; i < table_size; i++)
+    {
+        for (j = 0; j < tables[i].urc_size; j++)
+        {
+            urc = &(tables[i].urc[j]);
+
+            prefix_len = rt_strlen(urc->cmd_prefix);
+            suffix_len = rt_strlen(urc->cmd_suffix);
+            if (bufsz < prefix_len + suffix_len)
+            {
+                continue;
+            }
+            if ((prefix_len ? !rt_strncmp(buffer, urc->cmd_prefix, prefix_len) : 1)
+                    && (suffix_len ? !rt_strncmp(buffer + bufsz - suffix_len, urc->cmd_suffix, suffix_len) : 1))
+            {
+                return urc;
+            }
+        }
+    }
+
+    return RT_NULL;
+}
+
+/* the AT client matches the URC table when each character received */
+static const struct at_urc *client_line_scan(struct at_urc_table *tables, rt_size_t table_size, const char *line)
+{
+    rt_size_t len, size = rt_strlen(line);
+    const struct at_urc *urc = RT_NULL;
+
+    for (len = 1; len <= size; len++)
+    {
+        urc = client_urc_get(tables, table_size, line, len);
+        if (urc)
+        {
+            return urc;
+        }
+    }
+
+    return RT_NULL;
+}
+
+/* the trie matches the complete line, or the line ends on the first matched URC suffix */
+static const struct at_urc *trie_line_scan(struct at_device_urc_dispatcher *dispatcher, const char *line)
+{
+    rt_size_t len, size = rt_strlen(line);
+    const struct at_urc *urc = RT_NULL;
+
+    for (len = 1; len <= size; len++)
+    {
+        if (line[len - 1] != '\n' && line[len - 1] != ':' && len != size)
+        {
+            continue;
+        }
+
+        urc = at_device_urc_match(dispatcher, line, len);
+        if (urc)
+        {
+            return urc;
+        }
+    }
+
+    return RT_NULL;
+}
+
+static double bench_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static rt_size_t bench_entries(struct at_urc_table *tables, rt_size_t table_size)
+{
+    rt_size_t i, num = 0;
+
+    for (i = 0; i < table_size; i++)
+    {
+        num += tables[i].urc_size;
+    }
+
+    return num;
+}
+
+static int bench_run(const char *name, struct at_client *client, const struct at_urc **reg, const rt_size_t *reg_size, rt_size_t reg_num,
+                     const char **lines, rt_size_t line_num, int rounds)
+{
+    rt_size_t i, j, urc_num = 0;
+    int round, result = 0;
+    struct at_urc_table raw[BENCH_TABLE_MAX];
+    struct at_urc *all = RT_NULL;
+    struct at_device_urc_dispatcher *dispatcher = RT_NULL;
+    const struct at_urc *expect = RT_NULL, *match = RT_NULL;
+    rt_size_t hits = 0;
+    double start, raw_ns, pruned_ns, trie_ns;
+
+    /* the tables as written in the device classes and registered as it */
+    for (i = 0; i < reg_num; i++)
+    {
+        raw[i].urc = reg[i];
+        raw[i].urc_size = reg_size[i];
+        urc_num += reg_size[i];
+    }
+
+    /* the tables registered by the URC helper */
+    for (i = 0; i < reg_num; i++)
+    {
+        if (at_device_urc_set_table(client, reg[i], reg_size[i]) < 0)
+        {
+            printf("%s: URC table register failed.\n", name);
+            return -1;
+        }
+    }
+
+    /* the trie over all entries in registered order */
+    all = (struct at_urc *) rt_calloc(urc_num, sizeof(struct at_urc));
+    for (i = 0, urc_num = 0; i < reg_num; i++)
+    {
+        rt_memcpy(&all[urc_num], reg[i], reg_size[i] * sizeof(struct at_urc));
+        urc_num += reg_size[i];
+    }
+    dispatcher = at_device_urc_dispatcher_create(all, urc_num);
+    RT_ASSERT(dispatcher);
+
+    for (j = 0; j < line_num; j++)
+    {
+        expect = client_line_scan(raw, reg_num, lines[j]);
+        match = client_line_scan(client->urc_table, client->urc_table_size, lines[j]);
+        if (match != expect && (match == RT_NULL || expect == RT_NULL ||
+                rt_strcmp(match->cmd_prefix, expect->cmd_prefix) || match->func != expect->func))
+        {
+            printf("%s: pruned table mismatch on line %s", name, lines[j]);
+            result = -1;
+        }
+
+        match = trie_line_scan(dispatcher, lines[j]);
+        if (match != expect && (match == RT_NULL || expect == RT_NULL ||
+                rt_strcmp(match->cmd_prefix, expect->cmd_prefix) || match->func != expect->func))
+        {
+            printf("%s: trie mismatch on line %s", name, lines[j]);
+            result = -1;
+        }
+    }
+
+    start = bench_now_ns();
+    for (round = 0; round < rounds; round++)
+    {
+        for (j = 0; j < line_num; j++)
+        {
+            hits += client_line_scan(raw, reg_num, lines[j]) != RT_NULL;
+            BENCH_BARRIER();
+        }
+    }
+    raw_ns = bench_now_ns() - start;
+
+    start = bench_now_ns();
+    for (round = 0; round < rounds; round++)
+    {
+        for (j = 0; j < line_num; j++)
+        {
+            hits += client_line_scan(client->urc_table, client->urc_table_size, lines[j]) != RT_NULL;
+            BENCH_BARRIER();
+        }
+    }
+    pruned_ns = bench_now_ns() - start;
+
+    start = bench_now_ns();
+    for (round = 0; round < rounds; round++)
+    {
+        for (j = 0; j < line_num; j++)
+        {
+            hits += trie_line_scan(dispatcher, lines[j]) != RT_NULL;
+            BENCH_BARRIER();
+        }
+    }
+    trie_ns = bench_now_ns() - start;
+    RT_ASSERT(hits > 0);
+
+    printf("%-8s raw: %2u entries %8.1f ns/line, pruned: %2u entries %8.1f ns/line, trie: %8.1f ns/line\n",
+           name, (unsigned) urc_num, raw_ns / rounds / line_num,
+           (unsigned) bench_entries(client->urc_table, client->urc_table_size), pruned_ns / rounds / line_num,
+           trie_ns / rounds / line_num);
+
+    at_device_urc_dispatcher_delete(dispatcher);
+    rt_free(all);
+
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    int rounds = BENCH_ROUNDS_DEFAULT, result = 0;
+
+    if (argc > 1)
+    {
+        rounds = atoi(argv[1]) > 0 ? atoi(argv[1]) : BENCH_ROUNDS_DEFAULT;
+    }
+
+    result |= bench_run("esp8266", &esp8266_client, esp8266_register, esp8266_register_size,
+                        sizeof(esp8266_register) / sizeof(esp8266_register[0]),
+                        esp8266_lines, sizeof(esp8266_lines) / sizeof(esp8266_lines[0]), rounds);
+    result |= bench_run("ec20", &ec20_client, ec20_register, ec20_register_size,
+                        sizeof(ec20_register) / sizeof(ec20_register[0]),
+                        ec20_lines, sizeof(ec20_lines) / sizeof(ec20_lines[0]), rounds);
+
+    return result == 0 ? 0 : 1;
+}